@@ -0,0 +1,31 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+
+namespace voidengine {
+namespace benchmark {
+
+template <typename Fn>
+double measureMilliseconds(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+inline void report(const char* name, double milliseconds, size_t operations) {
+    double nsPerOp = operations ? (milliseconds * 1.0e6) / static_cast<double>(operations) : 0.0;
+    std::printf("%-48s %10.3f ms %12zu ops %10.1f ns/op\n", name, milliseconds, operations, nsPerOp);
+}
+
+// Keeps the optimizer from discarding results that are otherwise unused
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+    (void)*sink;
+}
+
+} // namespace benchmark
+} // namespace voidengine
@@ -0,0 +1,85 @@
+#include "Benchmark.h"
+#include "ui/UIAutomation.h"
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace voidengine;
+
+namespace {
+
+// A pause menu: a button that opens a panel of options, each of which writes
+// its name into a status label
+void buildMenu(ui::UIManager& manager, int optionCount) {
+    auto status = manager.createText("status", glm::vec2(20.0f, 20.0f), "Ready");
+    auto menu = manager.createPanel("menu", glm::vec2(100.0f, 80.0f), glm::vec2(300.0f, 40.0f * optionCount + 20.0f));
+    menu->setVisible(false);
+    
+    std::vector<std::shared_ptr<ui::Button>> options;
+    for (int i = 0; i < optionCount; i++) {
+        std::string name = "option_" + std::to_string(i);
+        auto option = manager.createButton(name, glm::vec2(110.0f, 90.0f + 40.0f * i), glm::vec2(280.0f, 30.0f),
+                                           "Option " + std::to_string(i));
+        option->setOnClick([status, menu, name]() {
+            status->setText(name);
+            menu->setVisible(false);
+        });
+        option->setVisible(false);
+        options.push_back(option);
+    }
+    
+    manager.createButton("open", glm::vec2(20.0f, 40.0f), glm::vec2(70.0f, 30.0f), "Menu", [menu, options]() {
+        menu->setVisible(true);
+        for (const auto& option : options) {
+            option->setVisible(true);
+        }
+    });
+}
+
+// Open the menu, pick one option by mouse and one by keyboard, and check the
+// label after each
+void runScenario(int index, int optionCount) {
+    ui::UIManager manager(1280, 720);
+    buildMenu(manager, optionCount);
+    ui::UIAutomation automation(manager);
+    automation.step();
+    
+    std::string picked = "option_" + std::to_string(index % optionCount);
+    automation.click("open");
+    automation.expectVisible("menu");
+    automation.click(picked);
+    automation.expectText("status", picked);
+    automation.expectVisible("menu", false);
+    
+    automation.click("open");
+    manager.setFocus(&automation.get("option_0"));
+    automation.tapKey(GLFW_KEY_ENTER);
+    automation.step();
+    automation.expectText("status", "option_0");
+}
+
+} // namespace
+
+int main() {
+    const int scenarios = 2000;
+    const int optionCount = 8;
+    
+    int failures = 0;
+    double elapsedMs = benchmark::measureMilliseconds([&]() {
+        for (int i = 0; i < scenarios; i++) {
+            try {
+                runScenario(i, optionCount);
+            } catch (const std::runtime_error& error) {
+                if (failures++ == 0) {
+                    std::cout << "  first failure: " << error.what() << std::endl;
+                }
+            }
+        }
+    });
+    benchmark::report("headless menu scenario", elapsedMs, scenarios);
+    std::cout << "  scenarios per minute: " << static_cast<long long>(scenarios / (elapsedMs / 60000.0))
+              << ", failures: " << failures << std::endl;
+    
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+#include "Benchmark.h"
+#include "core/AllocationTracker.h"
+#include "ui/Observable.h"
+#include "ui/Text.h"
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace voidengine;
+
+namespace {
+
+struct PlayerHud {
+    ui::Observable<int> score;
+    ui::Observable<int> ping;
+    ui::Observable<int> tenths;
+};
+
+void reportAllocations(const char* name, const core::AllocationCounters& before, int frames) {
+    if (core::isAllocationTrackingEnabled()) {
+        std::cout << "  " << name << " heap allocations per frame: "
+                  << static_cast<double>(core::getAllocationCounters().allocations - before.allocations) / frames
+                  << std::endl;
+    }
+}
+
+} // namespace
+
+// A HUD of score, ping and timer labels that game code feeds every frame. The
+// values themselves change far less often than once per frame, which is what
+// formatting into a label unconditionally pays for.
+int main() {
+    const size_t hudCount = 100;
+    const int frames = 2000;
+    const float deltaTime = 1.0f / 60.0f;
+    
+    ui::getUIRegistry().reserve(hudCount * 6 + 16);
+    
+    std::vector<std::shared_ptr<ui::Text>> polledLabels;
+    std::vector<std::shared_ptr<ui::Text>> boundLabels;
+    std::vector<std::unique_ptr<PlayerHud>> huds;
+    for (size_t i = 0; i < hudCount; i++) {
+        for (int j = 0; j < 3; j++) {
+            std::string id = std::to_string(i) + "_" + std::to_string(j);
+            polledLabels.push_back(std::make_shared<ui::Text>("polled_" + id, glm::vec2(0.0f)));
+            boundLabels.push_back(std::make_shared<ui::Text>("bound_" + id, glm::vec2(0.0f)));
+        }
+        
+        auto hud = std::make_unique<PlayerHud>();
+        PlayerHud& values = *hud;
+        boundLabels[i * 3]->bindText([&values](ui::FormatBuffer& out) {
+            out.append("Score: ").append(values.score.get());
+        });
+        boundLabels[i * 3 + 1]->bindText([&values](ui::FormatBuffer& out) {
+            out.append("Ping: ").append(values.ping.get()).append(" ms");
+        });
+        boundLabels[i * 3 + 2]->bindText([&values](ui::FormatBuffer& out) {
+            out.append("Time: ").append(values.tenths.get() / 10.0, 1);
+        });
+        huds.push_back(std::move(hud));
+    }
+    
+    auto scoreAt = [](size_t hud, int frame) { return static_cast<int>(hud) * 10 + frame / 30; };
+    auto pingAt = [](size_t hud, int frame) { return 40 + static_cast<int>((hud + frame / 60) % 20); };
+    auto secondsAt = [&](int frame) { return frame * deltaTime; };
+    
+    core::AllocationCounters before = core::getAllocationCounters();
+    double polledMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            for (size_t i = 0; i < hudCount; i++) {
+                char timer[32];
+                std::snprintf(timer, sizeof(timer), "Time: %.1f", secondsAt(frame));
+                polledLabels[i * 3]->setText("Score: " + std::to_string(scoreAt(i, frame)));
+                polledLabels[i * 3 + 1]->setText("Ping: " + std::to_string(pingAt(i, frame)) + " ms");
+                polledLabels[i * 3 + 2]->setText(timer);
+            }
+        }
+    });
+    benchmark::report("format every label every frame (per frame)", polledMs / frames, hudCount * 3);
+    reportAllocations("polled", before, frames);
+    
+    size_t runs = 0;
+    before = core::getAllocationCounters();
+    double boundMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            for (size_t i = 0; i < hudCount; i++) {
+                huds[i]->score.set(scoreAt(i, frame));
+                huds[i]->ping.set(pingAt(i, frame));
+                huds[i]->tenths.set(static_cast<int>(secondsAt(frame) * 10.0f));
+            }
+            runs += ui::getBindingScheduler().flush();
+        }
+    });
+    benchmark::report("observables + batched flush (per frame)", boundMs / frames, hudCount * 3);
+    reportAllocations("bound", before, frames);
+    std::cout << "  bindings run per frame: " << static_cast<double>(runs) / frames
+              << " of " << hudCount * 3 << " labels" << std::endl;
+    
+    benchmark::doNotOptimize(boundLabels.back()->getText().size());
+    
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "Benchmark.h"
+#include "ui/Button.h"
+#include "ui/FocusManager.h"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace voidengine;
+
+namespace {
+
+// What a focus move costs without an index: score every focusable widget
+ui::UIComponent* scanAll(const std::vector<std::shared_ptr<ui::UIComponent>>& widgets, const ui::UIComponent& from,
+                         const glm::vec2& axis) {
+    const glm::vec2 origin = from.getPosition() + from.getSize() * 0.5f;
+    ui::UIComponent* best = nullptr;
+    float bestScore = std::numeric_limits<float>::max();
+    for (const auto& widget : widgets) {
+        if (widget.get() == &from) {
+            continue;
+        }
+        const glm::vec2 delta = widget->getPosition() + widget->getSize() * 0.5f - origin;
+        const float advance = delta.x * axis.x + delta.y * axis.y;
+        if (advance < 0.5f) {
+            continue;
+        }
+        const float score = advance + 2.0f * std::abs(delta.x * axis.y - delta.y * axis.x);
+        if (score < bestScore) {
+            bestScore = score;
+            best = widget.get();
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+// A 100 x 50 grid of buttons, such as an inventory or level select screen,
+// navigated with the d-pad from every button in every direction
+int main() {
+    const int columns = 100;
+    const int rows = 50;
+    const glm::vec2 buttonSize(60.0f, 30.0f);
+    const glm::vec2 spacing(70.0f, 40.0f);
+    
+    ui::getUIRegistry().reserve(columns * rows * 2 + 16);
+    
+    std::vector<std::shared_ptr<ui::UIComponent>> roots;
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < columns; x++) {
+            std::string id = "cell_" + std::to_string(x) + "_" + std::to_string(y);
+            // Every other row is staggered so that ties are not the common case
+            glm::vec2 position(x * spacing.x + (y % 2) * 20.0f, y * spacing.y);
+            roots.push_back(std::make_shared<ui::Button>(id, position, buttonSize, ""));
+        }
+    }
+    
+    ui::FocusManager focus(roots);
+    const size_t widgetCount = roots.size();
+    
+    const int rebuilds = 20;
+    double rebuildMs = benchmark::measureMilliseconds([&]() {
+        for (int i = 0; i < rebuilds; i++) {
+            focus.invalidate();
+            benchmark::doNotOptimize(focus.getCandidateCount());
+        }
+    });
+    benchmark::report("rebuild grid index (per rebuild)", rebuildMs / rebuilds, widgetCount);
+    
+    const ui::FocusDirection directions[] = {
+        ui::FocusDirection::LEFT, ui::FocusDirection::RIGHT, ui::FocusDirection::UP, ui::FocusDirection::DOWN
+    };
+    const glm::vec2 axes[] = {
+        glm::vec2(-1.0f, 0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, -1.0f), glm::vec2(0.0f, 1.0f)
+    };
+    
+    size_t found = 0;
+    double gridMs = benchmark::measureMilliseconds([&]() {
+        for (const auto& widget : roots) {
+            for (ui::FocusDirection direction : directions) {
+                found += focus.findNeighbor(*widget, direction) != nullptr;
+            }
+        }
+    });
+    benchmark::report("grid query", gridMs, widgetCount * 4);
+    
+    // The linear scan is slow enough that a sample says as much as the lot
+    const size_t sampleStride = 16;
+    size_t scanned = 0;
+    double scanMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < widgetCount; i += sampleStride) {
+            for (const glm::vec2& axis : axes) {
+                benchmark::doNotOptimize(scanAll(roots, *roots[i], axis));
+                scanned++;
+            }
+        }
+    });
+    benchmark::report("linear scan over every widget", scanMs, scanned);
+    
+    std::cout << "  neighbors found: " << found << " of " << widgetCount * 4 << " queries" << std::endl;
+    std::cout << "  index rebuilds: " << focus.getRebuildCount() << std::endl;
+    
+    return 0;
+}
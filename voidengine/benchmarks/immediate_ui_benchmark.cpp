@@ -0,0 +1,72 @@
+#include "Benchmark.h"
+#include "ui/ImmediateUI.h"
+#include "core/AllocationTracker.h"
+#include <iostream>
+
+using namespace voidengine;
+
+namespace {
+
+const int WINDOW_COUNT = 10;
+const int ROWS_PER_WINDOW = 25;
+
+bool gFlags[WINDOW_COUNT][ROWS_PER_WINDOW];
+float gValues[WINDOW_COUNT][ROWS_PER_WINDOW];
+
+// Four widgets per row, 1000 per frame plus the window chrome
+void buildFrame(ui::ImmediateUI& ui, int frame) {
+    for (int w = 0; w < WINDOW_COUNT; w++) {
+        ui.pushId(w);
+        if (ui.beginWindow("Inspector", glm::vec2(20.0f + w * 30.0f, 20.0f), 260.0f)) {
+            for (int row = 0; row < ROWS_PER_WINDOW; row++) {
+                ui.pushId(row);
+                ui.text("entity %d frame %d", row, frame);
+                ui.sameLine();
+                ui.button("Select");
+                ui.checkbox("Enabled", gFlags[w][row]);
+                ui.slider("Weight", gValues[w][row], 0.0f, 1.0f);
+                ui.popId();
+            }
+            ui.endWindow();
+        }
+        ui.popId();
+    }
+    ui.endFrame();
+}
+
+} // namespace
+
+int main() {
+    const int frames = 2000;
+    
+    ui::ImmediateUI ui;
+    ui.setMousePosition(glm::vec2(100.0f, 100.0f));
+    
+    // The first frames grow the command buffers and the state table; the
+    // longest formatted text sizes the text arena
+    for (int frame = 0; frame < 3; frame++) {
+        buildFrame(ui, frames);
+    }
+    
+    core::AllocationCounters before = core::getAllocationCounters();
+    double frameMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            buildFrame(ui, frame);
+        }
+    });
+    uint64_t allocations = core::getAllocationCounters().allocations - before.allocations;
+    
+    const ui::ImmediateStats& stats = ui.getStats();
+    benchmark::report("build immediate frame (per frame)", frameMs / frames, stats.widgets);
+    std::cout << "  widgets: " << stats.widgets
+              << ", commands: " << stats.commands
+              << ", state entries: " << stats.stateEntries
+              << ", duplicate ids: " << stats.duplicateIds << std::endl;
+    if (!core::isAllocationTrackingEnabled()) {
+        std::cout << "  heap allocations: not counted (configure with -DVOIDENGINE_TRACK_ALLOCATIONS=ON)" << std::endl;
+        return 0;
+    }
+    std::cout << "  heap allocations over " << frames << " frames: " << allocations << std::endl;
+    
+    return allocations == 0 ? 0 : 1;
+}
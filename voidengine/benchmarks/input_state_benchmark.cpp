@@ -0,0 +1,148 @@
+#include "Benchmark.h"
+#include "input/InputSystem.h"
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include <GLFW/glfw3.h>
+
+using namespace voidengine;
+
+namespace {
+
+// The hash-map bookkeeping InputSystem used before, kept for comparison
+struct MapButtonStates {
+    std::unordered_map<int, input::ButtonState> states;
+    
+    void set(int code, input::ButtonState state) { states[code] = state; }
+    
+    input::ButtonState get(int code) const {
+        auto it = states.find(code);
+        return it != states.end() ? it->second : input::ButtonState::RELEASED;
+    }
+    
+    void age() {
+        for (auto& pair : states) {
+            if (pair.second == input::ButtonState::PRESSED_THIS_FRAME) {
+                pair.second = input::ButtonState::HELD;
+            } else if (pair.second == input::ButtonState::RELEASED_THIS_FRAME) {
+                pair.second = input::ButtonState::RELEASED;
+            }
+        }
+    }
+};
+
+struct KeyEvent {
+    int key;
+    input::ButtonState state;
+};
+
+} // namespace
+
+// Headless: the system is never given a window, so update() only ages button
+// state and events come in through updateKeyState as Window feeds them. Each
+// frame a few keys change out of everything on a full keyboard that has been
+// touched; a key changes at most once a frame, since a release and press
+// within one frame reads as held from the bitsets but as pressed from the maps.
+// Queries are gameplay polling a fixed set of bindings.
+int main() {
+    const int frames = 100000;
+    const int bindingsPolled = 64;
+    const int queryRounds = 200000;
+    
+    std::mt19937 rng(7);
+    std::vector<int> keys;
+    for (int key = GLFW_KEY_SPACE; key <= GLFW_KEY_LAST; key++) {
+        keys.push_back(key);
+    }
+    std::vector<std::vector<KeyEvent>> script(frames);
+    std::vector<bool> down(GLFW_KEY_LAST + 1, false);
+    for (int frame = 0; frame < frames; frame++) {
+        for (int i = 0; i < 3; i++) {
+            const int key = keys[(rng() % (keys.size() / 3)) * 3 + i];
+            down[key] = !down[key];
+            script[frame].push_back(KeyEvent{key, down[key] ? input::ButtonState::PRESSED_THIS_FRAME
+                                                            : input::ButtonState::RELEASED_THIS_FRAME});
+        }
+    }
+    std::vector<int> polled;
+    for (int i = 0; i < bindingsPolled; i++) {
+        polled.push_back(keys[rng() % keys.size()]);
+    }
+    
+    input::InputSystem system;
+    MapButtonStates map;
+    
+    // Events are set directly rather than queued, so polls come before the
+    // update() that ages them
+    size_t pressedBits = 0;
+    auto pollBits = [&]() {
+        for (int key : polled) {
+            pressedBits += system.isKeyPressed(key) + system.wasKeyPressedThisFrame(key);
+        }
+    };
+    size_t pressedMap = 0;
+    auto pollMap = [&]() {
+        for (int key : polled) {
+            const input::ButtonState state = map.get(key);
+            pressedMap += (state == input::ButtonState::HELD || state == input::ButtonState::PRESSED_THIS_FRAME) +
+                          (state == input::ButtonState::PRESSED_THIS_FRAME);
+        }
+    };
+    
+    double bitsFrameMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            for (const KeyEvent& event : script[frame]) {
+                system.updateKeyState(event.key, event.state);
+            }
+            pollBits();
+            system.update();
+        }
+    });
+    double mapFrameMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            for (const KeyEvent& event : script[frame]) {
+                map.set(event.key, event.state);
+            }
+            pollMap();
+            map.age();
+        }
+    });
+    const bool agree = pressedBits == pressedMap;
+    
+    double bitsUpdateMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            system.update();
+        }
+    });
+    double mapUpdateMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            map.age();
+        }
+    });
+    
+    double bitsQueryMs = benchmark::measureMilliseconds([&]() {
+        for (int round = 0; round < queryRounds; round++) {
+            pollBits();
+        }
+    });
+    double mapQueryMs = benchmark::measureMilliseconds([&]() {
+        for (int round = 0; round < queryRounds; round++) {
+            pollMap();
+        }
+    });
+    benchmark::doNotOptimize(pressedBits);
+    benchmark::doNotOptimize(pressedMap);
+    
+    const size_t queries = static_cast<size_t>(queryRounds) * bindingsPolled * 2;
+    benchmark::report("frame, bitsets", bitsFrameMs, frames);
+    benchmark::report("frame, hash maps", mapFrameMs, frames);
+    benchmark::report("update, bitsets", bitsUpdateMs, frames);
+    benchmark::report("update, hash maps", mapUpdateMs, frames);
+    benchmark::report("query, bitsets", bitsQueryMs, queries);
+    benchmark::report("query, hash maps", mapQueryMs, queries);
+    std::cout << "  " << map.states.size() << " keys tracked; polled states agree: " << (agree ? "yes" : "no")
+              << std::endl;
+    
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "Benchmark.h"
+#include "ui/Layout.h"
+#include "ui/Panel.h"
+#include "ui/Text.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace voidengine;
+
+int main() {
+    const size_t rowCount = 1000;
+    const size_t labelsPerRow = 99;
+    
+    ui::getUIRegistry().reserve(rowCount * (labelsPerRow + 1) + 1);
+    
+    auto root = std::make_shared<ui::Panel>("root", glm::vec2(0.0f), glm::vec2(0.0f));
+    ui::LayoutParams column;
+    column.direction = ui::LayoutDirection::COLUMN;
+    column.padding = glm::vec4(4.0f);
+    column.spacing = 2.0f;
+    column.crossAlign = ui::LayoutAlign::STRETCH;
+    root->setLayout(column);
+    
+    ui::LayoutParams row;
+    row.direction = ui::LayoutDirection::ROW;
+    row.spacing = 4.0f;
+    row.crossAlign = ui::LayoutAlign::CENTER;
+    
+    std::vector<std::shared_ptr<ui::Text>> labels;
+    labels.reserve(rowCount * labelsPerRow);
+    
+    for (size_t r = 0; r < rowCount; r++) {
+        auto rowPanel = std::make_shared<ui::Panel>("row_" + std::to_string(r), glm::vec2(0.0f), glm::vec2(0.0f));
+        rowPanel->setLayout(row);
+        
+        for (size_t c = 0; c < labelsPerRow; c++) {
+            auto label = std::make_shared<ui::Text>("label_" + std::to_string(r) + "_" + std::to_string(c),
+                                                    glm::vec2(0.0f), "cell " + std::to_string(c));
+            rowPanel->addComponent(label);
+            labels.push_back(label);
+        }
+        
+        root->addComponent(rowPanel);
+    }
+    
+    const size_t nodeCount = rowCount * (labelsPerRow + 1) + 1;
+    
+    ui::LayoutStats fullStats;
+    double fullMs = benchmark::measureMilliseconds([&]() {
+        fullStats = ui::updateLayout(*root);
+    });
+    benchmark::report("full layout (100k nodes)", fullMs, nodeCount);
+    std::cout << "  measured " << fullStats.measured << ", arranged " << fullStats.arranged << std::endl;
+    
+    ui::LayoutStats cleanStats;
+    double cleanMs = benchmark::measureMilliseconds([&]() {
+        cleanStats = ui::updateLayout(*root);
+    });
+    benchmark::report("layout with nothing dirty", cleanMs, 1);
+    
+    const size_t editCount = 1000;
+    size_t measured = 0;
+    size_t arranged = 0;
+    double editMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < editCount; i++) {
+            labels[(i * 7919) % labels.size()]->setText(i % 2 ? "edited label" : "x");
+            ui::LayoutStats stats = ui::updateLayout(*root);
+            measured += stats.measured;
+            arranged += stats.arranged;
+        }
+    });
+    benchmark::report("single label edit + relayout", editMs, editCount);
+    std::cout << "  per edit: measured " << (measured / editCount)
+              << ", arranged " << (arranged / editCount) << std::endl;
+    
+    benchmark::doNotOptimize(root->getSize());
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "Benchmark.h"
+#include "core/StringId.h"
+#include "ui/LocaleCompiler.h"
+#include "ui/Localization.h"
+#include "ui/Observable.h"
+#include "ui/Text.h"
+#include "ui/UIRenderer.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace voidengine;
+
+namespace {
+
+std::string makeSource(const char* name, const char* word, size_t entryCount) {
+    std::string source = std::string("@locale ") + name + "\n";
+    for (size_t i = 0; i < entryCount; i++) {
+        source += "label_" + std::to_string(i) + " = " + word + " " + std::to_string(i * 7919 % 100003) + "\n";
+    }
+    return source;
+}
+
+std::string writeImage(const std::vector<uint8_t>& image, const char* name) {
+    const std::string path = std::string("/tmp/voidengine_") + name + ".vloc";
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    return path;
+}
+
+} // namespace
+
+// Runs without a font, so measurement goes through the box fallback. Every
+// label is bound to an entry; each switch swaps the mapped table and flushes
+// the bindings, which re-resolve text and size. Tables compiled with the
+// fallback column size labels from the image, unbaked ones measure each string
+// on first use after a switch. The plain setText pass is the unlocalized
+// equivalent, re-measuring every label from its string.
+int main() {
+    const size_t entryCount = 5000;
+    const int switches = 40;
+    
+    const std::vector<ui::LocaleFont> fallback = {ui::LocaleFont{0, [](std::string_view text) {
+        return ui::measureText(text.data(), text.size(), ui::FONT_BASE_SIZE);
+    }}};
+    const std::string english = makeSource("en", "Settings", entryCount);
+    const std::string german = makeSource("de", "Einstellungen", entryCount);
+    
+    std::vector<uint8_t> englishImage;
+    double compileMs = benchmark::measureMilliseconds([&]() {
+        englishImage = ui::compileLocale(english, fallback);
+    });
+    benchmark::report("compile baked table", compileMs, entryCount);
+    
+    const std::string bakedPaths[2] = {writeImage(englishImage, "en_baked"),
+                                       writeImage(ui::compileLocale(german, fallback), "de_baked")};
+    const std::string plainPaths[2] = {writeImage(ui::compileLocale(english), "en"),
+                                       writeImage(ui::compileLocale(german), "de")};
+    
+    ui::Localization& localization = ui::getLocalization();
+    localization.setLocale(bakedPaths[0]);
+    std::vector<std::unique_ptr<ui::Text>> labels;
+    labels.reserve(entryCount);
+    for (size_t i = 0; i < entryCount; i++) {
+        auto label = std::make_unique<ui::Text>("label_" + std::to_string(i), glm::vec2(0.0f));
+        label->bindLocalizedText(core::hashString("label_" + std::to_string(i)));
+        labels.push_back(std::move(label));
+    }
+    ui::getBindingScheduler().flush();
+    
+    auto run = [&](const char* name, const std::string (&paths)[2]) {
+        const uint64_t measuredBefore = localization.getMeasureCount();
+        double ms = benchmark::measureMilliseconds([&]() {
+            for (int i = 0; i < switches; i++) {
+                localization.setLocale(paths[(i + 1) % 2]);
+                ui::getBindingScheduler().flush();
+            }
+        });
+        benchmark::report(name, ms / switches, entryCount);
+        std::cout << "  " << (localization.getMeasureCount() - measuredBefore) / switches
+                  << " strings measured per switch" << std::endl;
+    };
+    run("switch baked locale (per switch)", bakedPaths);
+    run("switch unbaked locale (per switch)", plainPaths);
+    
+    std::vector<std::string> texts[2];
+    for (size_t i = 0; i < entryCount; i++) {
+        texts[0].push_back("Settings " + std::to_string(i * 7919 % 100003));
+        texts[1].push_back("Einstellungen " + std::to_string(i * 7919 % 100003));
+    }
+    for (auto& label : labels) {
+        label->unbindText();
+    }
+    double plainMs = benchmark::measureMilliseconds([&]() {
+        for (int i = 0; i < switches; i++) {
+            for (size_t l = 0; l < entryCount; l++) {
+                labels[l]->setText(texts[(i + 1) % 2][l]);
+            }
+        }
+    });
+    benchmark::report("setText every label (per switch)", plainMs / switches, entryCount);
+    
+    labels.clear();
+    localization.clear();
+    for (const std::string& path : bakedPaths) {
+        std::remove(path.c_str());
+    }
+    for (const std::string& path : plainPaths) {
+        std::remove(path.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "Benchmark.h"
+#include "ui/LogConsole.h"
+#include "ui/Text.h"
+#include "ui/UIRegistry.h"
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace voidengine;
+
+namespace {
+
+void formatLogLine(uint64_t index, std::string& out) {
+    static const char* const LEVELS[] = {"INFO ", "DEBUG", "WARN ", "ERROR"};
+    out.clear();
+    out += "[";
+    out += std::to_string(index / 1000);
+    out += ".";
+    out += std::to_string(index % 1000);
+    out += "] ";
+    out += LEVELS[(index * 7) % 4];
+    out += " renderer: submitted batch ";
+    out += std::to_string(index * 2654435761u % 100000);
+    out += " with ";
+    out += std::to_string(index % 977);
+    out += " draw calls";
+}
+
+} // namespace
+
+int main() {
+    const uint64_t totalLines = 2000000;
+    const uint64_t linesPerFrame = 1000;
+    const float deltaTime = 1.0f / 60.0f;
+    
+    ui::getUIRegistry().reserve(16);
+    
+    const std::string spillPath = (std::filesystem::temp_directory_path() / "voidengine_log_spill.bin").string();
+    ui::LogConsole console("console", glm::vec2(0.0f), glm::vec2(1280.0f, 720.0f), 14.0f, 4 * 1024 * 1024);
+    console.setSpillFile(spillPath);
+    
+    std::string line;
+    uint64_t appendedBytes = 0;
+    double appendMs = benchmark::measureMilliseconds([&]() {
+        for (uint64_t i = 0; i < totalLines; i += linesPerFrame) {
+            for (uint64_t j = i; j < i + linesPerFrame; j++) {
+                formatLogLine(j, line);
+                appendedBytes += line.size();
+                console.append(line);
+            }
+            console.update(deltaTime);
+        }
+    });
+    benchmark::report("append and tail 1000 lines per frame (per line)", appendMs, totalLines);
+    
+    const ui::LogBuffer& buffer = console.getBuffer();
+    std::cout << "  lines retained: " << buffer.getLineCount() << ", text appended: " << appendedBytes / (1024 * 1024)
+              << " MB, resident: " << buffer.getResidentBytes() / (1024 * 1024)
+              << " MB, spilled: " << buffer.getSpilledBytes() / (1024 * 1024) << " MB" << std::endl;
+    std::cout << "  lines laid out for display: " << console.getLaidOutLineCount() << " of "
+              << console.getMeasuredLineCount() << " measured" << std::endl;
+    
+    // Jumps anywhere in the history, mostly into the spilled part
+    std::mt19937_64 random(7);
+    const int jumps = 2000;
+    double scrollMs = benchmark::measureMilliseconds([&]() {
+        for (int i = 0; i < jumps; i++) {
+            console.scrollToLine(buffer.getFirstLine() + random() % buffer.getLineCount());
+            console.update(deltaTime);
+        }
+    });
+    benchmark::report("scroll back to a random line (per jump)", scrollMs, jumps);
+    
+    double searchMs = benchmark::measureMilliseconds([&]() {
+        console.search("batch 4242 ");
+        while (console.isSearching()) {
+            console.update(deltaTime);
+        }
+    });
+    benchmark::report("background search of every retained line", searchMs, buffer.getLineCount());
+    std::cout << "  matches: " << console.getSearchMatches().size() << std::endl;
+    
+    // What the console replaces: one Text holding the whole log, remeasured on
+    // every append. Far fewer lines, since the cost grows with the total.
+    const uint64_t textLines = 5000;
+    ui::Text text("log", glm::vec2(0.0f), "", 14.0f);
+    std::string whole;
+    double textMs = benchmark::measureMilliseconds([&]() {
+        for (uint64_t i = 0; i < textLines; i++) {
+            formatLogLine(i, line);
+            whole += line;
+            whole += '\n';
+            text.setText(whole);
+        }
+    });
+    benchmark::report("Text::setText on a growing log (per line)", textMs, textLines);
+    
+    return 0;
+}
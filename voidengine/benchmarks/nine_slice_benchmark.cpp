@@ -0,0 +1,113 @@
+#include "Benchmark.h"
+#include "ui/Button.h"
+#include "ui/DrawList.h"
+#include "ui/Panel.h"
+#include "ui/TextureAtlas.h"
+#include "ui/UIRenderer.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace voidengine;
+
+namespace {
+
+void record(ui::DrawList& list, ui::UIComponent& root) {
+    list.clear();
+    ui::DrawListScope scope(list);
+    root.render();
+}
+
+// Wraps made-up texture names; recording never touches GL
+std::shared_ptr<ui::TextureAtlas> makeAtlas(unsigned int texture) {
+    auto atlas = std::make_shared<ui::TextureAtlas>(texture, 256, 256);
+    atlas->addRegion("panel", 0, 0, 64, 64, glm::vec4(12.0f));
+    atlas->addRegion("button", 64, 0, 48, 24, glm::vec4(6.0f, 6.0f, 6.0f, 6.0f));
+    atlas->addRegion("button_hover", 112, 0, 48, 24, glm::vec4(6.0f, 6.0f, 6.0f, 6.0f));
+    return atlas;
+}
+
+} // namespace
+
+// Records geometry only; submitting needs a GL context. A grid of skinned
+// panels of unlabeled buttons is recorded with every skin cut from one shared
+// atlas, then with each widget's skin in a texture of its own, the overlaid
+// full-size textures the atlas replaces. Batches are draw calls. Labels are
+// left out because glyphs each have their own texture and would split the
+// batches in both cases.
+int main() {
+    const size_t panelCount = 40;
+    const size_t buttonsPerPanel = 24;
+    const int frames = 200;
+    
+    auto shared = makeAtlas(1);
+    std::vector<std::shared_ptr<ui::TextureAtlas>> separate;
+    unsigned int nextTexture = 2;
+    auto ownAtlas = [&]() {
+        separate.push_back(makeAtlas(nextTexture++));
+        return separate.back();
+    };
+    
+    auto build = [&](bool useShared) {
+        auto screen = std::make_shared<ui::Panel>("screen", glm::vec2(0.0f), glm::vec2(1920.0f, 1080.0f), false);
+        for (size_t p = 0; p < panelCount; p++) {
+            const glm::vec2 origin(static_cast<float>(p % 8) * 240.0f, static_cast<float>(p / 8) * 216.0f);
+            auto panel = std::make_shared<ui::Panel>("panel_" + std::to_string(p), origin, glm::vec2(232.0f, 208.0f));
+            panel->setNineSlice(useShared ? shared : ownAtlas(), "panel");
+            for (size_t b = 0; b < buttonsPerPanel; b++) {
+                const glm::vec2 offset(8.0f + static_cast<float>(b % 3) * 74.0f, 8.0f + static_cast<float>(b / 3) * 25.0f);
+                auto button = std::make_shared<ui::Button>("button_" + std::to_string(p) + "_" + std::to_string(b),
+                                                           origin + offset, glm::vec2(70.0f, 22.0f));
+                auto atlas = useShared ? shared : ownAtlas();
+                button->setNineSlice(ui::ButtonState::NORMAL, atlas, "button");
+                button->setNineSlice(ui::ButtonState::HOVER, atlas, "button_hover");
+                panel->addComponent(button);
+            }
+            screen->addComponent(panel);
+        }
+        return screen;
+    };
+    
+    const size_t widgets = panelCount * (buttonsPerPanel + 1);
+    ui::DrawList list;
+    
+    auto plain = std::make_shared<ui::Panel>("screen", glm::vec2(0.0f), glm::vec2(1920.0f, 1080.0f), false);
+    for (size_t p = 0; p < panelCount; p++) {
+        const glm::vec2 origin(static_cast<float>(p % 8) * 240.0f, static_cast<float>(p / 8) * 216.0f);
+        auto panel = std::make_shared<ui::Panel>("plain_" + std::to_string(p), origin, glm::vec2(232.0f, 208.0f));
+        for (size_t b = 0; b < buttonsPerPanel; b++) {
+            const glm::vec2 offset(8.0f + static_cast<float>(b % 3) * 74.0f, 8.0f + static_cast<float>(b / 3) * 25.0f);
+            panel->addComponent(std::make_shared<ui::Button>("plain_" + std::to_string(p) + "_" + std::to_string(b),
+                                                             origin + offset, glm::vec2(70.0f, 22.0f)));
+        }
+        plain->addComponent(panel);
+    }
+    double plainMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            record(list, *plain);
+        }
+    });
+    benchmark::report("record solid fills (per frame)", plainMs / frames, widgets);
+    std::cout << "  " << list.getVertexCount() << " vertices in " << list.getBatchCount() << " batches" << std::endl;
+    
+    auto sharedScreen = build(true);
+    double sharedMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            record(list, *sharedScreen);
+        }
+    });
+    benchmark::report("record nine-slices, one atlas (per frame)", sharedMs / frames, widgets);
+    std::cout << "  " << list.getVertexCount() << " vertices in " << list.getBatchCount() << " batches" << std::endl;
+    
+    auto separateScreen = build(false);
+    double separateMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            record(list, *separateScreen);
+        }
+    });
+    benchmark::report("record nine-slices, texture per widget (per frame)", separateMs / frames, widgets);
+    std::cout << "  " << list.getVertexCount() << " vertices in " << list.getBatchCount() << " batches" << std::endl;
+    
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "Benchmark.h"
+#include "ui/Panel.h"
+#include "ui/Text.h"
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace voidengine;
+
+int main() {
+    const size_t childCount = 10000;
+    const size_t lookupCount = 1000000;
+    
+    std::vector<std::shared_ptr<ui::UIComponent>> children;
+    std::vector<std::string> ids;
+    children.reserve(childCount);
+    ids.reserve(childCount);
+    
+    for (size_t i = 0; i < childCount; i++) {
+        ids.push_back("child_" + std::to_string(i));
+        children.push_back(std::make_shared<ui::Text>(ids.back(), glm::vec2(0.0f), "row"));
+    }
+    
+    auto panel = std::make_shared<ui::Panel>("panel", glm::vec2(0.0f), glm::vec2(800.0f, 600.0f));
+    
+    double buildMs = benchmark::measureMilliseconds([&]() {
+        for (auto& child : children) {
+            panel->addComponent(child);
+        }
+    });
+    benchmark::report("build panel (10k children)", buildMs, childCount);
+    
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<size_t> pick(0, childCount - 1);
+    std::vector<size_t> order(lookupCount);
+    for (auto& index : order) {
+        index = pick(rng);
+    }
+    
+    std::vector<core::StringId> symbols(childCount);
+    for (size_t i = 0; i < childCount; i++) {
+        symbols[i] = children[i]->getIdSymbol();
+    }
+    
+    size_t found = 0;
+    double stringMs = benchmark::measureMilliseconds([&]() {
+        for (size_t index : order) {
+            found += panel->getComponent(ids[index]) != nullptr;
+        }
+    });
+    benchmark::report("random lookup by std::string", stringMs, lookupCount);
+    
+    double symbolMs = benchmark::measureMilliseconds([&]() {
+        for (size_t index : order) {
+            found += panel->getComponent(symbols[index]) != nullptr;
+        }
+    });
+    benchmark::report("random lookup by StringId", symbolMs, lookupCount);
+    
+    // Component ids are interned, so a symbol is found once and kept rather
+    // than hashed from a literal
+    const core::StringId cached = core::findString("child_4242");
+    double cachedMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < lookupCount; i++) {
+            found += panel->getComponent(cached) != nullptr;
+        }
+    });
+    benchmark::report("repeated lookup by cached symbol", cachedMs, lookupCount);
+    
+    double removeMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = childCount; i-- > 0;) {
+            panel->removeComponent(symbols[i]);
+        }
+    });
+    benchmark::report("remove all children (back to front)", removeMs, childCount);
+    
+    std::cout << "found " << found << " of " << (3 * lookupCount) << " lookups" << std::endl;
+    return 0;
+}
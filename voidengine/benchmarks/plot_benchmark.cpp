@@ -0,0 +1,90 @@
+#include "Benchmark.h"
+#include "ui/DrawList.h"
+#include "ui/Plot.h"
+#include "ui/UIRenderer.h"
+#include "ui/UIRegistry.h"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace voidengine;
+
+int main() {
+    const size_t samples = 1000000;
+    const int frames = 300;
+    const float deltaTime = 1.0f / 60.0f;
+    
+    ui::getUIRegistry().reserve(16);
+    
+    std::mt19937 random(11);
+    std::normal_distribution<float> noise(0.0f, 0.6f);
+    std::vector<float> frameTimes(samples);
+    for (size_t i = 0; i < samples; i++) {
+        frameTimes[i] = 16.6f + noise(random) + (i % 5000 == 0 ? 30.0f : 0.0f);
+    }
+    
+    ui::Plot plot("frame_times", glm::vec2(0.0f), glm::vec2(1280.0f, 240.0f));
+    size_t line = plot.addSeries(glm::vec4(0.3f, 0.9f, 0.4f, 1.0f), ui::PlotStyle::LINE, samples);
+    size_t area = plot.addSeries(glm::vec4(0.3f, 0.5f, 1.0f, 1.0f), ui::PlotStyle::AREA, samples);
+    ui::PlotSeries& lineSeries = plot.getSeries(line);
+    ui::PlotSeries& areaSeries = plot.getSeries(area);
+    
+    double singleMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < samples; i++) {
+            lineSeries.append(frameTimes[i]);
+        }
+    });
+    benchmark::report("append one sample at a time", singleMs, samples);
+    
+    const size_t block = 4096;
+    double blockMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < samples; i += block) {
+            areaSeries.append(frameTimes.data() + i, std::min(block, samples - i));
+        }
+    });
+    benchmark::report("append in blocks of 4096", blockMs, samples);
+    
+    std::vector<float> mins(1272);
+    std::vector<float> maxs(1272);
+    double decimateMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            lineSeries.decimate(lineSeries.getBeginIndex(), lineSeries.getEndIndex(), mins.size(), mins.data(),
+                                maxs.data());
+        }
+    });
+    benchmark::report("decimate 1M samples to 1272 columns", decimateMs / frames, 1);
+    
+    // A new frame time arrives and both series are redrawn, as a live graph would
+    ui::DrawList drawList;
+    size_t next = 0;
+    double frameMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            float value = frameTimes[next++ % samples];
+            lineSeries.append(value);
+            areaSeries.append(value);
+            plot.update(deltaTime);
+            if (plot.consumeRenderDirty()) {
+                drawList.clear();
+                ui::DrawListScope scope(drawList);
+                plot.render();
+            }
+        }
+    });
+    benchmark::report("append, decimate and record two series (per frame)", frameMs / frames, 1);
+    std::cout << "  vertices recorded: " << drawList.getVertexCount() << " (one quad per sample would be "
+              << 2 * samples * 4 << ")" << std::endl;
+    
+    // What the plot avoids: a quad per sample
+    double naiveMs = benchmark::measureMilliseconds([&]() {
+        drawList.clear();
+        ui::DrawListScope scope(drawList);
+        for (size_t i = 0; i < samples; i++) {
+            float x = static_cast<float>(i) * (1272.0f / static_cast<float>(samples));
+            ui::drawRect(glm::vec2(x, 240.0f - frameTimes[i] * 4.0f), glm::vec2(1.0f, 1.0f), glm::vec4(1.0f));
+        }
+    });
+    benchmark::report("record a quad per sample of one series", naiveMs, samples);
+    
+    return 0;
+}
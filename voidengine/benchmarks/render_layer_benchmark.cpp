@@ -0,0 +1,84 @@
+#include "Benchmark.h"
+#include "ui/Button.h"
+#include "ui/DrawList.h"
+#include "ui/Panel.h"
+#include "ui/Text.h"
+#include "ui/UIRenderer.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace voidengine;
+
+namespace {
+
+void record(ui::DrawList& list, ui::UIComponent& root) {
+    list.clear();
+    ui::DrawListScope scope(list);
+    root.render();
+}
+
+} // namespace
+
+// Records geometry only; submitting needs a GL context. A static background
+// of buttons sits under a tooltip whose text changes every frame, which is the
+// case per-layer caching is for.
+int main() {
+    const size_t buttonCount = 2000;
+    const int frames = 200;
+    
+    auto background = std::make_shared<ui::Panel>("background", glm::vec2(0.0f), glm::vec2(1920.0f, 1080.0f));
+    background->reserveChildren(buttonCount);
+    for (size_t i = 0; i < buttonCount; i++) {
+        float x = static_cast<float>(i % 40) * 48.0f;
+        float y = static_cast<float>(i / 40) * 21.0f;
+        background->addComponent(std::make_shared<ui::Button>("button_" + std::to_string(i), glm::vec2(x, y),
+                                                              glm::vec2(46.0f, 20.0f), "Item"));
+    }
+    
+    auto tooltip = std::make_shared<ui::Text>("tooltip", glm::vec2(400.0f, 300.0f), "frame 0", 14.0f);
+    tooltip->setRenderLayer(ui::UILayer::TOOLTIP);
+    
+    ui::DrawList backgroundList;
+    ui::DrawList tooltipList;
+    record(backgroundList, *background);
+    record(tooltipList, *tooltip);
+    std::cout << "  background: " << backgroundList.getVertexCount() << " vertices in "
+              << backgroundList.getBatchCount() << " batches" << std::endl;
+    
+    std::vector<std::string> labels;
+    for (int frame = 0; frame < frames; frame++) {
+        labels.push_back("frame " + std::to_string(frame));
+    }
+    
+    double uncachedMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            tooltip->setText(labels[frame]);
+            record(backgroundList, *background);
+            record(tooltipList, *tooltip);
+        }
+    });
+    benchmark::report("re-record every layer (per frame)", uncachedMs / frames, buttonCount);
+    
+    size_t rebuilds = 0;
+    background->consumeRenderDirty();
+    double cachedMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            tooltip->setText(labels[(frame + 1) % frames]);
+            if (background->consumeRenderDirty()) {
+                record(backgroundList, *background);
+                rebuilds++;
+            }
+            if (tooltip->consumeRenderDirty()) {
+                record(tooltipList, *tooltip);
+            }
+        }
+    });
+    benchmark::report("re-record dirty layers only (per frame)", cachedMs / frames, buttonCount);
+    std::cout << "  background rebuilds: " << rebuilds << std::endl;
+    
+    benchmark::doNotOptimize(tooltipList.getVertexCount());
+    
+    return 0;
+}
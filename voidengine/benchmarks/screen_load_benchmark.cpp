@@ -0,0 +1,94 @@
+#include "Benchmark.h"
+#include "core/MappedFile.h"
+#include "ui/ScreenCompiler.h"
+#include "ui/ScreenLoader.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace voidengine;
+
+namespace {
+
+std::string generateScreenSource(size_t groupCount, size_t itemsPerGroup) {
+    std::ostringstream source;
+    source << "{ \"type\": \"panel\", \"id\": \"root\", \"position\": [0, 0], \"size\": [1920, 1080],\n";
+    source << "  \"layout\": { \"direction\": \"column\", \"padding\": 4, \"spacing\": 2 },\n";
+    source << "  \"children\": [\n";
+    
+    for (size_t g = 0; g < groupCount; g++) {
+        source << "    { \"type\": \"panel\", \"id\": \"group_" << g << "\", \"background\": [0.2, 0.2, 0.3, 0.8],\n";
+        source << "      \"layout\": { \"direction\": \"row\", \"spacing\": 4, \"crossAlign\": \"center\" },\n";
+        source << "      \"children\": [\n";
+        
+        for (size_t i = 0; i < itemsPerGroup; i++) {
+            if (i % 2 == 0) {
+                source << "        { \"type\": \"button\", \"id\": \"button_" << g << "_" << i
+                       << "\", \"size\": [80, 24], \"text\": \"Action " << i << "\" }";
+            } else {
+                source << "        { \"type\": \"text\", \"id\": \"label_" << g << "_" << i
+                       << "\", \"text\": \"Value " << i << "\", \"fontSize\": 12, \"textColor\": [0.8, 0.8, 1.0, 1.0] }";
+            }
+            source << (i + 1 < itemsPerGroup ? ",\n" : "\n");
+        }
+        
+        source << "      ] }" << (g + 1 < groupCount ? ",\n" : "\n");
+    }
+    
+    source << "  ]\n}\n";
+    return source.str();
+}
+
+} // namespace
+
+int main() {
+    const size_t groupCount = 100;
+    const size_t itemsPerGroup = 100;
+    const size_t nodeCount = 1 + groupCount * (itemsPerGroup + 1);
+    const int runs = 5;
+    
+    std::string source = generateScreenSource(groupCount, itemsPerGroup);
+    std::vector<uint8_t> image = ui::compileScreen(source);
+    std::cout << "nodes: " << nodeCount << ", text: " << source.size() << " bytes, binary: "
+              << image.size() << " bytes" << std::endl;
+    
+    const std::string imagePath = "screen_load_benchmark.vui";
+    {
+        std::ofstream output(imagePath, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    }
+    
+    // Warm the registry and interner so both paths start from the same state
+    ui::instantiateScreen(image.data(), image.size());
+    
+    double textMs = 0.0;
+    double compileMs = 0.0;
+    for (int run = 0; run < runs; run++) {
+        textMs += benchmark::measureMilliseconds([&]() {
+            std::vector<uint8_t> compiled;
+            compileMs += benchmark::measureMilliseconds([&]() {
+                compiled = ui::compileScreen(source);
+            });
+            ui::LoadedScreen screen = ui::instantiateScreen(compiled.data(), compiled.size());
+            benchmark::doNotOptimize(screen.root);
+        });
+    }
+    benchmark::report("text path: parse + instantiate", textMs / runs, nodeCount);
+    benchmark::report("  of which parse and compile", compileMs / runs, nodeCount);
+    
+    double binaryMs = 0.0;
+    for (int run = 0; run < runs; run++) {
+        binaryMs += benchmark::measureMilliseconds([&]() {
+            core::MappedFile file(imagePath);
+            ui::LoadedScreen screen = ui::instantiateScreen(file.data(), file.size());
+            benchmark::doNotOptimize(screen.root);
+        });
+    }
+    benchmark::report("binary path: mmap + instantiate", binaryMs / runs, nodeCount);
+    
+    std::remove(imagePath.c_str());
+    return 0;
+}
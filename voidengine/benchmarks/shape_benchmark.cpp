@@ -0,0 +1,138 @@
+#include "Benchmark.h"
+#include "ui/Button.h"
+#include "ui/DrawList.h"
+#include "ui/Panel.h"
+#include "ui/ShapeTessellator.h"
+#include "ui/StyleSheet.h"
+#include "ui/UIRenderer.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace voidengine;
+
+namespace {
+
+void record(ui::DrawList& list, ui::UIComponent& root) {
+    list.clear();
+    ui::DrawListScope scope(list);
+    root.render();
+}
+
+} // namespace
+
+// Records geometry only; submitting needs a GL context. Tessellation is timed
+// on its own first, then a screen of rounded, shadowed menus is re-recorded
+// every frame while one menu plays an opening animation, with the shape cache
+// disabled so every draw tessellates, then enabled.
+int main() {
+    const size_t shapeCount = 20000;
+    const size_t menuCount = 8;
+    const size_t itemsPerMenu = 12;
+    const int frames = 300;
+    const int openingFrames = 20;
+    
+    ui::ShapeMesh mesh;
+    size_t vertices = 0;
+    double fillMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < shapeCount; i++) {
+            mesh.vertices.clear();
+            ui::tessellateRoundedRect(glm::vec2(100.0f + i % 200, 30.0f + i % 50), 8.0f, 1.0f, mesh);
+            vertices += mesh.vertices.size();
+        }
+    });
+    benchmark::report("tessellate rounded rect (r 8, AA)", fillMs, shapeCount);
+    std::cout << "  vertices per shape: " << vertices / shapeCount << std::endl;
+    
+    vertices = 0;
+    double shadowMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < shapeCount; i++) {
+            mesh.vertices.clear();
+            ui::tessellateRoundedRect(glm::vec2(300.0f + i % 200, 400.0f), 12.0f, 16.0f, mesh);
+            vertices += mesh.vertices.size();
+        }
+    });
+    benchmark::report("tessellate shadow (r 12, blur 16)", shadowMs, shapeCount);
+    std::cout << "  vertices per shape: " << vertices / shapeCount << std::endl;
+    
+    vertices = 0;
+    double strokeMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < shapeCount; i++) {
+            mesh.vertices.clear();
+            ui::tessellateRoundedRectStroke(glm::vec2(100.0f + i % 200, 30.0f), 8.0f, 1.5f, 1.0f, mesh);
+            vertices += mesh.vertices.size();
+        }
+    });
+    benchmark::report("tessellate rounded outline (r 8, w 1.5)", strokeMs, shapeCount);
+    std::cout << "  vertices per shape: " << vertices / shapeCount << std::endl;
+    
+    vertices = 0;
+    double arcMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < shapeCount; i++) {
+            mesh.vertices.clear();
+            ui::tessellateArc(24.0f, 0.0f, 0.001f * static_cast<float>(i % 6000), 4.0f, 1.0f, mesh);
+            vertices += mesh.vertices.size();
+        }
+    });
+    benchmark::report("tessellate arc (r 24, w 4)", arcMs, shapeCount);
+    std::cout << "  vertices per shape: " << vertices / shapeCount << std::endl;
+    
+    ui::getStyleSystem().setStyleSheet(ui::StyleSheet::parse(
+        "Panel { background: 0.15 0.15 0.18 0.95; border-radius: 8; shadow-blur: 12; }\n"
+        "Button { border-radius: 6; shadow-blur: 3; shadow: 0 0 0 0.3; }\n"));
+    
+    auto screen = std::make_shared<ui::Panel>("screen", glm::vec2(0.0f), glm::vec2(1920.0f, 1080.0f));
+    screen->setBorderEnabled(false);
+    std::vector<std::shared_ptr<ui::Panel>> menus;
+    for (size_t m = 0; m < menuCount; m++) {
+        auto menu = std::make_shared<ui::Panel>("menu_" + std::to_string(m), glm::vec2(20.0f + 230.0f * m, 40.0f),
+                                                glm::vec2(220.0f, 12.0f + 36.0f * itemsPerMenu));
+        for (size_t i = 0; i < itemsPerMenu; i++) {
+            menu->addComponent(std::make_shared<ui::Button>(
+                "item_" + std::to_string(m) + "_" + std::to_string(i),
+                glm::vec2(26.0f + 230.0f * m, 46.0f + 36.0f * i), glm::vec2(208.0f, 32.0f), "Item"));
+        }
+        screen->addComponent(menu);
+        menus.push_back(menu);
+    }
+    
+    // The last menu grows to full height over the first frames
+    auto playFrame = [&](int frame) {
+        const float opened = static_cast<float>(std::min(frame + 1, openingFrames)) / openingFrames;
+        menus.back()->setSize(glm::vec2(220.0f, (12.0f + 36.0f * itemsPerMenu) * opened));
+    };
+    
+    ui::DrawList list;
+    ui::ShapeCache& cache = ui::getShapeCache();
+    cache.setEnabled(false);
+    
+    double uncachedMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            playFrame(frame);
+            record(list, *screen);
+        }
+    });
+    benchmark::report("record menus, uncached (per frame)", uncachedMs / frames, menuCount * itemsPerMenu);
+    
+    cache.setEnabled(true);
+    const uint64_t hitsBefore = cache.getHitCount();
+    const uint64_t missesBefore = cache.getMissCount();
+    double cachedMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            playFrame(frame);
+            record(list, *screen);
+        }
+    });
+    benchmark::report("record menus, cached (per frame)", cachedMs / frames, menuCount * itemsPerMenu);
+    
+    const uint64_t hits = cache.getHitCount() - hitsBefore;
+    const uint64_t misses = cache.getMissCount() - missesBefore;
+    std::cout << "  shape cache: " << hits << " hits, " << misses << " misses ("
+              << 100.0 * static_cast<double>(hits) / static_cast<double>(hits + misses) << "% hit rate), "
+              << cache.size() << " meshes" << std::endl;
+    std::cout << "  frame: " << list.getVertexCount() << " vertices in " << list.getBatchCount() << " batches"
+              << std::endl;
+    
+    return 0;
+}
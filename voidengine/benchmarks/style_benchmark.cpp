@@ -0,0 +1,91 @@
+#include "Benchmark.h"
+#include "ui/Button.h"
+#include "ui/Panel.h"
+#include "ui/StyleSheet.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace voidengine;
+
+namespace {
+
+size_t refreshTree(ui::UIComponent& component) {
+    size_t count = 1;
+    component.refreshStyle();
+    for (size_t i = 0; i < component.getChildCount(); i++) {
+        count += refreshTree(*component.getChild(i));
+    }
+    return count;
+}
+
+} // namespace
+
+// Headless: refreshTree stands in for the walk UIManager::update does after a
+// sheet switch
+int main() {
+    const size_t buttonCount = 10000;
+    const int switches = 50;
+    
+    ui::getUIRegistry().reserve(buttonCount * 2 + 1);
+    
+    auto root = std::make_shared<ui::Panel>("root", glm::vec2(0.0f), glm::vec2(1920.0f, 1080.0f));
+    root->reserveChildren(buttonCount);
+    
+    double createMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < buttonCount; i++) {
+            auto button = std::make_shared<ui::Button>("button_" + std::to_string(i), glm::vec2(0.0f),
+                                                       glm::vec2(46.0f, 20.0f), "Item");
+            if (i % 3 == 0) {
+                button->setStyleClass("primary");
+            }
+            root->addComponent(button);
+        }
+    });
+    benchmark::report("create styled buttons", createMs, buttonCount);
+    
+    // A handful of one-off colors, the case sparse overrides are for
+    for (size_t i = 0; i < buttonCount; i += 1000) {
+        auto button = std::static_pointer_cast<ui::Button>(root->getComponent("button_" + std::to_string(i)));
+        button->setStateColor(ui::ButtonState::NORMAL, glm::vec4(0.8f, 0.2f, 0.2f, 1.0f));
+    }
+    
+    auto dark = ui::getStyleSystem().getStyleSheet();
+    auto light = ui::StyleSheet::parse(
+        "Panel { background: 0.85 0.85 0.88 0.9; border: 0.4 0.4 0.45; }\n"
+        "Button { background: 0.2 0.5 0.3; hover-background: 0.3 0.6 0.4; }\n"
+        "Button.primary { background: 0.1 0.3 0.7; border-width: 2; }\n");
+    
+    double switchMs = benchmark::measureMilliseconds([&]() {
+        for (int i = 0; i < switches; i++) {
+            ui::getStyleSystem().setStyleSheet(i % 2 == 0 ? light : dark);
+        }
+    });
+    benchmark::report("switch sheet", switchMs, switches);
+    
+    size_t refreshed = 0;
+    double refreshMs = benchmark::measureMilliseconds([&]() {
+        for (int i = 0; i < switches; i++) {
+            ui::getStyleSystem().setStyleSheet(i % 2 == 0 ? light : dark);
+            refreshed += refreshTree(*root);
+        }
+    });
+    benchmark::report("switch sheet + re-resolve every widget", refreshMs, refreshed);
+    
+    double idleMs = benchmark::measureMilliseconds([&]() {
+        for (int i = 0; i < switches; i++) {
+            refreshTree(*root);
+        }
+    });
+    benchmark::report("refresh walk with no change", idleMs, refreshed);
+    
+    std::cout << "  interned records: " << ui::getStyleSystem().getRecordCount()
+              << " for " << buttonCount + 1 << " widgets" << std::endl;
+    std::cout << "  sizeof(Button): " << sizeof(ui::Button)
+              << " bytes, sizeof(StyleRecord): " << sizeof(ui::StyleRecord) << " bytes" << std::endl;
+    
+    benchmark::doNotOptimize(refreshed);
+    
+    return 0;
+}
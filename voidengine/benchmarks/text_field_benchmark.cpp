@@ -0,0 +1,89 @@
+#include "Benchmark.h"
+#include "ui/TextField.h"
+#include <iostream>
+#include <string>
+#include <GLFW/glfw3.h>
+
+using namespace voidengine;
+
+// Headless: edits go through the same entry points as keyboard input, and
+// refreshLayout stands in for the layout half of a render
+int main() {
+    const size_t edits = 10000;
+    
+    std::string document;
+    document.reserve(1 << 20);
+    for (size_t i = 0; document.size() < (1u << 20); i++) {
+        document += "line " + std::to_string(i) + ": the quick brown fox jumps over the lazy dog\n";
+    }
+    
+    ui::TextField field("editor", glm::vec2(0.0f), glm::vec2(800.0f, 600.0f), true);
+    
+    double loadMs = benchmark::measureMilliseconds([&]() {
+        field.setText(document);
+        field.refreshLayout();
+    });
+    benchmark::report("load 1 MB document", loadMs, 1);
+    std::cout << "  bytes: " << field.getBuffer().size()
+              << ", lines: " << field.getBuffer().getLineCount() << std::endl;
+    
+    // Typing in the middle of the document, with the view following the cursor
+    size_t middle = field.getBuffer().getLineStart(field.getBuffer().getLineCount() / 2) + 5;
+    field.setCursor(middle);
+    field.refreshLayout();
+    
+    size_t rebuildsBefore = field.getLineRebuildCount();
+    double typeMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < edits; i++) {
+            field.handleChar('a' + static_cast<unsigned int>(i % 26));
+            field.refreshLayout();
+        }
+    });
+    benchmark::report("type mid-document + relayout", typeMs, edits);
+    std::cout << "  lines rebuilt per edit: "
+              << static_cast<double>(field.getLineRebuildCount() - rebuildsBefore) / edits << std::endl;
+    
+    rebuildsBefore = field.getLineRebuildCount();
+    double enterMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < edits / 10; i++) {
+            field.insertText("\n");
+            field.refreshLayout();
+        }
+    });
+    benchmark::report("insert line breaks + relayout", enterMs, edits / 10);
+    std::cout << "  lines rebuilt per edit: "
+              << static_cast<double>(field.getLineRebuildCount() - rebuildsBefore) / (edits / 10) << std::endl;
+    
+    double deleteMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < edits; i++) {
+            field.handleKey(GLFW_KEY_BACKSPACE, 0);
+            field.refreshLayout();
+        }
+    });
+    benchmark::report("backspace mid-document + relayout", deleteMs, edits);
+    
+    // Jumping around breaks the typing merge, so each edit is its own undo step
+    double scatteredMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < edits; i++) {
+            size_t line = (i * 7919) % field.getBuffer().getLineCount();
+            field.setCursor(field.getBuffer().getLineStart(line));
+            field.handleChar('x');
+            field.refreshLayout();
+        }
+    });
+    benchmark::report("scattered single-char edits + relayout", scatteredMs, edits);
+    std::cout << "  pieces: " << field.getBuffer().getPieceCount() << std::endl;
+    
+    size_t undone = 0;
+    double undoMs = benchmark::measureMilliseconds([&]() {
+        while (field.undo()) {
+            undone++;
+        }
+        field.refreshLayout();
+    });
+    benchmark::report("undo history", undoMs, undone);
+    
+    benchmark::doNotOptimize(field.getCursor());
+    
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "Benchmark.h"
+#include "ui/Panel.h"
+#include "ui/Tween.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace voidengine;
+
+int main() {
+    const size_t componentCount = 50000;
+    const size_t tweenCount = componentCount * 2;
+    const int frames = 120;
+    const float deltaTime = 1.0f / 60.0f;
+    
+    ui::getUIRegistry().reserve(componentCount);
+    
+    std::vector<std::shared_ptr<ui::Panel>> panels;
+    panels.reserve(componentCount);
+    for (size_t i = 0; i < componentCount; i++) {
+        panels.push_back(std::make_shared<ui::Panel>("panel_" + std::to_string(i),
+                                                     glm::vec2(0.0f), glm::vec2(10.0f)));
+    }
+    
+    ui::TweenSystem tweens(ui::getUIRegistry());
+    tweens.reserve(tweenCount);
+    
+    const size_t easingCount = static_cast<size_t>(ui::Easing::COUNT);
+    
+    double startMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < componentCount; i++) {
+            ui::UIHandle handle = panels[i]->getHandle();
+            ui::Easing easing = static_cast<ui::Easing>(i % easingCount);
+            // Long enough that every tween stays active for the whole run
+            float duration = 4.0f + static_cast<float>(i % 7);
+            
+            tweens.animate(handle, ui::TweenProperty::POSITION,
+                           glm::vec4(static_cast<float>(i % 800), static_cast<float>(i % 600), 0.0f, 0.0f),
+                           duration, easing);
+            tweens.animate(handle, ui::TweenProperty::BACKGROUND_COLOR,
+                           glm::vec4(1.0f, 0.5f, 0.25f, 1.0f), duration, easing);
+        }
+        tweens.update(0.0f);
+    });
+    benchmark::report("start 100k tweens", startMs, tweenCount);
+    std::cout << "  active: " << tweens.getActiveCount() << std::endl;
+    
+    double frameMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            tweens.update(deltaTime);
+        }
+    });
+    benchmark::report("update 100k tweens (per frame)", frameMs / frames, tweenCount);
+    benchmark::doNotOptimize(panels[componentCount / 2]->getPosition());
+    
+    // Retargeting every track exercises replacement and slot recycling
+    double retargetMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < componentCount; i++) {
+            tweens.animate(panels[i]->getHandle(), ui::TweenProperty::POSITION,
+                           glm::vec4(0.0f), 1.0f, ui::Easing::LINEAR);
+        }
+        tweens.update(deltaTime);
+    });
+    benchmark::report("retarget 50k tweens", retargetMs, componentCount);
+    
+    double drainMs = benchmark::measureMilliseconds([&]() {
+        tweens.update(100.0f);
+    });
+    benchmark::report("finish and recycle all tweens", drainMs, tweenCount);
+    std::cout << "  active after drain: " << tweens.getActiveCount() << std::endl;
+    
+    return 0;
+}
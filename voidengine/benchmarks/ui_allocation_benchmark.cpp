@@ -0,0 +1,127 @@
+#include "Benchmark.h"
+#include "core/AllocationTracker.h"
+#include "core/FrameArena.h"
+#include "core/JobSystem.h"
+#include "core/PoolAllocator.h"
+#include "ui/Button.h"
+#include "ui/Layout.h"
+#include "ui/Panel.h"
+#include "ui/Tween.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace voidengine;
+
+namespace {
+
+uint64_t allocationsSince(const core::AllocationCounters& before) {
+    return core::getAllocationCounters().allocations - before.allocations;
+}
+
+} // namespace
+
+int main() {
+    const size_t componentCount = 20000;
+    const int frames = 200;
+    const float deltaTime = 1.0f / 60.0f;
+    
+    ui::getUIRegistry().reserve(componentCount * 3 + 16);
+    
+    std::vector<std::string> ids;
+    ids.reserve(componentCount);
+    for (size_t i = 0; i < componentCount; i++) {
+        ids.push_back("button_" + std::to_string(i));
+    }
+    
+    // Buttons also create their label, so each one is two components
+    std::vector<std::shared_ptr<ui::Button>> buttons;
+    buttons.reserve(componentCount);
+    double heapMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < componentCount; i++) {
+            buttons.push_back(std::make_shared<ui::Button>(ids[i], glm::vec2(0.0f), glm::vec2(80.0f, 24.0f), "Label"));
+        }
+    });
+    benchmark::report("create 20k buttons (make_shared)", heapMs, componentCount);
+    buttons.clear();
+    
+    double poolMs = benchmark::measureMilliseconds([&]() {
+        for (size_t i = 0; i < componentCount; i++) {
+            buttons.push_back(core::makePooled<ui::Button>(ids[i], glm::vec2(0.0f), glm::vec2(80.0f, 24.0f), "Label"));
+        }
+    });
+    benchmark::report("create 20k buttons (pooled)", poolMs, componentCount);
+    
+    // Steady-state frames: layout, parallel update and hover-driven tweens
+    core::initializeJobSystem();
+    auto root = core::makePooled<ui::Panel>("root", glm::vec2(0.0f), glm::vec2(1920.0f, 1080.0f));
+    std::vector<std::shared_ptr<ui::Panel>> rows;
+    for (size_t r = 0; r < 100; r++) {
+        auto row = core::makePooled<ui::Panel>("row_" + std::to_string(r), glm::vec2(0.0f), glm::vec2(1920.0f, 24.0f));
+        row->reserveChildren(componentCount / 100);
+        for (size_t i = r; i < componentCount; i += 100) {
+            row->addComponent(buttons[i]);
+        }
+        root->addComponent(row);
+        rows.push_back(row);
+    }
+    
+    core::FrameArena arena;
+    ui::TweenSystem& tweens = ui::getTweenSystem();
+    tweens.reserve(componentCount);
+    
+    auto runFrame = [&](int frame) {
+        // Hover a band of buttons each frame so state changes start tweens
+        for (size_t i = 0; i < 200; i++) {
+            ui::UIEvent event;
+            event.type = (frame % 2 == 0) ? ui::UIEventType::MOUSE_ENTER : ui::UIEventType::MOUSE_LEAVE;
+            buttons[(static_cast<size_t>(frame) * 97 + i) % componentCount]->onEvent(event);
+        }
+        
+        tweens.update(deltaTime);
+        ui::updateLayout(*root);
+        core::gJobSystem->parallelFor(rows.size(), 4, [&](size_t index) {
+            rows[index]->update(deltaTime);
+        });
+        
+        for (int i = 0; i < 64; i++) {
+            benchmark::doNotOptimize(arena.format("fps %d item %d", frame, i));
+        }
+        arena.reset();
+    };
+    
+    // A warm-up pass over the same frames grows the job queues, tween storage
+    // and the arena to their peak
+    for (int frame = 0; frame < frames; frame++) {
+        runFrame(frame);
+    }
+    
+    core::AllocationCounters before = core::getAllocationCounters();
+    double frameMs = benchmark::measureMilliseconds([&]() {
+        for (int frame = 0; frame < frames; frame++) {
+            runFrame(frame);
+        }
+    });
+    uint64_t frameAllocations = allocationsSince(before);
+    benchmark::report("steady-state UI frame (per frame)", frameMs / frames, componentCount * 2);
+    
+    if (core::isAllocationTrackingEnabled()) {
+        std::cout << "  heap allocations per frame: "
+                  << static_cast<double>(frameAllocations) / frames << std::endl;
+    } else {
+        std::cout << "  heap allocations: not counted (configure with -DVOIDENGINE_TRACK_ALLOCATIONS=ON)" << std::endl;
+    }
+    
+    for (const core::PoolStats& stats : core::getPoolStats()) {
+        std::cout << "  pool " << stats.slotSize << " B: " << stats.slotsInUse << "/" << stats.capacity
+                  << " slots in " << stats.blocks << " blocks" << std::endl;
+    }
+    
+    rows.clear();
+    root.reset();
+    buttons.clear();
+    core::shutdownJobSystem();
+    
+    return 0;
+}
@@ -3,8 +3,10 @@
 #include "ui/Panel.h"
 #include "ui/Button.h"
 #include "ui/Text.h"
+#include "ui/StyleSheet.h"
 #include <iostream>
 #include <functional>
+#include <memory>
 
 int main() {
     try {
@@ -12,59 +14,55 @@ int main() {
         
         auto uiManager = window.getUIManager();
         
-        auto panel = uiManager->createPanel("mainPanel", 
-                                           glm::vec2(50, 50), 
-                                           glm::vec2(300, 400),
-                                           glm::vec4(0.2f, 0.2f, 0.3f, 0.8f));
+        // The layout lives in main_screen.json; only behaviour is wired up here
+        uiManager->loadScreen(UI_DEMO_SCREEN);
         
-        auto titleText = uiManager->createText("titleText", 
-                                              glm::vec2(200, 70), 
-                                              "UI Demo",
-                                              24.0f,
-                                              glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-        titleText->setAlignment(voidengine::ui::TextAlignment::CENTER);
+        auto button1 = std::dynamic_pointer_cast<voidengine::ui::Button>(uiManager->getComponent("button1"));
+        button1->setOnClick([]() {
+            std::cout << "Button 1 clicked!" << std::endl;
+        });
         
-        auto button1 = uiManager->createButton("button1", 
-                                              glm::vec2(100, 150), 
-                                              glm::vec2(200, 40),
-                                              "Click Me",
-                                              []() {
-                                                  std::cout << "Button 1 clicked!" << std::endl;
-                                              });
+        auto button3 = std::dynamic_pointer_cast<voidengine::ui::Button>(uiManager->getComponent("button3"));
+        button3->setOnClick([&window]() {
+            glfwSetWindowShouldClose(window.getNativeWindow(), GLFW_TRUE);
+        });
         
-        auto button2 = uiManager->createButton("button2", 
-                                              glm::vec2(100, 200), 
-                                              glm::vec2(200, 40),
-                                              "Disabled Button");
-        button2->setEnabled(false);
+        auto notes = uiManager->createTextField("notes", glm::vec2(540.0f, 420.0f), glm::vec2(240.0f, 160.0f), true);
+        notes->setText("Click to edit.\nCtrl+Z undoes.");
         
-        auto button3 = uiManager->createButton("button3", 
-                                              glm::vec2(100, 250), 
-                                              glm::vec2(200, 40),
-                                              "Exit",
-                                              [&window]() {
-                                                  glfwSetWindowShouldClose(window.getNativeWindow(), GLFW_TRUE);
-                                              });
-        
-        auto infoText = uiManager->createText("infoText", 
-                                             glm::vec2(200, 350), 
-                                             "Move your mouse over buttons\n"
-                                             "to see hover effects.\n"
-                                             "Click buttons to trigger actions.",
-                                             12.0f,
-                                             glm::vec4(0.8f, 0.8f, 1.0f, 1.0f));
-        infoText->setAlignment(voidengine::ui::TextAlignment::CENTER);
+        uiManager->initialize();
         
-        panel->addComponent(titleText);
-        panel->addComponent(button1);
-        panel->addComponent(button2);
-        panel->addComponent(button3);
-        panel->addComponent(infoText);
+        // Switching themes swaps one pointer; widgets re-resolve on the next update
+        auto darkTheme = voidengine::ui::getStyleSystem().getStyleSheet();
+        auto lightTheme = voidengine::ui::StyleSheet::parse(
+            "Panel { background: 0.85 0.85 0.88 0.9; border: 0.4 0.4 0.45; text: 0.1 0.1 0.1; }\n"
+            "Button { background: 0.2 0.5 0.3; hover-background: 0.3 0.6 0.4; pressed-background: 0.1 0.4 0.2; }\n"
+            "Text { text: 0.1 0.1 0.1; }\n"
+            "TextField { background: 1 1 1 0.95; border: 0.4 0.4 0.45; text: 0.1 0.1 0.1; }\n");
         
-        uiManager->initialize();
+        voidengine::ui::ImmediateUI& debugUI = uiManager->getImmediateUI();
+        bool showPanel = true;
+        bool lightMode = false;
+        int frameCount = 0;
         
         while (!window.shouldClose()) {
             window.clear(0.1f, 0.1f, 0.2f, 1.0f);
+            
+            if (debugUI.beginWindow("Debug", glm::vec2(540.0f, 20.0f))) {
+                const voidengine::ui::UIFrameStats& stats = uiManager->getFrameStats();
+                debugUI.text("frame %d", frameCount);
+                debugUI.text("pointer %u raw / %u coalesced", stats.rawPointerEvents, stats.coalescedPointerEvents);
+                debugUI.text("layers rebuilt %u, %u batches", stats.layerRebuilds, stats.drawBatches);
+                if (debugUI.checkbox("Show main panel", showPanel)) {
+                    uiManager->getComponent("mainPanel")->setVisible(showPanel);
+                }
+                if (debugUI.checkbox("Light theme", lightMode)) {
+                    voidengine::ui::getStyleSystem().setStyleSheet(lightMode ? lightTheme : darkTheme);
+                }
+                debugUI.endWindow();
+            }
+            frameCount++;
+            
             window.swapBuffers();
             window.pollEvents();
         }
@@ -0,0 +1,58 @@
+#include "AllocationTracker.h"
+
+#ifdef VOIDENGINE_TRACK_ALLOCATIONS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> gAllocationCount{0};
+std::atomic<uint64_t> gAllocatedBytes{0};
+
+} // namespace
+
+// The array, nothrow and aligned forms are not replaced: the standard library
+// routes the first two through this one, and aligned allocations are rare
+// enough to leave out
+void* operator new(size_t size) {
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    gAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+}
+#endif
+
+namespace voidengine {
+namespace core {
+
+bool isAllocationTrackingEnabled() {
+#ifdef VOIDENGINE_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocationCounters getAllocationCounters() {
+    AllocationCounters counters;
+#ifdef VOIDENGINE_TRACK_ALLOCATIONS
+    counters.allocations = gAllocationCount.load(std::memory_order_relaxed);
+    counters.bytes = gAllocatedBytes.load(std::memory_order_relaxed);
+#endif
+    return counters;
+}
+
+} // namespace core
+} // namespace voidengine
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+namespace voidengine {
+namespace core {
+
+struct AllocationCounters {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+// Process-wide totals of global operator new calls. Counting replaces the
+// global operator new and is compiled in only with the
+// VOIDENGINE_TRACK_ALLOCATIONS CMake option; otherwise the counters stay zero.
+bool isAllocationTrackingEnabled();
+AllocationCounters getAllocationCounters();
+
+} // namespace core
+} // namespace voidengine
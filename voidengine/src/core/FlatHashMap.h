@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace voidengine {
+namespace core {
+
+template <typename Key>
+struct FlatHash {
+    size_t operator()(const Key& key) const { return std::hash<Key>()(key); }
+};
+
+// Keys that are already hashes (string ids, handles) only need their bits
+// spread across the table, not a full hash
+template <>
+struct FlatHash<uint32_t> {
+    size_t operator()(uint32_t key) const {
+        uint32_t mixed = key * 0x9E3779B1u;
+        return static_cast<size_t>(mixed ^ (mixed >> 16));
+    }
+};
+
+template <>
+struct FlatHash<uint64_t> {
+    size_t operator()(uint64_t key) const {
+        uint64_t mixed = key * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(mixed ^ (mixed >> 32));
+    }
+};
+
+// Open-addressing hash map with linear probing and backward-shift deletion.
+// Entries live in one contiguous array, so lookups touch a handful of adjacent
+// cache lines instead of chasing bucket nodes. Pointers returned by find() and
+// insert() are invalidated by any insertion or erase.
+template <typename Key, typename Value, typename Hash = FlatHash<Key>>
+class FlatHashMap {
+public:
+    struct Entry {
+        Key key = Key();
+        Value value = Value();
+    };
+    
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return entries_.size(); }
+    
+    void clear() {
+        for (size_t i = 0; i < entries_.size(); i++) {
+            if (occupied_[i]) {
+                entries_[i] = Entry();
+                occupied_[i] = 0;
+            }
+        }
+        size_ = 0;
+    }
+    
+    void reserve(size_t count) {
+        size_t needed = 8;
+        while (needed * 3 < count * 4) {
+            needed *= 2;
+        }
+        if (needed > entries_.size()) {
+            rehash(needed);
+        }
+    }
+    
+    Value* find(const Key& key) {
+        size_t index = findIndex(key);
+        return index == NOT_FOUND ? nullptr : &entries_[index].value;
+    }
+    
+    const Value* find(const Key& key) const {
+        size_t index = findIndex(key);
+        return index == NOT_FOUND ? nullptr : &entries_[index].value;
+    }
+    
+    bool contains(const Key& key) const { return findIndex(key) != NOT_FOUND; }
+    
+    std::pair<Value*, bool> insert(const Key& key, Value value) {
+        if ((size_ + 1) * 4 > entries_.size() * 3) {
+            rehash(entries_.empty() ? 8 : entries_.size() * 2);
+        }
+        
+        size_t mask = entries_.size() - 1;
+        size_t index = Hash()(key) & mask;
+        while (occupied_[index]) {
+            if (entries_[index].key == key) {
+                return std::make_pair(&entries_[index].value, false);
+            }
+            index = (index + 1) & mask;
+        }
+        
+        entries_[index].key = key;
+        entries_[index].value = std::move(value);
+        occupied_[index] = 1;
+        size_++;
+        return std::make_pair(&entries_[index].value, true);
+    }
+    
+    Value& operator[](const Key& key) {
+        if (Value* value = find(key)) {
+            return *value;
+        }
+        return *insert(key, Value()).first;
+    }
+    
+    bool erase(const Key& key) {
+        size_t hole = findIndex(key);
+        if (hole == NOT_FOUND) {
+            return false;
+        }
+        
+        // Shift later members of the probe chain back so lookups never need
+        // tombstones to keep walking past the removed slot
+        size_t mask = entries_.size() - 1;
+        size_t next = hole;
+        while (true) {
+            next = (next + 1) & mask;
+            if (!occupied_[next]) {
+                break;
+            }
+            
+            size_t ideal = Hash()(entries_[next].key) & mask;
+            bool reachable = (next > hole) ? (ideal <= hole || ideal > next)
+                                           : (ideal <= hole && ideal > next);
+            if (reachable) {
+                entries_[hole] = std::move(entries_[next]);
+                hole = next;
+            }
+        }
+        
+        entries_[hole] = Entry();
+        occupied_[hole] = 0;
+        size_--;
+        return true;
+    }
+    
+    template <typename Fn>
+    void forEach(Fn&& fn) {
+        for (size_t i = 0; i < entries_.size(); i++) {
+            if (occupied_[i]) {
+                fn(entries_[i].key, entries_[i].value);
+            }
+        }
+    }
+    
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t i = 0; i < entries_.size(); i++) {
+            if (occupied_[i]) {
+                fn(entries_[i].key, entries_[i].value);
+            }
+        }
+    }
+    
+private:
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+    
+    size_t findIndex(const Key& key) const {
+        if (size_ == 0) {
+            return NOT_FOUND;
+        }
+        
+        size_t mask = entries_.size() - 1;
+        size_t index = Hash()(key) & mask;
+        while (occupied_[index]) {
+            if (entries_[index].key == key) {
+                return index;
+            }
+            index = (index + 1) & mask;
+        }
+        return NOT_FOUND;
+    }
+    
+    void rehash(size_t newCapacity) {
+        std::vector<Entry> oldEntries;
+        std::vector<uint8_t> oldOccupied;
+        oldEntries.swap(entries_);
+        oldOccupied.swap(occupied_);
+        
+        entries_.resize(newCapacity);
+        occupied_.assign(newCapacity, 0);
+        size_ = 0;
+        
+        for (size_t i = 0; i < oldEntries.size(); i++) {
+            if (oldOccupied[i]) {
+                insert(oldEntries[i].key, std::move(oldEntries[i].value));
+            }
+        }
+    }
+    
+    std::vector<Entry> entries_;
+    std::vector<uint8_t> occupied_;
+    size_t size_ = 0;
+};
+
+} // namespace core
+} // namespace voidengine
@@ -0,0 +1,90 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace voidengine {
+namespace core {
+
+FrameArena::FrameArena(size_t initialCapacity) {
+    blocks_.reserve(8);
+    addBlock(std::max<size_t>(initialCapacity, 64));
+}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment) {
+    Block* block = &blocks_.back();
+    uintptr_t base = reinterpret_cast<uintptr_t>(block->data.get());
+    size_t offset = ((base + block->offset + alignment - 1) & ~(alignment - 1)) - base;
+    
+    if (offset + bytes > block->size) {
+        addBlock(std::max(block->size * 2, bytes + alignment));
+        block = &blocks_.back();
+        base = reinterpret_cast<uintptr_t>(block->data.get());
+        offset = ((base + alignment - 1) & ~(alignment - 1)) - base;
+    }
+    
+    used_ += offset + bytes - block->offset;
+    block->offset = offset + bytes;
+    return block->data.get() + offset;
+}
+
+std::string_view FrameArena::copy(std::string_view text) {
+    if (text.empty()) {
+        return std::string_view();
+    }
+    
+    char* destination = allocateArray<char>(text.size());
+    std::memcpy(destination, text.data(), text.size());
+    return std::string_view(destination, text.size());
+}
+
+std::string_view FrameArena::format(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    std::string_view result = formatV(format, args);
+    va_end(args);
+    return result;
+}
+
+std::string_view FrameArena::formatV(const char* format, va_list args) {
+    va_list measureArgs;
+    va_copy(measureArgs, args);
+    int length = std::vsnprintf(nullptr, 0, format, measureArgs);
+    va_end(measureArgs);
+    
+    if (length <= 0) {
+        return std::string_view();
+    }
+    
+    // Room for the terminator vsnprintf insists on writing
+    char* destination = allocateArray<char>(static_cast<size_t>(length) + 1);
+    std::vsnprintf(destination, static_cast<size_t>(length) + 1, format, args);
+    return std::string_view(destination, static_cast<size_t>(length));
+}
+
+void FrameArena::reset() {
+    peak_ = std::max(peak_, used_);
+    used_ = 0;
+    
+    if (blocks_.size() > 1) {
+        size_t capacity = getCapacity();
+        blocks_.clear();
+        addBlock(capacity);
+    }
+    blocks_.back().offset = 0;
+}
+
+size_t FrameArena::getCapacity() const {
+    size_t capacity = 0;
+    for (const Block& block : blocks_) {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+void FrameArena::addBlock(size_t size) {
+    blocks_.push_back(Block{std::unique_ptr<uint8_t[]>(new uint8_t[size]), size, 0});
+}
+
+} // namespace core
+} // namespace voidengine
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace voidengine {
+namespace core {
+
+// Bump allocator for data that only lives until the end of a frame: formatted
+// strings, scratch arrays and the like. Nothing is freed individually; reset()
+// drops everything at once. Pointers stay valid until that reset, even when
+// the arena grows. A frame that overflows the first block gets its blocks
+// merged into one at the next reset, so after the first few frames the
+// arena stops touching the heap. Not thread-safe.
+class FrameArena {
+public:
+    explicit FrameArena(size_t initialCapacity = 16 * 1024);
+    
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+    
+    // Uninitialized storage; only for types that need no destructor
+    template <typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+    
+    std::string_view copy(std::string_view text);
+    std::string_view format(const char* format, ...);
+    std::string_view formatV(const char* format, va_list args);
+    
+    void reset();
+    
+    size_t getUsed() const { return used_; }
+    size_t getCapacity() const;
+    // Largest number of bytes used by a single frame so far
+    size_t getPeakUsage() const { return peak_; }
+    
+private:
+    struct Block {
+        std::unique_ptr<uint8_t[]> data;
+        size_t size;
+        size_t offset;
+    };
+    
+    void addBlock(size_t size);
+    
+    std::vector<Block> blocks_;
+    size_t used_ = 0;
+    size_t peak_ = 0;
+};
+
+} // namespace core
+} // namespace voidengine
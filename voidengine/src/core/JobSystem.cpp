@@ -0,0 +1,174 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+namespace voidengine {
+namespace core {
+
+std::unique_ptr<JobSystem> gJobSystem = nullptr;
+
+namespace {
+thread_local size_t tThreadIndex = 0;
+
+// Power of two, so ring indices wrap with a mask
+constexpr size_t INITIAL_QUEUE_CAPACITY = 64;
+}
+
+void initializeJobSystem(size_t workerCount) {
+    if (!gJobSystem) {
+        gJobSystem = std::make_unique<JobSystem>(workerCount);
+    }
+}
+
+void shutdownJobSystem() {
+    gJobSystem.reset();
+}
+
+JobSystem::JobSystem(size_t workerCount) {
+    if (workerCount == AUTO_WORKERS) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+    
+    for (size_t i = 0; i < workerCount + 1; i++) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+        queues_.back()->ring.resize(INITIAL_QUEUE_CAPACITY);
+    }
+    
+    for (size_t i = 0; i < workerCount; i++) {
+        workers_.emplace_back(&JobSystem::workerLoop, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        running_ = false;
+    }
+    wakeCondition_.notify_all();
+    
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+size_t JobSystem::getThreadIndex() {
+    return tThreadIndex;
+}
+
+void JobSystem::submit(JobFunction function, void* context, size_t begin, size_t end, JobCounter& counter) {
+    Job job;
+    job.function = function;
+    job.context = context;
+    job.begin = begin;
+    job.end = end;
+    job.counter = &counter;
+    
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+    queuedJobs_.fetch_add(1, std::memory_order_release);
+    
+    size_t threadIndex = std::min(tThreadIndex, queues_.size() - 1);
+    {
+        std::lock_guard<std::mutex> lock(queues_[threadIndex]->mutex);
+        queues_[threadIndex]->pushBack(job);
+    }
+    
+    if (!workers_.empty()) {
+        // Taking the sleep lock orders this wake after any in-flight predicate check
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    wakeCondition_.notify_one();
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    size_t threadIndex = std::min(tThreadIndex, queues_.size() - 1);
+    
+    while (counter.pending.load(std::memory_order_acquire) > 0) {
+        if (!runOne(threadIndex)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::workerLoop(size_t index) {
+    tThreadIndex = index;
+    
+    while (running_.load(std::memory_order_acquire)) {
+        if (runOne(index)) {
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wakeCondition_.wait(lock, [this]() {
+            return !running_.load(std::memory_order_acquire) ||
+                   queuedJobs_.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+bool JobSystem::runOne(size_t threadIndex) {
+    Job job;
+    if (!popLocal(threadIndex, job) && !steal(threadIndex, job)) {
+        return false;
+    }
+    
+    queuedJobs_.fetch_sub(1, std::memory_order_acq_rel);
+    job.function(job.context, job.begin, job.end);
+    job.counter->pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+bool JobSystem::popLocal(size_t threadIndex, Job& job) {
+    WorkQueue& queue = *queues_[threadIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.count == 0) {
+        return false;
+    }
+    
+    // Newest first keeps the owner working on data that is still hot in cache
+    job = queue.popBack();
+    return true;
+}
+
+void JobSystem::WorkQueue::pushBack(const Job& job) {
+    if (count == ring.size()) {
+        // Unroll into a ring twice the size so the indices stay contiguous
+        std::vector<Job> grown(ring.size() * 2);
+        for (size_t i = 0; i < count; i++) {
+            grown[i] = ring[(head + i) & (ring.size() - 1)];
+        }
+        ring.swap(grown);
+        head = 0;
+    }
+    
+    ring[(head + count) & (ring.size() - 1)] = job;
+    count++;
+}
+
+JobSystem::Job JobSystem::WorkQueue::popBack() {
+    count--;
+    return ring[(head + count) & (ring.size() - 1)];
+}
+
+JobSystem::Job JobSystem::WorkQueue::popFront() {
+    Job job = ring[head];
+    head = (head + 1) & (ring.size() - 1);
+    count--;
+    return job;
+}
+
+bool JobSystem::steal(size_t threadIndex, Job& job) {
+    size_t queueCount = queues_.size();
+    for (size_t offset = 1; offset < queueCount; offset++) {
+        WorkQueue& victim = *queues_[(threadIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.count > 0) {
+            // Oldest first steals the largest remaining chunks of a split
+            job = victim.popFront();
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace core
+} // namespace voidengine
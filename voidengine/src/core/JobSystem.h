@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace voidengine {
+namespace core {
+
+struct JobCounter {
+    std::atomic<size_t> pending{0};
+};
+
+// Work-stealing job system. Every participating thread owns a queue: it pushes
+// and pops its own work at the back and steals from the front of the others.
+// The thread that constructs the system is participant 0 and runs jobs
+// itself while it waits, so a system with zero workers degrades to running
+// everything inline on the caller.
+class JobSystem {
+public:
+    using JobFunction = void (*)(void* context, size_t begin, size_t end);
+    
+    // Picks hardware_concurrency() - 1 workers
+    static constexpr size_t AUTO_WORKERS = static_cast<size_t>(-1);
+    
+    explicit JobSystem(size_t workerCount = AUTO_WORKERS);
+    ~JobSystem();
+    
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    
+    size_t getWorkerCount() const { return workers_.size(); }
+    size_t getThreadCount() const { return queues_.size(); }
+    
+    // Index of the calling thread within this system; 0 for the main thread
+    static size_t getThreadIndex();
+    
+    void submit(JobFunction function, void* context, size_t begin, size_t end, JobCounter& counter);
+    
+    // Runs queued jobs on the calling thread until the counter drains
+    void wait(JobCounter& counter);
+    
+    // Splits [0, count) into chunks of at most grainSize and runs fn(index) for
+    // every index. Returns once all indices are done; fn may run on any thread.
+    template <typename Fn>
+    void parallelFor(size_t count, size_t grainSize, Fn&& fn) {
+        if (count == 0) {
+            return;
+        }
+        if (grainSize == 0) {
+            grainSize = 1;
+        }
+        
+        using FnType = typename std::remove_reference<Fn>::type;
+        JobFunction function = [](void* context, size_t begin, size_t end) {
+            FnType& body = *static_cast<FnType*>(context);
+            for (size_t i = begin; i < end; i++) {
+                body(i);
+            }
+        };
+        
+        JobCounter counter;
+        for (size_t begin = 0; begin < count; begin += grainSize) {
+            size_t end = begin + grainSize < count ? begin + grainSize : count;
+            submit(function, const_cast<void*>(static_cast<const void*>(&fn)), begin, end, counter);
+        }
+        wait(counter);
+    }
+    
+private:
+    struct Job {
+        JobFunction function = nullptr;
+        void* context = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+        JobCounter* counter = nullptr;
+    };
+    
+    // Ring buffer rather than std::deque, which allocates and frees blocks as
+    // jobs flow through it; the ring keeps its capacity from frame to frame
+    struct WorkQueue {
+        std::mutex mutex;
+        std::vector<Job> ring;
+        size_t head = 0;
+        size_t count = 0;
+        
+        void pushBack(const Job& job);
+        Job popBack();
+        Job popFront();
+    };
+    
+    void workerLoop(size_t index);
+    bool runOne(size_t threadIndex);
+    bool popLocal(size_t threadIndex, Job& job);
+    bool steal(size_t threadIndex, Job& job);
+    
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+    
+    std::mutex sleepMutex_;
+    std::condition_variable wakeCondition_;
+    std::atomic<size_t> queuedJobs_{0};
+    std::atomic<bool> running_{true};
+};
+
+extern std::unique_ptr<JobSystem> gJobSystem;
+
+void initializeJobSystem(size_t workerCount = JobSystem::AUTO_WORKERS);
+
+void shutdownJobSystem();
+
+} // namespace core
+} // namespace voidengine
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace voidengine {
+namespace core {
+
+// Read-only view of a whole file mapped into memory. Pages are loaded by the
+// OS on first touch, so opening is cheap regardless of file size.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    
+    // Throws std::runtime_error when the file cannot be opened or mapped. Other
+    // handles may keep writing to the file; the mapping covers what it held
+    // when opened.
+    void open(const std::string& path);
+    void close();
+    
+    bool isOpen() const { return data_ != nullptr; }
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    
+#ifdef _WIN32
+    void* fileHandle_ = nullptr;
+    void* mappingHandle_ = nullptr;
+#endif
+};
+
+} // namespace core
+} // namespace voidengine
@@ -0,0 +1,113 @@
+#include "PoolAllocator.h"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace voidengine {
+namespace core {
+
+namespace {
+
+std::mutex& registryMutex() {
+    static std::mutex* mutex = new std::mutex();
+    return *mutex;
+}
+
+std::vector<FixedPool*>& registeredPools() {
+    static std::vector<FixedPool*>* pools = new std::vector<FixedPool*>();
+    return *pools;
+}
+
+} // namespace
+
+FixedPool::FixedPool(size_t slotSize, size_t alignment, size_t firstBlockSlots)
+    : slotSize_(std::max(slotSize, sizeof(FreeSlot))),
+      alignment_(std::max(alignment, alignof(FreeSlot))),
+      nextBlockSlots_(std::max<size_t>(firstBlockSlots, 1)) {
+    // Keep every slot in a block aligned, not just the first
+    slotSize_ = (slotSize_ + alignment_ - 1) / alignment_ * alignment_;
+    
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registeredPools().push_back(this);
+}
+
+FixedPool::~FixedPool() {
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        auto& pools = registeredPools();
+        pools.erase(std::remove(pools.begin(), pools.end(), this), pools.end());
+    }
+    
+    for (void* block : blocks_) {
+        ::operator delete(block, std::align_val_t(alignment_));
+    }
+}
+
+void* FixedPool::allocate() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!freeList_) {
+        grow(nextBlockSlots_);
+    }
+    
+    FreeSlot* slot = freeList_;
+    freeList_ = slot->next;
+    slotsInUse_++;
+    return slot;
+}
+
+void FixedPool::deallocate(void* slot) {
+    if (!slot) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    FreeSlot* freed = static_cast<FreeSlot*>(slot);
+    freed->next = freeList_;
+    freeList_ = freed;
+    slotsInUse_--;
+}
+
+void FixedPool::reserve(size_t slots) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (slots > capacity_) {
+        grow(slots - capacity_);
+    }
+}
+
+PoolStats FixedPool::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    PoolStats stats;
+    stats.slotSize = slotSize_;
+    stats.slotsInUse = slotsInUse_;
+    stats.capacity = capacity_;
+    stats.blocks = blocks_.size();
+    return stats;
+}
+
+void FixedPool::grow(size_t slots) {
+    uint8_t* block = static_cast<uint8_t*>(::operator new(slots * slotSize_, std::align_val_t(alignment_)));
+    blocks_.push_back(block);
+    
+    // Thread the new slots onto the free list in address order
+    for (size_t i = slots; i > 0; i--) {
+        FreeSlot* slot = reinterpret_cast<FreeSlot*>(block + (i - 1) * slotSize_);
+        slot->next = freeList_;
+        freeList_ = slot;
+    }
+    
+    capacity_ += slots;
+    nextBlockSlots_ = std::max(nextBlockSlots_, slots) * 2;
+}
+
+std::vector<PoolStats> getPoolStats() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    std::vector<PoolStats> stats;
+    stats.reserve(registeredPools().size());
+    for (FixedPool* pool : registeredPools()) {
+        stats.push_back(pool->getStats());
+    }
+    return stats;
+}
+
+} // namespace core
+} // namespace voidengine
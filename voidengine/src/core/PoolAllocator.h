@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace voidengine {
+namespace core {
+
+struct PoolStats {
+    size_t slotSize = 0;
+    size_t slotsInUse = 0;
+    size_t capacity = 0;
+    size_t blocks = 0;
+};
+
+// Allocator for objects of one size. Slots are carved out of blocks that
+// double in size and are kept for the life of the pool; freed slots go onto
+// an intrusive free list, so once the pool has grown to its peak, allocating
+// and freeing never reach the heap. Safe to use from any thread.
+class FixedPool {
+public:
+    FixedPool(size_t slotSize, size_t alignment, size_t firstBlockSlots = 64);
+    ~FixedPool();
+    
+    FixedPool(const FixedPool&) = delete;
+    FixedPool& operator=(const FixedPool&) = delete;
+    
+    void* allocate();
+    void deallocate(void* slot);
+    
+    // Makes sure at least this many slots exist in total
+    void reserve(size_t slots);
+    
+    PoolStats getStats() const;
+    
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+    
+    void grow(size_t slots);
+    
+    size_t slotSize_;
+    size_t alignment_;
+    size_t nextBlockSlots_;
+    
+    FreeSlot* freeList_ = nullptr;
+    std::vector<void*> blocks_;
+    size_t slotsInUse_ = 0;
+    size_t capacity_ = 0;
+    
+    mutable std::mutex mutex_;
+};
+
+// Snapshot of every pool created so far, for allocation reports
+std::vector<PoolStats> getPoolStats();
+
+template <size_t Size, size_t Alignment>
+FixedPool& getFixedPool() {
+    // Never destroyed: pooled objects can be released by other statics during
+    // shutdown, after this pool would otherwise be gone
+    static FixedPool* pool = new FixedPool(Size, Alignment);
+    return *pool;
+}
+
+// Standard allocator that serves single objects from the FixedPool matching
+// their size and alignment; types with the same layout share a pool. Arrays
+// fall back to the heap. Meant for allocate_shared, which rebinds it to the
+// combined control block + object, so one pooled slot backs a shared_ptr.
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+    
+    PoolAllocator() = default;
+    
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) {}
+    
+    T* allocate(size_t count) {
+        if (count == 1) {
+            return static_cast<T*>(pool().allocate());
+        }
+        return std::allocator<T>().allocate(count);
+    }
+    
+    void deallocate(T* pointer, size_t count) {
+        if (count == 1) {
+            pool().deallocate(pointer);
+        } else {
+            std::allocator<T>().deallocate(pointer, count);
+        }
+    }
+    
+    template <typename U>
+    bool operator==(const PoolAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>&) const { return false; }
+    
+private:
+    static constexpr size_t SLOT_SIZE = ((sizeof(T) < sizeof(void*) ? sizeof(void*) : sizeof(T)) +
+                                         alignof(T) - 1) / alignof(T) * alignof(T);
+    
+    static FixedPool& pool() { return getFixedPool<SLOT_SIZE, alignof(T)>(); }
+};
+
+// make_shared counterpart that places the object and its control block in a
+// pooled slot
+template <typename T, typename... Args>
+std::shared_ptr<T> makePooled(Args&&... args) {
+    return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+}
+
+} // namespace core
+} // namespace voidengine
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace voidengine {
+namespace core {
+
+// Bounded single-producer, single-consumer ring. One thread may push while
+// another pops, with no locks and no allocation after construction; with more
+// than one of either the behaviour is undefined. Elements are copied in and
+// out, so T should be small and trivially copyable.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "SpscQueue elements must be trivially copyable");
+
+public:
+    static constexpr size_t CAPACITY = Capacity;
+    
+    SpscQueue() = default;
+    
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+    
+    // Producer only. Returns false and leaves the queue untouched when full.
+    bool push(const T& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ == Capacity) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ == Capacity) {
+                return false;
+            }
+        }
+        items_[tail & (Capacity - 1)] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // Consumer only. Returns false when empty.
+    bool pop(T& item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) {
+                return false;
+            }
+        }
+        item = items_[head & (Capacity - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // Consumer only. Drops everything pushed so far.
+    void clear() {
+        tailCache_ = tail_.load(std::memory_order_acquire);
+        head_.store(tailCache_, std::memory_order_release);
+    }
+    
+    // Exact only when called from a side with the other idle
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+
+private:
+    // The indices only grow; each side keeps its own copy of the other's so
+    // that it touches the shared cache line only when the ring looks full or
+    // empty
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t tailCache_ = 0;
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t headCache_ = 0;
+    alignas(64) T items_[Capacity];
+};
+
+} // namespace core
+} // namespace voidengine
@@ -0,0 +1,67 @@
+#include "StringId.h"
+
+namespace voidengine {
+namespace core {
+
+std::unique_ptr<StringInterner> gStringInterner = nullptr;
+
+StringInterner& getStringInterner() {
+    if (!gStringInterner) {
+        gStringInterner = std::make_unique<StringInterner>();
+    }
+    return *gStringInterner;
+}
+
+namespace {
+
+// Next symbol to try for str once id is taken; continuing the hash keeps the
+// sequence the same every time the string is looked up
+StringId probeString(std::string_view str, StringId id) {
+    return hashString(str.data(), str.size(), id ^ 0x9E3779B9u);
+}
+
+} // namespace
+
+StringId StringInterner::intern(std::string_view str) {
+    StringId id = hashString(str);
+    while (true) {
+        const std::string* const* existing = strings_.find(id);
+        if (!existing) {
+            if (id != INVALID_STRING_ID) {
+                break;
+            }
+        } else if (**existing == str) {
+            return id;
+        }
+        id = probeString(str, id);
+    }
+    
+    storage_.emplace_back(str);
+    strings_.insert(id, &storage_.back());
+    return id;
+}
+
+StringId StringInterner::find(std::string_view str) const {
+    StringId id = hashString(str);
+    while (true) {
+        const std::string* const* existing = strings_.find(id);
+        if (!existing) {
+            if (id != INVALID_STRING_ID) {
+                return INVALID_STRING_ID;
+            }
+        } else if (**existing == str) {
+            return id;
+        }
+        id = probeString(str, id);
+    }
+}
+
+const std::string& StringInterner::lookup(StringId id) const {
+    static const std::string empty;
+    
+    const std::string* const* str = strings_.find(id);
+    return str ? **str : empty;
+}
+
+} // namespace core
+} // namespace voidengine
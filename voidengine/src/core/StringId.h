@@ -0,0 +1,85 @@
+#pragma once
+
+#include "FlatHashMap.h"
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace voidengine {
+namespace core {
+
+// A 32-bit symbol for a string. hashString() and "play"_sid give its FNV-1a
+// hash, at compile time for literals, and tables that never intern (style
+// types and classes, atlas regions, locale keys) are keyed by that hash.
+// Component ids are interned instead, and an interned string whose hash is
+// already taken is given another symbol; lookups by component id take the
+// symbol from internString(), findString() or UIComponent::getIdSymbol(),
+// never from hashString() or _sid.
+using StringId = uint32_t;
+
+// Continues the hash from seed; hashing "b" seeded with the id of "a" equals
+// the id of "ab", which lets callers scope names under a parent id
+constexpr StringId hashString(const char* str, size_t length, StringId seed) {
+    uint32_t hash = seed;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<uint8_t>(str[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+constexpr StringId hashString(const char* str, size_t length) {
+    return hashString(str, length, 2166136261u);
+}
+
+constexpr StringId hashString(std::string_view str) {
+    return hashString(str.data(), str.size());
+}
+
+namespace literals {
+    constexpr StringId operator""_sid(const char* str, size_t length) {
+        return hashString(str, length);
+    }
+}
+
+// Never assigned by the interner
+constexpr StringId INVALID_STRING_ID = 0;
+
+// Maps symbols back to the strings that produced them. A string is given its
+// hash unless another string already holds it, in which case the hash is
+// rehashed until a free symbol turns up; the id of such a string differs from
+// its literal "x"_sid form, so look it up with find(). Strings are stored once
+// and never move or get freed, so references returned by lookup() stay valid
+// for the lifetime of the interner; ids generated without bound (per toast,
+// per row) grow it for good. Main thread only.
+class StringInterner {
+public:
+    StringId intern(std::string_view str);
+    // The symbol str was interned under, or INVALID_STRING_ID if it never was
+    StringId find(std::string_view str) const;
+    const std::string& lookup(StringId id) const;
+    bool contains(StringId id) const { return strings_.contains(id); }
+    size_t size() const { return strings_.size(); }
+    
+private:
+    std::deque<std::string> storage_;
+    FlatHashMap<StringId, const std::string*> strings_;
+};
+
+extern std::unique_ptr<StringInterner> gStringInterner;
+
+StringInterner& getStringInterner();
+
+inline StringId internString(std::string_view str) {
+    return getStringInterner().intern(str);
+}
+
+inline StringId findString(std::string_view str) {
+    return getStringInterner().find(str);
+}
+
+} // namespace core
+} // namespace voidengine
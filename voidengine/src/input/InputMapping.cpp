@@ -99,9 +99,9 @@ void InputMapping::update() {
         }
         
         if (state.justActivated || state.justDeactivated) {
-            for (const auto& callbackPair : callbacks_) {
-                if (callbackPair.first == actionName) {
-                    callbackPair.second(actionName, state);
+            for (const auto& entry : callbacks_) {
+                if (entry.actionName == actionName) {
+                    entry.callback(actionName, state);
                 }
             }
         }
@@ -209,14 +209,14 @@ glm::vec2 InputMapping::getActionVector(const std::string& actionName) const {
 
 int InputMapping::addActionCallback(const std::string& actionName, const ActionCallback& callback) {
     int id = nextCallbackId_++;
-    callbacks_.push_back(std::make_pair(actionName, callback));
+    callbacks_.push_back(CallbackEntry{id, actionName, callback});
     return id;
 }
 
 void InputMapping::removeActionCallback(int callbackId) {
-    if (!callbacks_.empty()) {
-        callbacks_.pop_back();
-    }
+    callbacks_.erase(std::remove_if(callbacks_.begin(), callbacks_.end(),
+                                    [callbackId](const CallbackEntry& entry) { return entry.id == callbackId; }),
+                     callbacks_.end());
 }
 
 void InputMapping::onInputEvent(const InputEvent& event) {
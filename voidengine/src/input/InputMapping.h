@@ -100,7 +100,13 @@ private:
     
     std::unordered_map<std::string, ActionState> actionStates_;
     
-    std::vector<std::pair<std::string, ActionCallback>> callbacks_;
+    struct CallbackEntry {
+        int id;
+        std::string actionName;
+        ActionCallback callback;
+    };
+    
+    std::vector<CallbackEntry> callbacks_;
     
     int nextCallbackId_;
     
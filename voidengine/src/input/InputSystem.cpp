@@ -73,12 +73,22 @@ void InputSystem::shutdown() {
         glfwSetJoystickCallback(nullptr);
     }
     
-    keyStates_.clear();
-    mouseButtonStates_.clear();
+    keysDown_.reset();
+    keysDownLastFrame_.reset();
+    mouseButtonsDown_.reset();
+    mouseButtonsDownLastFrame_.reset();
     gamepadButtonStates_.clear();
     gamepadAxisValues_.clear();
+    eventQueue_.clear();
+    for (std::atomic<uint32_t>& word : droppedKeyReleases_) {
+        word.store(0, std::memory_order_relaxed);
+    }
+    droppedButtonReleases_.store(0, std::memory_order_relaxed);
+    motionDropped_.store(false, std::memory_order_relaxed);
     
     callbacks_.clear();
+    rawMotionCallbacks_ = 0;
+    eventFilter_ = nullptr;
     
     window_ = nullptr;
     initialized_ = false;
@@ -87,13 +97,165 @@ void InputSystem::shutdown() {
 }
 
 void InputSystem::update() {
-    if (!initialized_) {
-        return;
+    // Edges are taken against what was down before this update's events
+    keysDownLastFrame_ = keysDown_;
+    mouseButtonsDownLastFrame_ = mouseButtonsDown_;
+    scrollDelta_ = glm::vec2(0.0f);
+    
+    drainEvents();
+    
+    if (initialized_) {
+        pollDevices();
+    }
+}
+
+bool InputSystem::queueEvent(const InputEvent& event) {
+    const bool button = event.type == EventType::KEY || event.type == EventType::MOUSE_BUTTON;
+    // Seen from the producer the size can only be overstated, so the reserve
+    // holds even while update() is draining
+    const bool pushed = (button || eventQueue_.size() < EVENT_QUEUE_CAPACITY - BUTTON_EVENT_RESERVE) &&
+                        eventQueue_.push(event);
+    
+    const int limit = event.type == EventType::KEY ? KEY_COUNT : MOUSE_BUTTON_COUNT;
+    if (button && event.code >= 0 && event.code < limit) {
+        std::atomic<uint32_t>& word = event.type == EventType::KEY ? droppedKeyReleases_[event.code / 32]
+                                                                    : droppedButtonReleases_;
+        const uint32_t bit = 1u << (event.code % 32);
+        const bool down = event.state == ButtonState::PRESSED || event.state == ButtonState::PRESSED_THIS_FRAME ||
+                          event.state == ButtonState::HELD;
+        if (!pushed && !down) {
+            word.fetch_or(bit, std::memory_order_acq_rel);
+        } else if (pushed && (word.load(std::memory_order_relaxed) & bit)) {
+            // Released on a retry or pressed again; the lost release no
+            // longer applies
+            word.fetch_and(~bit, std::memory_order_acq_rel);
+        }
+    }
+    
+    if (!pushed) {
+        if (event.type == EventType::MOUSE_MOVE_RAW) {
+            motionDropped_.store(true, std::memory_order_release);
+        }
+        droppedEvents_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void InputSystem::drainEvents() {
+    // Lost releases are taken before the count so that every press queued
+    // ahead of them is applied first and cannot leave the key down
+    auto take = [](std::atomic<uint32_t>& word) {
+        return word.load(std::memory_order_acquire) ? word.exchange(0, std::memory_order_acq_rel) : 0u;
+    };
+    uint32_t droppedKeys[KEY_WORDS];
+    for (int i = 0; i < KEY_WORDS; i++) {
+        droppedKeys[i] = take(droppedKeyReleases_[i]);
+    }
+    uint32_t droppedButtons = take(droppedButtonReleases_);
+    const bool motionDropped = motionDropped_.load(std::memory_order_acquire) &&
+                               motionDropped_.exchange(false, std::memory_order_acq_rel);
+    
+    // Only what was queued before the drain started, so a listener that
+    // queues more cannot keep it going
+    size_t count = eventQueue_.size();
+    InputEvent event;
+    while (count-- > 0 && eventQueue_.pop(event)) {
+        applyEvent(event);
+    }
+    
+    // Only the state is let go; listeners never see the lost release, and a
+    // producer that retried it still delivers it once
+    for (int i = 0; i < KEY_WORDS; i++) {
+        for (int bit = 0; droppedKeys[i] && bit < 32; bit++) {
+            if (droppedKeys[i] & (1u << bit)) {
+                keysDown_[i * 32 + bit] = false;
+            }
+        }
+    }
+    for (int bit = 0; droppedButtons && bit < MOUSE_BUTTON_COUNT; bit++) {
+        if (droppedButtons & (1u << bit)) {
+            mouseButtonsDown_[bit] = false;
+        }
+    }
+    
+    // A refused sample may have been the last before the cursor stopped
+    if (motionDropped && window_) {
+        double x, y;
+        glfwGetCursorPos(window_, &x, &y);
+        event = InputEvent();
+        event.type = EventType::MOUSE_MOVE_RAW;
+        event.position = glm::vec2(x, y);
+        event.timestamp = glfwGetTime();
+        applyEvent(event);
+    }
+}
+
+void InputSystem::applyEvent(InputEvent event) {
+    if (event.type == EventType::MOUSE_BUTTON) {
+        // Where the cursor was given the moves queued before the click
+        event.position = mousePosition_;
     }
     
+    if (eventFilter_ && eventFilter_(event)) {
+        // A key or button held before the filter took over must not stick
+        const bool release = (event.type == EventType::KEY || event.type == EventType::MOUSE_BUTTON) &&
+                             (event.state == ButtonState::RELEASED || event.state == ButtonState::RELEASED_THIS_FRAME);
+        if (!release) {
+            return;
+        }
+    }
+    
+    switch (event.type) {
+        case EventType::KEY:
+            setButtonDown(keysDown_, event.code, event.state);
+            break;
+        case EventType::MOUSE_BUTTON:
+            setButtonDown(mouseButtonsDown_, event.code, event.state);
+            break;
+        case EventType::MOUSE_MOVE_RAW:
+            event.delta = event.position - mousePosition_;
+            mousePosition_ = event.position;
+            lastMotionTime_ = event.timestamp;
+            pendingRawMotion_++;
+            if (rawMotionCallbacks_ == 0) {
+                return;
+            }
+            break;
+        case EventType::MOUSE_SCROLL:
+            scrollDelta_ += event.delta;
+            break;
+        case EventType::CHAR:
+            appendTextInput(static_cast<unsigned int>(event.code));
+            break;
+        default:
+            break;
+    }
+    
+    processInputEvent(event);
+}
+
+void InputSystem::pollDevices() {
     mouseDelta_ = mousePosition_ - lastMousePosition_;
     lastMousePosition_ = mousePosition_;
     
+    // However many cursor samples arrived, listeners see one move carrying
+    // the whole frame's delta
+    motionStats_.rawEvents = pendingRawMotion_;
+    motionStats_.coalescedEvents = 0;
+    pendingRawMotion_ = 0;
+    if (mouseDelta_ != glm::vec2(0.0f)) {
+        InputEvent event;
+        event.type = EventType::MOUSE_MOVE;
+        event.position = mousePosition_;
+        event.delta = mouseDelta_;
+        event.timestamp = lastMotionTime_;
+        
+        processInputEvent(event);
+        motionStats_.coalescedEvents = 1;
+    }
+    
+    const double pollTime = glfwGetTime();
     for (int jid = GLFW_JOYSTICK_1; jid <= GLFW_JOYSTICK_LAST; jid++) {
         if (glfwJoystickPresent(jid)) {
             int buttonCount;
@@ -122,6 +284,7 @@ void InputSystem::update() {
                         event.code = i;
                         event.state = newState;
                         event.gamepadId = jid;
+                        event.timestamp = pollTime;
                         
                         processInputEvent(event);
                     }
@@ -136,6 +299,7 @@ void InputSystem::update() {
                         event.code = i;
                         event.state = newState;
                         event.gamepadId = jid;
+                        event.timestamp = pollTime;
                         
                         processInputEvent(event);
                     } else {
@@ -172,6 +336,7 @@ void InputSystem::update() {
                     event.code = i;
                     event.position = glm::vec2(value, 0.0f);
                     event.gamepadId = jid;
+                    event.timestamp = pollTime;
                     
                     processInputEvent(event);
                 }
@@ -179,22 +344,6 @@ void InputSystem::update() {
         }
     }
     
-    for (auto& pair : keyStates_) {
-        if (pair.second == ButtonState::PRESSED_THIS_FRAME) {
-            pair.second = ButtonState::HELD;
-        } else if (pair.second == ButtonState::RELEASED_THIS_FRAME) {
-            pair.second = ButtonState::RELEASED;
-        }
-    }
-    
-    for (auto& pair : mouseButtonStates_) {
-        if (pair.second == ButtonState::PRESSED_THIS_FRAME) {
-            pair.second = ButtonState::HELD;
-        } else if (pair.second == ButtonState::RELEASED_THIS_FRAME) {
-            pair.second = ButtonState::RELEASED;
-        }
-    }
-    
     for (auto& gamepadPair : gamepadButtonStates_) {
         for (auto& buttonPair : gamepadPair.second) {
             if (buttonPair.second == ButtonState::PRESSED_THIS_FRAME) {
@@ -204,36 +353,56 @@ void InputSystem::update() {
             }
         }
     }
-    
-    scrollDelta_ = glm::vec2(0.0f);
 }
 
 int InputSystem::addCallback(EventType type, const InputCallback& callback) {
     int id = nextCallbackId_++;
-    callbacks_.push_back(std::make_pair(type, callback));
+    callbacks_.push_back(CallbackEntry{id, type, callback});
+    if (type == EventType::MOUSE_MOVE_RAW) {
+        rawMotionCallbacks_++;
+    }
     return id;
 }
 
 void InputSystem::removeCallback(int callbackId) {
-        if (!callbacks_.empty()) {
-        callbacks_.pop_back();
+    auto found = std::find_if(callbacks_.begin(), callbacks_.end(),
+                              [callbackId](const CallbackEntry& entry) { return entry.id == callbackId; });
+    if (found == callbacks_.end()) {
+        return;
     }
+    if (found->type == EventType::MOUSE_MOVE_RAW) {
+        rawMotionCallbacks_--;
+    }
+    callbacks_.erase(found);
 }
 
-ButtonState InputSystem::getKeyState(int keyCode) const {
-    auto it = keyStates_.find(keyCode);
-    if (it != keyStates_.end()) {
-        return it->second;
+template <size_t N>
+ButtonState InputSystem::getButtonState(const std::bitset<N>& down, const std::bitset<N>& downLastFrame, int code) {
+    if (code < 0 || code >= static_cast<int>(N)) {
+        return ButtonState::RELEASED;
     }
-    return ButtonState::RELEASED;
+    if (down[code]) {
+        return downLastFrame[code] ? ButtonState::HELD : ButtonState::PRESSED_THIS_FRAME;
+    }
+    return downLastFrame[code] ? ButtonState::RELEASED_THIS_FRAME : ButtonState::RELEASED;
 }
 
-ButtonState InputSystem::getMouseButtonState(int button) const {
-    auto it = mouseButtonStates_.find(button);
-    if (it != mouseButtonStates_.end()) {
-        return it->second;
+template <size_t N>
+void InputSystem::setButtonDown(std::bitset<N>& down, int code, ButtonState state) {
+    // GLFW_KEY_UNKNOWN and anything past the last code have no slot
+    if (code < 0 || code >= static_cast<int>(N)) {
+        return;
     }
-    return ButtonState::RELEASED;
+    down[code] = state == ButtonState::PRESSED || state == ButtonState::PRESSED_THIS_FRAME ||
+                 state == ButtonState::HELD;
+}
+
+ButtonState InputSystem::getKeyState(int keyCode) const {
+    return getButtonState(keysDown_, keysDownLastFrame_, keyCode);
+}
+
+ButtonState InputSystem::getMouseButtonState(int button) const {
+    return getButtonState(mouseButtonsDown_, mouseButtonsDownLastFrame_, button);
 }
 
 ButtonState InputSystem::getGamepadButtonState(int gamepadId, int button) const {
@@ -262,6 +431,15 @@ void InputSystem::setMousePosition(const glm::vec2& position) {
     mousePosition_ = position;
 }
 
+void InputSystem::recordMouseMove(const glm::vec2& position) {
+    InputEvent event;
+    event.type = EventType::MOUSE_MOVE_RAW;
+    event.position = position;
+    event.timestamp = glfwGetTime();
+    
+    queueEvent(event);
+}
+
 glm::vec2 InputSystem::getGamepadAxis(int gamepadId, int axisX, int axisY) const {
     glm::vec2 result(0.0f);
     
@@ -294,17 +472,15 @@ float InputSystem::getGamepadTrigger(int gamepadId, int axis) const {
 }
 
 bool InputSystem::isKeyPressed(int keyCode) const {
-    ButtonState state = getKeyState(keyCode);
-    return state == ButtonState::PRESSED || state == ButtonState::PRESSED_THIS_FRAME || state == ButtonState::HELD;
+    return keyCode >= 0 && keyCode < KEY_COUNT && keysDown_[keyCode];
 }
 
 bool InputSystem::isKeyReleased(int keyCode) const {
-    return getKeyState(keyCode) == ButtonState::RELEASED || getKeyState(keyCode) == ButtonState::RELEASED_THIS_FRAME;
+    return !isKeyPressed(keyCode);
 }
 
 bool InputSystem::isMouseButtonPressed(int button) const {
-    ButtonState state = getMouseButtonState(button);
-    return state == ButtonState::PRESSED || state == ButtonState::PRESSED_THIS_FRAME || state == ButtonState::HELD;
+    return button >= 0 && button < MOUSE_BUTTON_COUNT && mouseButtonsDown_[button];
 }
 
 bool InputSystem::wasKeyPressedThisFrame(int keyCode) const {
@@ -332,9 +508,9 @@ int InputSystem::getKeyScancode(int keyCode) {
 }
 
 void InputSystem::processInputEvent(const InputEvent& event) {
-    for (const auto& callbackPair : callbacks_) {
-        if (callbackPair.first == event.type) {
-            callbackPair.second(event);
+    for (const CallbackEntry& entry : callbacks_) {
+        if (entry.type == event.type) {
+            entry.callback(event);
         }
     }
 }
@@ -357,35 +533,25 @@ void InputSystem::keyCallback(GLFWwindow* window, int key, int scancode, int act
             return;
     }
     
-    instance_->keyStates_[key] = newState;
-    
     InputEvent event;
     event.type = EventType::KEY;
     event.code = key;
     event.state = newState;
     event.mods = mods;
+    event.timestamp = glfwGetTime();
     
-    instance_->processInputEvent(event);
+    instance_->queueEvent(event);
 }
 
 void InputSystem::charCallback(GLFWwindow* window, unsigned int codepoint) {
     if (!instance_) return;
     
-    if (codepoint < 0x80) {
-        instance_->textInput_ += static_cast<char>(codepoint);
-    } else if (codepoint < 0x800) {
-        instance_->textInput_ += static_cast<char>(0xC0 | (codepoint >> 6));
-        instance_->textInput_ += static_cast<char>(0x80 | (codepoint & 0x3F));
-    } else if (codepoint < 0x10000) {
-        instance_->textInput_ += static_cast<char>(0xE0 | (codepoint >> 12));
-        instance_->textInput_ += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
-        instance_->textInput_ += static_cast<char>(0x80 | (codepoint & 0x3F));
-    } else {
-        instance_->textInput_ += static_cast<char>(0xF0 | (codepoint >> 18));
-        instance_->textInput_ += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
-        instance_->textInput_ += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
-        instance_->textInput_ += static_cast<char>(0x80 | (codepoint & 0x3F));
-    }
+    InputEvent event;
+    event.type = EventType::CHAR;
+    event.code = static_cast<int>(codepoint);
+    event.timestamp = glfwGetTime();
+    
+    instance_->queueEvent(event);
 }
 
 void InputSystem::mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
@@ -403,44 +569,31 @@ void InputSystem::mouseButtonCallback(GLFWwindow* window, int button, int action
             return;
     }
     
-    instance_->mouseButtonStates_[button] = newState;
-    
     InputEvent event;
     event.type = EventType::MOUSE_BUTTON;
     event.code = button;
     event.state = newState;
-    event.position = instance_->mousePosition_;
     event.mods = mods;
+    event.timestamp = glfwGetTime();
     
-    instance_->processInputEvent(event);
+    instance_->queueEvent(event);
 }
 
 void InputSystem::cursorPosCallback(GLFWwindow* window, double xpos, double ypos) {
     if (!instance_) return;
     
-    glm::vec2 newPos(xpos, ypos);
-    glm::vec2 delta = newPos - instance_->mousePosition_;
-    
-    instance_->mousePosition_ = newPos;
-    
-    InputEvent event;
-    event.type = EventType::MOUSE_MOVE;
-    event.position = instance_->mousePosition_;
-    event.delta = delta;
-    
-    instance_->processInputEvent(event);
+    instance_->recordMouseMove(glm::vec2(xpos, ypos));
 }
 
 void InputSystem::scrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
     if (!instance_) return;
     
-    instance_->scrollDelta_ = glm::vec2(xoffset, yoffset);
-    
     InputEvent event;
     event.type = EventType::MOUSE_SCROLL;
-    event.delta = instance_->scrollDelta_;
+    event.delta = glm::vec2(xoffset, yoffset);
+    event.timestamp = glfwGetTime();
     
-    instance_->processInputEvent(event);
+    instance_->queueEvent(event);
 }
 
 void InputSystem::joystickCallback(int jid, int event) {
@@ -457,11 +610,15 @@ void InputSystem::joystickCallback(int jid, int event) {
 }
 
 void InputSystem::updateKeyState(int keyCode, ButtonState state) {
-    keyStates_[keyCode] = state;
+    setButtonDown(keysDown_, keyCode, state);
 }
 
 void InputSystem::updateMouseButtonState(int button, ButtonState state) {
-    mouseButtonStates_[button] = state;
+    setButtonDown(mouseButtonsDown_, button, state);
+}
+
+void InputSystem::updateScrollDelta(const glm::vec2& delta) {
+    scrollDelta_ = delta;
 }
 
 void InputSystem::appendTextInput(unsigned int codepoint) {
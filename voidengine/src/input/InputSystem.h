@@ -1,8 +1,12 @@
 #pragma once
 
+#include "../core/SpscQueue.h"
 #include <GLFW/glfw3.h>
+#include <atomic>
+#include <bitset>
 #include <unordered_map>
 #include <vector>
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <memory>
@@ -23,9 +27,13 @@ enum class EventType {
     KEY,
     MOUSE_BUTTON,
     MOUSE_MOVE,
+    // Every cursor sample as it arrives; MOUSE_MOVE is one event per update
+    MOUSE_MOVE_RAW,
     MOUSE_SCROLL,
     GAMEPAD_BUTTON,
-    GAMEPAD_AXIS
+    GAMEPAD_AXIS,
+    // Text typed; code is the Unicode code point
+    CHAR
 };
 
 struct InputEvent {
@@ -36,20 +44,52 @@ struct InputEvent {
     glm::vec2 delta;
     int mods;
     int gamepadId;
+    // Seconds on the glfwGetTime() clock when the event reached the engine,
+    // finer than the frame it is dispatched in
+    double timestamp = 0.0;
 };
 
 using InputCallback = std::function<void(const InputEvent&)>;
+// Returns true when the event was consumed and should go no further
+using InputFilter = std::function<bool(const InputEvent&)>;
+
+// Cursor samples received during the last frame versus MOUSE_MOVE events
+// dispatched for them
+struct MotionStats {
+    uint32_t rawEvents = 0;
+    uint32_t coalescedEvents = 0;
+};
 
 class InputSystem {
 public:
+    static constexpr int KEY_COUNT = GLFW_KEY_LAST + 1;
+    static constexpr int MOUSE_BUTTON_COUNT = GLFW_MOUSE_BUTTON_LAST + 1;
+    
     InputSystem();
     ~InputSystem();
 
     void initialize(GLFWwindow* window);
     void shutdown();
 
+    // Dispatches queued events in the order they arrived, then polls devices
     void update();
-
+    
+    // Queues an event for the next update(); returns false and counts the
+    // event dropped when the queue is full. The queue takes a single
+    // producer: with a window that is its GLFW callbacks, which run on the
+    // thread calling update(), so nothing else may call this. A system with
+    // no window may be fed from one other thread instead.
+    // The last slots are kept for keys and mouse buttons. A release that is
+    // dropped anyway lets go of its key or button at the next update(), and a
+    // dropped cursor sample makes it re-read the cursor.
+    bool queueEvent(const InputEvent& event);
+    uint64_t getDroppedEventCount() const { return droppedEvents_.load(std::memory_order_relaxed); }
+
+    // Sees each queued event in order during update(), before state and
+    // listeners; a consumed event goes no further, except that a release
+    // always lets go of its key or button
+    void setEventFilter(const InputFilter& filter) { eventFilter_ = filter; }
+    
     int addCallback(EventType type, const InputCallback& callback);
     void removeCallback(int callbackId);
 
@@ -60,6 +100,9 @@ public:
     glm::vec2 getMousePosition() const;
     glm::vec2 getMouseDelta() const;
     void setMousePosition(const glm::vec2& position);
+    // Queues a cursor sample; listeners get one coalesced MOUSE_MOVE from update()
+    void recordMouseMove(const glm::vec2& position);
+    const MotionStats& getMotionStats() const { return motionStats_; }
 
     glm::vec2 getGamepadAxis(int gamepadId, int axisX, int axisY) const;
     float getGamepadTrigger(int gamepadId, int axis) const;
@@ -69,6 +112,9 @@ public:
     bool isMouseButtonPressed(int button) const;
     bool wasKeyPressedThisFrame(int keyCode) const;
     bool wasKeyReleasedThisFrame(int keyCode) const;
+    // Every key that went down or up during the last update(), indexed by key code
+    std::bitset<KEY_COUNT> getKeysPressedThisFrame() const { return keysDown_ & ~keysDownLastFrame_; }
+    std::bitset<KEY_COUNT> getKeysReleasedThisFrame() const { return ~keysDown_ & keysDownLastFrame_; }
 
     const std::string& getTextInput() const;
     void clearTextInput();
@@ -76,10 +122,15 @@ public:
     static const char* getKeyName(int keyCode);
     static int getKeyScancode(int keyCode);
     
+    // Dispatches to listeners immediately, bypassing the queue and state
     void processInputEvent(const InputEvent& event);
     
+    // Records a key or button going down (PRESSED, PRESSED_THIS_FRAME, HELD)
+    // or up immediately; whether that is an edge is worked out against the
+    // state at the start of the last update()
     void updateKeyState(int keyCode, ButtonState state);
     void updateMouseButtonState(int button, ButtonState state);
+    void updateScrollDelta(const glm::vec2& delta);
     void appendTextInput(unsigned int codepoint);
 
 private:
@@ -90,11 +141,24 @@ private:
     static void scrollCallback(GLFWwindow* window, double xoffset, double yoffset);
     static void joystickCallback(int jid, int event);
 
+    void drainEvents();
+    void applyEvent(InputEvent event);
+    void pollDevices();
+    
+    template <size_t N>
+    static ButtonState getButtonState(const std::bitset<N>& down, const std::bitset<N>& downLastFrame, int code);
+    template <size_t N>
+    static void setButtonDown(std::bitset<N>& down, int code, ButtonState state);
+    
     GLFWwindow* window_;
     bool initialized_;
 
-    std::unordered_map<int, ButtonState> keyStates_;
-    std::unordered_map<int, ButtonState> mouseButtonStates_;
+    // Down now and down as of the start of the last update(); the edges are
+    // the bits that differ, and update() ages them with a copy
+    std::bitset<KEY_COUNT> keysDown_;
+    std::bitset<KEY_COUNT> keysDownLastFrame_;
+    std::bitset<MOUSE_BUTTON_COUNT> mouseButtonsDown_;
+    std::bitset<MOUSE_BUTTON_COUNT> mouseButtonsDownLastFrame_;
     std::unordered_map<int, std::unordered_map<int, ButtonState>> gamepadButtonStates_;
 
     glm::vec2 mousePosition_;
@@ -106,8 +170,37 @@ private:
 
     std::string textInput_;
 
-    std::vector<std::pair<EventType, InputCallback>> callbacks_;
+    struct CallbackEntry {
+        int id;
+        EventType type;
+        InputCallback callback;
+    };
+    
+    std::vector<CallbackEntry> callbacks_;
     int nextCallbackId_;
+    InputFilter eventFilter_;
+    
+    size_t rawMotionCallbacks_ = 0;
+    uint32_t pendingRawMotion_ = 0;
+    double lastMotionTime_ = 0.0;
+    MotionStats motionStats_;
+    
+    // Filled by GLFW callbacks, drained by update()
+    static constexpr size_t EVENT_QUEUE_CAPACITY = 1024;
+    // Slots only KEY and MOUSE_BUTTON events may take, so that a burst of
+    // cursor samples cannot crowd out a release
+    static constexpr size_t BUTTON_EVENT_RESERVE = 128;
+    core::SpscQueue<InputEvent, EVENT_QUEUE_CAPACITY> eventQueue_;
+    std::atomic<uint64_t> droppedEvents_{0};
+    
+    // Keys and buttons whose release the queue refused; set by the producer,
+    // taken by update()
+    static constexpr int KEY_WORDS = (KEY_COUNT + 31) / 32;
+    static_assert(MOUSE_BUTTON_COUNT <= 32, "Mouse buttons must fit one word");
+    std::atomic<uint32_t> droppedKeyReleases_[KEY_WORDS] = {};
+    std::atomic<uint32_t> droppedButtonReleases_{0};
+    // A cursor sample was refused; update() re-reads the cursor
+    std::atomic<bool> motionDropped_{false};
 
     static InputSystem* instance_;
 };
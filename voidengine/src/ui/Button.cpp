@@ -1,7 +1,12 @@
 #include "Button.h"
+#include "Localization.h"
 #include "Text.h"
+#include "Tween.h"
+#include "UIRenderer.h"
+#include "../core/PoolAllocator.h"
 #include <GLFW/glfw3.h>
 #include <memory>
+#include <stdexcept>
 #include <iostream>
 
 namespace voidengine {
@@ -9,13 +14,15 @@ namespace ui {
 
 Button::Button(const std::string& id, const glm::vec2& position, const glm::vec2& size,
                const std::string& text, const ButtonCallback& onClick)
-    : UIComponent(id, position, size), text_(text), onClick_(onClick) {
-    textComponent_ = std::make_shared<Text>(id + "_text", 
-                                           glm::vec2(0, 0),
-                                           text,
-                                           size.y * 0.5f,
-                                           glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+    : UIComponent(id, position, size), onClick_(onClick) {
+    // The label is drawn in the button's text color, so it needs no override
+    textComponent_ = core::makePooled<Text>(id + "_text",
+                                            glm::vec2(0, 0),
+                                            text,
+                                            size.y * 0.5f);
     textComponent_->setAlignment(TextAlignment::CENTER);
+    capabilities_ = UICapabilities::POINTER | UICapabilities::FOCUSABLE;
+    refreshStyle();
 }
 
 void Button::initialize() {
@@ -23,110 +30,239 @@ void Button::initialize() {
 }
 
 void Button::update(float deltaTime) {
-    if (!isEnabled_) {
+    ButtonState previous = state_;
+    
+    if (!isEnabled()) {
         state_ = ButtonState::DISABLED;
     } else if (isMousePressed_) {
         state_ = ButtonState::PRESSED;
-    } else if (isMouseOver_) {
+    } else if (isMouseOver_ || isFocused_) {
         state_ = ButtonState::HOVER;
     } else {
         state_ = ButtonState::NORMAL;
     }
     
+    if (state_ != previous) {
+        markRenderDirty();
+        getTweenSystem().animate(handle_, TweenProperty::BACKGROUND_COLOR, getStateColor(state_),
+                                 getTransitionDuration(), Easing::EASE_OUT_QUAD);
+    }
+    
     textComponent_->update(deltaTime);
 }
 
 void Button::render() {
-    if (!isVisible_) {
+    if (!isVisible()) {
         return;
     }
     
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    const glm::vec4& color = getStateColor(state_);
-    glColor4f(color.r, color.g, color.b, color.a);
+    const glm::vec2 position = getPosition();
+    const glm::vec2 size = getSize();
     
-    glBegin(GL_QUADS);
-    glVertex2f(position_.x, position_.y);
-    glVertex2f(position_.x + size_.x, position_.y);
-    glVertex2f(position_.x + size_.x, position_.y + size_.y);
-    glVertex2f(position_.x, position_.y + size_.y);
-    glEnd();
+    const UIStyle& buttonStyle = style();
+    const glm::vec4 outline(0.0f, 0.0f, 0.0f, 0.5f);
     
-    glColor4f(0.0f, 0.0f, 0.0f, 0.5f);
-    glLineWidth(1.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(position_.x, position_.y);
-    glVertex2f(position_.x + size_.x, position_.y);
-    glVertex2f(position_.x + size_.x, position_.y + size_.y);
-    glVertex2f(position_.x, position_.y + size_.y);
-    glEnd();
+    if (buttonStyle.shadowBlur > 0.0f) {
+        drawShadow(position + glm::vec2(0.0f, buttonStyle.shadowBlur * 0.5f), size, buttonStyle.borderRadius,
+                   buttonStyle.shadowBlur, buttonStyle.shadowColor);
+    }
     
-    float textX = position_.x + (size_.x / 2.0f);
+    const NineSliceSkin* skin = nullptr;
+    if (skins_) {
+        skin = skins_[static_cast<size_t>(state_)].atlas ? &skins_[static_cast<size_t>(state_)] : &skins_[0];
+    }
     
-    float textHeight = textComponent_->getFontSize();
-    float textY = position_.y + (size_.y / 2.0f) - (textHeight / 4.0f);
+    if (skin && skin->atlas) {
+        drawNineSlice(position, size, skin->atlas->getTexture(), skin->region);
+    } else if (buttonStyle.borderRadius > 0.0f) {
+        drawRoundedRect(position, size, buttonStyle.borderRadius, buttonStyle.backgroundColor);
+        drawRoundedRectOutline(position, size, buttonStyle.borderRadius, outline);
+    } else {
+        drawRect(position, size, buttonStyle.backgroundColor);
+        drawRectOutline(position, size, outline);
+    }
     
-    textComponent_->setPosition(glm::vec2(textX, textY));
+    // The label is only re-centered when the button's rect has moved
+    if (position != labelAnchorPosition_ || size != labelAnchorSize_) {
+        positionLabel();
+    }
     
     if (state_ == ButtonState::DISABLED) {
-        textComponent_->setColor(glm::vec4(0.7f, 0.7f, 0.7f, 0.7f));
+        textComponent_->renderWithColor(glm::vec4(0.7f, 0.7f, 0.7f, 0.7f));
     } else if (state_ == ButtonState::PRESSED) {
-        textComponent_->setColor(glm::vec4(0.9f, 0.9f, 1.0f, 1.0f));
+        textComponent_->renderWithColor(glm::vec4(0.9f, 0.9f, 1.0f, 1.0f));
     } else {
-        textComponent_->setColor(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+        textComponent_->renderWithColor(style().textColor);
     }
+}
+
+void Button::arrange(const glm::vec2& position, const glm::vec2& size) {
+    UIComponent::arrange(position, size);
+    positionLabel();
+}
+
+void Button::positionLabel() {
+    labelAnchorPosition_ = getPosition();
+    labelAnchorSize_ = getSize();
+    
+    float textX = labelAnchorPosition_.x + (labelAnchorSize_.x / 2.0f);
+    
+    float textHeight = textComponent_->getFontSize();
+    float textY = labelAnchorPosition_.y + (labelAnchorSize_.y / 2.0f) - (textHeight / 4.0f);
     
-    textComponent_->render();
+    textComponent_->setPosition(glm::vec2(textX, textY));
 }
 
 void Button::setStateColor(ButtonState state, const glm::vec4& color) {
+    StyleDeclaration declaration;
     switch (state) {
         case ButtonState::NORMAL:
-            normalColor_ = color;
+            declaration.setColor(StyleProperty::BACKGROUND, color);
             break;
         case ButtonState::HOVER:
-            hoverColor_ = color;
+            declaration.setColor(StyleProperty::HOVER_BACKGROUND, color);
             break;
         case ButtonState::PRESSED:
-            pressedColor_ = color;
+            declaration.setColor(StyleProperty::PRESSED_BACKGROUND, color);
             break;
         case ButtonState::DISABLED:
-            disabledColor_ = color;
+            declaration.setColor(StyleProperty::DISABLED_BACKGROUND, color);
             break;
     }
+    setStyleOverride(declaration);
 }
 
 const glm::vec4& Button::getStateColor(ButtonState state) const {
+    const StyleRecord& record = getStyleRecord();
     switch (state) {
-        case ButtonState::NORMAL:
-            return normalColor_;
         case ButtonState::HOVER:
-            return hoverColor_;
+            return record.hoverBackground;
         case ButtonState::PRESSED:
-            return pressedColor_;
+            return record.pressedBackground;
         case ButtonState::DISABLED:
-            return disabledColor_;
+            return record.disabledBackground;
         default:
-            return normalColor_;
+            return record.background;
+    }
+}
+
+void Button::setTransitionDuration(float seconds) {
+    StyleDeclaration declaration;
+    declaration.setNumber(StyleProperty::TRANSITION_DURATION, seconds);
+    setStyleOverride(declaration);
+}
+
+void Button::setTextColor(const glm::vec4& color) {
+    StyleDeclaration declaration;
+    declaration.setColor(StyleProperty::TEXT, color);
+    setStyleOverride(declaration);
+}
+
+void Button::setNineSlice(ButtonState state, std::shared_ptr<const TextureAtlas> atlas, const std::string& region) {
+    if (!atlas) {
+        throw std::invalid_argument("Button nine-slice needs an atlas");
+    }
+    const AtlasRegion& source = atlas->getRegion(region);
+    if (!skins_) {
+        skins_ = std::make_unique<NineSliceSkin[]>(static_cast<size_t>(ButtonState::DISABLED) + 1);
     }
+    NineSliceSkin& skin = skins_[static_cast<size_t>(state)];
+    skin.region = source;
+    skin.atlas = std::move(atlas);
+    markRenderDirty();
 }
 
-void Button::setText(const std::string& text) {
-    text_ = text;
-    if (textComponent_) {
-        textComponent_->setText(text);
+void Button::onStyleChanged(const StyleRecord& record) {
+    UIComponent::onStyleChanged(record);
+    style().backgroundColor = getStateColor(state_);
+    
+    // A blend toward the old state color would overwrite the new one
+    TweenSystem& tweens = getTweenSystem();
+    if (tweens.isAnimating(handle_, TweenProperty::BACKGROUND_COLOR)) {
+        tweens.cancel(handle_, TweenProperty::BACKGROUND_COLOR);
     }
 }
 
+void Button::setText(std::string_view text) {
+    if (textComponent_->getText() == text) {
+        return;
+    }
+    textComponent_->setText(text);
+    // The label is not parented, so its own mark does not reach our root
+    markRenderDirty();
+}
+
+void Button::bindText(TextFormatter format) {
+    textBinding_.reset();
+    textBinding_ = std::make_unique<Binding>([this, format = std::move(format)]() {
+        FormatBuffer buffer;
+        format(buffer);
+        setText(buffer.view());
+    });
+}
+
+void Button::bindLocalizedText(core::StringId id) {
+    textBinding_.reset();
+    textBinding_ = std::make_unique<Binding>([this, id]() {
+        getLocalization().getVersion();
+        textComponent_->setLocalizedText(id);
+        markRenderDirty();
+    });
+}
+
 const std::string& Button::getText() const {
-    return text_;
+    return textComponent_->getText();
+}
+
+void Button::onEvent(UIEvent& event) {
+    switch (event.type) {
+        case UIEventType::MOUSE_ENTER:
+            isMouseOver_ = true;
+            break;
+        case UIEventType::MOUSE_LEAVE:
+            isMouseOver_ = false;
+            break;
+        case UIEventType::MOUSE_MOVE:
+            if (event.phase == UIEventPhase::TARGET) {
+                onMouseMove(event.position);
+            }
+            break;
+        case UIEventType::MOUSE_BUTTON:
+            if (event.phase == UIEventPhase::TARGET && event.button == GLFW_MOUSE_BUTTON_LEFT) {
+                onMouseButton(event.button, event.action, event.position);
+                event.consume();
+            }
+            break;
+        case UIEventType::FOCUS_GAINED:
+            isFocused_ = true;
+            break;
+        case UIEventType::FOCUS_LOST:
+            isFocused_ = false;
+            break;
+        case UIEventType::KEY:
+            if (event.phase == UIEventPhase::TARGET && event.action == GLFW_PRESS &&
+                (event.key == GLFW_KEY_ENTER || event.key == GLFW_KEY_KP_ENTER || event.key == GLFW_KEY_SPACE)) {
+                activate();
+                event.consume();
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+bool Button::activate() {
+    if (!isEnabled()) {
+        return false;
+    }
+    if (onClick_) {
+        onClick_();
+    }
+    return true;
 }
 
 bool Button::isPointInside(const glm::vec2& point) const {
-    return (point.x >= position_.x && point.x <= position_.x + size_.x &&
-            point.y >= position_.y && point.y <= position_.y + size_.y);
+    return containsPoint(point);
 }
 
 void Button::onMouseMove(const glm::vec2& point) {
@@ -140,7 +276,7 @@ void Button::onMouseButton(int button, int action, const glm::vec2& point) {
                 isMousePressed_ = true;
             }
         } else if (action == GLFW_RELEASE) {
-            if (isMousePressed_ && isPointInside(point) && isEnabled_ && onClick_) {
+            if (isMousePressed_ && isPointInside(point) && isEnabled() && onClick_) {
                 onClick_();
             }
             isMousePressed_ = false;
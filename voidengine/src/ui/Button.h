@@ -1,9 +1,12 @@
 #pragma once
 
 #include "UIComponent.h"
+#include "Observable.h"
+#include "TextureAtlas.h"
 #include <functional>
 #include <glm/glm.hpp>
 #include <string>
+#include <string_view>
 #include <memory>
 
 namespace voidengine {
@@ -31,17 +34,42 @@ public:
     void initialize() override;
     void update(float deltaTime) override;
     void render() override;
+    core::StringId getStyleType() const override { return core::hashString("Button"); }
     
-    void setText(const std::string& text);
+    void onEvent(UIEvent& event) override;
+    bool activate() override;
+    void arrange(const glm::vec2& position, const glm::vec2& size) override;
+    
+    void setText(std::string_view text);
+    // The label component owns the string; the button keeps no copy
     const std::string& getText() const;
     
+    // Label counterpart of Text::bindText
+    void bindText(TextFormatter format);
+    void unbindText() { textBinding_.reset(); }
+    // Label counterpart of Text::bindLocalizedText
+    void bindLocalizedText(core::StringId id);
+    
     void setOnClick(const ButtonCallback& callback) { onClick_ = callback; }
     
+    // Colors and timing come from the style sheet; the setters override it for
+    // this button only
     void setStateColor(ButtonState state, const glm::vec4& color);
     const glm::vec4& getStateColor(ButtonState state) const;
     
-    void setTextColor(const glm::vec4& color) { textColor_ = color; }
-    const glm::vec4& getTextColor() const { return textColor_; }
+    // Seconds the background takes to blend into a new state color
+    void setTransitionDuration(float seconds);
+    float getTransitionDuration() const { return getStyleRecord().transitionDuration; }
+    
+    void setTextColor(const glm::vec4& color);
+    const glm::vec4& getTextColor() const { return getStyleRecord().text; }
+    
+    // Draws the atlas region nine-slice in place of the background while the
+    // button is in that state; states without a skin of their own use the
+    // NORMAL one. Throws std::out_of_range for unknown regions.
+    void setNineSlice(ButtonState state, std::shared_ptr<const TextureAtlas> atlas, const std::string& region);
+    void clearNineSlices() { skins_.reset(); markRenderDirty(); }
+    bool hasNineSlice() const { return skins_ != nullptr; }
     
     ButtonState getState() const { return state_; }
     void setState(ButtonState state) { state_ = state; }
@@ -50,21 +78,27 @@ public:
     void onMouseMove(const glm::vec2& point);
     void onMouseButton(int button, int action, const glm::vec2& point);
     
+protected:
+    void onStyleChanged(const StyleRecord& record) override;
+    
 private:
-    std::string text_;
+    void positionLabel();
+    
     ButtonCallback onClick_;
     ButtonState state_ = ButtonState::NORMAL;
     
-    glm::vec4 normalColor_ = glm::vec4(0.3f, 0.3f, 0.8f, 1.0f);
-    glm::vec4 hoverColor_ = glm::vec4(0.4f, 0.4f, 0.9f, 1.0f);
-    glm::vec4 pressedColor_ = glm::vec4(0.2f, 0.2f, 0.7f, 1.0f);
-    glm::vec4 disabledColor_ = glm::vec4(0.5f, 0.5f, 0.5f, 0.7f);
-    
-    glm::vec4 textColor_ = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
     bool isMouseOver_ = false;
     bool isMousePressed_ = false;
+    // Focus highlights like hover so keyboard and gamepad users see it
+    bool isFocused_ = false;
+    
+    // One per ButtonState, allocated when the first skin is set
+    std::unique_ptr<NineSliceSkin[]> skins_;
     
     std::shared_ptr<Text> textComponent_;
+    std::unique_ptr<Binding> textBinding_;
+    glm::vec2 labelAnchorPosition_ = glm::vec2(0.0f);
+    glm::vec2 labelAnchorSize_ = glm::vec2(-1.0f);
 };
 
 } // namespace ui
@@ -0,0 +1,33 @@
+#include "Clipboard.h"
+#include <GLFW/glfw3.h>
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+std::string& localClipboard() {
+    static std::string text;
+    return text;
+}
+
+} // namespace
+
+void setClipboardText(const std::string& text) {
+    if (GLFWwindow* window = glfwGetCurrentContext()) {
+        glfwSetClipboardString(window, text.c_str());
+        return;
+    }
+    localClipboard() = text;
+}
+
+std::string getClipboardText() {
+    if (GLFWwindow* window = glfwGetCurrentContext()) {
+        const char* text = glfwGetClipboardString(window);
+        return text ? std::string(text) : std::string();
+    }
+    return localClipboard();
+}
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string>
+
+namespace voidengine {
+namespace ui {
+
+// System clipboard through GLFW. Without a current GLFW context (headless
+// runs) a process-local buffer stands in for it.
+void setClipboardText(const std::string& text);
+std::string getClipboardText();
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,425 @@
+#include "DataGrid.h"
+#include "UIRenderer.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+constexpr float CELL_PADDING = 4.0f;
+constexpr size_t LAYOUT_CACHE_CAPACITY = 4096;
+
+const glm::vec4 HEADER_SHADE(0.0f, 0.0f, 0.0f, 0.35f);
+const glm::vec4 STRIPE_SHADE(1.0f, 1.0f, 1.0f, 0.03f);
+const glm::vec4 SCROLL_THUMB(0.8f, 0.8f, 0.8f, 0.6f);
+
+} // namespace
+
+DataGrid::DataGrid(const std::string& id, const glm::vec2& position, const glm::vec2& size,
+                   float rowHeight, float fontSize)
+    : UIComponent(id, position, size), rowHeight_(rowHeight), fontSize_(fontSize),
+      layoutCache_(LAYOUT_CACHE_CAPACITY) {
+    if (rowHeight_ <= 0.0f || fontSize_ <= 0.0f) {
+        throw std::invalid_argument("DataGrid row height and font size must be positive");
+    }
+    
+    capabilities_ = UICapabilities::POINTER | UICapabilities::CLIPS_CHILDREN;
+    rebuildColumns();
+    refreshStyle();
+}
+
+void DataGrid::update(float deltaTime) {
+    if (!source_) {
+        return;
+    }
+    
+    syncColumns();
+    
+    // Appended rows change the scroll range, which the scrollbar shows
+    size_t displayed = getDisplayedRowCount();
+    if (displayed != displayedRows_) {
+        displayedRows_ = displayed;
+        clampScroll();
+        markRenderDirty();
+    }
+    
+    updateVisibleRange();
+    resizeSlots();
+    refreshCells();
+}
+
+void DataGrid::render() {
+    if (!isVisible()) {
+        return;
+    }
+    
+    const glm::vec2 position = getPosition();
+    const glm::vec2 size = getSize();
+    const float headerHeight = getHeaderHeight();
+    const float bodyTop = position.y + headerHeight;
+    const glm::vec2 bodySize(size.x, std::max(size.y - headerHeight, 0.0f));
+    const glm::vec4& textColor = style().textColor;
+    const glm::vec4 separatorColor = style().borderColor * glm::vec4(1.0f, 1.0f, 1.0f, 0.4f);
+    
+    // The order or the size may have changed since the last update
+    if (source_) {
+        syncColumns();
+        updateVisibleRange();
+    }
+    
+    drawRect(position, size, style().backgroundColor);
+    drawRect(position, glm::vec2(size.x, headerHeight), HEADER_SHADE);
+    
+    if (source_ && columnCount_ > 0 && !slots_.empty()) {
+        pushClipRect(glm::vec2(position.x, bodyTop), bodySize);
+        
+        for (size_t r = firstRow_; r < firstRow_ + rowCount_; r++) {
+            const float y = bodyTop + static_cast<float>(r) * rowHeight_ - scrollOffset_.y;
+            if (r % 2 == 1) {
+                drawRect(glm::vec2(position.x, y), glm::vec2(size.x, rowHeight_), STRIPE_SHADE);
+            }
+            
+            const size_t row = getSourceRow(r);
+            for (size_t c = firstColumn_; c < firstColumn_ + columnCount_; c++) {
+                const CellSlot& slot = slotFor(r, c);
+                // Not refreshed yet, e.g. drawn before the first update
+                if (slot.row != row || slot.column != c) {
+                    continue;
+                }
+                
+                const float x = position.x + columnOffsets_[c] - scrollOffset_.x;
+                const float available = getColumnWidth(c) - 2.0f * CELL_PADDING;
+                float textX = x + CELL_PADDING;
+                // Text too wide for its cell is cut on the right whatever the alignment
+                if (slot.run.size.x <= available) {
+                    if (columnAlignments_[c] == TextAlignment::RIGHT) {
+                        textX += available - slot.run.size.x;
+                    } else if (columnAlignments_[c] == TextAlignment::CENTER) {
+                        textX += (available - slot.run.size.x) * 0.5f;
+                    }
+                }
+                const float textY = y + (rowHeight_ - fontSize_) * 0.5f;
+                drawTextRun(slot.run, glm::vec2(textX, textY), textColor, available);
+            }
+        }
+        
+        for (size_t c = firstColumn_; c < firstColumn_ + columnCount_; c++) {
+            const float right = position.x + columnOffsets_[c + 1] - scrollOffset_.x;
+            drawRect(glm::vec2(right - 1.0f, bodyTop), glm::vec2(1.0f, bodySize.y), separatorColor);
+        }
+        
+        popClipRect();
+        
+        pushClipRect(position, glm::vec2(size.x, headerHeight));
+        for (size_t c = firstColumn_; c < firstColumn_ + columnCount_; c++) {
+            FormatBuffer label;
+            label.append(source_->getColumnName(c));
+            if (c == sortColumn_) {
+                label.append(sortAscending_ ? " ^" : " v");
+            }
+            
+            const float x = position.x + columnOffsets_[c] - scrollOffset_.x;
+            const TextRun& run = layoutCache_.get(label.view(), fontSize_);
+            drawTextRun(run, glm::vec2(x + CELL_PADDING, position.y + (headerHeight - fontSize_) * 0.5f), textColor,
+                        getColumnWidth(c) - 2.0f * CELL_PADDING);
+            drawRect(glm::vec2(x + getColumnWidth(c) - 1.0f, position.y), glm::vec2(1.0f, headerHeight),
+                     separatorColor);
+        }
+        popClipRect();
+    }
+    
+    const glm::vec2 content = getContentSize();
+    if (content.y > bodySize.y && bodySize.y > 0.0f) {
+        float thumbHeight = std::max(16.0f, bodySize.y * (bodySize.y / content.y));
+        float thumbY = bodyTop + (bodySize.y - thumbHeight) * (scrollOffset_.y / (content.y - bodySize.y));
+        drawRect(glm::vec2(position.x + size.x - 4.0f, thumbY), glm::vec2(3.0f, thumbHeight), SCROLL_THUMB);
+    }
+    if (content.x > size.x && size.x > 0.0f) {
+        float thumbWidth = std::max(16.0f, size.x * (size.x / content.x));
+        float thumbX = position.x + (size.x - thumbWidth) * (scrollOffset_.x / (content.x - size.x));
+        drawRect(glm::vec2(thumbX, position.y + size.y - 4.0f), glm::vec2(thumbWidth, 3.0f), SCROLL_THUMB);
+    }
+    
+    drawRectOutline(position, size, style().borderColor);
+}
+
+void DataGrid::onEvent(UIEvent& event) {
+    if (event.phase == UIEventPhase::CAPTURE) {
+        return;
+    }
+    
+    if (event.type == UIEventType::SCROLL) {
+        setScrollOffset(scrollOffset_ - event.scroll * rowHeight_ * scrollSpeed_);
+        event.consume();
+    } else if (event.type == UIEventType::MOUSE_BUTTON && event.phase == UIEventPhase::TARGET) {
+        const glm::vec2 local = event.position - getPosition();
+        if (source_ && event.button == GLFW_MOUSE_BUTTON_LEFT && event.action == GLFW_PRESS &&
+            local.y < getHeaderHeight() && local.x + scrollOffset_.x < columnOffsets_.back()) {
+            size_t column = columnAt(local.x + scrollOffset_.x);
+            sortByColumn(column, column == sortColumn_ ? !sortAscending_ : true);
+        }
+        event.consume();
+    }
+}
+
+void DataGrid::setSource(DataGridSource* source) {
+    source_ = source;
+    filter_ = nullptr;
+    sortColumn_ = NO_COLUMN;
+    scrollOffset_ = glm::vec2(0.0f);
+    slots_.assign(slots_.size(), CellSlot());
+    rebuildColumns();
+    refreshOrder();
+}
+
+void DataGrid::setColumnWidth(size_t column, float width) {
+    if (width <= 0.0f) {
+        throw std::invalid_argument("DataGrid column width must be positive");
+    }
+    if (column >= columnWidths_.size()) {
+        columnWidths_.resize(column + 1, -1.0f);
+    }
+    columnWidths_[column] = width;
+    rebuildColumns();
+}
+
+float DataGrid::getColumnWidth(size_t column) const {
+    if (column < columnWidths_.size() && columnWidths_[column] > 0.0f) {
+        return columnWidths_[column];
+    }
+    return defaultColumnWidth_;
+}
+
+void DataGrid::setDefaultColumnWidth(float width) {
+    if (width <= 0.0f) {
+        throw std::invalid_argument("DataGrid column width must be positive");
+    }
+    defaultColumnWidth_ = width;
+    rebuildColumns();
+}
+
+void DataGrid::setColumnAlignment(size_t column, TextAlignment alignment) {
+    if (column >= columnAlignments_.size()) {
+        columnAlignments_.resize(column + 1, TextAlignment::LEFT);
+    }
+    columnAlignments_[column] = alignment;
+    markRenderDirty();
+}
+
+void DataGrid::sortByColumn(size_t column, bool ascending) {
+    if (!source_ || column >= source_->getColumnCount()) {
+        throw std::out_of_range("DataGrid sort column out of range");
+    }
+    sortColumn_ = column;
+    sortAscending_ = ascending;
+    refreshOrder();
+}
+
+void DataGrid::clearSort() {
+    sortColumn_ = NO_COLUMN;
+    refreshOrder();
+}
+
+void DataGrid::setFilter(RowFilter filter) {
+    filter_ = std::move(filter);
+    refreshOrder();
+}
+
+void DataGrid::clearFilter() {
+    filter_ = nullptr;
+    refreshOrder();
+}
+
+void DataGrid::refreshOrder() {
+    identityOrder_ = !filter_ && sortColumn_ == NO_COLUMN;
+    order_.clear();
+    
+    if (identityOrder_) {
+        order_.shrink_to_fit();
+    } else if (source_) {
+        const size_t rows = source_->getRowCount();
+        if (rows > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("DataGrid cannot sort or filter more than 2^32 - 1 rows");
+        }
+        
+        order_.reserve(rows);
+        for (size_t row = 0; row < rows; row++) {
+            if (!filter_ || filter_(row)) {
+                order_.push_back(static_cast<uint32_t>(row));
+            }
+        }
+        
+        if (sortColumn_ != NO_COLUMN) {
+            const DataGridSource& source = *source_;
+            const size_t column = sortColumn_;
+            // Stable, so equal keys keep the previous order and repeated
+            // header clicks do not shuffle ties
+            if (sortAscending_) {
+                std::stable_sort(order_.begin(), order_.end(), [&source, column](uint32_t a, uint32_t b) {
+                    return source.lessThan(column, a, b);
+                });
+            } else {
+                std::stable_sort(order_.begin(), order_.end(), [&source, column](uint32_t a, uint32_t b) {
+                    return source.lessThan(column, b, a);
+                });
+            }
+        }
+    }
+    
+    displayedRows_ = getDisplayedRowCount();
+    clampScroll();
+    markRenderDirty();
+}
+
+size_t DataGrid::getDisplayedRowCount() const {
+    if (!source_) {
+        return 0;
+    }
+    return identityOrder_ ? source_->getRowCount() : order_.size();
+}
+
+size_t DataGrid::getSourceRow(size_t displayRow) const {
+    return identityOrder_ ? displayRow : order_[displayRow];
+}
+
+void DataGrid::setScrollOffset(const glm::vec2& offset) {
+    glm::vec2 previous = scrollOffset_;
+    scrollOffset_ = offset;
+    clampScroll();
+    if (scrollOffset_ != previous) {
+        markRenderDirty();
+    }
+}
+
+void DataGrid::scrollToRow(size_t displayRow) {
+    const float bodyHeight = std::max(getSize().y - getHeaderHeight(), 0.0f);
+    const float top = static_cast<float>(displayRow) * rowHeight_;
+    glm::vec2 offset = scrollOffset_;
+    if (top < offset.y) {
+        offset.y = top;
+    } else if (top + rowHeight_ > offset.y + bodyHeight) {
+        offset.y = top + rowHeight_ - bodyHeight;
+    }
+    setScrollOffset(offset);
+}
+
+glm::vec2 DataGrid::getContentSize() const {
+    return glm::vec2(columnOffsets_.back(), static_cast<float>(getDisplayedRowCount()) * rowHeight_);
+}
+
+void DataGrid::rebuildColumns() {
+    // Settings made before the source was set are kept, so these only grow
+    const size_t count = source_ ? source_->getColumnCount() : 0;
+    if (columnWidths_.size() < count) {
+        columnWidths_.resize(count, -1.0f);
+    }
+    if (columnAlignments_.size() < count) {
+        columnAlignments_.resize(count, TextAlignment::LEFT);
+    }
+    
+    columnOffsets_.resize(count + 1);
+    columnOffsets_[0] = 0.0f;
+    narrowestColumn_ = defaultColumnWidth_;
+    for (size_t c = 0; c < count; c++) {
+        const float width = getColumnWidth(c);
+        columnOffsets_[c + 1] = columnOffsets_[c] + width;
+        narrowestColumn_ = std::min(narrowestColumn_, width);
+    }
+    
+    clampScroll();
+    markRenderDirty();
+}
+
+void DataGrid::syncColumns() {
+    if (columnOffsets_.size() != source_->getColumnCount() + 1) {
+        rebuildColumns();
+    }
+}
+
+void DataGrid::updateVisibleRange() {
+    const glm::vec2 size = getSize();
+    const float bodyHeight = std::max(size.y - getHeaderHeight(), 0.0f);
+    const size_t columns = columnOffsets_.size() - 1;
+    
+    if (displayedRows_ == 0 || columns == 0) {
+        rowCount_ = 0;
+        columnCount_ = 0;
+        return;
+    }
+    
+    firstRow_ = std::min(static_cast<size_t>(scrollOffset_.y / rowHeight_), displayedRows_ - 1);
+    size_t endRow = std::min(static_cast<size_t>((scrollOffset_.y + bodyHeight) / rowHeight_) + 1, displayedRows_);
+    rowCount_ = endRow - firstRow_;
+    
+    firstColumn_ = columnAt(scrollOffset_.x);
+    size_t endColumn = firstColumn_;
+    while (endColumn < columns && columnOffsets_[endColumn] < scrollOffset_.x + size.x) {
+        endColumn++;
+    }
+    columnCount_ = endColumn - firstColumn_;
+}
+
+void DataGrid::resizeSlots() {
+    // Enough slots for the most rows and columns any scroll position can
+    // show, so visible cells never share a slot
+    const glm::vec2 size = getSize();
+    const float bodyHeight = std::max(size.y - getHeaderHeight(), 0.0f);
+    const size_t columns = columnOffsets_.size() - 1;
+    const size_t rows = static_cast<size_t>(std::ceil(bodyHeight / rowHeight_)) + 1;
+    const size_t slotColumns = std::min(columns, static_cast<size_t>(std::ceil(size.x / narrowestColumn_)) + 1);
+    
+    if (rows != slotRows_ || slotColumns != slotColumns_) {
+        slotRows_ = rows;
+        slotColumns_ = std::max<size_t>(slotColumns, 1);
+        slots_.assign(slotRows_ * slotColumns_, CellSlot());
+    }
+}
+
+void DataGrid::refreshCells() {
+    bool changed = false;
+    for (size_t r = firstRow_; r < firstRow_ + rowCount_; r++) {
+        const size_t row = getSourceRow(r);
+        for (size_t c = firstColumn_; c < firstColumn_ + columnCount_; c++) {
+            CellSlot& slot = slotFor(r, c);
+            const uint32_t stamp = source_->getCellStamp(row, c);
+            if (slot.row == row && slot.column == c && slot.stamp == stamp) {
+                continue;
+            }
+            
+            FormatBuffer buffer;
+            source_->formatCell(row, c, buffer);
+            // Copying into the slot reuses its glyph storage
+            slot.run = layoutCache_.get(buffer.view(), fontSize_);
+            slot.row = row;
+            slot.column = c;
+            slot.stamp = stamp;
+            cellRebuilds_++;
+            changed = true;
+        }
+    }
+    
+    if (changed) {
+        markRenderDirty();
+    }
+}
+
+void DataGrid::clampScroll() {
+    const glm::vec2 viewport(getSize().x, std::max(getSize().y - getHeaderHeight(), 0.0f));
+    const glm::vec2 limit = glm::max(getContentSize() - viewport, glm::vec2(0.0f));
+    scrollOffset_ = glm::clamp(scrollOffset_, glm::vec2(0.0f), limit);
+}
+
+size_t DataGrid::columnAt(float x) const {
+    const size_t columns = columnOffsets_.size() - 1;
+    auto it = std::upper_bound(columnOffsets_.begin(), columnOffsets_.begin() + columns, x);
+    size_t column = static_cast<size_t>(it - columnOffsets_.begin());
+    return column > 0 ? column - 1 : 0;
+}
+
+} // namespace ui
+} // namespace voidengine
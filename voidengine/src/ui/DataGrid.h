@@ -0,0 +1,156 @@
+#pragma once
+
+#include "UIComponent.h"
+#include "Observable.h"
+#include "Text.h"
+#include "TextLayout.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace voidengine {
+namespace ui {
+
+// Cell values for a DataGrid, kept however suits the data, typically one array
+// per column. The grid only ever asks about the cells on screen.
+class DataGridSource {
+public:
+    virtual ~DataGridSource() = default;
+    
+    virtual size_t getRowCount() const = 0;
+    virtual size_t getColumnCount() const = 0;
+    virtual std::string_view getColumnName(size_t column) const = 0;
+    
+    virtual void formatCell(size_t row, size_t column, FormatBuffer& out) const = 0;
+    // Must change whenever the cell's value does; a visible cell is only
+    // reformatted and laid out again when its stamp moves. A per-column
+    // counter is enough for columns that change as a whole.
+    virtual uint32_t getCellStamp(size_t row, size_t column) const = 0;
+    // The order sortByColumn uses
+    virtual bool lessThan(size_t column, size_t rowA, size_t rowB) const = 0;
+};
+
+// Table of a DataGridSource that creates no per-row or per-cell components:
+// only the rows and columns inside the viewport are visited. Each visible
+// cell keeps its laid-out text run in a slot of a ring buffer indexed by
+// display row and column, so scrolling by a row re-lays out one row of cells
+// and a frame where nothing changed lays out none. Runs come from a
+// TextLayoutCache, so repeated values are laid out once.
+//
+// Sorting and filtering build a permutation of source row indices; the data
+// is never copied. Clicking a column header sorts by it, and clicking again
+// reverses the order.
+class DataGrid : public UIComponent {
+public:
+    using RowFilter = std::function<bool(size_t row)>;
+    
+    static constexpr size_t NO_COLUMN = static_cast<size_t>(-1);
+    
+    DataGrid(const std::string& id, const glm::vec2& position, const glm::vec2& size,
+             float rowHeight = 22.0f, float fontSize = 14.0f);
+    
+    void update(float deltaTime) override;
+    void render() override;
+    core::StringId getStyleType() const override { return core::hashString("DataGrid"); }
+    
+    void onEvent(UIEvent& event) override;
+    
+    // The source must outlive the grid or be replaced first. Null empties it.
+    void setSource(DataGridSource* source);
+    DataGridSource* getSource() const { return source_; }
+    
+    void setColumnWidth(size_t column, float width);
+    float getColumnWidth(size_t column) const;
+    // For columns without an explicit width
+    void setDefaultColumnWidth(float width);
+    void setColumnAlignment(size_t column, TextAlignment alignment);
+    
+    // Rows appended to the source show up on their own while the grid is
+    // unsorted and unfiltered; otherwise call refreshOrder(), which also
+    // re-sorts after values the sort depends on changed
+    void sortByColumn(size_t column, bool ascending = true);
+    void clearSort();
+    size_t getSortColumn() const { return sortColumn_; }
+    bool isSortAscending() const { return sortAscending_; }
+    void setFilter(RowFilter filter);
+    void clearFilter();
+    void refreshOrder();
+    
+    size_t getDisplayedRowCount() const;
+    size_t getSourceRow(size_t displayRow) const;
+    
+    void setScrollOffset(const glm::vec2& offset);
+    const glm::vec2& getScrollOffset() const { return scrollOffset_; }
+    void scrollToRow(size_t displayRow);
+    glm::vec2 getContentSize() const;
+    
+    float getRowHeight() const { return rowHeight_; }
+    float getHeaderHeight() const { return rowHeight_; }
+    
+    // Cells formatted and laid out again since construction
+    uint64_t getCellRebuildCount() const { return cellRebuilds_; }
+    const TextLayoutCache& getLayoutCache() const { return layoutCache_; }
+
+private:
+    static constexpr size_t NO_ROW = static_cast<size_t>(-1);
+    
+    struct CellSlot {
+        size_t row = NO_ROW;
+        size_t column = NO_COLUMN;
+        uint32_t stamp = 0;
+        TextRun run;
+    };
+    
+    void rebuildColumns();
+    void syncColumns();
+    void updateVisibleRange();
+    void refreshCells();
+    void resizeSlots();
+    void clampScroll();
+    size_t columnAt(float x) const;
+    
+    CellSlot& slotFor(size_t displayRow, size_t column) {
+        return slots_[(displayRow % slotRows_) * slotColumns_ + column % slotColumns_];
+    }
+    
+    DataGridSource* source_ = nullptr;
+    float rowHeight_;
+    float fontSize_;
+    float defaultColumnWidth_ = 100.0f;
+    
+    std::vector<float> columnWidths_;
+    std::vector<TextAlignment> columnAlignments_;
+    // columnOffsets_[c] is the left edge of column c; one extra entry holds
+    // the total width
+    std::vector<float> columnOffsets_;
+    float narrowestColumn_ = 0.0f;
+    
+    // Source rows in display order; empty while unsorted and unfiltered
+    std::vector<uint32_t> order_;
+    bool identityOrder_ = true;
+    RowFilter filter_;
+    size_t sortColumn_ = NO_COLUMN;
+    bool sortAscending_ = true;
+    
+    glm::vec2 scrollOffset_ = glm::vec2(0.0f);
+    float scrollSpeed_ = 3.0f;
+    
+    size_t displayedRows_ = 0;
+    size_t firstRow_ = 0;
+    size_t rowCount_ = 0;
+    size_t firstColumn_ = 0;
+    size_t columnCount_ = 0;
+    
+    std::vector<CellSlot> slots_;
+    size_t slotRows_ = 0;
+    size_t slotColumns_ = 0;
+    
+    TextLayoutCache layoutCache_;
+    uint64_t cellRebuilds_ = 0;
+};
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,196 @@
+#include "DrawList.h"
+#include "ShapeTessellator.h"
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <stdexcept>
+#include <GLFW/glfw3.h>
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+const glm::vec4 NO_CLIP(0.0f, 0.0f, -1.0f, -1.0f);
+
+uint32_t packColor(const glm::vec4& color) {
+    auto channel = [](float value) {
+        return static_cast<uint32_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    };
+    
+    // Byte order in memory is r, g, b, a on little-endian targets
+    return channel(color.r) | (channel(color.g) << 8) | (channel(color.b) << 16) | (channel(color.a) << 24);
+}
+
+} // namespace
+
+void DrawList::clear() {
+    vertices_.clear();
+    batches_.clear();
+    clipStack_.clear();
+}
+
+void DrawList::addRect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) {
+    addQuad(position.x, position.y, position.x + size.x, position.y + size.y, 0.0f, 0.0f, 0.0f, 0.0f, 0,
+            packColor(color));
+}
+
+void DrawList::addRectOutline(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color,
+                              float width) {
+    // Four strips centred on the edges, as GL_LINE_LOOP would draw them
+    uint32_t packed = packColor(color);
+    const float half = width * 0.5f;
+    const float x0 = position.x;
+    const float y0 = position.y;
+    const float x1 = position.x + size.x;
+    const float y1 = position.y + size.y;
+    
+    addQuad(x0 - half, y0 - half, x1 + half, y0 + half, 0.0f, 0.0f, 0.0f, 0.0f, 0, packed);
+    addQuad(x0 - half, y1 - half, x1 + half, y1 + half, 0.0f, 0.0f, 0.0f, 0.0f, 0, packed);
+    addQuad(x0 - half, y0 + half, x0 + half, y1 - half, 0.0f, 0.0f, 0.0f, 0.0f, 0, packed);
+    addQuad(x1 - half, y0 + half, x1 + half, y1 - half, 0.0f, 0.0f, 0.0f, 0.0f, 0, packed);
+}
+
+void DrawList::addTexturedRect(const glm::vec2& position, const glm::vec2& size, unsigned int texture,
+                               const glm::vec4& color) {
+    addQuad(position.x, position.y, position.x + size.x, position.y + size.y, 0.0f, 0.0f, 1.0f, 1.0f, texture,
+            packColor(color));
+}
+
+void DrawList::addNineSlice(const glm::vec2& position, const glm::vec2& size, unsigned int texture,
+                            const AtlasRegion& region, const glm::vec4& color) {
+    const NineSliceGrid grid = computeNineSliceGrid(position, size, region);
+    const uint32_t packed = packColor(color);
+    for (int row = 0; row < 3; row++) {
+        for (int column = 0; column < 3; column++) {
+            addQuad(grid.x[column], grid.y[row], grid.x[column + 1], grid.y[row + 1], grid.u[column], grid.v[row],
+                    grid.u[column + 1], grid.v[row + 1], texture, packed);
+        }
+    }
+}
+
+void DrawList::addShape(const ShapeMesh& mesh, const glm::vec2& offset, const glm::vec4& color) {
+    if (mesh.vertices.empty()) {
+        return;
+    }
+    const glm::vec4& clip = clipStack_.empty() ? NO_CLIP : clipStack_.back();
+    
+    if (batches_.empty() || batches_.back().texture != 0 || batches_.back().clip != clip) {
+        batches_.push_back(DrawBatch{0, clip, static_cast<uint32_t>(vertices_.size()), 0});
+    }
+    batches_.back().count += static_cast<uint32_t>(mesh.vertices.size());
+    
+    const uint32_t rgb = packColor(glm::vec4(color.r, color.g, color.b, 0.0f));
+    const float alpha = std::min(std::max(color.a, 0.0f), 1.0f) * 255.0f;
+    for (const ShapeVertex& vertex : mesh.vertices) {
+        const uint32_t a = static_cast<uint32_t>(alpha * vertex.coverage + 0.5f);
+        addVertex(offset.x + vertex.position.x, offset.y + vertex.position.y, 0.0f, 0.0f, rgb | (a << 24));
+    }
+}
+
+void DrawList::pushClipRect(const glm::vec2& position, const glm::vec2& size) {
+    glm::vec4 clip(position.x, position.y, std::max(size.x, 0.0f), std::max(size.y, 0.0f));
+    
+    if (!clipStack_.empty()) {
+        const glm::vec4& outer = clipStack_.back();
+        float x0 = std::max(clip.x, outer.x);
+        float y0 = std::max(clip.y, outer.y);
+        float x1 = std::min(clip.x + clip.z, outer.x + outer.z);
+        float y1 = std::min(clip.y + clip.w, outer.y + outer.w);
+        clip = glm::vec4(x0, y0, std::max(x1 - x0, 0.0f), std::max(y1 - y0, 0.0f));
+    }
+    
+    clipStack_.push_back(clip);
+}
+
+void DrawList::popClipRect() {
+    if (clipStack_.empty()) {
+        throw std::logic_error("DrawList clip stack underflow");
+    }
+    clipStack_.pop_back();
+}
+
+void DrawList::submit() const {
+    if (batches_.empty()) {
+        return;
+    }
+    
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_TEXTURE_BIT | GL_SCISSOR_BIT);
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    
+    const DrawVertex* base = vertices_.data();
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(DrawVertex), &base->x);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(DrawVertex), &base->u);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(DrawVertex), &base->color);
+    
+    // Track state across batches so only the changes are issued
+    unsigned int boundTexture = 0;
+    bool clipping = false;
+    glm::vec4 currentClip = NO_CLIP;
+    
+    for (const DrawBatch& batch : batches_) {
+        if (batch.texture != boundTexture) {
+            if (batch.texture != 0) {
+                if (boundTexture == 0) {
+                    glEnable(GL_TEXTURE_2D);
+                }
+                glBindTexture(GL_TEXTURE_2D, batch.texture);
+            } else {
+                glDisable(GL_TEXTURE_2D);
+            }
+            boundTexture = batch.texture;
+        }
+        
+        if (batch.clip != currentClip) {
+            if (batch.clip.z < 0.0f) {
+                glDisable(GL_SCISSOR_TEST);
+                clipping = false;
+            } else {
+                if (!clipping) {
+                    glEnable(GL_SCISSOR_TEST);
+                    clipping = true;
+                }
+                glScissor(static_cast<GLint>(batch.clip.x),
+                          static_cast<GLint>(viewport[3] - (batch.clip.y + batch.clip.w)),
+                          static_cast<GLsizei>(batch.clip.z),
+                          static_cast<GLsizei>(batch.clip.w));
+            }
+            currentClip = batch.clip;
+        }
+        
+        glDrawArrays(GL_QUADS, static_cast<GLint>(batch.first), static_cast<GLsizei>(batch.count));
+    }
+    
+    glPopClientAttrib();
+    glPopAttrib();
+}
+
+void DrawList::addQuad(float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1,
+                       unsigned int texture, uint32_t color) {
+    const glm::vec4& clip = clipStack_.empty() ? NO_CLIP : clipStack_.back();
+    
+    if (batches_.empty() || batches_.back().texture != texture || batches_.back().clip != clip) {
+        batches_.push_back(DrawBatch{texture, clip, static_cast<uint32_t>(vertices_.size()), 0});
+    }
+    batches_.back().count += 4;
+    
+    addVertex(x0, y0, u0, v0, color);
+    addVertex(x1, y0, u1, v0, color);
+    addVertex(x1, y1, u1, v1, color);
+    addVertex(x0, y1, u0, v1, color);
+}
+
+void DrawList::addVertex(float x, float y, float u, float v, uint32_t color) {
+    vertices_.push_back(DrawVertex{x, y, u, v, color});
+}
+
+} // namespace ui
+} // namespace voidengine
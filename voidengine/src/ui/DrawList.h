@@ -0,0 +1,74 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace voidengine {
+namespace ui {
+
+struct AtlasRegion;
+struct ShapeMesh;
+
+struct DrawVertex {
+    float x, y;
+    float u, v;
+    // RGBA8, as glColorPointer reads it
+    uint32_t color;
+};
+
+// A run of quads drawn with one glDrawArrays call
+struct DrawBatch {
+    // Zero for untextured geometry
+    unsigned int texture;
+    // Window-space x, y, width, height; negative width when unclipped
+    glm::vec4 clip;
+    uint32_t first;
+    uint32_t count;
+};
+
+// Recorded UI geometry that can be replayed without touching the widgets that
+// produced it. Everything is a quad, outlines included, so consecutive shapes
+// sharing a texture and clip rect are merged into one batch. clear() keeps
+// the storage, so re-recording a list of similar size does not allocate.
+class DrawList {
+public:
+    void clear();
+    
+    void addRect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+    void addRectOutline(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, float width);
+    // Maps the whole texture onto the rect
+    void addTexturedRect(const glm::vec2& position, const glm::vec2& size, unsigned int texture,
+                         const glm::vec4& color);
+    // Nine quads of the atlas region, borders unstretched; see
+    // computeNineSliceGrid
+    void addNineSlice(const glm::vec2& position, const glm::vec2& size, unsigned int texture,
+                      const AtlasRegion& region, const glm::vec4& color);
+    // Translates the mesh by offset and scales the color's alpha by each
+    // vertex's coverage
+    void addShape(const ShapeMesh& mesh, const glm::vec2& offset, const glm::vec4& color);
+    
+    // Clip rects nest by intersection
+    void pushClipRect(const glm::vec2& position, const glm::vec2& size);
+    void popClipRect();
+    
+    // Draws with client-side vertex arrays under the UI projection
+    void submit() const;
+    
+    bool empty() const { return batches_.empty(); }
+    size_t getBatchCount() const { return batches_.size(); }
+    size_t getVertexCount() const { return vertices_.size(); }
+
+private:
+    void addQuad(float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1,
+                 unsigned int texture, uint32_t color);
+    void addVertex(float x, float y, float u, float v, uint32_t color);
+    
+    std::vector<DrawVertex> vertices_;
+    std::vector<DrawBatch> batches_;
+    std::vector<glm::vec4> clipStack_;
+};
+
+} // namespace ui
+} // namespace voidengine
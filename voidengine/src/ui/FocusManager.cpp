@@ -0,0 +1,286 @@
+#include "FocusManager.h"
+#include "UIComponent.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+// Keeps cell indices far from overflow for widgets placed far off screen
+constexpr float MAX_CELL_INDEX = 1.0e6f;
+
+// A candidate must be at least this far ahead, so widgets sharing a row are
+// not reached by pressing up or down
+constexpr float MIN_ADVANCE = 0.5f;
+
+glm::vec2 directionAxis(FocusDirection direction) {
+    switch (direction) {
+        case FocusDirection::LEFT:
+            return glm::vec2(-1.0f, 0.0f);
+        case FocusDirection::RIGHT:
+            return glm::vec2(1.0f, 0.0f);
+        case FocusDirection::UP:
+            return glm::vec2(0.0f, -1.0f);
+        default:
+            return glm::vec2(0.0f, 1.0f);
+    }
+}
+
+} // namespace
+
+FocusManager::FocusManager(const std::vector<std::shared_ptr<UIComponent>>& roots)
+    : roots_(roots), registry_(&getUIRegistry()) {
+}
+
+void FocusManager::setNeighbor(const UIComponent& from, FocusDirection direction, const UIComponent* to) {
+    if (direction >= FocusDirection::COUNT) {
+        throw std::invalid_argument("Invalid focus direction");
+    }
+    neighbors_[neighborKey(from, direction)] = to ? to->getHandle() : UIHandle();
+}
+
+void FocusManager::clearNeighbor(const UIComponent& from, FocusDirection direction) {
+    neighbors_.erase(neighborKey(from, direction));
+}
+
+UIComponent* FocusManager::findNeighbor(const UIComponent& from, FocusDirection direction) {
+    if (direction >= FocusDirection::COUNT) {
+        throw std::invalid_argument("Invalid focus direction");
+    }
+    
+    if (const UIHandle* link = neighbors_.find(neighborKey(from, direction))) {
+        if (!link->isValid()) {
+            return nullptr;
+        }
+        // A link to a destroyed widget falls back to the search
+        if (UIComponent* target = registry_->owner(*link)) {
+            return target;
+        }
+    }
+    
+    refresh();
+    if (candidates_.empty()) {
+        return nullptr;
+    }
+    
+    const glm::vec2 origin = from.getPosition() + from.getSize() * 0.5f;
+    const glm::vec2 axis = directionAxis(direction);
+    int cx;
+    int cy;
+    cellOf(origin, cx, cy);
+    
+    // Only the part of the grid ahead of the widget can hold a result
+    int minX = 0;
+    int maxX = columns_ - 1;
+    int minY = 0;
+    int maxY = rows_ - 1;
+    switch (direction) {
+        case FocusDirection::LEFT:
+            maxX = std::min(maxX, cx);
+            break;
+        case FocusDirection::RIGHT:
+            minX = std::max(minX, cx);
+            break;
+        case FocusDirection::UP:
+            maxY = std::min(maxY, cy);
+            break;
+        default:
+            minY = std::max(minY, cy);
+            break;
+    }
+    if (minX > maxX || minY > maxY) {
+        return nullptr;
+    }
+    
+    const int lastRing = std::max(std::max(std::abs(cx - minX), std::abs(cx - maxX)),
+                                  std::max(std::abs(cy - minY), std::abs(cy - maxY)));
+    
+    UIComponent* best = nullptr;
+    float bestScore = std::numeric_limits<float>::max();
+    for (int ring = 0; ring <= lastRing; ring++) {
+        // Everything in ring r is at least r - 1 cells away, and a score is
+        // never less than the distance
+        if (ring >= 2 && static_cast<float>(ring - 1) * cellSize_ >= bestScore) {
+            break;
+        }
+        
+        if (ring == 0) {
+            if (cx >= minX && cx <= maxX && cy >= minY && cy <= maxY) {
+                scanCell(cx, cy, from, origin, axis, best, bestScore);
+            }
+            continue;
+        }
+        
+        const int x0 = std::max(cx - ring, minX);
+        const int x1 = std::min(cx + ring, maxX);
+        for (int y : {cy - ring, cy + ring}) {
+            if (y >= minY && y <= maxY) {
+                for (int x = x0; x <= x1; x++) {
+                    scanCell(x, y, from, origin, axis, best, bestScore);
+                }
+            }
+        }
+        
+        const int y0 = std::max(cy - ring + 1, minY);
+        const int y1 = std::min(cy + ring - 1, maxY);
+        for (int x : {cx - ring, cx + ring}) {
+            if (x >= minX && x <= maxX) {
+                for (int y = y0; y <= y1; y++) {
+                    scanCell(x, y, from, origin, axis, best, bestScore);
+                }
+            }
+        }
+    }
+    
+    return best;
+}
+
+UIComponent* FocusManager::findFirst() {
+    refresh();
+    return first_;
+}
+
+size_t FocusManager::getCandidateCount() {
+    refresh();
+    return candidates_.size();
+}
+
+void FocusManager::refresh() {
+    const uint32_t version = registry_->getSpatialVersion();
+    if (indexValid_ && version == indexedVersion_) {
+        return;
+    }
+    indexValid_ = true;
+    indexedVersion_ = version;
+    rebuildCount_++;
+    
+    scratch_.clear();
+    float extentSum = 0.0f;
+    for (const auto& root : roots_) {
+        // Roots inside another component are reached through it
+        if (!root->getParent()) {
+            collect(*root, extentSum);
+        }
+    }
+    
+    candidates_.clear();
+    cellStart_.clear();
+    columns_ = 0;
+    rows_ = 0;
+    first_ = nullptr;
+    if (scratch_.empty()) {
+        return;
+    }
+    
+    glm::vec2 low(std::numeric_limits<float>::max());
+    glm::vec2 high(std::numeric_limits<float>::lowest());
+    const Candidate* first = &scratch_.front();
+    for (const Candidate& candidate : scratch_) {
+        low = glm::min(low, candidate.center);
+        high = glm::max(high, candidate.center);
+        
+        if (candidate.center.y < first->center.y ||
+            (candidate.center.y == first->center.y && candidate.center.x < first->center.x)) {
+            first = &candidate;
+        }
+    }
+    first_ = first->component;
+    
+    // Cells about one widget across keep a few candidates per cell; sparse
+    // layouts widen the cells so the grid stays proportional to the count
+    const size_t count = scratch_.size();
+    gridOrigin_ = low;
+    cellSize_ = std::max(extentSum / static_cast<float>(count), 1.0f);
+    while (true) {
+        columns_ = static_cast<int>(std::min((high.x - low.x) / cellSize_, MAX_CELL_INDEX)) + 1;
+        rows_ = static_cast<int>(std::min((high.y - low.y) / cellSize_, MAX_CELL_INDEX)) + 1;
+        if (static_cast<size_t>(columns_) * static_cast<size_t>(rows_) <= count * 4 + 64) {
+            break;
+        }
+        cellSize_ *= 2.0f;
+    }
+    
+    // Counting sort by cell
+    const size_t cellCount = static_cast<size_t>(columns_) * static_cast<size_t>(rows_);
+    cellStart_.assign(cellCount + 1, 0);
+    for (const Candidate& candidate : scratch_) {
+        int x;
+        int y;
+        cellOf(candidate.center, x, y);
+        cellStart_[static_cast<size_t>(y) * columns_ + x + 1]++;
+    }
+    for (size_t i = 0; i < cellCount; i++) {
+        cellStart_[i + 1] += cellStart_[i];
+    }
+    
+    candidates_.resize(count);
+    for (const Candidate& candidate : scratch_) {
+        int x;
+        int y;
+        cellOf(candidate.center, x, y);
+        // cellStart_[cell] is used as the fill cursor and ends up at the next
+        // cell's start, so shift the table back afterwards
+        candidates_[cellStart_[static_cast<size_t>(y) * columns_ + x]++] = candidate;
+    }
+    for (size_t i = cellCount; i > 0; i--) {
+        cellStart_[i] = cellStart_[i - 1];
+    }
+    cellStart_[0] = 0;
+}
+
+void FocusManager::collect(UIComponent& node, float& extentSum) {
+    if (!node.isVisible()) {
+        return;
+    }
+    
+    if (node.hasCapability(UICapabilities::FOCUSABLE) && node.isEnabled()) {
+        const glm::vec2 size = node.getSize();
+        scratch_.push_back(Candidate{node.getPosition() + size * 0.5f, &node});
+        extentSum += std::max(size.x, size.y);
+    }
+    
+    for (size_t i = 0; i < node.getChildCount(); i++) {
+        collect(*node.getChild(i), extentSum);
+    }
+}
+
+void FocusManager::cellOf(const glm::vec2& point, int& x, int& y) const {
+    const glm::vec2 cell = (point - gridOrigin_) / cellSize_;
+    x = static_cast<int>(std::floor(std::min(std::max(cell.x, -MAX_CELL_INDEX), MAX_CELL_INDEX)));
+    y = static_cast<int>(std::floor(std::min(std::max(cell.y, -MAX_CELL_INDEX), MAX_CELL_INDEX)));
+}
+
+void FocusManager::scanCell(int x, int y, const UIComponent& from, const glm::vec2& origin, const glm::vec2& axis,
+                            UIComponent*& best, float& bestScore) const {
+    const size_t cell = static_cast<size_t>(y) * columns_ + x;
+    for (uint32_t i = cellStart_[cell]; i < cellStart_[cell + 1]; i++) {
+        const Candidate& candidate = candidates_[i];
+        if (candidate.component == &from) {
+            continue;
+        }
+        
+        const glm::vec2 delta = candidate.center - origin;
+        const float advance = delta.x * axis.x + delta.y * axis.y;
+        if (advance < MIN_ADVANCE) {
+            continue;
+        }
+        
+        const float offset = std::abs(delta.x * axis.y - delta.y * axis.x);
+        const float score = advance + 2.0f * offset;
+        if (score < bestScore) {
+            bestScore = score;
+            best = candidate.component;
+        }
+    }
+}
+
+uint64_t FocusManager::neighborKey(const UIComponent& from, FocusDirection direction) {
+    return (static_cast<uint64_t>(from.getHandle().value) << 8) | static_cast<uint64_t>(direction);
+}
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "UIRegistry.h"
+#include "../core/FlatHashMap.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace voidengine {
+namespace ui {
+
+class UIComponent;
+
+enum class FocusDirection : uint8_t {
+    LEFT,
+    RIGHT,
+    UP,
+    DOWN,
+    COUNT
+};
+
+// Directional navigation between the FOCUSABLE components of a set of roots.
+// Candidates are bucketed by center into a uniform grid with cells about the
+// size of an average widget. A query walks rings of cells outward from the
+// current widget, only on the side it is moving toward, and stops as soon as
+// no unvisited cell can hold a better candidate, so it touches a handful of
+// cells whatever the widget count. The grid is rebuilt on the next query
+// after the registry's spatial version moves.
+//
+// A candidate must lie ahead of the current widget's center; among those the
+// lowest distance along the direction plus twice the sideways offset wins.
+class FocusManager {
+public:
+    // Candidates are visible, enabled descendants of these roots, which must
+    // outlive the manager
+    explicit FocusManager(const std::vector<std::shared_ptr<UIComponent>>& roots);
+    
+    // Replaces the search from one widget in one direction. A null target
+    // blocks movement that way.
+    void setNeighbor(const UIComponent& from, FocusDirection direction, const UIComponent* to);
+    void clearNeighbor(const UIComponent& from, FocusDirection direction);
+    
+    // Null when nothing lies that way
+    UIComponent* findNeighbor(const UIComponent& from, FocusDirection direction);
+    // The top-left-most candidate, for when nothing has focus yet
+    UIComponent* findFirst();
+    
+    // For changes the registry cannot see, such as roots being added
+    void invalidate() { indexValid_ = false; }
+    
+    size_t getCandidateCount();
+    size_t getRebuildCount() const { return rebuildCount_; }
+
+private:
+    struct Candidate {
+        glm::vec2 center;
+        UIComponent* component;
+    };
+    
+    void refresh();
+    void collect(UIComponent& node, float& extentSum);
+    void cellOf(const glm::vec2& point, int& x, int& y) const;
+    void scanCell(int x, int y, const UIComponent& from, const glm::vec2& origin, const glm::vec2& axis,
+                  UIComponent*& best, float& bestScore) const;
+    
+    static uint64_t neighborKey(const UIComponent& from, FocusDirection direction);
+    
+    const std::vector<std::shared_ptr<UIComponent>>& roots_;
+    UIRegistry* registry_;
+    
+    bool indexValid_ = false;
+    uint32_t indexedVersion_ = 0;
+    size_t rebuildCount_ = 0;
+    
+    // Sorted by cell; the candidates of cell i are [cellStart_[i], cellStart_[i + 1])
+    std::vector<Candidate> candidates_;
+    std::vector<Candidate> scratch_;
+    std::vector<uint32_t> cellStart_;
+    glm::vec2 gridOrigin_ = glm::vec2(0.0f);
+    float cellSize_ = 1.0f;
+    int columns_ = 0;
+    int rows_ = 0;
+    UIComponent* first_ = nullptr;
+    
+    // An invalid handle blocks movement
+    core::FlatHashMap<uint64_t, UIHandle> neighbors_;
+};
+
+} // namespace ui
+} // namespace voidengine
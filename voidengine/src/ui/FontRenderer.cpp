@@ -1,5 +1,8 @@
 #include "FontRenderer.h"
+#include "DrawList.h"
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 
 namespace voidengine {
 namespace ui {
@@ -17,6 +20,12 @@ void shutdownFontSystem() {
     gFontRenderer.reset();
 }
 
+core::StringId makeFontKey(const std::string& fontPath, unsigned int pixelSize) {
+    const size_t slash = fontPath.find_last_of("/\\");
+    const std::string name = slash == std::string::npos ? fontPath : fontPath.substr(slash + 1);
+    return core::hashString(name + "@" + std::to_string(pixelSize));
+}
+
 FontRenderer::FontRenderer() 
     : isInitialized(false), fontLoaded(false) {
 }
@@ -59,6 +68,7 @@ bool FontRenderer::loadFont(const std::string& fontPath, unsigned int fontSize)
         
         FT_Done_Face(face);
         fontLoaded = false;
+        fontKey = 0;
     }
     
     if (FT_New_Face(ft, fontPath.c_str(), 0, &face)) {
@@ -93,6 +103,7 @@ bool FontRenderer::loadFont(const std::string& fontPath, unsigned int fontSize)
     }
     
     fontLoaded = true;
+    fontKey = makeFontKey(fontPath, fontSize);
     return true;
 }
 
@@ -137,61 +148,93 @@ unsigned int FontRenderer::createTexture(unsigned char* data, unsigned int width
 }
 
 void FontRenderer::renderText(const std::string& text, float x, float y, float scale, const glm::vec4& color) {
-    if (!fontLoaded) {
-        return;
-    }
-    
-    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_TEXTURE_BIT);
-    
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    glEnable(GL_TEXTURE_2D);
-    
-    glColor4f(color.r, color.g, color.b, color.a);
-    
+    renderText(text.data(), text.size(), x, y, scale, color);
+}
+
+template <typename Fn>
+void FontRenderer::forEachGlyph(const char* text, size_t length, float x, float y, float scale, Fn&& fn) {
     float xpos = x;
     float ypos = y + (face->size->metrics.height >> 6) * scale * 0.75f;
     
-    for (char c : text) {
+    for (size_t i = 0; i < length; i++) {
+        char c = text[i];
         if (c == '\n') {
             xpos = x;
             ypos += (face->size->metrics.height >> 6) * scale;
             continue;
         }
         
-        if (characters.find(c) == characters.end()) {
+        auto it = characters.find(c);
+        if (it == characters.end()) {
             continue;
         }
         
-        Character ch = characters[c];
-        
-        float x0 = xpos + ch.bearing.x * scale;
-        float y0 = ypos - ch.bearing.y * scale;
-        float w = ch.size.x * scale;
-        float h = ch.size.y * scale;
-        
+        const Character& ch = it->second;
         if (ch.size.x > 0 && ch.size.y > 0) {
-            glBindTexture(GL_TEXTURE_2D, ch.textureID);
-            
-            glBegin(GL_QUADS);
-            
-            glTexCoord2f(0.0f, 0.0f); glVertex2f(x0, y0);
-            glTexCoord2f(1.0f, 0.0f); glVertex2f(x0 + w, y0);
-            glTexCoord2f(1.0f, 1.0f); glVertex2f(x0 + w, y0 + h);
-            glTexCoord2f(0.0f, 1.0f); glVertex2f(x0, y0 + h);
-            
-            glEnd();
+            fn(ch, xpos + ch.bearing.x * scale, ypos - ch.bearing.y * scale, ch.size.x * scale, ch.size.y * scale);
         }
         
         xpos += (ch.advance >> 6) * scale;
     }
+}
+
+void FontRenderer::renderText(const char* text, size_t length, float x, float y, float scale, const glm::vec4& color) {
+    if (!fontLoaded) {
+        return;
+    }
+    
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_TEXTURE_BIT);
+    
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    
+    glEnable(GL_TEXTURE_2D);
+    
+    glColor4f(color.r, color.g, color.b, color.a);
+    
+    forEachGlyph(text, length, x, y, scale, [](const Character& ch, float x0, float y0, float w, float h) {
+        glBindTexture(GL_TEXTURE_2D, ch.textureID);
+        
+        glBegin(GL_QUADS);
+        
+        glTexCoord2f(0.0f, 0.0f); glVertex2f(x0, y0);
+        glTexCoord2f(1.0f, 0.0f); glVertex2f(x0 + w, y0);
+        glTexCoord2f(1.0f, 1.0f); glVertex2f(x0 + w, y0 + h);
+        glTexCoord2f(0.0f, 1.0f); glVertex2f(x0, y0 + h);
+        
+        glEnd();
+    });
     
     glPopAttrib();
 }
 
+void FontRenderer::appendText(DrawList& list, const char* text, size_t length, float x, float y,
+                              float scale, const glm::vec4& color) {
+    if (!fontLoaded) {
+        return;
+    }
+    
+    forEachGlyph(text, length, x, y, scale, [&](const Character& ch, float x0, float y0, float w, float h) {
+        list.addTexturedRect(glm::vec2(x0, y0), glm::vec2(w, h), ch.textureID, color);
+    });
+}
+
+void FontRenderer::layoutText(const char* text, size_t length, float scale, std::vector<GlyphQuad>& glyphs) {
+    if (!fontLoaded) {
+        return;
+    }
+    
+    forEachGlyph(text, length, 0.0f, 0.0f, scale, [&](const Character& ch, float x0, float y0, float w, float h) {
+        glyphs.push_back(GlyphQuad{glm::vec2(x0, y0), glm::vec2(w, h), ch.textureID});
+    });
+}
+
 glm::vec2 FontRenderer::getTextDimensions(const std::string& text, float scale) {
-    if (!fontLoaded || text.empty()) {
+    return getTextDimensions(text.data(), text.size(), scale);
+}
+
+glm::vec2 FontRenderer::getTextDimensions(const char* text, size_t length, float scale) {
+    if (!fontLoaded || length == 0) {
         return glm::vec2(0.0f);
     }
     
@@ -200,7 +243,8 @@ glm::vec2 FontRenderer::getTextDimensions(const std::string& text, float scale)
     float height = (face->size->metrics.height >> 6) * scale;
     int numLines = 1;
     
-    for (char c : text) {
+    for (size_t i = 0; i < length; i++) {
+        char c = text[i];
         if (c == '\n') {
             maxWidth = std::max(maxWidth, width);
             width = 0.0f;
@@ -223,5 +267,52 @@ glm::vec2 FontRenderer::getTextDimensions(const std::string& text, float scale)
     return glm::vec2(maxWidth, totalHeight);
 }
 
+FontMetrics::FontMetrics(const std::string& fontPath, unsigned int pixelSize)
+    : fontKey_(makeFontKey(fontPath, pixelSize)) {
+    FT_Library library;
+    if (FT_Init_FreeType(&library)) {
+        throw std::runtime_error("Could not initialize FreeType");
+    }
+    FT_Face metricsFace;
+    if (FT_New_Face(library, fontPath.c_str(), 0, &metricsFace)) {
+        FT_Done_FreeType(library);
+        throw std::runtime_error("Failed to load font at " + fontPath);
+    }
+    
+    FT_Set_Pixel_Sizes(metricsFace, 0, pixelSize);
+    lineHeight_ = static_cast<float>(metricsFace->size->metrics.height >> 6);
+    std::fill(advances_, advances_ + 128, -1L);
+    for (unsigned char c = 32; c < 128; c++) {
+        if (FT_Load_Char(metricsFace, c, FT_LOAD_DEFAULT) == 0) {
+            advances_[c] = metricsFace->glyph->advance.x;
+        }
+    }
+    
+    FT_Done_Face(metricsFace);
+    FT_Done_FreeType(library);
+}
+
+glm::vec2 FontMetrics::measure(const char* text, size_t length) const {
+    if (length == 0) {
+        return glm::vec2(0.0f);
+    }
+    
+    float maxWidth = 0.0f;
+    float width = 0.0f;
+    int numLines = 1;
+    for (size_t i = 0; i < length; i++) {
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c == '\n') {
+            maxWidth = std::max(maxWidth, width);
+            width = 0.0f;
+            numLines++;
+        } else if (c < 128 && advances_[c] >= 0) {
+            width += static_cast<float>(advances_[c] >> 6);
+        }
+    }
+    
+    return glm::vec2(std::max(maxWidth, width), lineHeight_ * numLines);
+}
+
 } // namespace ui
 } // namespace voidengine 
\ No newline at end of file
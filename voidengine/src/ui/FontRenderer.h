@@ -1,5 +1,7 @@
 #pragma once
 
+#include "TextLayout.h"
+#include "../core/StringId.h"
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include <GLFW/glfw3.h>
@@ -12,6 +14,12 @@
 namespace voidengine {
 namespace ui {
 
+class DrawList;
+
+// Identifies a font file loaded at a pixel size, by file name so baked data
+// survives moving the file
+core::StringId makeFontKey(const std::string& fontPath, unsigned int pixelSize);
+
 struct Character {
     unsigned int textureID;
     glm::ivec2 size;
@@ -23,15 +31,28 @@ class FontRenderer {
 public:
     FontRenderer();
     ~FontRenderer();
-
+    
     bool initialize();
-
+    
     bool loadFont(const std::string& fontPath, unsigned int fontSize);
-
+    
     void renderText(const std::string& text, float x, float y, 
                    float scale, const glm::vec4& color);
-
+    void renderText(const char* text, size_t length, float x, float y,
+                   float scale, const glm::vec4& color);
+    // Records the glyph quads instead of drawing them
+    void appendText(DrawList& list, const char* text, size_t length, float x, float y,
+                    float scale, const glm::vec4& color);
+    
+    // Glyph quads relative to the text's top-left corner
+    void layoutText(const char* text, size_t length, float scale, std::vector<GlyphQuad>& glyphs);
+    
     glm::vec2 getTextDimensions(const std::string& text, float scale);
+    glm::vec2 getTextDimensions(const char* text, size_t length, float scale);
+    
+    bool isFontLoaded() const { return fontLoaded; }
+    // makeFontKey() of the loaded font; zero when none is loaded
+    core::StringId getFontKey() const { return fontKey; }
 
 private:
     FT_Library ft;
@@ -39,10 +60,33 @@ private:
     std::map<char, Character> characters;
     bool isInitialized;
     bool fontLoaded;
+    core::StringId fontKey = 0;
+    
+    // Calls fn(character, x, y, width, height) for each visible glyph quad
+    template <typename Fn>
+    void forEachGlyph(const char* text, size_t length, float x, float y, float scale, Fn&& fn);
     
     unsigned int createTexture(unsigned char* data, unsigned int width, unsigned int height);
 };
 
+// Measures text as FontRenderer::getTextDimensions does at scale 1, with
+// FreeType alone, so tools can bake metrics without a GL context
+class FontMetrics {
+public:
+    // Throws std::runtime_error when the font cannot be loaded
+    FontMetrics(const std::string& fontPath, unsigned int pixelSize);
+    
+    glm::vec2 measure(const char* text, size_t length) const;
+    core::StringId getFontKey() const { return fontKey_; }
+    
+private:
+    // Advances in 26.6 fixed point of the printable ASCII glyphs FontRenderer
+    // loads; negative for glyphs that failed to load
+    long advances_[128];
+    float lineHeight_ = 0.0f;
+    core::StringId fontKey_;
+};
+
 extern std::unique_ptr<FontRenderer> gFontRenderer;
 
 bool initializeFontSystem();
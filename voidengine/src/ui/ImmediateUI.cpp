@@ -0,0 +1,405 @@
+#include "ImmediateUI.h"
+#include "UIRenderer.h"
+#include <algorithm>
+#include <cstdarg>
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+constexpr float FONT_SIZE = 14.0f;
+constexpr float ROW_HEIGHT = 22.0f;
+constexpr float TITLE_HEIGHT = 22.0f;
+constexpr float PADDING = 6.0f;
+constexpr float SPACING = 4.0f;
+constexpr float BUTTON_PADDING = 8.0f;
+const glm::vec2 ORIGIN(8.0f, 8.0f);
+
+// Frames a widget may go unsubmitted before its state is dropped
+constexpr uint32_t STATE_LIFETIME = 120;
+constexpr uint32_t COLLECT_INTERVAL = 60;
+
+const glm::vec4 WINDOW_COLOR(0.1f, 0.1f, 0.12f, 0.9f);
+const glm::vec4 TITLE_COLOR(0.25f, 0.25f, 0.4f, 1.0f);
+const glm::vec4 TEXT_COLOR(1.0f, 1.0f, 1.0f, 1.0f);
+const glm::vec4 OUTLINE_COLOR(0.0f, 0.0f, 0.0f, 0.5f);
+const glm::vec4 WIDGET_COLOR(0.3f, 0.3f, 0.8f, 1.0f);
+const glm::vec4 WIDGET_HOVER_COLOR(0.4f, 0.4f, 0.9f, 1.0f);
+const glm::vec4 WIDGET_ACTIVE_COLOR(0.2f, 0.2f, 0.7f, 1.0f);
+const glm::vec4 TRACK_COLOR(0.2f, 0.2f, 0.25f, 1.0f);
+
+const glm::vec4& widgetColor(bool active, bool hovered) {
+    return active ? WIDGET_ACTIVE_COLOR : (hovered ? WIDGET_HOVER_COLOR : WIDGET_COLOR);
+}
+
+} // namespace
+
+ImmediateUI::ImmediateUI()
+    : cursor_(ORIGIN), indentX_(ORIGIN.x) {
+    idStack_.push_back(core::hashString(""));
+}
+
+void ImmediateUI::setMousePosition(const glm::vec2& position) {
+    mousePosition_ = position;
+}
+
+void ImmediateUI::setMouseButton(bool down) {
+    // Edges are latched until endFrame, so a press and release inside one
+    // frame still register as a click
+    if (down && !mouseDown_) {
+        mousePressed_ = true;
+    } else if (!down && mouseDown_) {
+        mouseReleased_ = true;
+    }
+    mouseDown_ = down;
+}
+
+bool ImmediateUI::wantsMouse(const glm::vec2& point) const {
+    if (activeId_ != 0) {
+        return true;
+    }
+    
+    for (const glm::vec4& rect : windowRects_) {
+        if (point.x >= rect.x && point.x <= rect.x + rect.z &&
+            point.y >= rect.y && point.y <= rect.y + rect.w) {
+            return true;
+        }
+    }
+    return false;
+}
+
+core::StringId ImmediateUI::makeId(std::string_view label) const {
+    return core::hashString(label.data(), label.size(), idStack_.back());
+}
+
+ImmediateUI::WidgetState& ImmediateUI::touchState(core::StringId id) {
+    WidgetState& state = states_[id];
+    if (state.lastFrame == frame_) {
+        duplicateCount_++;
+    }
+    state.lastFrame = frame_;
+    widgetCount_++;
+    return state;
+}
+
+void ImmediateUI::pushId(std::string_view id) {
+    // The separator keeps "a" then "b" apart from a widget labelled "ab"
+    idStack_.push_back(core::hashString("/", 1, makeId(id)));
+}
+
+void ImmediateUI::pushId(int id) {
+    char bytes[sizeof(int)];
+    for (size_t i = 0; i < sizeof(int); i++) {
+        bytes[i] = static_cast<char>((static_cast<unsigned int>(id) >> (i * 8)) & 0xFF);
+    }
+    idStack_.push_back(core::hashString("/", 1, core::hashString(bytes, sizeof(bytes), idStack_.back())));
+}
+
+void ImmediateUI::popId() {
+    if (idStack_.size() > 1) {
+        idStack_.pop_back();
+    }
+}
+
+bool ImmediateUI::beginWindow(std::string_view title, const glm::vec2& initialPosition, float width) {
+    core::StringId id = makeId(title);
+    bool isNew = !states_.contains(id);
+    WidgetState& state = touchState(id);
+    if (isNew) {
+        state.position = initialPosition;
+    }
+    
+    // Title bar: drag to move, the box on the right toggles collapse
+    glm::vec2 togglePosition(state.position.x + width - TITLE_HEIGHT, state.position.y);
+    glm::vec2 toggleSize(TITLE_HEIGHT, TITLE_HEIGHT);
+    core::StringId toggleId = core::hashString("#collapse", 9, id);
+    bool toggleHovered = false;
+    if (buttonBehavior(toggleId, togglePosition, toggleSize, toggleHovered)) {
+        state.collapsed = !state.collapsed;
+    }
+    
+    glm::vec2 titleSize(width - TITLE_HEIGHT, TITLE_HEIGHT);
+    if (activeId_ == 0 && mousePressed_ && isHovered(state.position, titleSize)) {
+        activeId_ = id;
+        dragOrigin_ = mousePosition_ - state.position;
+    }
+    if (activeId_ == id && mouseDown_) {
+        state.position = mousePosition_ - dragOrigin_;
+        togglePosition = glm::vec2(state.position.x + width - TITLE_HEIGHT, state.position.y);
+    }
+    
+    size_t backgroundCommand = commands_.size();
+    addRect(state.position, glm::vec2(width, TITLE_HEIGHT), WINDOW_COLOR);
+    addRect(state.position, glm::vec2(width, TITLE_HEIGHT), TITLE_COLOR);
+    
+    std::string_view titleText = displayText(title);
+    float textY = state.position.y + (TITLE_HEIGHT - FONT_SIZE) * 0.5f;
+    addText(glm::vec2(state.position.x + PADDING, textY), textArena_.copy(titleText), TEXT_COLOR);
+    addText(glm::vec2(togglePosition.x + PADDING, textY), textArena_.copy(state.collapsed ? "+" : "-"),
+            toggleHovered ? WIDGET_HOVER_COLOR : TEXT_COLOR);
+    
+    if (state.collapsed) {
+        nextWindowRects_.push_back(glm::vec4(state.position.x, state.position.y, width, TITLE_HEIGHT));
+        return false;
+    }
+    
+    windowStack_.push_back(WindowFrame{backgroundCommand, state.position, width, cursor_, indentX_});
+    idStack_.push_back(core::hashString("/", 1, id));
+    
+    cursor_ = state.position + glm::vec2(PADDING, TITLE_HEIGHT + PADDING);
+    indentX_ = cursor_.x;
+    sameLine_ = false;
+    return true;
+}
+
+void ImmediateUI::endWindow() {
+    if (windowStack_.empty()) {
+        return;
+    }
+    
+    WindowFrame frame = windowStack_.back();
+    windowStack_.pop_back();
+    popId();
+    
+    float height = std::max(cursor_.y - SPACING + PADDING - frame.position.y, TITLE_HEIGHT);
+    commands_[frame.backgroundCommand].size = glm::vec2(frame.width, height);
+    commands_.insert(commands_.begin() + static_cast<std::ptrdiff_t>(frame.backgroundCommand) + 1,
+                     DrawCommand{CommandType::RECT_OUTLINE, frame.position, glm::vec2(frame.width, height),
+                                 OUTLINE_COLOR, nullptr, 0});
+    nextWindowRects_.push_back(glm::vec4(frame.position.x, frame.position.y, frame.width, height));
+    
+    cursor_ = frame.savedCursor;
+    indentX_ = frame.savedIndent;
+    sameLine_ = false;
+}
+
+float ImmediateUI::contentWidth() const {
+    return windowStack_.empty() ? 200.0f : windowStack_.back().width - 2.0f * PADDING;
+}
+
+glm::vec2 ImmediateUI::placeWidget(const glm::vec2& size) {
+    glm::vec2 position;
+    if (sameLine_) {
+        position = glm::vec2(lastWidgetRight_ + SPACING, lineY_);
+        lineHeight_ = std::max(lineHeight_, size.y);
+    } else {
+        position = cursor_;
+        lineY_ = cursor_.y;
+        lineHeight_ = size.y;
+    }
+    
+    sameLine_ = false;
+    lastWidgetRight_ = position.x + size.x;
+    cursor_ = glm::vec2(indentX_, lineY_ + lineHeight_ + SPACING);
+    return position;
+}
+
+bool ImmediateUI::isHovered(const glm::vec2& position, const glm::vec2& size) const {
+    return mousePosition_.x >= position.x && mousePosition_.x < position.x + size.x &&
+           mousePosition_.y >= position.y && mousePosition_.y < position.y + size.y;
+}
+
+bool ImmediateUI::buttonBehavior(core::StringId id, const glm::vec2& position, const glm::vec2& size, bool& hovered) {
+    bool inside = isHovered(position, size);
+    hovered = inside && (activeId_ == 0 || activeId_ == id);
+    
+    if (hovered && mousePressed_ && activeId_ == 0) {
+        activeId_ = id;
+    }
+    
+    // Clicks complete on release over the widget that took the press
+    return activeId_ == id && mouseReleased_ && inside;
+}
+
+void ImmediateUI::label(std::string_view text) {
+    addLabel(textArena_.copy(text));
+}
+
+void ImmediateUI::text(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    std::string_view formatted = textArena_.formatV(format, args);
+    va_end(args);
+    
+    addLabel(formatted);
+}
+
+void ImmediateUI::addLabel(std::string_view text) {
+    glm::vec2 measured = measureText(text.data(), text.size(), FONT_SIZE);
+    glm::vec2 size(measured.x, std::max(ROW_HEIGHT, measured.y));
+    glm::vec2 position = placeWidget(size);
+    
+    addText(glm::vec2(position.x, position.y + (ROW_HEIGHT - FONT_SIZE) * 0.5f), text, TEXT_COLOR);
+}
+
+bool ImmediateUI::button(std::string_view label) {
+    core::StringId id = makeId(label);
+    touchState(id);
+    
+    std::string_view shown = textArena_.copy(displayText(label));
+    glm::vec2 measured = measureText(shown.data(), shown.size(), FONT_SIZE);
+    glm::vec2 size(measured.x + 2.0f * BUTTON_PADDING, ROW_HEIGHT);
+    glm::vec2 position = placeWidget(size);
+    
+    bool hovered = false;
+    bool clicked = buttonBehavior(id, position, size, hovered);
+    
+    addRect(position, size, widgetColor(activeId_ == id && hovered, hovered));
+    addOutline(position, size, OUTLINE_COLOR);
+    addText(glm::vec2(position.x + BUTTON_PADDING, position.y + (ROW_HEIGHT - FONT_SIZE) * 0.5f),
+            shown, TEXT_COLOR);
+    return clicked;
+}
+
+bool ImmediateUI::checkbox(std::string_view label, bool& value) {
+    core::StringId id = makeId(label);
+    touchState(id);
+    
+    std::string_view shown = textArena_.copy(displayText(label));
+    float boxSize = ROW_HEIGHT - 6.0f;
+    glm::vec2 measured = measureText(shown.data(), shown.size(), FONT_SIZE);
+    glm::vec2 size(boxSize + SPACING + measured.x, ROW_HEIGHT);
+    glm::vec2 position = placeWidget(size);
+    
+    bool hovered = false;
+    bool toggled = buttonBehavior(id, position, size, hovered);
+    if (toggled) {
+        value = !value;
+    }
+    
+    glm::vec2 boxPosition(position.x, position.y + 3.0f);
+    addRect(boxPosition, glm::vec2(boxSize), hovered ? WIDGET_HOVER_COLOR : TRACK_COLOR);
+    addOutline(boxPosition, glm::vec2(boxSize), OUTLINE_COLOR);
+    if (value) {
+        addRect(boxPosition + glm::vec2(4.0f), glm::vec2(boxSize - 8.0f), TEXT_COLOR);
+    }
+    addText(glm::vec2(position.x + boxSize + SPACING, position.y + (ROW_HEIGHT - FONT_SIZE) * 0.5f),
+            shown, TEXT_COLOR);
+    return toggled;
+}
+
+bool ImmediateUI::slider(std::string_view label, float& value, float minValue, float maxValue) {
+    core::StringId id = makeId(label);
+    touchState(id);
+    
+    glm::vec2 size(contentWidth(), ROW_HEIGHT);
+    glm::vec2 position = placeWidget(size);
+    
+    bool hovered = false;
+    buttonBehavior(id, position, size, hovered);
+    
+    bool changed = false;
+    if (activeId_ == id && mouseDown_ && maxValue > minValue) {
+        float t = std::min(std::max((mousePosition_.x - position.x) / size.x, 0.0f), 1.0f);
+        float dragged = minValue + t * (maxValue - minValue);
+        if (dragged != value) {
+            value = dragged;
+            changed = true;
+        }
+    }
+    
+    float range = maxValue - minValue;
+    float fill = range > 0.0f ? std::min(std::max((value - minValue) / range, 0.0f), 1.0f) : 0.0f;
+    
+    addRect(position, size, TRACK_COLOR);
+    addRect(position, glm::vec2(size.x * fill, size.y), widgetColor(activeId_ == id, hovered));
+    addOutline(position, size, OUTLINE_COLOR);
+    
+    std::string_view shown = displayText(label);
+    std::string_view valueText = textArena_.format("%.*s: %.2f", static_cast<int>(shown.size()), shown.data(), value);
+    addText(glm::vec2(position.x + BUTTON_PADDING, position.y + (ROW_HEIGHT - FONT_SIZE) * 0.5f),
+            valueText, TEXT_COLOR);
+    return changed;
+}
+
+void ImmediateUI::separator() {
+    glm::vec2 position = placeWidget(glm::vec2(contentWidth(), SPACING + 1.0f));
+    addRect(glm::vec2(position.x, position.y + SPACING * 0.5f), glm::vec2(contentWidth(), 1.0f), OUTLINE_COLOR);
+}
+
+void ImmediateUI::sameLine() {
+    sameLine_ = true;
+}
+
+void ImmediateUI::render() {
+    for (const DrawCommand& command : commands_) {
+        switch (command.type) {
+            case CommandType::RECT:
+                drawRect(command.position, command.size, command.color);
+                break;
+            case CommandType::RECT_OUTLINE:
+                drawRectOutline(command.position, command.size, command.color);
+                break;
+            case CommandType::TEXT:
+                drawText(command.text, command.textLength, command.position, FONT_SIZE, command.color);
+                break;
+        }
+    }
+}
+
+void ImmediateUI::endFrame() {
+    while (!windowStack_.empty()) {
+        endWindow();
+    }
+    
+    stats_.commands = commands_.size();
+    stats_.widgets = widgetCount_;
+    stats_.duplicateIds = duplicateCount_;
+    stats_.stateEntries = states_.size();
+    
+    if (frame_ % COLLECT_INTERVAL == 0) {
+        staleIds_.clear();
+        uint32_t frame = frame_;
+        states_.forEach([this, frame](core::StringId id, const WidgetState& state) {
+            if (frame - state.lastFrame > STATE_LIFETIME) {
+                staleIds_.push_back(id);
+            }
+        });
+        for (core::StringId id : staleIds_) {
+            states_.erase(id);
+        }
+    }
+    
+    windowRects_.swap(nextWindowRects_);
+    nextWindowRects_.clear();
+    commands_.clear();
+    textArena_.reset();
+    idStack_.resize(1);
+    
+    if (!mouseDown_) {
+        activeId_ = 0;
+    }
+    mousePressed_ = false;
+    mouseReleased_ = false;
+    
+    cursor_ = ORIGIN;
+    indentX_ = ORIGIN.x;
+    sameLine_ = false;
+    widgetCount_ = 0;
+    duplicateCount_ = 0;
+    frame_++;
+}
+
+void ImmediateUI::addRect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) {
+    commands_.push_back(DrawCommand{CommandType::RECT, position, size, color, nullptr, 0});
+}
+
+void ImmediateUI::addOutline(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) {
+    commands_.push_back(DrawCommand{CommandType::RECT_OUTLINE, position, size, color, nullptr, 0});
+}
+
+void ImmediateUI::addText(const glm::vec2& position, std::string_view text, const glm::vec4& color) {
+    if (!text.empty()) {
+        commands_.push_back(DrawCommand{CommandType::TEXT, position, glm::vec2(0.0f), color,
+                                        text.data(), static_cast<uint32_t>(text.size())});
+    }
+}
+
+std::string_view ImmediateUI::displayText(std::string_view label) {
+    size_t hidden = label.find("##");
+    return hidden == std::string_view::npos ? label : label.substr(0, hidden);
+}
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "../core/FlatHashMap.h"
+#include "../core/FrameArena.h"
+#include "../core/StringId.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace voidengine {
+namespace ui {
+
+struct ImmediateStats {
+    size_t commands = 0;
+    size_t widgets = 0;
+    size_t stateEntries = 0;
+    size_t duplicateIds = 0;
+};
+
+// Immediate-mode widgets for overlays that change every frame:
+//
+//     if (ui.beginWindow("Debug", glm::vec2(10, 10))) {
+//         ui.text("fps %.1f", fps);
+//         if (ui.button("Reload")) { ... }
+//         ui.endWindow();
+//     }
+//
+// Calls made between two UIManager::render() calls build the next frame.
+// A widget's identity is its label hashed into the current id stack, so the
+// same label in different windows or pushId() scopes stays distinct; text
+// after "##" is part of the id but not displayed. Per-widget state persists
+// in a hash table keyed by that id and is dropped after a widget has not been
+// submitted for a while. Output is a command list of rects and text replayed
+// through the same primitives as the retained widgets, after them. All
+// buffers keep their capacity, so a frame that submits the same widgets as
+// the previous one performs no allocation. Main thread only.
+class ImmediateUI {
+public:
+    ImmediateUI();
+    
+    // Input, fed by UIManager
+    void setMousePosition(const glm::vec2& position);
+    void setMouseButton(bool down);
+    
+    // True when the pointer is over an immediate window or a widget is being
+    // dragged, i.e. when the overlay should swallow the click
+    bool wantsMouse(const glm::vec2& point) const;
+    
+    bool beginWindow(std::string_view title, const glm::vec2& initialPosition, float width = 240.0f);
+    void endWindow();
+    
+    void pushId(std::string_view id);
+    void pushId(int id);
+    void popId();
+    
+    void label(std::string_view text);
+    void text(const char* format, ...);
+    bool button(std::string_view label);
+    bool checkbox(std::string_view label, bool& value);
+    bool slider(std::string_view label, float& value, float minValue, float maxValue);
+    void separator();
+    // Places the next widget to the right of the previous one
+    void sameLine();
+    
+    void render();
+    // Resets the command buffers and input edges for the next frame
+    void endFrame();
+    
+    const ImmediateStats& getStats() const { return stats_; }
+    
+private:
+    enum class CommandType : uint8_t {
+        RECT,
+        RECT_OUTLINE,
+        TEXT
+    };
+    
+    struct DrawCommand {
+        CommandType type;
+        glm::vec2 position;
+        glm::vec2 size;
+        glm::vec4 color;
+        const char* text;
+        uint32_t textLength;
+    };
+    
+    struct WidgetState {
+        uint32_t lastFrame = 0;
+        glm::vec2 position = glm::vec2(0.0f);
+        bool collapsed = false;
+    };
+    
+    struct WindowFrame {
+        size_t backgroundCommand;
+        glm::vec2 position;
+        float width;
+        glm::vec2 savedCursor;
+        float savedIndent;
+    };
+    
+    core::StringId makeId(std::string_view label) const;
+    WidgetState& touchState(core::StringId id);
+    
+    // Reserves the next widget rect and advances the layout cursor
+    glm::vec2 placeWidget(const glm::vec2& size);
+    bool isHovered(const glm::vec2& position, const glm::vec2& size) const;
+    bool buttonBehavior(core::StringId id, const glm::vec2& position, const glm::vec2& size, bool& hovered);
+    
+    float contentWidth() const;
+    
+    void addRect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+    void addOutline(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+    // Text must already live in textArena_
+    void addText(const glm::vec2& position, std::string_view text, const glm::vec4& color);
+    void addLabel(std::string_view text);
+    
+    static std::string_view displayText(std::string_view label);
+    
+    std::vector<DrawCommand> commands_;
+    core::FrameArena textArena_;
+    std::vector<core::StringId> idStack_;
+    std::vector<WindowFrame> windowStack_;
+    std::vector<core::StringId> staleIds_;
+    
+    core::FlatHashMap<core::StringId, WidgetState> states_;
+    
+    // Window rects from the previous frame, for wantsMouse()
+    std::vector<glm::vec4> windowRects_;
+    std::vector<glm::vec4> nextWindowRects_;
+    
+    glm::vec2 mousePosition_ = glm::vec2(0.0f);
+    glm::vec2 dragOrigin_ = glm::vec2(0.0f);
+    bool mouseDown_ = false;
+    bool mousePressed_ = false;
+    bool mouseReleased_ = false;
+    
+    core::StringId activeId_ = 0;
+    
+    glm::vec2 cursor_;
+    float indentX_;
+    float lineY_ = 0.0f;
+    float lineHeight_ = 0.0f;
+    float lastWidgetRight_ = 0.0f;
+    bool sameLine_ = false;
+    
+    uint32_t frame_ = 1;
+    size_t widgetCount_ = 0;
+    size_t duplicateCount_ = 0;
+    ImmediateStats stats_;
+};
+
+} // namespace ui
+} // namespace voidengine
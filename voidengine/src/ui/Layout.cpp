@@ -0,0 +1,416 @@
+#include "Layout.h"
+#include "UIComponent.h"
+#include <algorithm>
+#include <vector>
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+float mainAxis(const glm::vec2& value, bool row) {
+    return row ? value.x : value.y;
+}
+
+float crossAxis(const glm::vec2& value, bool row) {
+    return row ? value.y : value.x;
+}
+
+glm::vec2 fromAxes(float main, float cross, bool row) {
+    return row ? glm::vec2(main, cross) : glm::vec2(cross, main);
+}
+
+glm::vec2 clampSize(const glm::vec2& size, const LayoutParams& params) {
+    return glm::vec2(std::min(std::max(size.x, params.minSize.x), params.maxSize.x),
+                     std::min(std::max(size.y, params.minSize.y), params.maxSize.y));
+}
+
+class LayoutPass {
+public:
+    explicit LayoutPass(UIRegistry& registry) : registry_(registry) {}
+    
+    glm::vec2 measure(UIComponent& node) {
+        UIHandle handle = node.getHandle();
+        uint8_t flags = registry_.flags(handle);
+        if (!(flags & UIFlags::LAYOUT_DIRTY)) {
+            return registry_.layoutState(handle).measuredSize;
+        }
+        
+        const LayoutParams& params = registry_.layoutParams(handle);
+        LayoutState& state = registry_.layoutState(handle);
+        const bool full = (flags & UIFlags::LAYOUT_STRUCTURE) != 0;
+        size_t childCount = node.getChildCount();
+        glm::vec2 content(0.0f);
+        
+        if (params.direction == LayoutDirection::NONE) {
+            // Absolute children still need their own nested layouts measured
+            if (full) {
+                for (size_t i = 0; i < childCount; i++) {
+                    UIComponent* child = node.getChild(i);
+                    if (child->isVisible()) {
+                        measure(*child);
+                    }
+                }
+            } else {
+                for (size_t i = 0; i < state.dirtyChildren.size(); i++) {
+                    UIComponent* child = dirtyChild(node, state.dirtyChildren[i]);
+                    if (child && child->isVisible()) {
+                        measure(*child);
+                    }
+                }
+            }
+            content = node.measureContent();
+        } else {
+            bool row = params.direction == LayoutDirection::ROW;
+            if (full) {
+                state.childrenMain = 0.0;
+                state.childrenCross = 0.0f;
+                state.crossCount = 0;
+                state.visibleCount = 0;
+                state.totalGrow = 0.0;
+                state.growCount = 0;
+                for (size_t i = 0; i < childCount; i++) {
+                    UIComponent* child = node.getChild(i);
+                    LayoutState& childState = registry_.layoutState(child->getHandle());
+                    childState.counted = false;
+                    if (child->isVisible()) {
+                        measure(*child);
+                        count(state, *child, childState, row);
+                    }
+                }
+            } else {
+                // Take each changed child out of the sums and put it back with
+                // its new size
+                for (size_t i = 0; i < state.dirtyChildren.size(); i++) {
+                    UIComponent* child = dirtyChild(node, state.dirtyChildren[i]);
+                    if (!child) {
+                        continue;
+                    }
+                    LayoutState& childState = registry_.layoutState(child->getHandle());
+                    if (childState.counted) {
+                        uncount(state, childState, row);
+                    }
+                    if (child->isVisible()) {
+                        measure(*child);
+                        count(state, *child, childState, row);
+                    }
+                }
+                if (state.crossCount == 0) {
+                    rescanCross(node, state, row);
+                }
+            }
+            if (state.visibleCount == 0) {
+                state.childrenMain = 0.0;
+            }
+            if (state.growCount == 0) {
+                state.totalGrow = 0.0;
+            }
+            
+            float main = static_cast<float>(state.childrenMain);
+            if (state.visibleCount > 1) {
+                main += params.spacing * static_cast<float>(state.visibleCount - 1);
+            }
+            
+            content = fromAxes(main, state.childrenCross, row) +
+                      glm::vec2(params.padding.x + params.padding.z, params.padding.y + params.padding.w);
+        }
+        
+        if (params.preferredSize.x >= 0.0f) {
+            content.x = params.preferredSize.x;
+        }
+        if (params.preferredSize.y >= 0.0f) {
+            content.y = params.preferredSize.y;
+        }
+        
+        glm::vec2 measured = clampSize(content, params);
+        state.measuredSize = measured;
+        stats.measured++;
+        return measured;
+    }
+    
+    // Nodes that are not inside a stacking container keep their own position
+    void placeAbsolute(UIComponent& node) {
+        UIHandle handle = node.getHandle();
+        if (registry_.layoutParams(handle).direction != LayoutDirection::NONE) {
+            arrange(node, node.getPosition(), registry_.layoutState(handle).measuredSize);
+        } else if (registry_.flags(handle) & UIFlags::LAYOUT_DIRTY) {
+            layoutChildren(node, node.getPosition(), node.getSize());
+        }
+    }
+    
+    void arrange(UIComponent& node, const glm::vec2& position, const glm::vec2& size) {
+        UIHandle handle = node.getHandle();
+        LayoutState& state = registry_.layoutState(handle);
+        bool dirty = (registry_.flags(handle) & UIFlags::LAYOUT_DIRTY) != 0;
+        
+        if (!dirty && state.assignedPosition == position && state.assignedSize == size) {
+            return;
+        }
+        
+        const glm::vec2 oldPosition = node.getPosition();
+        const glm::vec2 oldSize = node.getSize();
+        state.assignedPosition = position;
+        state.assignedSize = size;
+        node.arrange(position, size);
+        stats.arranged++;
+        
+        layoutChildren(node, oldPosition, oldSize);
+    }
+    
+    LayoutStats stats;
+    
+private:
+    // A listed child that is still alive and still ours
+    UIComponent* dirtyChild(UIComponent& node, uint32_t value) {
+        UIHandle handle;
+        handle.value = value;
+        UIComponent* child = registry_.owner(handle);
+        return child && child->getParent() == &node ? child : nullptr;
+    }
+    
+    void count(LayoutState& state, UIComponent& child, LayoutState& childState, bool row) {
+        const float childCross = crossAxis(childState.measuredSize, row);
+        if (childCross > state.childrenCross) {
+            state.childrenCross = childCross;
+            state.crossCount = 1;
+        } else if (childCross == state.childrenCross) {
+            state.crossCount++;
+        }
+        state.childrenMain += mainAxis(childState.measuredSize, row);
+        state.visibleCount++;
+        
+        childState.countedGrow = registry_.layoutParams(child.getHandle()).flexGrow;
+        if (childState.countedGrow > 0.0f) {
+            state.totalGrow += childState.countedGrow;
+            state.growCount++;
+        }
+        childState.counted = true;
+    }
+    
+    // Uses the measured size the child was counted with, so it runs before
+    // the child is measured again
+    void uncount(LayoutState& state, LayoutState& childState, bool row) {
+        if (crossAxis(childState.measuredSize, row) >= state.childrenCross && state.crossCount > 0) {
+            state.crossCount--;
+        }
+        state.childrenMain -= mainAxis(childState.measuredSize, row);
+        state.visibleCount--;
+        if (childState.countedGrow > 0.0f) {
+            state.totalGrow -= childState.countedGrow;
+            state.growCount--;
+        }
+        childState.counted = false;
+    }
+    
+    // Only when every child at the largest cross size shrank or left
+    void rescanCross(UIComponent& node, LayoutState& state, bool row) {
+        state.childrenCross = 0.0f;
+        state.crossCount = 0;
+        size_t childCount = node.getChildCount();
+        for (size_t i = 0; i < childCount; i++) {
+            UIComponent* child = node.getChild(i);
+            const LayoutState& childState = registry_.layoutState(child->getHandle());
+            if (!childState.counted) {
+                continue;
+            }
+            const float childCross = crossAxis(childState.measuredSize, row);
+            if (childCross > state.childrenCross) {
+                state.childrenCross = childCross;
+                state.crossCount = 1;
+            } else if (childCross == state.childrenCross) {
+                state.crossCount++;
+            }
+        }
+    }
+    
+    // The old rect is the node's before this arrangement; children whose
+    // rects cannot depend on what changed in it are left alone
+    void layoutChildren(UIComponent& node, const glm::vec2& oldPosition, const glm::vec2& oldSize) {
+        UIHandle handle = node.getHandle();
+        registry_.flags(handle) &= static_cast<uint8_t>(~UIFlags::LAYOUT_DIRTY);
+        node.onLayout();
+        
+        // Read after onLayout, which may remap the children
+        uint8_t& flags = registry_.flags(handle);
+        const bool structure = (flags & UIFlags::LAYOUT_STRUCTURE) != 0;
+        flags &= static_cast<uint8_t>(~UIFlags::LAYOUT_STRUCTURE);
+        
+        const LayoutParams params = registry_.layoutParams(handle);
+        LayoutState& state = registry_.layoutState(handle);
+        std::vector<uint32_t>& dirty = state.dirtyChildren;
+        size_t childCount = node.getChildCount();
+        
+        if (params.direction == LayoutDirection::NONE) {
+            if (structure) {
+                dirty.clear();
+                for (size_t i = 0; i < childCount; i++) {
+                    UIComponent* child = node.getChild(i);
+                    registry_.flags(child->getHandle()) &= static_cast<uint8_t>(~UIFlags::LAYOUT_QUEUED);
+                    if (child->isVisible()) {
+                        placeAbsolute(*child);
+                    }
+                }
+                return;
+            }
+            // Children placed here may mark more; they wait for the next pass
+            const size_t listed = dirty.size();
+            for (size_t i = 0; i < listed; i++) {
+                UIComponent* child = dirtyChild(node, dirty[i]);
+                if (child) {
+                    registry_.flags(child->getHandle()) &= static_cast<uint8_t>(~UIFlags::LAYOUT_QUEUED);
+                    if (child->isVisible()) {
+                        placeAbsolute(*child);
+                    }
+                }
+            }
+            dirty.erase(dirty.begin(), dirty.begin() + listed);
+            return;
+        }
+        
+        bool row = params.direction == LayoutDirection::ROW;
+        glm::vec2 innerPosition = node.getPosition() + glm::vec2(params.padding.x, params.padding.y);
+        glm::vec2 innerSize = node.getSize() - glm::vec2(params.padding.x + params.padding.z,
+                                                         params.padding.y + params.padding.w);
+        float innerMain = mainAxis(innerSize, row);
+        float innerCross = crossAxis(innerSize, row);
+        
+        float usedMain = static_cast<float>(state.childrenMain);
+        if (state.visibleCount > 1) {
+            usedMain += params.spacing * static_cast<float>(state.visibleCount - 1);
+        }
+        const double totalGrow = state.totalGrow;
+        
+        float freeMain = innerMain - usedMain;
+        float start = 0.0f;
+        if (freeMain > 0.0f && totalGrow <= 0.0) {
+            if (params.mainAlign == LayoutAlign::CENTER) {
+                start = freeMain * 0.5f;
+            } else if (params.mainAlign == LayoutAlign::END) {
+                start = freeMain;
+            }
+        }
+        
+        // Siblings keep their rects unless the container moved, its children
+        // changed, its cross size changed, or the space handed out by grow or
+        // alignment did. Children packed at the start ignore the main size.
+        const glm::vec2 size = node.getSize();
+        const bool sameShares = usedMain == state.arrangedMain && totalGrow == state.arrangedGrow &&
+                                mainAxis(size, row) == mainAxis(oldSize, row);
+        const bool packedStart = totalGrow <= 0.0 && state.arrangedGrow <= 0.0 && params.mainAlign == LayoutAlign::START;
+        const bool incremental = !structure && node.getPosition() == oldPosition &&
+                                 crossAxis(size, row) == crossAxis(oldSize, row) && (sameShares || packedStart);
+        state.arrangedMain = usedMain;
+        state.arrangedGrow = totalGrow;
+        
+        auto place = [&](UIComponent& child, float& cursor) {
+            UIHandle childHandle = child.getHandle();
+            const LayoutParams& childParams = registry_.layoutParams(childHandle);
+            glm::vec2 measured = registry_.layoutState(childHandle).measuredSize;
+            
+            float childMain = mainAxis(measured, row);
+            if (freeMain > 0.0f && totalGrow > 0.0) {
+                childMain += freeMain * static_cast<float>(childParams.flexGrow / totalGrow);
+            }
+            childMain = std::min(std::max(childMain, mainAxis(childParams.minSize, row)),
+                                 mainAxis(childParams.maxSize, row));
+            
+            float childCross = crossAxis(measured, row);
+            if (params.crossAlign == LayoutAlign::STRETCH) {
+                childCross = std::min(std::max(innerCross, crossAxis(childParams.minSize, row)),
+                                      crossAxis(childParams.maxSize, row));
+            }
+            
+            float crossOffset = 0.0f;
+            if (params.crossAlign == LayoutAlign::CENTER) {
+                crossOffset = (innerCross - childCross) * 0.5f;
+            } else if (params.crossAlign == LayoutAlign::END) {
+                crossOffset = innerCross - childCross;
+            }
+            
+            // Absolute main coordinates, so a pass resuming from a sibling's
+            // stored rect rounds exactly as a pass from the first child does
+            arrange(child, fromAxes(cursor, crossAxis(innerPosition, row) + crossOffset, row),
+                    fromAxes(childMain, childCross, row));
+            cursor += childMain;
+            cursor += params.spacing;
+        };
+        
+        if (!incremental) {
+            dirty.clear();
+            float cursor = mainAxis(innerPosition, row) + start;
+            for (size_t i = 0; i < childCount; i++) {
+                UIComponent* child = node.getChild(i);
+                registry_.flags(child->getHandle()) &= static_cast<uint8_t>(~UIFlags::LAYOUT_QUEUED);
+                if (child->isVisible()) {
+                    place(*child, cursor);
+                }
+            }
+            return;
+        }
+        
+        // Only the changed children and the siblings after them that they push
+        size_t first = childCount;
+        size_t last = 0;
+        const size_t listed = dirty.size();
+        for (size_t i = 0; i < listed; i++) {
+            UIComponent* child = dirtyChild(node, dirty[i]);
+            if (!child) {
+                continue;
+            }
+            registry_.flags(child->getHandle()) &= static_cast<uint8_t>(~UIFlags::LAYOUT_QUEUED);
+            size_t index = node.getChildIndex(*child);
+            if (index < childCount) {
+                first = std::min(first, index);
+                last = std::max(last, index);
+            }
+        }
+        dirty.erase(dirty.begin(), dirty.begin() + listed);
+        if (first == childCount) {
+            return;
+        }
+        
+        float cursor = mainAxis(innerPosition, row) + start;
+        for (size_t i = first; i-- > 0;) {
+            UIComponent* previous = node.getChild(i);
+            if (previous->isVisible()) {
+                const LayoutState& previousState = registry_.layoutState(previous->getHandle());
+                cursor = mainAxis(previousState.assignedPosition, row);
+                cursor += mainAxis(previousState.assignedSize, row);
+                cursor += params.spacing;
+                break;
+            }
+        }
+        
+        for (size_t i = first; i < childCount; i++) {
+            UIComponent* child = node.getChild(i);
+            if (!child->isVisible()) {
+                continue;
+            }
+            const LayoutState& childState = registry_.layoutState(child->getHandle());
+            const glm::vec2 oldPosition = childState.assignedPosition;
+            const glm::vec2 oldSize = childState.assignedSize;
+            place(*child, cursor);
+            if (i > last && childState.assignedPosition == oldPosition && childState.assignedSize == oldSize) {
+                break;
+            }
+        }
+    }
+    
+    UIRegistry& registry_;
+};
+
+} // namespace
+
+LayoutStats updateLayout(UIComponent& root) {
+    if (!root.isLayoutDirty()) {
+        return LayoutStats();
+    }
+    
+    LayoutPass pass(getUIRegistry());
+    pass.measure(root);
+    pass.placeAbsolute(root);
+    return pass.stats;
+}
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace voidengine {
+namespace ui {
+
+class UIComponent;
+
+enum class LayoutDirection {
+    NONE,
+    ROW,
+    COLUMN
+};
+
+enum class LayoutAlign {
+    START,
+    CENTER,
+    END,
+    STRETCH
+};
+
+// Per-node layout settings. A NONE container leaves its children where they
+// were placed by hand; ROW and COLUMN containers stack their visible children
+// along the main axis. Negative preferred size components mean "auto": leaves
+// keep their current size and containers shrink-wrap their content.
+struct LayoutParams {
+    LayoutDirection direction = LayoutDirection::NONE;
+    glm::vec4 padding = glm::vec4(0.0f); // left, top, right, bottom
+    float spacing = 0.0f;
+    LayoutAlign mainAlign = LayoutAlign::START;
+    LayoutAlign crossAlign = LayoutAlign::START;
+    glm::vec2 preferredSize = glm::vec2(-1.0f);
+    glm::vec2 minSize = glm::vec2(0.0f);
+    glm::vec2 maxSize = glm::vec2(1.0e9f);
+    float flexGrow = 0.0f;
+};
+
+// Cached results of the last pass. The measured size is only recomputed for
+// nodes on a dirty path, and a node whose assigned rect did not change and
+// which is not dirty skips its whole subtree during arrangement. The intrinsic
+// size is the last one set outside of layout; leaves measure from it, so a
+// rect grown by flex or stretch never becomes their natural size.
+//
+// A container keeps the sums over its visible children and the children
+// marked dirty since its last pass, so an edit adjusts the sums by the
+// changed children's difference instead of rescanning every sibling.
+struct LayoutState {
+    glm::vec2 intrinsicSize = glm::vec2(0.0f);
+    glm::vec2 measuredSize = glm::vec2(0.0f);
+    glm::vec2 assignedPosition = glm::vec2(0.0f);
+    glm::vec2 assignedSize = glm::vec2(-1.0f);
+    
+    // Children's measured main sizes without spacing, the largest cross size
+    // and how many children have it
+    double childrenMain = 0.0;
+    float childrenCross = 0.0f;
+    uint32_t crossCount = 0;
+    uint32_t visibleCount = 0;
+    double totalGrow = 0.0;
+    uint32_t growCount = 0;
+    // Main size and grow the children were last arranged with
+    float arrangedMain = -1.0f;
+    double arrangedGrow = 0.0;
+    
+    // As a child: whether the parent's sums include it, and with which grow
+    bool counted = false;
+    float countedGrow = 0.0f;
+    
+    // UIHandle values, so a destroyed child is noticed rather than followed
+    std::vector<uint32_t> dirtyChildren;
+};
+
+struct LayoutStats {
+    size_t measured = 0;
+    size_t arranged = 0;
+};
+
+// Runs measure and arrange over the subtree rooted at root. Root nodes are
+// placed at their current position with their measured size. Needs no GL
+// context, so it can run headless.
+LayoutStats updateLayout(UIComponent& root);
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,202 @@
+#include "LocaleCompiler.h"
+#include "LocaleFormat.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+struct SourceEntry {
+    core::StringId id;
+    std::string key;
+    std::string text;
+    int line;
+};
+
+[[noreturn]] void fail(int line, const std::string& message) {
+    throw std::runtime_error("Locale source line " + std::to_string(line) + ": " + message);
+}
+
+std::string_view trim(std::string_view text) {
+    size_t begin = 0;
+    size_t end = text.size();
+    while (begin < end && (text[begin] == ' ' || text[begin] == '\t' || text[begin] == '\r')) {
+        begin++;
+    }
+    while (end > begin && (text[end - 1] == ' ' || text[end - 1] == '\t' || text[end - 1] == '\r')) {
+        end--;
+    }
+    return text.substr(begin, end - begin);
+}
+
+std::string unescape(std::string_view text, int line) {
+    std::string result;
+    result.reserve(text.size());
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] != '\\') {
+            result.push_back(text[i]);
+            continue;
+        }
+        if (++i == text.size()) {
+            fail(line, "Dangling '\\' at end of text");
+        }
+        switch (text[i]) {
+            case 'n': result.push_back('\n'); break;
+            case 't': result.push_back('\t'); break;
+            case 's': result.push_back(' '); break;
+            case '\\': result.push_back('\\'); break;
+            default: fail(line, std::string("Unknown escape '\\") + text[i] + "'");
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+std::vector<uint8_t> compileLocale(std::string_view source, const std::vector<LocaleFont>& fonts) {
+    std::string name;
+    std::vector<SourceEntry> entries;
+    std::unordered_map<core::StringId, size_t> byId;
+    
+    int lineNumber = 0;
+    size_t position = 0;
+    while (position < source.size()) {
+        size_t end = source.find('\n', position);
+        if (end == std::string_view::npos) {
+            end = source.size();
+        }
+        std::string_view line = trim(source.substr(position, end - position));
+        position = end + 1;
+        lineNumber++;
+        
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        if (line[0] == '@') {
+            constexpr std::string_view DIRECTIVE = "@locale";
+            if (line.substr(0, DIRECTIVE.size()) != DIRECTIVE || line.size() == DIRECTIVE.size() ||
+                (line[DIRECTIVE.size()] != ' ' && line[DIRECTIVE.size()] != '\t')) {
+                fail(lineNumber, "Expected '@locale <name>'");
+            }
+            name = std::string(trim(line.substr(DIRECTIVE.size())));
+            continue;
+        }
+        
+        const size_t equals = line.find('=');
+        if (equals == std::string_view::npos) {
+            fail(lineNumber, "Expected 'key = text'");
+        }
+        std::string_view key = trim(line.substr(0, equals));
+        if (key.empty()) {
+            fail(lineNumber, "Entry has no key");
+        }
+        
+        SourceEntry entry;
+        entry.id = core::hashString(key);
+        entry.key = std::string(key);
+        entry.text = unescape(trim(line.substr(equals + 1)), lineNumber);
+        entry.line = lineNumber;
+        
+        auto found = byId.find(entry.id);
+        if (found != byId.end()) {
+            const SourceEntry& other = entries[found->second];
+            if (other.key == entry.key) {
+                fail(lineNumber, "Duplicate key '" + entry.key + "'");
+            }
+            fail(lineNumber, "Key '" + entry.key + "' hashes like '" + other.key + "' on line " +
+                             std::to_string(other.line));
+        }
+        byId.emplace(entry.id, entries.size());
+        entries.push_back(std::move(entry));
+    }
+    
+    std::sort(entries.begin(), entries.end(),
+              [](const SourceEntry& a, const SourceEntry& b) { return a.id < b.id; });
+    
+    std::vector<char> strings(name.begin(), name.end());
+    std::vector<LocaleEntryRecord> records;
+    records.reserve(entries.size());
+    for (const SourceEntry& entry : entries) {
+        LocaleEntryRecord record = {};
+        record.id = entry.id;
+        record.textOffset = static_cast<uint32_t>(strings.size());
+        record.textLength = static_cast<uint32_t>(entry.text.size());
+        strings.insert(strings.end(), entry.text.begin(), entry.text.end());
+        records.push_back(record);
+    }
+    while (strings.size() % 4 != 0) {
+        strings.push_back('\0');
+    }
+    if (strings.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Locale source holds too much text");
+    }
+    
+    std::vector<LocaleFontRecord> fontRecords;
+    std::vector<float> metrics(entries.size() * fonts.size() * 2, std::numeric_limits<float>::quiet_NaN());
+    for (size_t f = 0; f < fonts.size(); f++) {
+        fontRecords.push_back(LocaleFontRecord{fonts[f].key, 0});
+        if (!fonts[f].measure) {
+            continue;
+        }
+        for (size_t e = 0; e < entries.size(); e++) {
+            const glm::vec2 size = fonts[f].measure(entries[e].text);
+            metrics[(e * fonts.size() + f) * 2] = size.x;
+            metrics[(e * fonts.size() + f) * 2 + 1] = size.y;
+        }
+    }
+    
+    LocaleHeader header = {};
+    header.magic = LocaleFormat::MAGIC;
+    header.version = LocaleFormat::VERSION;
+    header.entryCount = static_cast<uint32_t>(records.size());
+    header.fontCount = static_cast<uint32_t>(fontRecords.size());
+    header.stringBytes = static_cast<uint32_t>(strings.size());
+    header.entriesOffset = sizeof(LocaleHeader);
+    header.fontsOffset = header.entriesOffset + static_cast<uint32_t>(records.size() * sizeof(LocaleEntryRecord));
+    header.metricsOffset = header.fontsOffset + static_cast<uint32_t>(fontRecords.size() * sizeof(LocaleFontRecord));
+    header.stringsOffset = header.metricsOffset + static_cast<uint32_t>(metrics.size() * sizeof(float));
+    header.nameOffset = 0;
+    header.nameLength = static_cast<uint32_t>(name.size());
+    header.totalSize = header.stringsOffset + header.stringBytes;
+    
+    std::vector<uint8_t> image(header.totalSize);
+    auto copy = [&image](uint32_t offset, const void* data, size_t size) {
+        if (size > 0) {
+            std::memcpy(image.data() + offset, data, size);
+        }
+    };
+    copy(0, &header, sizeof(header));
+    copy(header.entriesOffset, records.data(), records.size() * sizeof(LocaleEntryRecord));
+    copy(header.fontsOffset, fontRecords.data(), fontRecords.size() * sizeof(LocaleFontRecord));
+    copy(header.metricsOffset, metrics.data(), metrics.size() * sizeof(float));
+    copy(header.stringsOffset, strings.data(), strings.size());
+    return image;
+}
+
+void compileLocaleFile(const std::string& inputPath, const std::string& outputPath,
+                       const std::vector<LocaleFont>& fonts) {
+    std::ifstream input(inputPath, std::ios::binary);
+    if (!input) {
+        throw std::runtime_error("Failed to open locale source: " + inputPath);
+    }
+    
+    std::stringstream buffer;
+    buffer << input.rdbuf();
+    std::vector<uint8_t> image = compileLocale(buffer.str(), fonts);
+    
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        throw std::runtime_error("Failed to write compiled locale: " + outputPath);
+    }
+    output.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+}
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../core/StringId.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace voidengine {
+namespace ui {
+
+// A font to bake metrics for. The key is FontRenderer::getFontKey() of that
+// font once loaded, or zero for the box fallback drawn when no font is;
+// measure returns a text's dimensions at scale 1, as measureText would at
+// FONT_BASE_SIZE.
+struct LocaleFont {
+    core::StringId key;
+    std::function<glm::vec2(std::string_view)> measure;
+};
+
+// Compiles a string table into the binary .vloc image described in
+// LocaleFormat.h. The source has one "key = text" entry per line; blank lines
+// and lines starting with '#' are skipped, "@locale name" names the table,
+// and text may use the escapes \n, \t, \\ and \s for a leading or trailing
+// space. Every entry is measured in every font given. Throws
+// std::runtime_error naming the offending line.
+std::vector<uint8_t> compileLocale(std::string_view source, const std::vector<LocaleFont>& fonts = {});
+
+// Reads a source from disk and writes the compiled image
+void compileLocaleFile(const std::string& inputPath, const std::string& outputPath,
+                       const std::vector<LocaleFont>& fonts = {});
+
+} // namespace ui
+} // namespace voidengine
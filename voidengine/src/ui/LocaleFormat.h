@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace voidengine {
+namespace ui {
+
+// Binary string table layout (.vloc), produced by the locale compiler and read
+// in place by Localization. Little-endian, 4-byte aligned:
+//
+//   LocaleHeader
+//   LocaleEntryRecord[entryCount]       sorted by id
+//   LocaleFontRecord[fontCount]
+//   float[entryCount * fontCount * 2]   width and height of each entry in each
+//                                       font at scale 1, entry-major; NaN
+//                                       where the entry was not measured
+//   char[stringBytes]                   locale name and texts, UTF-8
+namespace LocaleFormat {
+    constexpr uint32_t MAGIC = 0x314C5656; // "VVL1"
+    constexpr uint32_t VERSION = 1;
+}
+
+struct LocaleHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t fontCount;
+    uint32_t stringBytes;
+    uint32_t entriesOffset;
+    uint32_t fontsOffset;
+    uint32_t metricsOffset;
+    uint32_t stringsOffset;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t totalSize;
+};
+
+struct LocaleEntryRecord {
+    // StringId of the entry's key
+    uint32_t id;
+    uint32_t textOffset;
+    uint32_t textLength;
+    uint32_t reserved;
+};
+
+struct LocaleFontRecord {
+    // FontRenderer::getFontKey() of the font the metrics were taken with
+    uint32_t key;
+    uint32_t reserved;
+};
+
+static_assert(std::is_trivially_copyable<LocaleHeader>::value, "LocaleHeader must be trivially copyable");
+static_assert(std::is_trivially_copyable<LocaleEntryRecord>::value, "LocaleEntryRecord must be trivially copyable");
+static_assert(sizeof(LocaleHeader) % 4 == 0 && sizeof(LocaleEntryRecord) % 4 == 0 &&
+              sizeof(LocaleFontRecord) % 4 == 0, "Locale records must keep 4-byte alignment");
+
+} // namespace ui
+} // namespace voidengine
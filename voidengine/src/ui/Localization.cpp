@@ -0,0 +1,173 @@
+#include "Localization.h"
+#include "FontRenderer.h"
+#include "UIRenderer.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace voidengine {
+namespace ui {
+
+std::unique_ptr<Localization> gLocalization = nullptr;
+
+Localization& getLocalization() {
+    if (!gLocalization) {
+        gLocalization = std::make_unique<Localization>();
+    }
+    return *gLocalization;
+}
+
+namespace {
+
+const LocaleHeader& validateImage(const uint8_t* data, size_t size) {
+    if (!data || size < sizeof(LocaleHeader)) {
+        throw std::runtime_error("Locale image is truncated");
+    }
+    if (reinterpret_cast<uintptr_t>(data) % alignof(LocaleEntryRecord) != 0) {
+        throw std::runtime_error("Locale image is misaligned");
+    }
+    
+    const LocaleHeader& header = *reinterpret_cast<const LocaleHeader*>(data);
+    if (header.magic != LocaleFormat::MAGIC) {
+        throw std::runtime_error("Not a compiled locale image");
+    }
+    if (header.version != LocaleFormat::VERSION) {
+        throw std::runtime_error("Unsupported locale image version " + std::to_string(header.version));
+    }
+    
+    const uint64_t entriesEnd = static_cast<uint64_t>(header.entriesOffset) +
+                                static_cast<uint64_t>(header.entryCount) * sizeof(LocaleEntryRecord);
+    const uint64_t fontsEnd = static_cast<uint64_t>(header.fontsOffset) +
+                              static_cast<uint64_t>(header.fontCount) * sizeof(LocaleFontRecord);
+    const uint64_t metricsEnd = static_cast<uint64_t>(header.metricsOffset) +
+                                static_cast<uint64_t>(header.entryCount) * header.fontCount * 2 * sizeof(float);
+    const uint64_t stringsEnd = static_cast<uint64_t>(header.stringsOffset) + header.stringBytes;
+    if (header.totalSize > size || header.entriesOffset % 4 != 0 || header.fontsOffset % 4 != 0 ||
+        header.metricsOffset % 4 != 0 || entriesEnd > header.fontsOffset || fontsEnd > header.metricsOffset ||
+        metricsEnd > header.stringsOffset || stringsEnd > header.totalSize ||
+        static_cast<uint64_t>(header.nameOffset) + header.nameLength > header.stringBytes) {
+        throw std::runtime_error("Locale image header is inconsistent");
+    }
+    
+    // Lookups binary search the ids, so they must be strictly increasing
+    const LocaleEntryRecord* entries = reinterpret_cast<const LocaleEntryRecord*>(data + header.entriesOffset);
+    for (uint32_t i = 0; i < header.entryCount; i++) {
+        const LocaleEntryRecord& entry = entries[i];
+        if ((i > 0 && entries[i - 1].id >= entry.id) ||
+            static_cast<uint64_t>(entry.textOffset) + entry.textLength > header.stringBytes) {
+            throw std::runtime_error("Locale entry " + std::to_string(i) + " is malformed");
+        }
+    }
+    
+    return header;
+}
+
+} // namespace
+
+void Localization::setLocale(const std::string& path) {
+    core::MappedFile file(path);
+    adopt(file.data(), file.size());
+    file_ = std::move(file);
+}
+
+void Localization::setLocale(const uint8_t* data, size_t size) {
+    adopt(data, size);
+    file_.close();
+}
+
+void Localization::clear() {
+    file_.close();
+    data_ = nullptr;
+    entries_ = nullptr;
+    fonts_ = nullptr;
+    metrics_ = nullptr;
+    strings_ = nullptr;
+    entryCount_ = 0;
+    fontCount_ = 0;
+    fontResolved_ = false;
+    measured_.clear();
+    version_.set(version_.peek() + 1);
+}
+
+std::string_view Localization::getLocaleName() const {
+    if (!data_) {
+        return std::string_view();
+    }
+    const LocaleHeader& header = *reinterpret_cast<const LocaleHeader*>(data_);
+    return std::string_view(strings_ + header.nameOffset, header.nameLength);
+}
+
+std::string_view Localization::getString(core::StringId id) const {
+    const uint32_t index = findEntry(id);
+    if (index == NOT_FOUND) {
+        return std::string_view();
+    }
+    return std::string_view(strings_ + entries_[index].textOffset, entries_[index].textLength);
+}
+
+glm::vec2 Localization::measure(core::StringId id, float fontSize) {
+    const uint32_t index = findEntry(id);
+    if (index == NOT_FOUND) {
+        return measureText("", 0, fontSize);
+    }
+    
+    const core::StringId fontKey = gFontRenderer && gFontRenderer->isFontLoaded() ? gFontRenderer->getFontKey() : 0;
+    if (!fontResolved_ || fontKey != fontKey_) {
+        fontKey_ = fontKey;
+        fontResolved_ = true;
+        fontColumn_ = NOT_FOUND;
+        for (uint32_t f = 0; f < fontCount_; f++) {
+            if (fonts_[f].key == fontKey) {
+                fontColumn_ = f;
+                break;
+            }
+        }
+        measured_.assign(entryCount_, glm::vec2(std::numeric_limits<float>::quiet_NaN()));
+    }
+    
+    const float scale = fontSize / FONT_BASE_SIZE;
+    if (fontColumn_ != NOT_FOUND) {
+        const float* baked = metrics_ + (static_cast<size_t>(index) * fontCount_ + fontColumn_) * 2;
+        if (!std::isnan(baked[0])) {
+            return glm::vec2(baked[0], baked[1]) * scale;
+        }
+    }
+    
+    glm::vec2& cached = measured_[index];
+    if (std::isnan(cached.x)) {
+        const LocaleEntryRecord& entry = entries_[index];
+        cached = measureText(strings_ + entry.textOffset, entry.textLength, FONT_BASE_SIZE);
+        measureCount_++;
+    }
+    return cached * scale;
+}
+
+uint32_t Localization::findEntry(core::StringId id) const {
+    uint32_t low = 0;
+    uint32_t high = entryCount_;
+    while (low < high) {
+        const uint32_t middle = low + (high - low) / 2;
+        if (entries_[middle].id < id) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low < entryCount_ && entries_[low].id == id ? low : NOT_FOUND;
+}
+
+void Localization::adopt(const uint8_t* data, size_t size) {
+    const LocaleHeader& header = validateImage(data, size);
+    data_ = data;
+    entries_ = reinterpret_cast<const LocaleEntryRecord*>(data + header.entriesOffset);
+    fonts_ = reinterpret_cast<const LocaleFontRecord*>(data + header.fontsOffset);
+    metrics_ = reinterpret_cast<const float*>(data + header.metricsOffset);
+    strings_ = reinterpret_cast<const char*>(data + header.stringsOffset);
+    entryCount_ = header.entryCount;
+    fontCount_ = header.fontCount;
+    fontResolved_ = false;
+    version_.set(version_.peek() + 1);
+}
+
+} // namespace ui
+} // namespace voidengine
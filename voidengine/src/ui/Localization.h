@@ -0,0 +1,78 @@
+#pragma once
+
+#include "LocaleFormat.h"
+#include "Observable.h"
+#include "../core/MappedFile.h"
+#include "../core/StringId.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace voidengine {
+namespace ui {
+
+// The current string table, a compiled .vloc image read in place. Texts are
+// views into the image and stay valid until the next setLocale() or clear().
+// Labels bound with Text::bindLocalizedText follow locale switches at the
+// next binding flush. Main thread only.
+class Localization {
+public:
+    // Maps the file and switches to it; the previous table is unmapped.
+    // Throws std::runtime_error when the image is malformed, keeping the
+    // current table.
+    void setLocale(const std::string& path);
+    // Switches to an image the caller keeps alive and 4-byte aligned
+    void setLocale(const uint8_t* data, size_t size);
+    void clear();
+    
+    std::string_view getLocaleName() const;
+    bool hasString(core::StringId id) const { return findEntry(id) != NOT_FOUND; }
+    // Empty when the table has no such entry
+    std::string_view getString(core::StringId id) const;
+    // What measureText would return for the string at fontSize. Read from the
+    // table when it was baked for the loaded font, otherwise measured once and
+    // kept until the locale or the font changes.
+    glm::vec2 measure(core::StringId id, float fontSize);
+    
+    size_t size() const { return entryCount_; }
+    // Changes on every switch; reading it inside a binding subscribes it
+    uint32_t getVersion() const { return version_.get(); }
+    // Strings measured because the table had no metrics for them
+    uint64_t getMeasureCount() const { return measureCount_; }
+
+private:
+    static constexpr uint32_t NOT_FOUND = 0xFFFFFFFFu;
+    
+    uint32_t findEntry(core::StringId id) const;
+    void adopt(const uint8_t* data, size_t size);
+    
+    core::MappedFile file_;
+    const uint8_t* data_ = nullptr;
+    const LocaleEntryRecord* entries_ = nullptr;
+    const LocaleFontRecord* fonts_ = nullptr;
+    const float* metrics_ = nullptr;
+    const char* strings_ = nullptr;
+    uint32_t entryCount_ = 0;
+    uint32_t fontCount_ = 0;
+    
+    // Font the runtime metrics and the baked column were resolved for
+    core::StringId fontKey_ = 0;
+    bool fontResolved_ = false;
+    uint32_t fontColumn_ = NOT_FOUND;
+    // At scale 1; NaN until measured
+    std::vector<glm::vec2> measured_;
+    uint64_t measureCount_ = 0;
+    
+    Observable<uint32_t> version_;
+};
+
+extern std::unique_ptr<Localization> gLocalization;
+
+Localization& getLocalization();
+
+} // namespace ui
+} // namespace voidengine
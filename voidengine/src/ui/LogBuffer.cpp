@@ -0,0 +1,249 @@
+#include "LogBuffer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+// Chunks are spilled as their line end offsets followed by their text, and
+// both sizes are stored in 32 bits
+constexpr size_t MAX_LINE_BYTES = std::numeric_limits<uint32_t>::max() / 2;
+
+// Compacting the chunk index once this many dropped records lead it
+constexpr size_t COMPACT_THRESHOLD = 64;
+
+} // namespace
+
+LogBuffer::LogBuffer(size_t memoryBudget, size_t chunkBytes)
+    : chunkBytes_(chunkBytes) {
+    if (chunkBytes_ == 0 || chunkBytes_ > MAX_LINE_BYTES) {
+        throw std::invalid_argument("Log buffer chunk size out of range");
+    }
+    // The chunk being appended to and the one before it always stay resident
+    maxResidentChunks_ = std::max<size_t>(memoryBudget / chunkBytes_, 2);
+}
+
+LogBuffer::~LogBuffer() {
+    spillMap_.close();
+    if (isSpilling()) {
+        spillStream_.close();
+        std::remove(spillPath_.c_str());
+    }
+}
+
+void LogBuffer::append(std::string_view line) {
+    if (line.size() > MAX_LINE_BYTES) {
+        throw std::length_error("Log line too long");
+    }
+    
+    if (head_ == chunks_.size()) {
+        startChunk();
+    } else {
+        const Chunk& tail = *chunks_.back().resident;
+        // A line longer than a chunk gets a chunk of its own
+        if (!tail.ends.empty() && tail.text.size() + line.size() > chunkBytes_) {
+            startChunk();
+        }
+    }
+    
+    ChunkRecord& record = chunks_.back();
+    Chunk& tail = *record.resident;
+    tail.text.append(line.data(), line.size());
+    tail.ends.push_back(static_cast<uint32_t>(tail.text.size()));
+    record.lineCount++;
+    endLine_++;
+    
+    while (chunks_.size() - head_ > 1 && getLineCount() - chunks_[head_].lineCount >= maxLines_) {
+        dropHead();
+    }
+}
+
+std::string_view LogBuffer::getLine(uint64_t line) {
+    if (line < firstLine_ || line >= endLine_) {
+        throw std::out_of_range("Log line not in buffer");
+    }
+    
+    const ChunkRecord& record = chunks_[findChunk(line)];
+    const size_t index = static_cast<size_t>(line - record.firstLine);
+    
+    if (record.resident) {
+        const Chunk& chunk = *record.resident;
+        const uint32_t begin = index > 0 ? chunk.ends[index - 1] : 0;
+        return std::string_view(chunk.text.data() + begin, chunk.ends[index] - begin);
+    }
+    
+    ensureMapped(record.fileOffset + record.byteSize);
+    const uint8_t* base = spillMap_.data() + record.fileOffset;
+    uint32_t begin = 0;
+    uint32_t end;
+    if (index > 0) {
+        std::memcpy(&begin, base + (index - 1) * sizeof(uint32_t), sizeof(uint32_t));
+    }
+    std::memcpy(&end, base + index * sizeof(uint32_t), sizeof(uint32_t));
+    const char* text = reinterpret_cast<const char*>(base + record.lineCount * sizeof(uint32_t));
+    return std::string_view(text + begin, end - begin);
+}
+
+void LogBuffer::setMaxLines(uint64_t maxLines) {
+    if (maxLines == 0) {
+        throw std::invalid_argument("Log buffer must keep at least one line");
+    }
+    maxLines_ = maxLines;
+    while (chunks_.size() - head_ > 1 && getLineCount() - chunks_[head_].lineCount >= maxLines_) {
+        dropHead();
+    }
+}
+
+void LogBuffer::setSpillFile(const std::string& path) {
+    if (!empty()) {
+        throw std::logic_error("Log spill file must be set before lines are appended");
+    }
+    
+    spillMap_.close();
+    if (isSpilling()) {
+        spillStream_.close();
+        std::remove(spillPath_.c_str());
+    }
+    spillPath_.clear();
+    spillSize_ = 0;
+    
+    if (path.empty()) {
+        return;
+    }
+    spillStream_.open(path, std::ios::binary | std::ios::trunc);
+    if (!spillStream_) {
+        spillStream_.clear();
+        throw std::runtime_error("Failed to create log spill file: " + path);
+    }
+    spillPath_ = path;
+}
+
+void LogBuffer::clear() {
+    chunks_.clear();
+    head_ = 0;
+    firstResident_ = 0;
+    residentChunks_ = 0;
+    firstLine_ = endLine_;
+    
+    spillMap_.close();
+    if (isSpilling()) {
+        spillStream_.close();
+        spillStream_.open(spillPath_, std::ios::binary | std::ios::trunc);
+        spillSize_ = 0;
+    }
+}
+
+LogBuffer::Snapshot LogBuffer::snapshot() {
+    Snapshot result;
+    result.spillPath = spillPath_;
+    result.endLine = endLine_;
+    result.parts.reserve(chunks_.size() - head_);
+    if (isSpilling()) {
+        spillStream_.flush();
+    }
+    
+    for (size_t i = head_; i < chunks_.size(); i++) {
+        const ChunkRecord& record = chunks_[i];
+        Snapshot::Part part;
+        part.firstLine = record.firstLine;
+        part.fileOffset = record.fileOffset;
+        part.lineCount = record.lineCount;
+        part.byteSize = record.byteSize;
+        // The back chunk is still being appended to, so it is copied
+        if (i + 1 == chunks_.size()) {
+            part.chunk = std::make_shared<const Chunk>(*record.resident);
+        } else {
+            part.chunk = record.resident;
+        }
+        result.parts.push_back(std::move(part));
+    }
+    return result;
+}
+
+void LogBuffer::startChunk() {
+    ChunkRecord record;
+    record.resident = std::make_shared<Chunk>();
+    record.resident->text.reserve(chunkBytes_);
+    record.firstLine = endLine_;
+    chunks_.push_back(std::move(record));
+    residentChunks_++;
+    
+    if (residentChunks_ > maxResidentChunks_) {
+        evictOldest();
+    }
+}
+
+void LogBuffer::evictOldest() {
+    firstResident_ = std::max(firstResident_, head_);
+    while (!chunks_[firstResident_].resident) {
+        firstResident_++;
+    }
+    
+    if (isSpilling()) {
+        spill(chunks_[firstResident_]);
+        firstResident_++;
+    } else {
+        // Without a spill file every live chunk is resident, so this is the head
+        dropHead();
+    }
+}
+
+void LogBuffer::spill(ChunkRecord& record) {
+    const Chunk& chunk = *record.resident;
+    const size_t endsBytes = chunk.ends.size() * sizeof(uint32_t);
+    spillStream_.write(reinterpret_cast<const char*>(chunk.ends.data()), static_cast<std::streamsize>(endsBytes));
+    spillStream_.write(chunk.text.data(), static_cast<std::streamsize>(chunk.text.size()));
+    if (!spillStream_) {
+        throw std::runtime_error("Failed to write log spill file: " + spillPath_);
+    }
+    
+    record.fileOffset = spillSize_;
+    record.byteSize = static_cast<uint32_t>(endsBytes + chunk.text.size());
+    spillSize_ += record.byteSize;
+    record.resident.reset();
+    residentChunks_--;
+}
+
+void LogBuffer::dropHead() {
+    ChunkRecord& record = chunks_[head_];
+    if (record.resident) {
+        record.resident.reset();
+        residentChunks_--;
+    }
+    firstLine_ += record.lineCount;
+    head_++;
+    firstResident_ = std::max(firstResident_, head_);
+    
+    if (head_ >= COMPACT_THRESHOLD && head_ * 2 >= chunks_.size()) {
+        chunks_.erase(chunks_.begin(), chunks_.begin() + static_cast<std::ptrdiff_t>(head_));
+        firstResident_ -= head_;
+        head_ = 0;
+    }
+}
+
+size_t LogBuffer::findChunk(uint64_t line) const {
+    // Most reads are of recent lines
+    if (line >= chunks_.back().firstLine) {
+        return chunks_.size() - 1;
+    }
+    auto it = std::upper_bound(chunks_.begin() + static_cast<std::ptrdiff_t>(head_), chunks_.end(), line,
+                               [](uint64_t value, const ChunkRecord& record) { return value < record.firstLine; });
+    return static_cast<size_t>(it - chunks_.begin()) - 1;
+}
+
+void LogBuffer::ensureMapped(uint64_t end) {
+    // The mapping covers the file as it was when mapped, so it is redone once
+    // a read reaches past it
+    if (spillMap_.size() < end) {
+        spillStream_.flush();
+        spillMap_.open(spillPath_);
+    }
+}
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "../core/MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace voidengine {
+namespace ui {
+
+// Append-only store of text lines in bounded memory. Lines are packed back to
+// back into chunks of a fixed size, so appending never moves earlier text.
+// Lines are numbered from the first line ever appended and keep their number
+// when older ones are dropped.
+//
+// When the resident chunks outgrow the memory budget, the oldest one is
+// written to the spill file if one is set, or dropped otherwise. Spilled
+// chunks are read back through a memory mapping, which leaves paging them in
+// and out to the OS. Only a small index entry per spilled chunk stays in
+// memory. The spill file grows until clear() and is deleted with the buffer.
+class LogBuffer {
+public:
+    struct Chunk {
+        std::string text;
+        // End offset in text of each line
+        std::vector<uint32_t> ends;
+    };
+    
+    // Every line retained when the snapshot was taken, for reading on another
+    // thread. Resident chunks are shared rather than copied. Spilled chunks are
+    // read from spillPath, whose existing contents never change until clear().
+    struct Snapshot {
+        struct Part {
+            // Null when the chunk is read from the spill file
+            std::shared_ptr<const Chunk> chunk;
+            uint64_t firstLine = 0;
+            uint64_t fileOffset = 0;
+            uint32_t lineCount = 0;
+            uint32_t byteSize = 0;
+        };
+        
+        std::vector<Part> parts;
+        std::string spillPath;
+        uint64_t endLine = 0;
+    };
+    
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 16 * 1024 * 1024;
+    static constexpr size_t DEFAULT_CHUNK_BYTES = 64 * 1024;
+    static constexpr uint64_t UNLIMITED = static_cast<uint64_t>(-1);
+    
+    explicit LogBuffer(size_t memoryBudget = DEFAULT_MEMORY_BUDGET, size_t chunkBytes = DEFAULT_CHUNK_BYTES);
+    ~LogBuffer();
+    
+    LogBuffer(const LogBuffer&) = delete;
+    LogBuffer& operator=(const LogBuffer&) = delete;
+    
+    // Adds one line; any '\n' in it is kept as text
+    void append(std::string_view line);
+    
+    // Absolute line number; the view stays valid until the buffer is next
+    // modified or another line is read. Throws std::out_of_range for lines
+    // that were dropped or not yet appended.
+    std::string_view getLine(uint64_t line);
+    
+    uint64_t getFirstLine() const { return firstLine_; }
+    uint64_t getEndLine() const { return endLine_; }
+    uint64_t getLineCount() const { return endLine_ - firstLine_; }
+    bool empty() const { return endLine_ == firstLine_; }
+    
+    // Oldest lines beyond this many are dropped a chunk at a time
+    void setMaxLines(uint64_t maxLines);
+    uint64_t getMaxLines() const { return maxLines_; }
+    
+    // Only allowed while empty. Creates or truncates the file; throws
+    // std::runtime_error when it cannot be written.
+    void setSpillFile(const std::string& path);
+    const std::string& getSpillFile() const { return spillPath_; }
+    bool isSpilling() const { return !spillPath_.empty(); }
+    
+    // Drops every line, truncating the spill file. Numbering continues.
+    void clear();
+    
+    Snapshot snapshot();
+    
+    size_t getResidentBytes() const { return residentChunks_ * chunkBytes_; }
+    uint64_t getSpilledBytes() const { return spillSize_; }
+
+private:
+    struct ChunkRecord {
+        // Null once spilled
+        std::shared_ptr<Chunk> resident;
+        uint64_t firstLine = 0;
+        uint64_t fileOffset = 0;
+        uint32_t lineCount = 0;
+        uint32_t byteSize = 0;
+    };
+    
+    void startChunk();
+    void evictOldest();
+    void spill(ChunkRecord& record);
+    void dropHead();
+    size_t findChunk(uint64_t line) const;
+    void ensureMapped(uint64_t end);
+    
+    size_t chunkBytes_;
+    size_t maxResidentChunks_;
+    uint64_t maxLines_ = UNLIMITED;
+    
+    // chunks_[head_] onwards are live; the back one takes appends
+    std::vector<ChunkRecord> chunks_;
+    size_t head_ = 0;
+    size_t firstResident_ = 0;
+    size_t residentChunks_ = 0;
+    uint64_t firstLine_ = 0;
+    uint64_t endLine_ = 0;
+    
+    std::string spillPath_;
+    std::ofstream spillStream_;
+    uint64_t spillSize_ = 0;
+    core::MappedFile spillMap_;
+};
+
+} // namespace ui
+} // namespace voidengine
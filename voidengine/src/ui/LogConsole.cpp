@@ -0,0 +1,386 @@
+#include "LogConsole.h"
+#include "UIRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+constexpr float PADDING = 4.0f;
+
+const glm::vec4 MATCH_SHADE(1.0f, 0.8f, 0.2f, 0.25f);
+const glm::vec4 SCROLL_THUMB(0.8f, 0.8f, 0.8f, 0.6f);
+
+} // namespace
+
+LogConsole::LogConsole(const std::string& id, const glm::vec2& position, const glm::vec2& size, float fontSize,
+                       size_t memoryBudget)
+    : UIComponent(id, position, size), fontSize_(fontSize), buffer_(memoryBudget) {
+    if (fontSize_ <= 0.0f) {
+        throw std::invalid_argument("LogConsole font size must be positive");
+    }
+    
+    capabilities_ = UICapabilities::POINTER | UICapabilities::CLIPS_CHILDREN;
+    refreshStyle();
+}
+
+LogConsole::~LogConsole() {
+    cancelSearch();
+}
+
+void LogConsole::update(float deltaTime) {
+    drainPending();
+    collectSearchResults();
+    pruneMatches();
+    clampScroll();
+    refreshLines();
+}
+
+void LogConsole::render() {
+    if (!isVisible()) {
+        return;
+    }
+    
+    const glm::vec2 position = getPosition();
+    const glm::vec2 size = getSize();
+    const float lineHeight = getLineHeight();
+    const glm::vec2 inner = glm::max(size - glm::vec2(2.0f * PADDING), glm::vec2(0.0f));
+    
+    drawRect(position, size, style().backgroundColor);
+    
+    if (!slots_.empty()) {
+        pushClipRect(position + glm::vec2(PADDING), inner);
+        
+        const uint64_t end = std::min(topLine_ + getVisibleLineCount(), buffer_.getEndLine());
+        auto match = std::lower_bound(matches_.begin(), matches_.end(), topLine_);
+        for (uint64_t line = topLine_; line < end; line++) {
+            const glm::vec2 origin = position + glm::vec2(PADDING, PADDING + static_cast<float>(line - topLine_) * lineHeight);
+            while (match != matches_.end() && *match < line) {
+                ++match;
+            }
+            if (match != matches_.end() && *match == line) {
+                drawRect(glm::vec2(position.x, origin.y), glm::vec2(size.x, lineHeight), MATCH_SHADE);
+            }
+            
+            const LineSlot& slot = slots_[line % slots_.size()];
+            // Not laid out yet, e.g. drawn before the first update
+            if (slot.line != line) {
+                continue;
+            }
+            drawTextRun(slot.run, origin + glm::vec2(0.0f, (lineHeight - fontSize_) * 0.5f), style().textColor,
+                        inner.x);
+        }
+        
+        popClipRect();
+    }
+    
+    const uint64_t lines = buffer_.getLineCount();
+    const size_t visible = getVisibleLineCount();
+    if (lines > visible && inner.y > 0.0f) {
+        const double shown = static_cast<double>(visible) / static_cast<double>(lines);
+        const double scrolled = static_cast<double>(topLine_ - buffer_.getFirstLine()) /
+                                static_cast<double>(lines - visible);
+        float thumbHeight = std::max(16.0f, static_cast<float>(inner.y * shown));
+        float thumbY = position.y + PADDING + static_cast<float>((inner.y - thumbHeight) * scrolled);
+        drawRect(glm::vec2(position.x + size.x - 4.0f, thumbY), glm::vec2(3.0f, thumbHeight), SCROLL_THUMB);
+    }
+    
+    drawRectOutline(position, size, style().borderColor);
+}
+
+void LogConsole::onEvent(UIEvent& event) {
+    if (event.phase == UIEventPhase::CAPTURE) {
+        return;
+    }
+    
+    if (event.type == UIEventType::SCROLL) {
+        scrollBy(-static_cast<int64_t>(std::lround(event.scroll.y * scrollSpeed_)));
+        event.consume();
+    } else if (event.type == UIEventType::MOUSE_BUTTON && event.phase == UIEventPhase::TARGET) {
+        event.consume();
+    }
+}
+
+void LogConsole::append(std::string_view text) {
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    pending_.append(text.data(), text.size());
+    if (text.empty() || text.back() != '\n') {
+        pending_.push_back('\n');
+    }
+}
+
+void LogConsole::clear() {
+    cancelSearch();
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pending_.clear();
+    }
+    
+    buffer_.clear();
+    matches_.clear();
+    searchSnapshotEnd_ = buffer_.getEndLine();
+    slots_.assign(slots_.size(), LineSlot());
+    contentWidth_ = 0.0f;
+    topLine_ = buffer_.getFirstLine();
+    followTail_ = true;
+    markRenderDirty();
+}
+
+void LogConsole::setSpillFile(const std::string& path) {
+    buffer_.setSpillFile(path);
+}
+
+void LogConsole::setMaxLines(uint64_t maxLines) {
+    buffer_.setMaxLines(maxLines);
+    pruneMatches();
+    clampScroll();
+}
+
+void LogConsole::scrollToLine(uint64_t line) {
+    topLine_ = line;
+    followTail_ = line >= maxTopLine();
+    clampScroll();
+    markRenderDirty();
+}
+
+void LogConsole::scrollBy(int64_t lines) {
+    if (lines < 0) {
+        const uint64_t distance = static_cast<uint64_t>(-lines);
+        const uint64_t first = buffer_.getFirstLine();
+        scrollToLine(topLine_ - first > distance ? topLine_ - distance : first);
+    } else {
+        scrollToLine(topLine_ + static_cast<uint64_t>(lines));
+    }
+}
+
+size_t LogConsole::getVisibleLineCount() const {
+    const float inner = getSize().y - 2.0f * PADDING;
+    return std::max<size_t>(1, static_cast<size_t>(std::floor(inner / getLineHeight())));
+}
+
+void LogConsole::setFollowTail(bool follow) {
+    followTail_ = follow;
+    clampScroll();
+}
+
+void LogConsole::search(std::string query) {
+    cancelSearch();
+    query_ = std::move(query);
+    matches_.clear();
+    markRenderDirty();
+    if (query_.empty()) {
+        return;
+    }
+    
+    // Queued lines are matched as they are drained, like any later ones
+    searchSnapshotEnd_ = buffer_.getEndLine();
+    if (buffer_.empty()) {
+        return;
+    }
+    searchState_ = std::make_shared<SearchState>();
+    searchThread_ = std::thread(runSearch, searchState_, buffer_.snapshot(), query_);
+}
+
+void LogConsole::cancelSearch() {
+    if (searchThread_.joinable()) {
+        searchState_->cancelled = true;
+        searchThread_.join();
+    }
+    searchState_.reset();
+}
+
+bool LogConsole::isSearching() const {
+    return searchState_ != nullptr;
+}
+
+bool LogConsole::scrollToNextMatch() {
+    auto it = std::upper_bound(matches_.begin(), matches_.end(), topLine_);
+    if (it == matches_.end()) {
+        return false;
+    }
+    scrollToLine(*it);
+    return true;
+}
+
+bool LogConsole::scrollToPreviousMatch() {
+    auto it = std::lower_bound(matches_.begin(), matches_.end(), topLine_);
+    if (it == matches_.begin()) {
+        return false;
+    }
+    scrollToLine(*(it - 1));
+    return true;
+}
+
+void LogConsole::runSearch(std::shared_ptr<SearchState> state, LogBuffer::Snapshot snapshot, std::string query) {
+    const std::boyer_moore_horspool_searcher<std::string::const_iterator> searcher(query.begin(), query.end());
+    core::MappedFile spill;
+    std::vector<uint32_t> spilledEnds;
+    std::vector<uint64_t> batch;
+    
+    for (const LogBuffer::Snapshot::Part& part : snapshot.parts) {
+        if (state->cancelled) {
+            break;
+        }
+        
+        const char* text;
+        size_t textSize;
+        const uint32_t* ends;
+        if (part.chunk) {
+            text = part.chunk->text.data();
+            textSize = part.chunk->text.size();
+            ends = part.chunk->ends.data();
+        } else {
+            if (!spill.isOpen()) {
+                try {
+                    spill.open(snapshot.spillPath);
+                } catch (const std::exception&) {
+                    break;
+                }
+            }
+            const uint8_t* base = spill.data() + part.fileOffset;
+            const size_t endsBytes = part.lineCount * sizeof(uint32_t);
+            spilledEnds.resize(part.lineCount);
+            std::memcpy(spilledEnds.data(), base, endsBytes);
+            text = reinterpret_cast<const char*>(base + endsBytes);
+            textSize = part.byteSize - endsBytes;
+            ends = spilledEnds.data();
+        }
+        
+        // One pass over the chunk's text, which holds its lines back to back;
+        // a hit that crosses into the next line is retried one byte on
+        batch.clear();
+        const char* const textEnd = text + textSize;
+        const char* from = text;
+        while (true) {
+            const char* hit = std::search(from, textEnd, searcher);
+            if (hit == textEnd) {
+                break;
+            }
+            const uint32_t offset = static_cast<uint32_t>(hit - text);
+            const size_t index = static_cast<size_t>(std::upper_bound(ends, ends + part.lineCount, offset) - ends);
+            if (offset + query.size() <= ends[index]) {
+                batch.push_back(part.firstLine + index);
+                from = text + ends[index];
+            } else {
+                from = hit + 1;
+            }
+        }
+        
+        if (!batch.empty()) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->found.insert(state->found.end(), batch.begin(), batch.end());
+        }
+    }
+    
+    state->finished = true;
+}
+
+void LogConsole::drainPending() {
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pending_.swap(draining_);
+    }
+    if (draining_.empty()) {
+        return;
+    }
+    
+    // Only the new lines are measured; the content width is a running maximum
+    size_t start = 0;
+    while (start < draining_.size()) {
+        size_t end = draining_.find('\n', start);
+        std::string_view line(draining_.data() + start, end - start);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        
+        if (!query_.empty() && line.find(query_) != std::string_view::npos) {
+            matches_.push_back(buffer_.getEndLine());
+        }
+        buffer_.append(line);
+        contentWidth_ = std::max(contentWidth_, measureText(line.data(), line.size(), fontSize_).x);
+        measuredLines_++;
+        start = end + 1;
+    }
+    
+    draining_.clear();
+    markRenderDirty();
+}
+
+void LogConsole::collectSearchResults() {
+    if (!searchState_) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(searchState_->mutex);
+        if (!searchState_->found.empty()) {
+            // Background matches all come before the lines matched on arrival
+            auto live = std::lower_bound(matches_.begin(), matches_.end(), searchSnapshotEnd_);
+            matches_.insert(live, searchState_->found.begin(), searchState_->found.end());
+            searchState_->found.clear();
+            markRenderDirty();
+        }
+    }
+    
+    if (searchState_->finished) {
+        searchThread_.join();
+        searchState_.reset();
+    }
+}
+
+void LogConsole::pruneMatches() {
+    auto retained = std::lower_bound(matches_.begin(), matches_.end(), buffer_.getFirstLine());
+    matches_.erase(matches_.begin(), retained);
+}
+
+void LogConsole::clampScroll() {
+    const uint64_t previous = topLine_;
+    const uint64_t last = maxTopLine();
+    if (followTail_ || topLine_ > last) {
+        topLine_ = last;
+    }
+    topLine_ = std::max(topLine_, buffer_.getFirstLine());
+    if (topLine_ != previous) {
+        markRenderDirty();
+    }
+}
+
+uint64_t LogConsole::maxTopLine() const {
+    const size_t visible = getVisibleLineCount();
+    return buffer_.getLineCount() > visible ? buffer_.getEndLine() - visible : buffer_.getFirstLine();
+}
+
+void LogConsole::refreshLines() {
+    const size_t visible = getVisibleLineCount();
+    if (slots_.size() != visible) {
+        slots_.assign(visible, LineSlot());
+    }
+    
+    // Lines never change once appended, so a slot only needs a new run when
+    // a different line scrolls into it
+    bool changed = false;
+    const uint64_t end = std::min(topLine_ + visible, buffer_.getEndLine());
+    for (uint64_t line = topLine_; line < end; line++) {
+        LineSlot& slot = slots_[line % visible];
+        if (slot.line == line) {
+            continue;
+        }
+        std::string_view text = buffer_.getLine(line);
+        layoutText(text.data(), text.size(), fontSize_, slot.run);
+        slot.line = line;
+        laidOutLines_++;
+        changed = true;
+    }
+    
+    if (changed) {
+        markRenderDirty();
+    }
+}
+
+} // namespace ui
+} // namespace voidengine
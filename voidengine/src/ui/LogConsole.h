@@ -0,0 +1,133 @@
+#pragma once
+
+#include "UIComponent.h"
+#include "LogBuffer.h"
+#include "TextLayout.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace voidengine {
+namespace ui {
+
+// Scrolling view of a LogBuffer for tailing engine output. append() may be
+// called from any thread; lines are queued and move into the buffer on the
+// next update(), which measures only those new lines. Only the lines in view
+// are laid out, once each, and they keep their glyph runs while they stay in
+// view. The view follows the newest line until the user scrolls up, and
+// follows it again on reaching the bottom.
+//
+// search() scans the retained lines on a background thread while lines keep
+// arriving; matches appear as they are found and are highlighted.
+class LogConsole : public UIComponent {
+public:
+    LogConsole(const std::string& id, const glm::vec2& position, const glm::vec2& size, float fontSize = 14.0f,
+               size_t memoryBudget = LogBuffer::DEFAULT_MEMORY_BUDGET);
+    
+    virtual ~LogConsole();
+    
+    void update(float deltaTime) override;
+    void render() override;
+    core::StringId getStyleType() const override { return core::hashString("LogConsole"); }
+    
+    void onEvent(UIEvent& event) override;
+    
+    // Thread-safe. Text holding several lines is split at each '\n'.
+    void append(std::string_view text);
+    void clear();
+    
+    // Like LogBuffer::setSpillFile; only allowed before anything is appended
+    void setSpillFile(const std::string& path);
+    void setMaxLines(uint64_t maxLines);
+    const LogBuffer& getBuffer() const { return buffer_; }
+    
+    // Absolute line numbers, as in LogBuffer
+    void scrollToLine(uint64_t line);
+    void scrollBy(int64_t lines);
+    uint64_t getTopLine() const { return topLine_; }
+    size_t getVisibleLineCount() const;
+    bool isFollowingTail() const { return followTail_; }
+    void setFollowTail(bool follow);
+    
+    float getLineHeight() const { return fontSize_ * 1.25f; }
+    // Width of the widest line measured so far
+    float getContentWidth() const { return contentWidth_; }
+    
+    // Case-sensitive; an empty query clears the search
+    void search(std::string query);
+    void cancelSearch();
+    const std::string& getSearchQuery() const { return query_; }
+    bool isSearching() const;
+    // Ascending absolute line numbers of the lines still retained
+    const std::vector<uint64_t>& getSearchMatches() const { return matches_; }
+    // Scrolls the next or previous match below or above the top line into
+    // view; false when there is none
+    bool scrollToNextMatch();
+    bool scrollToPreviousMatch();
+    
+    // Lines measured on arrival and lines laid out for display since
+    // construction
+    uint64_t getMeasuredLineCount() const { return measuredLines_; }
+    uint64_t getLaidOutLineCount() const { return laidOutLines_; }
+
+private:
+    struct LineSlot {
+        uint64_t line = NO_LINE;
+        TextRun run;
+    };
+    
+    // Shared with the search thread
+    struct SearchState {
+        std::atomic<bool> cancelled{false};
+        std::atomic<bool> finished{false};
+        std::mutex mutex;
+        std::vector<uint64_t> found;
+    };
+    
+    static constexpr uint64_t NO_LINE = static_cast<uint64_t>(-1);
+    
+    static void runSearch(std::shared_ptr<SearchState> state, LogBuffer::Snapshot snapshot, std::string query);
+    
+    void drainPending();
+    void collectSearchResults();
+    void pruneMatches();
+    void clampScroll();
+    uint64_t maxTopLine() const;
+    void refreshLines();
+    
+    float fontSize_;
+    LogBuffer buffer_;
+    
+    std::mutex pendingMutex_;
+    std::string pending_;
+    // Swapped with pending_ so both keep their capacity
+    std::string draining_;
+    
+    uint64_t topLine_ = 0;
+    bool followTail_ = true;
+    float scrollSpeed_ = 3.0f;
+    float contentWidth_ = 0.0f;
+    
+    std::vector<LineSlot> slots_;
+    
+    std::string query_;
+    std::vector<uint64_t> matches_;
+    // Lines from here on are searched as they arrive; the ones before are
+    // left to the background scan
+    uint64_t searchSnapshotEnd_ = 0;
+    std::shared_ptr<SearchState> searchState_;
+    std::thread searchThread_;
+    
+    uint64_t measuredLines_ = 0;
+    uint64_t laidOutLines_ = 0;
+};
+
+} // namespace ui
+} // namespace voidengine
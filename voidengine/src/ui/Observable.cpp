@@ -0,0 +1,189 @@
+#include "Observable.h"
+#include <algorithm>
+
+namespace voidengine {
+namespace ui {
+
+std::unique_ptr<BindingScheduler> gBindingScheduler = nullptr;
+
+BindingScheduler& getBindingScheduler() {
+    if (!gBindingScheduler) {
+        gBindingScheduler = std::make_unique<BindingScheduler>();
+    }
+    return *gBindingScheduler;
+}
+
+namespace {
+
+thread_local DependencyObserver* tTrackingObserver = nullptr;
+
+// A pass is one run of everything queued before it; more than a few means a
+// binding keeps changing its own inputs
+constexpr int MAX_FLUSH_PASSES = 8;
+
+} // namespace
+
+DependencyObserver::~DependencyObserver() {
+    for (const Dependency& dependency : dependencies_) {
+        dependency.observable->removeObserver(dependency.slot);
+    }
+    if (tTrackingObserver == this) {
+        tTrackingObserver = nullptr;
+    }
+}
+
+DependencyObserver* DependencyObserver::beginTracking() {
+    for (const Dependency& dependency : dependencies_) {
+        dependency.observable->removeObserver(dependency.slot);
+    }
+    dependencies_.clear();
+    
+    DependencyObserver* previous = tTrackingObserver;
+    tTrackingObserver = this;
+    return previous;
+}
+
+void DependencyObserver::endTracking(DependencyObserver* previous) {
+    tTrackingObserver = previous;
+}
+
+void DependencyObserver::addDependency(ObservableBase* observable) {
+    // Dependency sets are small, and a value read twice must subscribe once
+    for (const Dependency& dependency : dependencies_) {
+        if (dependency.observable == observable) {
+            return;
+        }
+    }
+    dependencies_.push_back(Dependency{observable, observable->observers_.size()});
+    observable->observers_.push_back(this);
+}
+
+void DependencyObserver::removeDependency(ObservableBase* observable) {
+    for (Dependency& dependency : dependencies_) {
+        if (dependency.observable == observable) {
+            dependency = dependencies_.back();
+            dependencies_.pop_back();
+            return;
+        }
+    }
+}
+
+ObservableBase::~ObservableBase() {
+    for (DependencyObserver* observer : observers_) {
+        observer->removeDependency(this);
+    }
+}
+
+void ObservableBase::trackRead() const {
+    if (tTrackingObserver) {
+        tTrackingObserver->addDependency(const_cast<ObservableBase*>(this));
+    }
+}
+
+void ObservableBase::notifyObservers() {
+    // Observers only mark themselves here, so the list cannot change under us
+    for (DependencyObserver* observer : observers_) {
+        observer->onDependencyChanged();
+    }
+}
+
+void ObservableBase::removeObserver(size_t slot) const {
+    // The last observer moves into the freed slot and must learn where it went
+    DependencyObserver* moved = observers_.back();
+    observers_[slot] = moved;
+    observers_.pop_back();
+    if (slot < observers_.size()) {
+        for (DependencyObserver::Dependency& dependency : moved->dependencies_) {
+            if (dependency.observable == this) {
+                dependency.slot = slot;
+                break;
+            }
+        }
+    }
+}
+
+Binding::Binding(std::function<void()> effect) : effect_(std::move(effect)) {
+    run();
+}
+
+Binding::~Binding() {
+    // Also covers a binding destroyed mid-flush, which is no longer marked
+    // scheduled but may still be waiting its turn in the running pass
+    if (gBindingScheduler) {
+        gBindingScheduler->cancel(this);
+    }
+}
+
+void Binding::run() {
+    track(effect_);
+}
+
+void Binding::onDependencyChanged() {
+    if (!scheduled_) {
+        getBindingScheduler().schedule(this);
+    }
+}
+
+void BindingScheduler::schedule(Binding* binding) {
+    binding->scheduled_ = true;
+    pending_.push_back(binding);
+}
+
+void BindingScheduler::cancel(Binding* binding) {
+    binding->scheduled_ = false;
+    // Null out rather than erase, since flush() may be iterating running_
+    std::replace(pending_.begin(), pending_.end(), binding, static_cast<Binding*>(nullptr));
+    std::replace(running_.begin(), running_.end(), binding, static_cast<Binding*>(nullptr));
+}
+
+size_t BindingScheduler::flush() {
+    size_t ran = 0;
+    
+    for (int pass = 0; pass < MAX_FLUSH_PASSES && !pending_.empty(); pass++) {
+        running_.swap(pending_);
+        // Cleared up front so a binding re-queued by an earlier one in this
+        // pass is queued exactly once for the next
+        for (Binding* binding : running_) {
+            if (binding) {
+                binding->scheduled_ = false;
+            }
+        }
+        for (size_t i = 0; i < running_.size(); i++) {
+            Binding* binding = running_[i];
+            if (!binding) {
+                continue;
+            }
+            binding->run();
+            ran++;
+        }
+        running_.clear();
+    }
+    
+    return ran;
+}
+
+FormatBuffer& FormatBuffer::append(std::string_view text) {
+    size_t count = std::min(text.size(), CAPACITY - size_);
+    std::copy(text.data(), text.data() + count, data_ + size_);
+    size_ += count;
+    return *this;
+}
+
+FormatBuffer& FormatBuffer::append(char c) {
+    if (size_ < CAPACITY) {
+        data_[size_++] = c;
+    }
+    return *this;
+}
+
+FormatBuffer& FormatBuffer::append(double value, int precision) {
+    std::to_chars_result result = std::to_chars(data_ + size_, data_ + CAPACITY, value,
+                                                std::chars_format::fixed, precision);
+    if (result.ec == std::errc()) {
+        size_ = static_cast<size_t>(result.ptr - data_);
+    }
+    return *this;
+}
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace voidengine {
+namespace ui {
+
+class ObservableBase;
+
+// Anything that reads observables and wants to hear when they change. Reads
+// made inside track() become the dependency set, replacing the previous one,
+// so a branch that stops reading a value also stops listening to it.
+class DependencyObserver {
+public:
+    DependencyObserver() = default;
+    virtual ~DependencyObserver();
+    
+    DependencyObserver(const DependencyObserver&) = delete;
+    DependencyObserver& operator=(const DependencyObserver&) = delete;
+    
+    // Called from inside set(); only record that work is needed here
+    virtual void onDependencyChanged() = 0;
+    
+    size_t getDependencyCount() const { return dependencies_.size(); }
+
+protected:
+    template <typename Fn>
+    void track(Fn&& fn);
+
+private:
+    friend class ObservableBase;
+    
+    // Drops the current dependencies and makes this the tracking observer
+    DependencyObserver* beginTracking();
+    void endTracking(DependencyObserver* previous);
+    void addDependency(ObservableBase* observable);
+    void removeDependency(ObservableBase* observable);
+    
+    struct Dependency {
+        ObservableBase* observable;
+        // Where this observer sits in the observable's list, so unsubscribing
+        // does not search it; many labels may share one observable
+        size_t slot;
+    };
+    
+    std::vector<Dependency> dependencies_;
+};
+
+class ObservableBase {
+public:
+    ObservableBase() = default;
+    virtual ~ObservableBase();
+    
+    ObservableBase(const ObservableBase&) = delete;
+    ObservableBase& operator=(const ObservableBase&) = delete;
+    
+    size_t getObserverCount() const { return observers_.size(); }
+
+protected:
+    // Subscribes the observer currently tracking, if any
+    void trackRead() const;
+    void notifyObservers();
+
+private:
+    friend class DependencyObserver;
+    
+    void removeObserver(size_t slot) const;
+    
+    mutable std::vector<DependencyObserver*> observers_;
+};
+
+// A value that notifies its readers when it changes. Main thread only.
+template <typename T>
+class Observable : public ObservableBase {
+public:
+    Observable() = default;
+    explicit Observable(T value) : value_(std::move(value)) {}
+    
+    // Inside a binding or computed this also subscribes it
+    const T& get() const {
+        trackRead();
+        return value_;
+    }
+    
+    // Reads without subscribing
+    const T& peek() const { return value_; }
+    
+    // Setting an equal value notifies no one
+    void set(const T& value) {
+        if (value_ == value) {
+            return;
+        }
+        value_ = value;
+        notifyObservers();
+    }
+
+private:
+    T value_ = T();
+};
+
+// A value derived from other observables. Changes are pushed as far as
+// marking it stale; it recomputes the next time it is read, so any number of
+// changes to its inputs within a frame cost one evaluation.
+template <typename T>
+class Computed : public ObservableBase, private DependencyObserver {
+public:
+    explicit Computed(std::function<T()> compute) : compute_(std::move(compute)) {}
+    
+    const T& get() {
+        trackRead();
+        if (stale_) {
+            track([this]() { value_ = compute_(); });
+            stale_ = false;
+        }
+        return value_;
+    }
+
+private:
+    void onDependencyChanged() override {
+        if (!stale_) {
+            stale_ = true;
+            notifyObservers();
+        }
+    }
+    
+    std::function<T()> compute_;
+    T value_ = T();
+    bool stale_ = true;
+};
+
+// A side effect that runs once when created and again at the next flush after
+// anything it read changed. Changes are batched: a value set many times in a
+// frame runs its bindings once.
+class Binding : private DependencyObserver {
+public:
+    explicit Binding(std::function<void()> effect);
+    ~Binding() override;
+    
+    void run();
+
+private:
+    friend class BindingScheduler;
+    
+    void onDependencyChanged() override;
+    
+    std::function<void()> effect_;
+    bool scheduled_ = false;
+};
+
+// Queues bindings whose inputs changed; UIManager::update flushes it once per
+// frame before layout. Main thread only.
+class BindingScheduler {
+public:
+    void schedule(Binding* binding);
+    void cancel(Binding* binding);
+    
+    // Runs each queued binding once and returns how many ran. Bindings queued
+    // by those runs are flushed too, up to a bounded number of passes so a
+    // binding that feeds itself waits for the next frame instead of spinning.
+    size_t flush();
+    
+    size_t getPendingCount() const { return pending_.size(); }
+
+private:
+    std::vector<Binding*> pending_;
+    std::vector<Binding*> running_;
+};
+
+extern std::unique_ptr<BindingScheduler> gBindingScheduler;
+
+BindingScheduler& getBindingScheduler();
+
+// Fixed-capacity text assembled with std::to_chars, for bindings that format
+// numbers every time they run. Output past the capacity is cut off.
+class FormatBuffer {
+public:
+    static constexpr size_t CAPACITY = 128;
+    
+    FormatBuffer& append(std::string_view text);
+    FormatBuffer& append(char c);
+    FormatBuffer& append(double value, int precision);
+    
+    template <typename Integer, typename = std::enable_if_t<std::is_integral<Integer>::value &&
+                                                            !std::is_same<Integer, bool>::value &&
+                                                            !std::is_same<Integer, char>::value>>
+    FormatBuffer& append(Integer value) {
+        std::to_chars_result result = std::to_chars(data_ + size_, data_ + CAPACITY, value);
+        if (result.ec == std::errc()) {
+            size_ = static_cast<size_t>(result.ptr - data_);
+        }
+        return *this;
+    }
+    
+    void clear() { size_ = 0; }
+    std::string_view view() const { return std::string_view(data_, size_); }
+    size_t size() const { return size_; }
+
+private:
+    char data_[CAPACITY];
+    size_t size_ = 0;
+};
+
+using TextFormatter = std::function<void(FormatBuffer&)>;
+
+template <typename Fn>
+void DependencyObserver::track(Fn&& fn) {
+    DependencyObserver* previous = beginTracking();
+    try {
+        fn();
+    } catch (...) {
+        endTracking(previous);
+        throw;
+    }
+    endTracking(previous);
+}
+
+} // namespace ui
+} // namespace voidengine
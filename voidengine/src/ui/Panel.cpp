@@ -1,17 +1,29 @@
 #include "Panel.h"
-#include <algorithm>
+#include "UIRenderer.h"
 #include <stdexcept>
-#include <GLFW/glfw3.h>
 
 namespace voidengine {
 namespace ui {
 
+Panel::Panel(const std::string& id, const glm::vec2& position, const glm::vec2& size, bool hasBorder)
+    : UIComponent(id, position, size) {
+    capabilities_ = UICapabilities::POINTER;
+    setFlag(UIFlags::BORDER, hasBorder);
+    refreshStyle();
+}
+
 Panel::Panel(const std::string& id, const glm::vec2& position, const glm::vec2& size,
-             const glm::vec4& backgroundColor, bool hasBorder, const glm::vec4& borderColor)
-    : UIComponent(id, position, size),
-      backgroundColor_(backgroundColor),
-      hasBorder_(hasBorder),
-      borderColor_(borderColor) {
+             const glm::vec4& backgroundColor, bool hasBorder)
+    : Panel(id, position, size, hasBorder) {
+    setBackgroundColor(backgroundColor);
+}
+
+Panel::~Panel() {
+    for (auto& child : children_) {
+        if (child->getParent() == this) {
+            child->setParent(nullptr);
+        }
+    }
 }
 
 void Panel::initialize() {
@@ -27,76 +39,134 @@ void Panel::update(float deltaTime) {
 }
 
 void Panel::render() {
-    if (!isVisible_) {
+    if (!isVisible()) {
         return;
     }
     
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    const glm::vec2 position = getPosition();
+    const glm::vec2 size = getSize();
+    const UIStyle& panelStyle = style();
     
-    glColor4f(backgroundColor_.r, backgroundColor_.g, backgroundColor_.b, backgroundColor_.a);
-    glBegin(GL_QUADS);
-    glVertex2f(position_.x, position_.y);
-    glVertex2f(position_.x + size_.x, position_.y);
-    glVertex2f(position_.x + size_.x, position_.y + size_.y);
-    glVertex2f(position_.x, position_.y + size_.y);
-    glEnd();
+    if (panelStyle.shadowBlur > 0.0f) {
+        drawShadow(position + glm::vec2(0.0f, panelStyle.shadowBlur * 0.5f), size, panelStyle.borderRadius,
+                   panelStyle.shadowBlur, panelStyle.shadowColor);
+    }
     
-    if (hasBorder_) {
-        glColor4f(borderColor_.r, borderColor_.g, borderColor_.b, borderColor_.a);
-        glLineWidth(borderWidth_);
-        glBegin(GL_LINE_LOOP);
-        glVertex2f(position_.x, position_.y);
-        glVertex2f(position_.x + size_.x, position_.y);
-        glVertex2f(position_.x + size_.x, position_.y + size_.y);
-        glVertex2f(position_.x, position_.y + size_.y);
-        glEnd();
+    if (skin_.atlas) {
+        drawNineSlice(position, size, skin_.atlas->getTexture(), skin_.region);
+    } else if (panelStyle.borderRadius > 0.0f) {
+        drawRoundedRect(position, size, panelStyle.borderRadius, panelStyle.backgroundColor);
+        if (isBorderEnabled()) {
+            drawRoundedRectOutline(position, size, panelStyle.borderRadius, panelStyle.borderColor,
+                                   panelStyle.borderWidth);
+        }
+    } else {
+        drawRect(position, size, panelStyle.backgroundColor);
+        if (isBorderEnabled()) {
+            drawRectOutline(position, size, panelStyle.borderColor, panelStyle.borderWidth);
+        }
     }
     
     for (auto& child : children_) {
-        child->render();
+        if (child->isVisible()) {
+            child->render();
+        }
+    }
+}
+
+void Panel::onEvent(UIEvent& event) {
+    // Panels are opaque to clicks so they never fall through to gameplay input,
+    // including clicks a child left unhandled on the way back up
+    if (event.type == UIEventType::MOUSE_BUTTON &&
+        (event.phase == UIEventPhase::TARGET || event.phase == UIEventPhase::BUBBLE)) {
+        event.consume();
     }
 }
 
+void Panel::setNineSlice(std::shared_ptr<const TextureAtlas> atlas, const std::string& region) {
+    if (!atlas) {
+        throw std::invalid_argument("Panel nine-slice needs an atlas");
+    }
+    skin_.region = atlas->getRegion(region);
+    skin_.atlas = std::move(atlas);
+    markRenderDirty();
+}
+
+void Panel::clearNineSlice() {
+    skin_.atlas.reset();
+    markRenderDirty();
+}
+
+void Panel::setBackgroundColor(const glm::vec4& color) {
+    StyleDeclaration declaration;
+    declaration.setColor(StyleProperty::BACKGROUND, color);
+    setStyleOverride(declaration);
+}
+
+void Panel::setBorderColor(const glm::vec4& color) {
+    StyleDeclaration declaration;
+    declaration.setColor(StyleProperty::BORDER, color);
+    setStyleOverride(declaration);
+}
+
 void Panel::addComponent(std::shared_ptr<UIComponent> component) {
     if (!component) {
         throw std::invalid_argument("Cannot add null component to panel");
     }
     
-    auto it = std::find_if(children_.begin(), children_.end(),
-                          [&](const std::shared_ptr<UIComponent>& child) {
-                              return child->getId() == component->getId();
-                          });
-    
-    if (it != children_.end()) {
+    if (!childIndexById_.insert(component->getIdSymbol(), children_.size()).second) {
         throw std::invalid_argument("Component with ID " + component->getId() + " already exists in panel");
     }
     
+    component->setParent(this);
     children_.push_back(component);
+    markLayoutStructureDirty();
 }
 
-void Panel::removeComponent(const std::string& componentId) {
-    auto it = std::find_if(children_.begin(), children_.end(),
-                          [&](const std::shared_ptr<UIComponent>& child) {
-                              return child->getId() == componentId;
-                          });
-    
-    if (it != children_.end()) {
-        children_.erase(it);
+size_t Panel::getChildIndex(const UIComponent& child) const {
+    const size_t* found = childIndexById_.find(child.getIdSymbol());
+    if (found && children_[*found].get() == &child) {
+        return *found;
     }
+    return children_.size();
 }
 
-std::shared_ptr<UIComponent> Panel::getComponent(const std::string& componentId) {
-    auto it = std::find_if(children_.begin(), children_.end(),
-                          [&](const std::shared_ptr<UIComponent>& child) {
-                              return child->getId() == componentId;
-                          });
+void Panel::reserveChildren(size_t count) {
+    children_.reserve(count);
+    childIndexById_.reserve(count);
+}
+
+void Panel::removeComponent(const std::string& componentId) {
+    removeComponent(core::findString(componentId));
+}
+
+void Panel::removeComponent(core::StringId componentId) {
+    const size_t* found = childIndexById_.find(componentId);
+    if (!found) {
+        return;
+    }
+    
+    size_t index = *found;
+    childIndexById_.erase(componentId);
     
-    if (it != children_.end()) {
-        return *it;
+    children_[index]->setParent(nullptr);
+    children_.erase(children_.begin() + index);
+    
+    // Children keep their insertion order for rendering, so later siblings shift down
+    for (size_t i = index; i < children_.size(); i++) {
+        childIndexById_[children_[i]->getIdSymbol()] = i;
     }
     
-    return nullptr;
+    markLayoutStructureDirty();
+}
+
+std::shared_ptr<UIComponent> Panel::getComponent(const std::string& componentId) {
+    return getComponent(core::findString(componentId));
+}
+
+std::shared_ptr<UIComponent> Panel::getComponent(core::StringId componentId) {
+    const size_t* found = childIndexById_.find(componentId);
+    return found ? children_[*found] : nullptr;
 }
 
 } // namespace ui
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "UIComponent.h"
+#include "TextureAtlas.h"
+#include "../core/FlatHashMap.h"
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -9,35 +11,55 @@ namespace ui {
 
 class Panel : public UIComponent {
 public:
-    Panel(const std::string& id, const glm::vec2& position, const glm::vec2& size, 
-          const glm::vec4& backgroundColor = glm::vec4(0.2f, 0.2f, 0.2f, 0.8f),
-          bool hasBorder = true, const glm::vec4& borderColor = glm::vec4(0.8f, 0.8f, 0.8f, 1.0f));
+    // Colors come from the style sheet
+    Panel(const std::string& id, const glm::vec2& position, const glm::vec2& size, bool hasBorder = true);
+    // Overrides the sheet's background for this panel only
+    Panel(const std::string& id, const glm::vec2& position, const glm::vec2& size,
+          const glm::vec4& backgroundColor, bool hasBorder = true);
     
-    virtual ~Panel() = default;
+    virtual ~Panel();
     
     void initialize() override;
     void update(float deltaTime) override;
+    bool forwardsUpdateToChildren() const override { return true; }
     void render() override;
+    core::StringId getStyleType() const override { return core::hashString("Panel"); }
+    
+    void onEvent(UIEvent& event) override;
+    
+    size_t getChildCount() const override { return children_.size(); }
+    UIComponent* getChild(size_t index) const override { return children_[index].get(); }
+    size_t getChildIndex(const UIComponent& child) const override;
     
     void addComponent(std::shared_ptr<UIComponent> component);
+    void reserveChildren(size_t count);
     void removeComponent(const std::string& componentId);
+    // The symbol overloads take an interned id, as from findString() or
+    // getIdSymbol(); a hashed one misses ids that collided
+    void removeComponent(core::StringId componentId);
     std::shared_ptr<UIComponent> getComponent(const std::string& componentId);
+    std::shared_ptr<UIComponent> getComponent(core::StringId componentId);
+    
+    // The color setters override the sheet for this panel
+    void setBackgroundColor(const glm::vec4& color);
+    const glm::vec4& getBackgroundColor() const { return style().backgroundColor; }
     
-    void setBackgroundColor(const glm::vec4& color) { backgroundColor_ = color; }
-    const glm::vec4& getBackgroundColor() const { return backgroundColor_; }
+    void setBorderEnabled(bool enabled) { setFlag(UIFlags::BORDER, enabled); markRenderDirty(); }
+    bool isBorderEnabled() const { return (registry_->flags(handle_) & UIFlags::BORDER) != 0; }
     
-    void setBorderEnabled(bool enabled) { hasBorder_ = enabled; }
-    bool isBorderEnabled() const { return hasBorder_; }
+    void setBorderColor(const glm::vec4& color);
+    const glm::vec4& getBorderColor() const { return style().borderColor; }
     
-    void setBorderColor(const glm::vec4& color) { borderColor_ = color; }
-    const glm::vec4& getBorderColor() const { return borderColor_; }
+    // Draws the atlas region nine-slice in place of the background and
+    // border. Throws std::out_of_range for unknown regions.
+    void setNineSlice(std::shared_ptr<const TextureAtlas> atlas, const std::string& region);
+    void clearNineSlice();
+    bool hasNineSlice() const { return skin_.atlas != nullptr; }
     
 private:
     std::vector<std::shared_ptr<UIComponent>> children_;
-    glm::vec4 backgroundColor_;
-    bool hasBorder_;
-    glm::vec4 borderColor_;
-    float borderWidth_ = 1.0f;
+    core::FlatHashMap<core::StringId, size_t> childIndexById_;
+    NineSliceSkin skin_;
 };
 
 } // namespace ui
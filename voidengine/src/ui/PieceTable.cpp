@@ -0,0 +1,221 @@
+#include "PieceTable.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace voidengine {
+namespace ui {
+
+PieceTable::PieceTable(std::string text) {
+    assign(std::move(text));
+}
+
+void PieceTable::assign(std::string text) {
+    original_ = std::move(text);
+    added_.clear();
+    pieces_.clear();
+    size_ = original_.size();
+    if (size_ > 0) {
+        pieces_.push_back(Piece{Source::ORIGINAL, 0, size_});
+    }
+    
+    lineStarts_.assign(1, 0);
+    for (const char* p = original_.data(), *end = p + size_;
+         (p = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)))) != nullptr; p++) {
+        lineStarts_.push_back(static_cast<size_t>(p - original_.data()) + 1);
+    }
+    
+    cachedPiece_ = 0;
+    cachedPieceStart_ = 0;
+}
+
+const char* PieceTable::pieceData(const Piece& piece) const {
+    return (piece.source == Source::ORIGINAL ? original_.data() : added_.data()) + piece.start;
+}
+
+size_t PieceTable::findPiece(size_t offset, size_t& pieceStart) const {
+    size_t index = cachedPiece_;
+    size_t start = cachedPieceStart_;
+    if (index > pieces_.size()) {
+        index = 0;
+        start = 0;
+    }
+    
+    while (index > 0 && start > offset) {
+        index--;
+        start -= pieces_[index].length;
+    }
+    while (index < pieces_.size() && start + pieces_[index].length <= offset) {
+        start += pieces_[index].length;
+        index++;
+    }
+    
+    cachedPiece_ = index;
+    cachedPieceStart_ = start;
+    pieceStart = start;
+    return index;
+}
+
+void PieceTable::insert(size_t offset, std::string_view text) {
+    if (offset > size_) {
+        throw std::out_of_range("PieceTable insert offset out of range");
+    }
+    if (text.empty()) {
+        return;
+    }
+    
+    size_t addedStart = added_.size();
+    added_.append(text.data(), text.size());
+    
+    size_t pieceStart = 0;
+    size_t index = findPiece(offset, pieceStart);
+    Piece inserted{Source::ADDED, addedStart, text.size()};
+    
+    bool extendsPrevious = offset == pieceStart && index > 0 &&
+                           pieces_[index - 1].source == Source::ADDED &&
+                           pieces_[index - 1].start + pieces_[index - 1].length == addedStart;
+    
+    if (extendsPrevious) {
+        // Typing continues the previous insertion: grow its piece in place
+        Piece& previous = pieces_[index - 1];
+        cachedPiece_ = index - 1;
+        cachedPieceStart_ = pieceStart - previous.length;
+        previous.length += text.size();
+    } else if (offset == pieceStart) {
+        pieces_.insert(pieces_.begin() + static_cast<std::ptrdiff_t>(index), inserted);
+    } else {
+        Piece& split = pieces_[index];
+        size_t head = offset - pieceStart;
+        Piece tail{split.source, split.start + head, split.length - head};
+        split.length = head;
+        pieces_.insert(pieces_.begin() + static_cast<std::ptrdiff_t>(index) + 1, {inserted, tail});
+    }
+    size_ += text.size();
+    
+    // Starts after the insertion point move; a start equal to it stays, since
+    // the new text joins the beginning of that line
+    auto firstMoved = std::upper_bound(lineStarts_.begin(), lineStarts_.end(), offset);
+    for (auto it = firstMoved; it != lineStarts_.end(); ++it) {
+        *it += text.size();
+    }
+    
+    size_t newlineCount = static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+    if (newlineCount > 0) {
+        size_t position = static_cast<size_t>(firstMoved - lineStarts_.begin());
+        lineStarts_.insert(firstMoved, newlineCount, 0);
+        for (size_t i = 0; i < text.size(); i++) {
+            if (text[i] == '\n') {
+                lineStarts_[position++] = offset + i + 1;
+            }
+        }
+    }
+}
+
+void PieceTable::erase(size_t offset, size_t length) {
+    if (offset > size_ || length > size_ - offset) {
+        throw std::out_of_range("PieceTable erase range out of range");
+    }
+    if (length == 0) {
+        return;
+    }
+    
+    size_t end = offset + length;
+    size_t firstStart = 0;
+    size_t first = findPiece(offset, firstStart);
+    
+    // Walk to the piece holding the last erased byte
+    size_t last = first;
+    size_t lastStart = firstStart;
+    while (lastStart + pieces_[last].length < end) {
+        lastStart += pieces_[last].length;
+        last++;
+    }
+    
+    Piece replacement[2];
+    size_t replacementCount = 0;
+    if (offset > firstStart) {
+        Piece head = pieces_[first];
+        head.length = offset - firstStart;
+        replacement[replacementCount++] = head;
+    }
+    if (end < lastStart + pieces_[last].length) {
+        Piece tail = pieces_[last];
+        size_t skip = end - lastStart;
+        tail.start += skip;
+        tail.length -= skip;
+        replacement[replacementCount++] = tail;
+    }
+    
+    auto eraseBegin = pieces_.begin() + static_cast<std::ptrdiff_t>(first);
+    auto eraseEnd = pieces_.begin() + static_cast<std::ptrdiff_t>(last) + 1;
+    size_t removedCount = last - first + 1;
+    if (replacementCount <= removedCount) {
+        std::copy(replacement, replacement + replacementCount, eraseBegin);
+        pieces_.erase(eraseBegin + static_cast<std::ptrdiff_t>(replacementCount), eraseEnd);
+    } else {
+        // Erasing inside a single piece splits it in two
+        *eraseBegin = replacement[0];
+        pieces_.insert(eraseBegin + 1, replacement[1]);
+    }
+    
+    size_ -= length;
+    cachedPiece_ = first;
+    cachedPieceStart_ = firstStart;
+    
+    // Starts in (offset, end] belonged to erased newlines
+    auto removeBegin = std::upper_bound(lineStarts_.begin(), lineStarts_.end(), offset);
+    auto removeEnd = std::upper_bound(removeBegin, lineStarts_.end(), end);
+    auto next = lineStarts_.erase(removeBegin, removeEnd);
+    for (; next != lineStarts_.end(); ++next) {
+        *next -= length;
+    }
+}
+
+char PieceTable::at(size_t offset) const {
+    if (offset >= size_) {
+        throw std::out_of_range("PieceTable offset out of range");
+    }
+    
+    size_t pieceStart = 0;
+    size_t index = findPiece(offset, pieceStart);
+    return pieceData(pieces_[index])[offset - pieceStart];
+}
+
+void PieceTable::copyRange(size_t offset, size_t length, std::string& out) const {
+    if (offset > size_ || length > size_ - offset) {
+        throw std::out_of_range("PieceTable range out of range");
+    }
+    
+    size_t pieceStart = 0;
+    size_t index = findPiece(offset, pieceStart);
+    size_t skip = offset - pieceStart;
+    
+    while (length > 0) {
+        const Piece& piece = pieces_[index++];
+        size_t count = std::min(piece.length - skip, length);
+        out.append(pieceData(piece) + skip, count);
+        length -= count;
+        skip = 0;
+    }
+}
+
+std::string PieceTable::getText() const {
+    std::string text;
+    text.reserve(size_);
+    for (const Piece& piece : pieces_) {
+        text.append(pieceData(piece), piece.length);
+    }
+    return text;
+}
+
+size_t PieceTable::getLineEnd(size_t line) const {
+    return line + 1 < lineStarts_.size() ? lineStarts_[line + 1] - 1 : size_;
+}
+
+size_t PieceTable::getLineAt(size_t offset) const {
+    auto it = std::upper_bound(lineStarts_.begin(), lineStarts_.end(), offset);
+    return static_cast<size_t>(it - lineStarts_.begin()) - 1;
+}
+
+} // namespace ui
+} // namespace voidengine
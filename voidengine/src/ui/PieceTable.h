@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace voidengine {
+namespace ui {
+
+// Text buffer for editors. The loaded text is never modified; inserted text
+// is appended to a second buffer, and the document is a list of pieces that
+// reference spans of either one. An edit splits at most two pieces and never
+// moves document text, and typing at the end of the last insertion just
+// extends its piece.
+//
+// A sorted table of line start offsets is maintained alongside, so line
+// lookups are a binary search and an edit only shifts the starts after it.
+class PieceTable {
+public:
+    PieceTable() = default;
+    explicit PieceTable(std::string text);
+    
+    // Replaces the whole document
+    void assign(std::string text);
+    
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    
+    void insert(size_t offset, std::string_view text);
+    void erase(size_t offset, size_t length);
+    
+    char at(size_t offset) const;
+    // Appends [offset, offset + length) to out
+    void copyRange(size_t offset, size_t length, std::string& out) const;
+    std::string getText() const;
+    
+    // Lines are separated by '\n'; an empty document has one empty line
+    size_t getLineCount() const { return lineStarts_.size(); }
+    size_t getLineStart(size_t line) const { return lineStarts_[line]; }
+    // Offset of the line's '\n', or the document end for the last line
+    size_t getLineEnd(size_t line) const;
+    size_t getLineAt(size_t offset) const;
+    
+    size_t getPieceCount() const { return pieces_.size(); }
+    
+private:
+    enum class Source : uint8_t {
+        ORIGINAL,
+        ADDED
+    };
+    
+    struct Piece {
+        Source source;
+        size_t start;
+        size_t length;
+    };
+    
+    const char* pieceData(const Piece& piece) const;
+    // Index of the piece holding offset, or pieces_.size() at the very end;
+    // pieceStart receives that piece's document offset
+    size_t findPiece(size_t offset, size_t& pieceStart) const;
+    
+    std::string original_;
+    std::string added_;
+    std::vector<Piece> pieces_;
+    size_t size_ = 0;
+    
+    std::vector<size_t> lineStarts_ = std::vector<size_t>(1, 0);
+    
+    // Edits cluster around the cursor, so the last lookup is a good start
+    mutable size_t cachedPiece_ = 0;
+    mutable size_t cachedPieceStart_ = 0;
+};
+
+} // namespace ui
+} // namespace voidengine
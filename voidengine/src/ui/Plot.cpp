@@ -0,0 +1,183 @@
+#include "Plot.h"
+#include "UIRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+constexpr float PADDING = 4.0f;
+constexpr float AREA_ALPHA = 0.35f;
+
+} // namespace
+
+Plot::Plot(const std::string& id, const glm::vec2& position, const glm::vec2& size)
+    : UIComponent(id, position, size) {
+    refreshStyle();
+}
+
+void Plot::update(float deltaTime) {
+    for (SeriesEntry& entry : series_) {
+        if (entry.series->getVersion() != entry.seenVersion) {
+            entry.seenVersion = entry.series->getVersion();
+            markRenderDirty();
+        }
+    }
+}
+
+void Plot::render() {
+    if (!isVisible()) {
+        return;
+    }
+    
+    const glm::vec2 position = getPosition();
+    const glm::vec2 size = getSize();
+    const glm::vec2 inner = glm::max(size - glm::vec2(2.0f * PADDING), glm::vec2(0.0f));
+    const glm::vec2 origin = position + glm::vec2(PADDING);
+    
+    drawRect(position, size, style().backgroundColor);
+    
+    uint64_t begin = UINT64_MAX;
+    uint64_t end = 0;
+    for (const SeriesEntry& entry : series_) {
+        if (!entry.series->empty()) {
+            begin = std::min(begin, entry.series->getBeginIndex());
+            end = std::max(end, entry.series->getEndIndex());
+        }
+    }
+    if (window_ > 0 && end > window_) {
+        begin = end - window_;
+    }
+    
+    // One column per pixel, or per sample when there are fewer samples
+    const size_t columns = end > begin ? static_cast<size_t>(std::min<uint64_t>(
+                                             static_cast<uint64_t>(inner.x), end - begin)) : 0;
+    if (columns > 0 && inner.y > 0.0f) {
+        float low = INFINITY;
+        float high = -INFINITY;
+        for (SeriesEntry& entry : series_) {
+            entry.mins.resize(columns);
+            entry.maxs.resize(columns);
+            entry.series->decimate(begin, end, columns, entry.mins.data(), entry.maxs.data());
+            if (autoRange_) {
+                for (size_t c = 0; c < columns; c++) {
+                    // NaN compares false, so empty columns fall through
+                    if (entry.mins[c] < low) {
+                        low = entry.mins[c];
+                    }
+                    if (entry.maxs[c] > high) {
+                        high = entry.maxs[c];
+                    }
+                }
+            }
+        }
+        
+        if (autoRange_) {
+            if (low > high) {
+                valueRange_ = glm::vec2(0.0f, 1.0f);
+            } else if (low == high) {
+                valueRange_ = glm::vec2(low - 0.5f, high + 0.5f);
+            } else {
+                valueRange_ = glm::vec2(low, high);
+            }
+        }
+        
+        const float scale = inner.y / (valueRange_.y - valueRange_.x);
+        const float bottom = origin.y + inner.y;
+        auto toY = [&](float value) { return bottom - (value - valueRange_.x) * scale; };
+        const float baseline = toY(std::clamp(0.0f, valueRange_.x, valueRange_.y));
+        const float columnWidth = inner.x / static_cast<float>(columns);
+        
+        pushClipRect(origin, inner);
+        for (const SeriesEntry& entry : series_) {
+            const glm::vec4 fill(entry.color.r, entry.color.g, entry.color.b, entry.color.a * AREA_ALPHA);
+            float previousMin = NAN;
+            float previousMax = NAN;
+            
+            for (size_t c = 0; c < columns; c++) {
+                const float columnMin = entry.mins[c];
+                const float columnMax = entry.maxs[c];
+                if (std::isnan(columnMin)) {
+                    previousMin = NAN;
+                    previousMax = NAN;
+                    continue;
+                }
+                
+                const float x = origin.x + static_cast<float>(c) * columnWidth;
+                if (entry.style == PlotStyle::AREA) {
+                    const float top = toY(columnMax);
+                    drawRect(glm::vec2(x, std::min(top, baseline)), glm::vec2(columnWidth, std::abs(baseline - top)),
+                             fill);
+                }
+                
+                // Stretched to meet the previous column's span so the line has
+                // no gaps, and at least a pixel thick
+                float spanMin = columnMin;
+                float spanMax = columnMax;
+                if (!std::isnan(previousMin)) {
+                    spanMin = std::min(spanMin, previousMax);
+                    spanMax = std::max(spanMax, previousMin);
+                }
+                const float top = toY(spanMax) - 0.5f;
+                const float height = toY(spanMin) + 0.5f - top;
+                drawRect(glm::vec2(x, top), glm::vec2(std::max(columnWidth, 1.0f), height), entry.color);
+                
+                previousMin = columnMin;
+                previousMax = columnMax;
+            }
+        }
+        popClipRect();
+    }
+    
+    drawRectOutline(position, size, style().borderColor);
+}
+
+size_t Plot::addSeries(const glm::vec4& color, PlotStyle style, size_t capacity) {
+    SeriesEntry entry;
+    entry.series = std::make_unique<PlotSeries>(capacity);
+    entry.color = color;
+    entry.style = style;
+    entry.seenVersion = entry.series->getVersion();
+    series_.push_back(std::move(entry));
+    markRenderDirty();
+    return series_.size() - 1;
+}
+
+PlotSeries& Plot::getSeries(size_t index) {
+    if (index >= series_.size()) {
+        throw std::out_of_range("Plot series index out of range");
+    }
+    return *series_[index].series;
+}
+
+const PlotSeries& Plot::getSeries(size_t index) const {
+    if (index >= series_.size()) {
+        throw std::out_of_range("Plot series index out of range");
+    }
+    return *series_[index].series;
+}
+
+void Plot::setWindow(uint64_t samples) {
+    window_ = samples;
+    markRenderDirty();
+}
+
+void Plot::setValueRange(float min, float max) {
+    if (!(min < max)) {
+        throw std::invalid_argument("Plot value range must have min below max");
+    }
+    valueRange_ = glm::vec2(min, max);
+    autoRange_ = false;
+    markRenderDirty();
+}
+
+void Plot::setAutoRange() {
+    autoRange_ = true;
+    markRenderDirty();
+}
+
+} // namespace ui
+} // namespace voidengine
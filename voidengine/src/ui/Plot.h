@@ -0,0 +1,68 @@
+#pragma once
+
+#include "UIComponent.h"
+#include "PlotSeries.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace voidengine {
+namespace ui {
+
+enum class PlotStyle {
+    LINE,
+    // Filled down to zero, or to the bottom edge when zero is out of range,
+    // with the line on top
+    AREA
+};
+
+// Line and area charts of PlotSeries sharing one horizontal window: the most
+// recent samples up to the newest one in any series. Every series is decimated
+// to one min/max pair per pixel column and drawn as one quad per column for a
+// line, two for an area, so the vertex count depends on the width alone.
+class Plot : public UIComponent {
+public:
+    Plot(const std::string& id, const glm::vec2& position, const glm::vec2& size);
+    
+    void update(float deltaTime) override;
+    void render() override;
+    core::StringId getStyleType() const override { return core::hashString("Plot"); }
+    
+    // Returns the index for getSeries
+    size_t addSeries(const glm::vec4& color, PlotStyle style = PlotStyle::LINE,
+                     size_t capacity = PlotSeries::DEFAULT_CAPACITY);
+    PlotSeries& getSeries(size_t index);
+    const PlotSeries& getSeries(size_t index) const;
+    size_t getSeriesCount() const { return series_.size(); }
+    
+    // Shows the newest samples samples; zero shows everything retained
+    void setWindow(uint64_t samples);
+    uint64_t getWindow() const { return window_; }
+    
+    // A fixed vertical range; otherwise it fits the samples in view
+    void setValueRange(float min, float max);
+    void setAutoRange();
+    bool isAutoRange() const { return autoRange_; }
+    // The range of the last drawn frame
+    glm::vec2 getValueRange() const { return valueRange_; }
+
+private:
+    struct SeriesEntry {
+        std::unique_ptr<PlotSeries> series;
+        glm::vec4 color;
+        PlotStyle style;
+        uint32_t seenVersion = 0;
+        std::vector<float> mins;
+        std::vector<float> maxs;
+    };
+    
+    std::vector<SeriesEntry> series_;
+    uint64_t window_ = 0;
+    bool autoRange_ = true;
+    glm::vec2 valueRange_ = glm::vec2(0.0f, 1.0f);
+};
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,252 @@
+#include "PlotSeries.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VOIDENGINE_PLOT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+constexpr size_t MIN_CAPACITY = 64;
+constexpr size_t FIRST_BUCKET_SIZE = 8;
+// No level is made with fewer buckets than this
+constexpr size_t MIN_LEVEL_BUCKETS = 8;
+
+// Min and max of each run of 8 samples
+void reduceSamples(const float* samples, size_t buckets, float* mins, float* maxs) {
+    size_t b = 0;
+
+#ifdef VOIDENGINE_PLOT_SSE2
+    // Four buckets at a time: fold each to four lanes, transpose so lane i
+    // holds bucket i, then fold across the registers
+    for (; b + 4 <= buckets; b += 4) {
+        const float* p = samples + b * FIRST_BUCKET_SIZE;
+        __m128 a0 = _mm_loadu_ps(p), a1 = _mm_loadu_ps(p + 4);
+        __m128 b0 = _mm_loadu_ps(p + 8), b1 = _mm_loadu_ps(p + 12);
+        __m128 c0 = _mm_loadu_ps(p + 16), c1 = _mm_loadu_ps(p + 20);
+        __m128 d0 = _mm_loadu_ps(p + 24), d1 = _mm_loadu_ps(p + 28);
+        
+        __m128 lowA = _mm_min_ps(a0, a1), lowB = _mm_min_ps(b0, b1);
+        __m128 lowC = _mm_min_ps(c0, c1), lowD = _mm_min_ps(d0, d1);
+        _MM_TRANSPOSE4_PS(lowA, lowB, lowC, lowD);
+        _mm_storeu_ps(mins + b, _mm_min_ps(_mm_min_ps(lowA, lowB), _mm_min_ps(lowC, lowD)));
+        
+        __m128 highA = _mm_max_ps(a0, a1), highB = _mm_max_ps(b0, b1);
+        __m128 highC = _mm_max_ps(c0, c1), highD = _mm_max_ps(d0, d1);
+        _MM_TRANSPOSE4_PS(highA, highB, highC, highD);
+        _mm_storeu_ps(maxs + b, _mm_max_ps(_mm_max_ps(highA, highB), _mm_max_ps(highC, highD)));
+    }
+#endif
+    for (; b < buckets; b++) {
+        const float* p = samples + b * FIRST_BUCKET_SIZE;
+        float low = p[0];
+        float high = p[0];
+        for (size_t i = 1; i < FIRST_BUCKET_SIZE; i++) {
+            low = std::min(low, p[i]);
+            high = std::max(high, p[i]);
+        }
+        mins[b] = low;
+        maxs[b] = high;
+    }
+}
+
+// Each bucket from the two below it
+void reducePairs(const float* childMins, const float* childMaxs, size_t buckets, float* mins, float* maxs) {
+    size_t b = 0;
+
+#ifdef VOIDENGINE_PLOT_SSE2
+    for (; b + 4 <= buckets; b += 4) {
+        __m128 low0 = _mm_loadu_ps(childMins + 2 * b), low1 = _mm_loadu_ps(childMins + 2 * b + 4);
+        _mm_storeu_ps(mins + b, _mm_min_ps(_mm_shuffle_ps(low0, low1, _MM_SHUFFLE(2, 0, 2, 0)),
+                                           _mm_shuffle_ps(low0, low1, _MM_SHUFFLE(3, 1, 3, 1))));
+        
+        __m128 high0 = _mm_loadu_ps(childMaxs + 2 * b), high1 = _mm_loadu_ps(childMaxs + 2 * b + 4);
+        _mm_storeu_ps(maxs + b, _mm_max_ps(_mm_shuffle_ps(high0, high1, _MM_SHUFFLE(2, 0, 2, 0)),
+                                           _mm_shuffle_ps(high0, high1, _MM_SHUFFLE(3, 1, 3, 1))));
+    }
+#endif
+    for (; b < buckets; b++) {
+        mins[b] = std::min(childMins[2 * b], childMins[2 * b + 1]);
+        maxs[b] = std::max(childMaxs[2 * b], childMaxs[2 * b + 1]);
+    }
+}
+
+} // namespace
+
+PlotSeries::PlotSeries(size_t capacity) {
+    if (capacity > (std::numeric_limits<size_t>::max() >> 1) + 1) {
+        throw std::length_error("Plot series capacity too large");
+    }
+    capacity_ = MIN_CAPACITY;
+    while (capacity_ < capacity) {
+        capacity_ <<= 1;
+    }
+    samples_.resize(capacity_);
+    
+    for (size_t buckets = capacity_ / FIRST_BUCKET_SIZE; buckets >= MIN_LEVEL_BUCKETS; buckets /= 2) {
+        Level level;
+        level.mins.resize(buckets);
+        level.maxs.resize(buckets);
+        levels_.push_back(std::move(level));
+    }
+}
+
+void PlotSeries::append(const float* values, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    // Only the newest capacity samples would survive
+    if (count > capacity_) {
+        values += count - capacity_;
+        end_ += count - capacity_;
+        count = capacity_;
+    }
+    
+    const uint64_t first = end_;
+    const size_t slot = static_cast<size_t>(first & (capacity_ - 1));
+    const size_t head = std::min(count, capacity_ - slot);
+    std::memcpy(samples_.data() + slot, values, head * sizeof(float));
+    std::memcpy(samples_.data(), values + head, (count - head) * sizeof(float));
+    
+    end_ += count;
+    if (end_ - begin_ > capacity_) {
+        begin_ = end_ - capacity_;
+    }
+    
+    if (count == 1) {
+        // Folding a single value into the bucket it joins at each level is
+        // cheaper than recomputing those buckets
+        const float value = *values;
+        for (size_t l = 0; l < levels_.size(); l++) {
+            Level& level = levels_[l];
+            const uint64_t bucketSize = getBucketSize(l + 1);
+            const size_t slot = static_cast<size_t>((first / bucketSize) & (level.mins.size() - 1));
+            if (first % bucketSize == 0) {
+                level.mins[slot] = value;
+                level.maxs[slot] = value;
+            } else {
+                level.mins[slot] = std::min(level.mins[slot], value);
+                level.maxs[slot] = std::max(level.maxs[slot], value);
+            }
+        }
+    } else {
+        updatePyramid(first);
+    }
+    version_++;
+}
+
+void PlotSeries::clear() {
+    begin_ = 0;
+    end_ = 0;
+    version_++;
+}
+
+float PlotSeries::getSample(uint64_t index) const {
+    if (index < begin_ || index >= end_) {
+        throw std::out_of_range("Plot sample not retained");
+    }
+    return samples_[index & (capacity_ - 1)];
+}
+
+size_t PlotSeries::decimate(uint64_t begin, uint64_t end, size_t columns, float* mins, float* maxs) const {
+    if (columns == 0 || end <= begin) {
+        return 0;
+    }
+    std::fill(mins, mins + columns, std::numeric_limits<float>::quiet_NaN());
+    std::fill(maxs, maxs + columns, std::numeric_limits<float>::quiet_NaN());
+    
+    const uint64_t span = end - begin;
+    const uint64_t perColumn = span / columns;
+    size_t level = 0;
+    while (level + 1 < getLevelCount() && getBucketSize(level + 1) <= perColumn) {
+        level++;
+    }
+    
+    const uint64_t from = std::max(begin, begin_);
+    const uint64_t to = std::min(end, end_);
+    if (from >= to) {
+        return level;
+    }
+    
+    const uint64_t bucketSize = getBucketSize(level);
+    const float* levelMins = level == 0 ? samples_.data() : levels_[level - 1].mins.data();
+    const float* levelMaxs = level == 0 ? samples_.data() : levels_[level - 1].maxs.data();
+    const uint64_t slotMask = (level == 0 ? capacity_ : levels_[level - 1].mins.size()) - 1;
+    
+    for (uint64_t b = (from + bucketSize - 1) / bucketSize; b * bucketSize < to; b++) {
+        const size_t column = static_cast<size_t>((b * bucketSize - begin) * columns / span);
+        const size_t slot = static_cast<size_t>(b & slotMask);
+        if (std::isnan(mins[column])) {
+            mins[column] = levelMins[slot];
+            maxs[column] = levelMaxs[slot];
+        } else {
+            mins[column] = std::min(mins[column], levelMins[slot]);
+            maxs[column] = std::max(maxs[column], levelMaxs[slot]);
+        }
+    }
+    return level;
+}
+
+void PlotSeries::updatePyramid(uint64_t index) {
+    // Bucket b of every level lives in slot b modulo the level's size, and the
+    // two buckets below it in the adjacent slots 2b and 2b + 1, so runs of
+    // buckets map to runs of slots up to the end of the ring
+    {
+        Level& level = levels_[0];
+        const uint64_t slotMask = level.mins.size() - 1;
+        const uint64_t complete = end_ / FIRST_BUCKET_SIZE;
+        const uint64_t last = (end_ - 1) / FIRST_BUCKET_SIZE;
+        
+        for (uint64_t b = index / FIRST_BUCKET_SIZE; b < complete;) {
+            const size_t slot = static_cast<size_t>(b & slotMask);
+            const size_t count = static_cast<size_t>(std::min<uint64_t>(complete - b, level.mins.size() - slot));
+            reduceSamples(samples_.data() + slot * FIRST_BUCKET_SIZE, count, level.mins.data() + slot,
+                          level.maxs.data() + slot);
+            b += count;
+        }
+        
+        if (last == complete) {
+            const size_t slot = static_cast<size_t>(last & slotMask);
+            const float* p = samples_.data() + slot * FIRST_BUCKET_SIZE;
+            const size_t count = static_cast<size_t>(end_ - last * FIRST_BUCKET_SIZE);
+            level.mins[slot] = *std::min_element(p, p + count);
+            level.maxs[slot] = *std::max_element(p, p + count);
+        }
+    }
+    
+    for (size_t l = 1; l < levels_.size(); l++) {
+        const Level& below = levels_[l - 1];
+        Level& level = levels_[l];
+        const uint64_t bucketSize = getBucketSize(l + 1);
+        const uint64_t slotMask = level.mins.size() - 1;
+        const uint64_t lastChild = (end_ - 1) / (bucketSize / 2);
+        // Buckets before this one have both children
+        const uint64_t paired = (lastChild + 1) / 2;
+        const uint64_t last = (end_ - 1) / bucketSize;
+        
+        for (uint64_t b = index / bucketSize; b < paired;) {
+            const size_t slot = static_cast<size_t>(b & slotMask);
+            const size_t count = static_cast<size_t>(std::min<uint64_t>(paired - b, level.mins.size() - slot));
+            reducePairs(below.mins.data() + 2 * slot, below.maxs.data() + 2 * slot, count, level.mins.data() + slot,
+                        level.maxs.data() + slot);
+            b += count;
+        }
+        
+        if (last == paired) {
+            const size_t slot = static_cast<size_t>(last & slotMask);
+            level.mins[slot] = below.mins[2 * slot];
+            level.maxs[slot] = below.maxs[2 * slot];
+        }
+    }
+}
+
+} // namespace ui
+} // namespace voidengine
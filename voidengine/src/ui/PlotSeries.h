@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace voidengine {
+namespace ui {
+
+// Samples of one plotted quantity at unit spacing, keeping the most recent
+// capacity of them in a ring. Alongside the samples it keeps a min/max
+// pyramid: level 1 has a bucket per 8 samples and each level above halves the
+// bucket count. Appending recomputes only the buckets the new samples fall
+// in, and decimate() reads the coarsest level whose buckets are no wider than
+// a column, so drawing costs the same for a thousand samples or a million.
+//
+// Samples are indexed from the first one ever appended; values should be
+// finite.
+class PlotSeries {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 20;
+    
+    // Rounded up to a power of two of at least 64
+    explicit PlotSeries(size_t capacity = DEFAULT_CAPACITY);
+    
+    void append(float value) { append(&value, 1); }
+    void append(const float* values, size_t count);
+    // Indices start from zero again
+    void clear();
+    
+    size_t getCapacity() const { return capacity_; }
+    uint64_t getBeginIndex() const { return begin_; }
+    uint64_t getEndIndex() const { return end_; }
+    size_t size() const { return static_cast<size_t>(end_ - begin_); }
+    bool empty() const { return end_ == begin_; }
+    // Throws std::out_of_range outside [getBeginIndex(), getEndIndex())
+    float getSample(uint64_t index) const;
+    // Changes on every append and clear
+    uint32_t getVersion() const { return version_; }
+    
+    // Splits [begin, end) into columns equal parts and writes the min and max
+    // of each to mins and maxs; columns without retained samples get NaN.
+    // Buckets are assigned whole to the column they start in, and the oldest
+    // partly overwritten bucket is skipped, so edges are accurate to one
+    // bucket, which is at most a column wide. Returns the level read, zero
+    // meaning the samples themselves.
+    size_t decimate(uint64_t begin, uint64_t end, size_t columns, float* mins, float* maxs) const;
+    
+    // Including level zero, the samples
+    size_t getLevelCount() const { return levels_.size() + 1; }
+    static uint64_t getBucketSize(size_t level) { return level == 0 ? 1 : uint64_t(8) << (level - 1); }
+
+private:
+    struct Level {
+        std::vector<float> mins;
+        std::vector<float> maxs;
+    };
+    
+    // Recomputes, at every level, the buckets holding samples from index on
+    void updatePyramid(uint64_t index);
+    
+    size_t capacity_;
+    std::vector<float> samples_;
+    // levels_[0] is level 1
+    std::vector<Level> levels_;
+    uint64_t begin_ = 0;
+    uint64_t end_ = 0;
+    uint32_t version_ = 0;
+};
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,536 @@
+#include "ScreenCompiler.h"
+#include "ScreenFormat.h"
+#include "Layout.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+struct JsonValue {
+    enum class Kind {
+        NUL,
+        BOOL,
+        NUMBER,
+        STRING,
+        ARRAY,
+        OBJECT
+    };
+    
+    Kind kind = Kind::NUL;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+    int line = 0;
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(std::string_view source) : source_(source) {}
+    
+    JsonValue parseDocument() {
+        JsonValue value = parseValue();
+        skipWhitespace();
+        if (position_ != source_.size()) {
+            fail("Unexpected trailing content");
+        }
+        return value;
+    }
+    
+private:
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::runtime_error("Screen source line " + std::to_string(line_) + ": " + message);
+    }
+    
+    void skipWhitespace() {
+        while (position_ < source_.size()) {
+            char c = source_[position_];
+            if (c == '\n') {
+                line_++;
+                position_++;
+            } else if (c == ' ' || c == '\t' || c == '\r') {
+                position_++;
+            } else if (c == '/' && position_ + 1 < source_.size() && source_[position_ + 1] == '/') {
+                while (position_ < source_.size() && source_[position_] != '\n') {
+                    position_++;
+                }
+            } else {
+                break;
+            }
+        }
+    }
+    
+    bool consume(char expected) {
+        skipWhitespace();
+        if (position_ < source_.size() && source_[position_] == expected) {
+            position_++;
+            return true;
+        }
+        return false;
+    }
+    
+    void expect(char expected) {
+        if (!consume(expected)) {
+            fail(std::string("Expected '") + expected + "'");
+        }
+    }
+    
+    bool matchKeyword(const char* keyword) {
+        size_t length = std::strlen(keyword);
+        if (source_.compare(position_, length, keyword) == 0) {
+            position_ += length;
+            return true;
+        }
+        return false;
+    }
+    
+    JsonValue parseValue() {
+        skipWhitespace();
+        if (position_ >= source_.size()) {
+            fail("Unexpected end of input");
+        }
+        
+        JsonValue value;
+        value.line = line_;
+        char c = source_[position_];
+        
+        if (c == '{') {
+            value.kind = JsonValue::Kind::OBJECT;
+            position_++;
+            if (!consume('}')) {
+                do {
+                    skipWhitespace();
+                    if (position_ >= source_.size() || source_[position_] != '"') {
+                        fail("Expected member name");
+                    }
+                    std::string name = parseString();
+                    expect(':');
+                    value.members.emplace_back(std::move(name), parseValue());
+                } while (consume(','));
+                expect('}');
+            }
+        } else if (c == '[') {
+            value.kind = JsonValue::Kind::ARRAY;
+            position_++;
+            if (!consume(']')) {
+                do {
+                    value.items.push_back(parseValue());
+                } while (consume(','));
+                expect(']');
+            }
+        } else if (c == '"') {
+            value.kind = JsonValue::Kind::STRING;
+            value.string = parseString();
+        } else if (matchKeyword("true")) {
+            value.kind = JsonValue::Kind::BOOL;
+            value.boolean = true;
+        } else if (matchKeyword("false")) {
+            value.kind = JsonValue::Kind::BOOL;
+        } else if (matchKeyword("null")) {
+            value.kind = JsonValue::Kind::NUL;
+        } else {
+            value.kind = JsonValue::Kind::NUMBER;
+            value.number = parseNumber();
+        }
+        
+        return value;
+    }
+    
+    std::string parseString() {
+        position_++;
+        std::string result;
+        
+        while (true) {
+            if (position_ >= source_.size()) {
+                fail("Unterminated string");
+            }
+            char c = source_[position_++];
+            if (c == '"') {
+                break;
+            }
+            if (c == '\n') {
+                fail("Newline in string");
+            }
+            if (c != '\\') {
+                result.push_back(c);
+                continue;
+            }
+            
+            if (position_ >= source_.size()) {
+                fail("Unterminated escape");
+            }
+            char escape = source_[position_++];
+            switch (escape) {
+                case '"': result.push_back('"'); break;
+                case '\\': result.push_back('\\'); break;
+                case '/': result.push_back('/'); break;
+                case 'n': result.push_back('\n'); break;
+                case 't': result.push_back('\t'); break;
+                case 'r': result.push_back('\r'); break;
+                case 'u': appendCodepoint(result, parseHex4()); break;
+                default: fail(std::string("Unknown escape '\\") + escape + "'");
+            }
+        }
+        
+        return result;
+    }
+    
+    uint32_t parseHex4() {
+        if (position_ + 4 > source_.size()) {
+            fail("Truncated \\u escape");
+        }
+        uint32_t value = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = source_[position_++];
+            value <<= 4;
+            if (c >= '0' && c <= '9') {
+                value |= static_cast<uint32_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                value |= static_cast<uint32_t>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                value |= static_cast<uint32_t>(c - 'A' + 10);
+            } else {
+                fail("Invalid \\u escape");
+            }
+        }
+        return value;
+    }
+    
+    static void appendCodepoint(std::string& out, uint32_t codepoint) {
+        if (codepoint < 0x80) {
+            out.push_back(static_cast<char>(codepoint));
+        } else if (codepoint < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+            out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        }
+    }
+    
+    double parseNumber() {
+        // strtod needs a terminated buffer; numbers are short, so copy the token
+        size_t start = position_;
+        while (position_ < source_.size() && std::strchr("+-0123456789.eE", source_[position_])) {
+            position_++;
+        }
+        if (start == position_) {
+            fail("Unexpected character");
+        }
+        
+        std::string token(source_.substr(start, position_ - start));
+        char* end = nullptr;
+        double value = std::strtod(token.c_str(), &end);
+        if (end != token.c_str() + token.size()) {
+            fail("Invalid number '" + token + "'");
+        }
+        return value;
+    }
+    
+    std::string_view source_;
+    size_t position_ = 0;
+    int line_ = 1;
+};
+
+class ScreenEmitter {
+public:
+    std::vector<uint8_t> emit(const JsonValue& root) {
+        if (root.kind != JsonValue::Kind::OBJECT) {
+            fail(root, "Screen root must be a node object");
+        }
+        emitNode(root, ScreenFormat::NO_PARENT);
+        
+        while (strings_.size() % 4 != 0) {
+            strings_.push_back('\0');
+        }
+        
+        ScreenHeader header = {};
+        header.magic = ScreenFormat::MAGIC;
+        header.version = ScreenFormat::VERSION;
+        header.nodeCount = static_cast<uint32_t>(records_.size());
+        header.stringBytes = static_cast<uint32_t>(strings_.size());
+        header.nodesOffset = sizeof(ScreenHeader);
+        header.stringsOffset = header.nodesOffset + static_cast<uint32_t>(records_.size() * sizeof(ScreenNodeRecord));
+        header.totalSize = header.stringsOffset + header.stringBytes;
+        
+        std::vector<uint8_t> image(header.totalSize);
+        std::memcpy(image.data(), &header, sizeof(header));
+        std::memcpy(image.data() + header.nodesOffset, records_.data(), records_.size() * sizeof(ScreenNodeRecord));
+        std::memcpy(image.data() + header.stringsOffset, strings_.data(), strings_.size());
+        return image;
+    }
+    
+private:
+    [[noreturn]] static void fail(const JsonValue& value, const std::string& message) {
+        throw std::runtime_error("Screen source line " + std::to_string(value.line) + ": " + message);
+    }
+    
+    static const std::string& asString(const JsonValue& value, const char* name) {
+        if (value.kind != JsonValue::Kind::STRING) {
+            fail(value, std::string("'") + name + "' must be a string");
+        }
+        return value.string;
+    }
+    
+    static float asNumber(const JsonValue& value, const char* name) {
+        if (value.kind != JsonValue::Kind::NUMBER) {
+            fail(value, std::string("'") + name + "' must be a number");
+        }
+        return static_cast<float>(value.number);
+    }
+    
+    static bool asBool(const JsonValue& value, const char* name) {
+        if (value.kind != JsonValue::Kind::BOOL) {
+            fail(value, std::string("'") + name + "' must be true or false");
+        }
+        return value.boolean;
+    }
+    
+    static void asFloats(const JsonValue& value, const char* name, float* out, size_t count) {
+        if (value.kind != JsonValue::Kind::ARRAY || value.items.size() != count) {
+            fail(value, std::string("'") + name + "' must be an array of " + std::to_string(count) + " numbers");
+        }
+        for (size_t i = 0; i < count; i++) {
+            out[i] = asNumber(value.items[i], name);
+        }
+    }
+    
+    static uint8_t asAlign(const JsonValue& value, const char* name) {
+        const std::string& text = asString(value, name);
+        if (text == "start") return static_cast<uint8_t>(LayoutAlign::START);
+        if (text == "center") return static_cast<uint8_t>(LayoutAlign::CENTER);
+        if (text == "end") return static_cast<uint8_t>(LayoutAlign::END);
+        if (text == "stretch") return static_cast<uint8_t>(LayoutAlign::STRETCH);
+        fail(value, "Unknown alignment '" + text + "'");
+    }
+    
+    static const JsonValue* findMember(const JsonValue& object, const char* name) {
+        for (const auto& member : object.members) {
+            if (member.first == name) {
+                return &member.second;
+            }
+        }
+        return nullptr;
+    }
+    
+    void storeString(const std::string& text, uint32_t& offset, uint32_t& length) {
+        offset = static_cast<uint32_t>(strings_.size());
+        length = static_cast<uint32_t>(text.size());
+        strings_.insert(strings_.end(), text.begin(), text.end());
+    }
+    
+    void emitLayout(const JsonValue& layout, ScreenNodeRecord& record) {
+        if (layout.kind != JsonValue::Kind::OBJECT) {
+            fail(layout, "'layout' must be an object");
+        }
+        
+        for (const auto& member : layout.members) {
+            const std::string& key = member.first;
+            const JsonValue& value = member.second;
+            
+            if (key == "direction") {
+                const std::string& direction = asString(value, "direction");
+                if (direction == "none") {
+                    record.layoutDirection = static_cast<uint8_t>(LayoutDirection::NONE);
+                } else if (direction == "row") {
+                    record.layoutDirection = static_cast<uint8_t>(LayoutDirection::ROW);
+                } else if (direction == "column") {
+                    record.layoutDirection = static_cast<uint8_t>(LayoutDirection::COLUMN);
+                } else {
+                    fail(value, "Unknown layout direction '" + direction + "'");
+                }
+            } else if (key == "padding") {
+                if (value.kind == JsonValue::Kind::NUMBER) {
+                    float padding = asNumber(value, "padding");
+                    for (float& side : record.padding) {
+                        side = padding;
+                    }
+                } else {
+                    asFloats(value, "padding", record.padding, 4);
+                }
+            } else if (key == "spacing") {
+                record.spacing = asNumber(value, "spacing");
+            } else if (key == "mainAlign") {
+                record.mainAlign = asAlign(value, "mainAlign");
+            } else if (key == "crossAlign") {
+                record.crossAlign = asAlign(value, "crossAlign");
+            } else if (key == "preferredSize") {
+                asFloats(value, "preferredSize", record.preferredSize, 2);
+            } else if (key == "minSize") {
+                asFloats(value, "minSize", record.minSize, 2);
+            } else if (key == "maxSize") {
+                asFloats(value, "maxSize", record.maxSize, 2);
+            } else if (key == "flexGrow") {
+                record.flexGrow = asNumber(value, "flexGrow");
+            } else {
+                fail(value, "Unknown layout property '" + key + "'");
+            }
+        }
+    }
+    
+    void emitNode(const JsonValue& node, uint32_t parent) {
+        if (node.kind != JsonValue::Kind::OBJECT) {
+            fail(node, "Screen node must be an object");
+        }
+        
+        const JsonValue* typeValue = findMember(node, "type");
+        const JsonValue* idValue = findMember(node, "id");
+        if (!typeValue || !idValue) {
+            fail(node, "Screen node needs a 'type' and an 'id'");
+        }
+        
+        ScreenNodeRecord record = {};
+        const std::string& type = asString(*typeValue, "type");
+        if (type == "panel") {
+            record.type = static_cast<uint8_t>(ScreenNodeType::PANEL);
+            record.flags |= ScreenNodeFlags::BORDER;
+            record.fontSize = 16.0f;
+        } else if (type == "button") {
+            record.type = static_cast<uint8_t>(ScreenNodeType::BUTTON);
+            record.fontSize = 16.0f;
+        } else if (type == "text") {
+            record.type = static_cast<uint8_t>(ScreenNodeType::TEXT);
+            record.fontSize = 16.0f;
+        } else {
+            fail(*typeValue, "Unknown node type '" + type + "'");
+        }
+        
+        record.flags |= ScreenNodeFlags::VISIBLE | ScreenNodeFlags::ENABLED;
+        record.parent = parent;
+        const std::string& id = asString(*idValue, "id");
+        if (!ids_.insert(id).second) {
+            fail(*idValue, "Duplicate id '" + id + "'");
+        }
+        storeString(id, record.idOffset, record.idLength);
+        
+        LayoutParams defaults;
+        record.layoutDirection = static_cast<uint8_t>(defaults.direction);
+        record.mainAlign = static_cast<uint8_t>(defaults.mainAlign);
+        record.crossAlign = static_cast<uint8_t>(defaults.crossAlign);
+        for (int i = 0; i < 4; i++) {
+            record.padding[i] = defaults.padding[i];
+        }
+        record.spacing = defaults.spacing;
+        for (int i = 0; i < 2; i++) {
+            record.preferredSize[i] = defaults.preferredSize[i];
+            record.minSize[i] = defaults.minSize[i];
+            record.maxSize[i] = defaults.maxSize[i];
+        }
+        record.flexGrow = defaults.flexGrow;
+        
+        const JsonValue* children = nullptr;
+        
+        for (const auto& member : node.members) {
+            const std::string& key = member.first;
+            const JsonValue& value = member.second;
+            
+            if (key == "type" || key == "id") {
+                continue;
+            } else if (key == "position") {
+                asFloats(value, "position", record.position, 2);
+            } else if (key == "size") {
+                asFloats(value, "size", record.size, 2);
+            } else if (key == "visible") {
+                setFlag(record, ScreenNodeFlags::VISIBLE, asBool(value, "visible"));
+            } else if (key == "enabled") {
+                setFlag(record, ScreenNodeFlags::ENABLED, asBool(value, "enabled"));
+            } else if (key == "border") {
+                setFlag(record, ScreenNodeFlags::BORDER, asBool(value, "border"));
+            } else if (key == "background") {
+                asFloats(value, "background", record.backgroundColor, 4);
+                record.flags |= ScreenNodeFlags::HAS_BACKGROUND_COLOR;
+            } else if (key == "borderColor") {
+                asFloats(value, "borderColor", record.borderColor, 4);
+                record.flags |= ScreenNodeFlags::HAS_BORDER_COLOR;
+            } else if (key == "textColor") {
+                asFloats(value, "textColor", record.textColor, 4);
+                record.flags |= ScreenNodeFlags::HAS_TEXT_COLOR;
+            } else if (key == "text") {
+                storeString(asString(value, "text"), record.textOffset, record.textLength);
+            } else if (key == "fontSize") {
+                record.fontSize = asNumber(value, "fontSize");
+            } else if (key == "align") {
+                const std::string& align = asString(value, "align");
+                if (align == "left") {
+                    record.textAlignment = 0;
+                } else if (align == "center") {
+                    record.textAlignment = 1;
+                } else if (align == "right") {
+                    record.textAlignment = 2;
+                } else {
+                    fail(value, "Unknown text alignment '" + align + "'");
+                }
+            } else if (key == "layout") {
+                emitLayout(value, record);
+            } else if (key == "children") {
+                if (record.type != static_cast<uint8_t>(ScreenNodeType::PANEL)) {
+                    fail(value, "Only panels can have children");
+                }
+                if (value.kind != JsonValue::Kind::ARRAY) {
+                    fail(value, "'children' must be an array");
+                }
+                children = &value;
+            } else {
+                fail(value, "Unknown node property '" + key + "'");
+            }
+        }
+        
+        uint32_t index = static_cast<uint32_t>(records_.size());
+        records_.push_back(record);
+        
+        if (children) {
+            records_[index].childCount = static_cast<uint32_t>(children->items.size());
+            for (const JsonValue& child : children->items) {
+                emitNode(child, index);
+            }
+        }
+    }
+    
+    static void setFlag(ScreenNodeRecord& record, uint8_t flag, bool value) {
+        record.flags = value ? (record.flags | flag) : (record.flags & ~flag);
+    }
+    
+    std::vector<ScreenNodeRecord> records_;
+    std::vector<char> strings_;
+    std::unordered_set<std::string> ids_;
+};
+
+} // namespace
+
+std::vector<uint8_t> compileScreen(std::string_view source) {
+    JsonParser parser(source);
+    JsonValue root = parser.parseDocument();
+    
+    ScreenEmitter emitter;
+    return emitter.emit(root);
+}
+
+void compileScreenFile(const std::string& inputPath, const std::string& outputPath) {
+    std::ifstream input(inputPath, std::ios::binary);
+    if (!input) {
+        throw std::runtime_error("Failed to open screen source: " + inputPath);
+    }
+    
+    std::stringstream buffer;
+    buffer << input.rdbuf();
+    std::vector<uint8_t> image = compileScreen(buffer.str());
+    
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        throw std::runtime_error("Failed to write compiled screen: " + outputPath);
+    }
+    output.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+}
+
+} // namespace ui
+} // namespace voidengine
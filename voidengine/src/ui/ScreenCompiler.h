@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace voidengine {
+namespace ui {
+
+// Compiles a text screen description into the binary .vui image described in
+// ScreenFormat.h. The text is JSON with // line comments allowed; each node
+// is an object with a "type" ("panel", "button" or "text") and an "id", plus
+// optional "position", "size", "visible", "enabled", "border", "background",
+// "borderColor", "textColor", "text", "fontSize", "align", "layout" and, for
+// panels, "children". Throws std::runtime_error naming the offending line.
+std::vector<uint8_t> compileScreen(std::string_view source);
+
+// Reads a text description from disk and writes the compiled image next to it
+void compileScreenFile(const std::string& inputPath, const std::string& outputPath);
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace voidengine {
+namespace ui {
+
+// Binary screen layout (.vui), produced by the screen compiler and read in
+// place by the loader. Little-endian, 4-byte aligned:
+//
+//   ScreenHeader
+//   ScreenNodeRecord[nodeCount]   pre-order, parents before children
+//   char[stringBytes]             ids and texts, referenced by offset/length
+namespace ScreenFormat {
+    constexpr uint32_t MAGIC = 0x31495556; // "VUI1"
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t NO_PARENT = 0xFFFFFFFFu;
+}
+
+enum class ScreenNodeType : uint8_t {
+    PANEL,
+    BUTTON,
+    TEXT
+};
+
+namespace ScreenNodeFlags {
+    constexpr uint8_t VISIBLE = 1u << 0;
+    constexpr uint8_t ENABLED = 1u << 1;
+    constexpr uint8_t BORDER = 1u << 2;
+    constexpr uint8_t HAS_BACKGROUND_COLOR = 1u << 3;
+    constexpr uint8_t HAS_BORDER_COLOR = 1u << 4;
+    constexpr uint8_t HAS_TEXT_COLOR = 1u << 5;
+}
+
+struct ScreenHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t nodeCount;
+    uint32_t stringBytes;
+    uint32_t nodesOffset;
+    uint32_t stringsOffset;
+    uint32_t totalSize;
+    uint32_t reserved;
+};
+
+struct ScreenNodeRecord {
+    uint8_t type;
+    uint8_t flags;
+    uint8_t textAlignment;
+    uint8_t layoutDirection;
+    uint8_t mainAlign;
+    uint8_t crossAlign;
+    uint8_t padding0[2];
+    
+    uint32_t parent;
+    uint32_t childCount;
+    uint32_t idOffset;
+    uint32_t idLength;
+    uint32_t textOffset;
+    uint32_t textLength;
+    
+    float position[2];
+    float size[2];
+    float backgroundColor[4];
+    float borderColor[4];
+    float textColor[4];
+    float fontSize;
+    
+    float padding[4];
+    float spacing;
+    float preferredSize[2];
+    float minSize[2];
+    float maxSize[2];
+    float flexGrow;
+};
+
+static_assert(std::is_trivially_copyable<ScreenHeader>::value, "ScreenHeader must be trivially copyable");
+static_assert(std::is_trivially_copyable<ScreenNodeRecord>::value, "ScreenNodeRecord must be trivially copyable");
+static_assert(sizeof(ScreenHeader) % 4 == 0 && sizeof(ScreenNodeRecord) % 4 == 0,
+              "Screen records must keep 4-byte alignment");
+
+} // namespace ui
+} // namespace voidengine
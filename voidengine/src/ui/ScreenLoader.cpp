@@ -0,0 +1,237 @@
+#include "ScreenLoader.h"
+#include "ScreenFormat.h"
+#include "Panel.h"
+#include "Button.h"
+#include "Text.h"
+#include "../core/MappedFile.h"
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+// Bump allocator shared by all widgets of one screen. Nothing is freed
+// individually; the blocks go away with the last widget, because every
+// control block holds a copy of the allocator and thus of the arena.
+class ScreenArena {
+public:
+    explicit ScreenArena(size_t capacity) : blockSize_(capacity) {}
+    
+    // Blocks come from operator new, which already satisfies the fundamental
+    // alignments widgets use
+    void* allocate(size_t bytes, size_t alignment) {
+        size_t offset = (used_ + alignment - 1) & ~(alignment - 1);
+        if (blocks_.empty() || offset + bytes > currentBlockSize_) {
+            currentBlockSize_ = bytes > blockSize_ ? bytes : blockSize_;
+            blocks_.push_back(std::unique_ptr<uint8_t[]>(new uint8_t[currentBlockSize_]));
+            offset = 0;
+        }
+        
+        used_ = offset + bytes;
+        return blocks_.back().get() + offset;
+    }
+    
+private:
+    std::vector<std::unique_ptr<uint8_t[]>> blocks_;
+    size_t blockSize_;
+    size_t currentBlockSize_ = 0;
+    size_t used_ = 0;
+};
+
+template <typename T>
+class ScreenArenaAllocator {
+public:
+    using value_type = T;
+    
+    explicit ScreenArenaAllocator(std::shared_ptr<ScreenArena> arena) : arena_(std::move(arena)) {}
+    
+    template <typename U>
+    ScreenArenaAllocator(const ScreenArenaAllocator<U>& other) : arena_(other.arena_) {}
+    
+    T* allocate(size_t count) {
+        return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T)));
+    }
+    
+    void deallocate(T*, size_t) {}
+    
+    template <typename U>
+    bool operator==(const ScreenArenaAllocator<U>& other) const { return arena_ == other.arena_; }
+    template <typename U>
+    bool operator!=(const ScreenArenaAllocator<U>& other) const { return arena_ != other.arena_; }
+    
+    std::shared_ptr<ScreenArena> arena_;
+};
+
+// Room for the object plus the shared_ptr control block around it
+constexpr size_t CONTROL_BLOCK_ALLOWANCE = 64;
+
+const ScreenHeader& validateImage(const uint8_t* data, size_t size) {
+    if (!data || size < sizeof(ScreenHeader)) {
+        throw std::runtime_error("Screen image is truncated");
+    }
+    if (reinterpret_cast<uintptr_t>(data) % alignof(ScreenNodeRecord) != 0) {
+        throw std::runtime_error("Screen image is misaligned");
+    }
+    
+    const ScreenHeader& header = *reinterpret_cast<const ScreenHeader*>(data);
+    if (header.magic != ScreenFormat::MAGIC) {
+        throw std::runtime_error("Not a compiled screen image");
+    }
+    if (header.version != ScreenFormat::VERSION) {
+        throw std::runtime_error("Unsupported screen image version " + std::to_string(header.version));
+    }
+    
+    uint64_t nodesEnd = static_cast<uint64_t>(header.nodesOffset) +
+                        static_cast<uint64_t>(header.nodeCount) * sizeof(ScreenNodeRecord);
+    uint64_t stringsEnd = static_cast<uint64_t>(header.stringsOffset) + header.stringBytes;
+    if (header.nodeCount == 0 || header.totalSize > size || header.nodesOffset < sizeof(ScreenHeader) ||
+        header.nodesOffset % 4 != 0 || nodesEnd > header.stringsOffset || stringsEnd > header.totalSize) {
+        throw std::runtime_error("Screen image header is inconsistent");
+    }
+    
+    const ScreenNodeRecord* records = reinterpret_cast<const ScreenNodeRecord*>(data + header.nodesOffset);
+    // childCount sizes reservations at load, so it must equal the children that actually follow
+    std::vector<uint32_t> children(header.nodeCount, 0);
+    for (uint32_t i = 0; i < header.nodeCount; i++) {
+        const ScreenNodeRecord& record = records[i];
+        
+        bool validParent = i == 0 ? record.parent == ScreenFormat::NO_PARENT
+                                  : record.parent < i &&
+                                    records[record.parent].type == static_cast<uint8_t>(ScreenNodeType::PANEL);
+        if (!validParent || record.type > static_cast<uint8_t>(ScreenNodeType::TEXT) ||
+            record.textAlignment > static_cast<uint8_t>(TextAlignment::RIGHT) ||
+            record.layoutDirection > static_cast<uint8_t>(LayoutDirection::COLUMN) ||
+            record.mainAlign > static_cast<uint8_t>(LayoutAlign::STRETCH) ||
+            record.crossAlign > static_cast<uint8_t>(LayoutAlign::STRETCH) ||
+            static_cast<uint64_t>(record.idOffset) + record.idLength > header.stringBytes ||
+            static_cast<uint64_t>(record.textOffset) + record.textLength > header.stringBytes) {
+            throw std::runtime_error("Screen node " + std::to_string(i) + " is malformed");
+        }
+        if (i > 0) {
+            children[record.parent]++;
+        }
+    }
+    for (uint32_t i = 0; i < header.nodeCount; i++) {
+        if (records[i].childCount != children[i]) {
+            throw std::runtime_error("Screen node " + std::to_string(i) + " is malformed");
+        }
+    }
+    
+    return header;
+}
+
+glm::vec2 toVec2(const float* values) {
+    return glm::vec2(values[0], values[1]);
+}
+
+glm::vec4 toVec4(const float* values) {
+    return glm::vec4(values[0], values[1], values[2], values[3]);
+}
+
+} // namespace
+
+LoadedScreen instantiateScreen(const uint8_t* data, size_t size) {
+    const ScreenHeader& header = validateImage(data, size);
+    const ScreenNodeRecord* records = reinterpret_cast<const ScreenNodeRecord*>(data + header.nodesOffset);
+    const char* strings = reinterpret_cast<const char*>(data + header.stringsOffset);
+    uint32_t nodeCount = header.nodeCount;
+    
+    size_t arenaBytes = 0;
+    for (uint32_t i = 0; i < nodeCount; i++) {
+        switch (static_cast<ScreenNodeType>(records[i].type)) {
+            case ScreenNodeType::PANEL: arenaBytes += sizeof(Panel); break;
+            case ScreenNodeType::BUTTON: arenaBytes += sizeof(Button); break;
+            case ScreenNodeType::TEXT: arenaBytes += sizeof(Text); break;
+        }
+        arenaBytes += CONTROL_BLOCK_ALLOWANCE;
+    }
+    auto arena = std::make_shared<ScreenArena>(arenaBytes);
+    
+    // Buttons own a label, so they take two registry entries
+    UIRegistry& registry = getUIRegistry();
+    registry.reserve(registry.size() + nodeCount * 2);
+    
+    LoadedScreen screen;
+    screen.components.reserve(nodeCount);
+    
+    for (uint32_t i = 0; i < nodeCount; i++) {
+        const ScreenNodeRecord& record = records[i];
+        std::string id(strings + record.idOffset, record.idLength);
+        std::string text(strings + record.textOffset, record.textLength);
+        glm::vec2 position = toVec2(record.position);
+        glm::vec2 nodeSize = toVec2(record.size);
+        
+        std::shared_ptr<UIComponent> component;
+        switch (static_cast<ScreenNodeType>(record.type)) {
+            case ScreenNodeType::PANEL: {
+                auto panel = std::allocate_shared<Panel>(ScreenArenaAllocator<Panel>(arena), id, position, nodeSize);
+                if (record.flags & ScreenNodeFlags::HAS_BACKGROUND_COLOR) {
+                    panel->setBackgroundColor(toVec4(record.backgroundColor));
+                }
+                if (record.flags & ScreenNodeFlags::HAS_BORDER_COLOR) {
+                    panel->setBorderColor(toVec4(record.borderColor));
+                }
+                panel->setBorderEnabled((record.flags & ScreenNodeFlags::BORDER) != 0);
+                panel->reserveChildren(record.childCount);
+                component = panel;
+                break;
+            }
+            case ScreenNodeType::BUTTON: {
+                auto button = std::allocate_shared<Button>(ScreenArenaAllocator<Button>(arena), id, position, nodeSize, text);
+                if (record.flags & ScreenNodeFlags::HAS_BACKGROUND_COLOR) {
+                    button->setStateColor(ButtonState::NORMAL, toVec4(record.backgroundColor));
+                }
+                if (record.flags & ScreenNodeFlags::HAS_TEXT_COLOR) {
+                    button->setTextColor(toVec4(record.textColor));
+                }
+                component = button;
+                break;
+            }
+            case ScreenNodeType::TEXT: {
+                auto label = std::allocate_shared<Text>(ScreenArenaAllocator<Text>(arena), id, position,
+                                                        text, record.fontSize);
+                if (record.flags & ScreenNodeFlags::HAS_TEXT_COLOR) {
+                    label->setColor(toVec4(record.textColor));
+                }
+                label->setAlignment(static_cast<TextAlignment>(record.textAlignment));
+                component = label;
+                break;
+            }
+        }
+        
+        component->setVisible((record.flags & ScreenNodeFlags::VISIBLE) != 0);
+        component->setEnabled((record.flags & ScreenNodeFlags::ENABLED) != 0);
+        
+        LayoutParams params;
+        params.direction = static_cast<LayoutDirection>(record.layoutDirection);
+        params.padding = toVec4(record.padding);
+        params.spacing = record.spacing;
+        params.mainAlign = static_cast<LayoutAlign>(record.mainAlign);
+        params.crossAlign = static_cast<LayoutAlign>(record.crossAlign);
+        params.preferredSize = toVec2(record.preferredSize);
+        params.minSize = toVec2(record.minSize);
+        params.maxSize = toVec2(record.maxSize);
+        params.flexGrow = record.flexGrow;
+        component->setLayout(params);
+        
+        if (record.parent != ScreenFormat::NO_PARENT) {
+            static_cast<Panel&>(*screen.components[record.parent]).addComponent(component);
+        }
+        screen.components.push_back(std::move(component));
+    }
+    
+    screen.root = screen.components.front();
+    return screen;
+}
+
+LoadedScreen loadScreenFile(const std::string& path) {
+    core::MappedFile file(path);
+    return instantiateScreen(file.data(), file.size());
+}
+
+} // namespace ui
+} // namespace voidengine
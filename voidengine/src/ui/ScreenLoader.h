@@ -0,0 +1,29 @@
+#pragma once
+
+#include "UIComponent.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace voidengine {
+namespace ui {
+
+struct LoadedScreen {
+    std::shared_ptr<UIComponent> root;
+    // Every node in pre-order, root first
+    std::vector<std::shared_ptr<UIComponent>> components;
+};
+
+// Builds the widgets described by a compiled .vui image. The records are read
+// in place, so loading is a validation pass plus construction; widgets are
+// carved out of one arena sized from the node counts. Throws
+// std::runtime_error when the image is malformed.
+LoadedScreen instantiateScreen(const uint8_t* data, size_t size);
+
+// Maps the file and instantiates it; the mapping is released before returning
+LoadedScreen loadScreenFile(const std::string& path);
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,365 @@
+#include "ScrollList.h"
+#include "UIRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace voidengine {
+namespace ui {
+
+ScrollList::ScrollList(const std::string& id, const glm::vec2& position, const glm::vec2& size,
+                       float rowHeight)
+    : UIComponent(id, position, size), rowHeight_(rowHeight) {
+    if (rowHeight_ <= 0.0f) {
+        throw std::invalid_argument("ScrollList row height must be positive");
+    }
+    
+    capabilities_ = UICapabilities::POINTER | UICapabilities::CLIPS_CHILDREN;
+    refreshStyle();
+}
+
+ScrollList::~ScrollList() {
+    for (auto& row : rows_) {
+        if (row->getParent() == this) {
+            row->setParent(nullptr);
+        }
+    }
+}
+
+void ScrollList::initialize() {
+    for (auto& row : rows_) {
+        row->initialize();
+    }
+}
+
+void ScrollList::update(float deltaTime) {
+    // Rows are rebound in onLayout on the main thread, so update only ticks
+    // the rows that are already bound
+    for (size_t i = 0; i < visibleCount_; i++) {
+        getChild(i)->update(deltaTime);
+    }
+}
+
+void ScrollList::onLayout() {
+    updateVisibleRows();
+}
+
+void ScrollList::render() {
+    if (!isVisible()) {
+        return;
+    }
+    
+    updateVisibleRows();
+    
+    const glm::vec2 position = getPosition();
+    const glm::vec2 size = getSize();
+    
+    drawRect(position, size, style().backgroundColor);
+    
+    // Overscan rows extend past the viewport, so clip them
+    pushClipRect(position, size);
+    
+    for (size_t i = 0; i < visibleCount_; i++) {
+        UIComponent* row = getChild(i);
+        if (row->isVisible()) {
+            row->render();
+        }
+    }
+    
+    popClipRect();
+    
+    float contentHeight = getContentHeight();
+    if (contentHeight > size.y) {
+        float thumbHeight = std::max(16.0f, size.y * (size.y / contentHeight));
+        float thumbY = position.y + (size.y - thumbHeight) * (scrollOffset_ / maxScrollOffset());
+        float thumbX = position.x + size.x - 4.0f;
+        
+        drawRect(glm::vec2(thumbX, thumbY), glm::vec2(3.0f, thumbHeight), glm::vec4(0.8f, 0.8f, 0.8f, 0.6f));
+    }
+}
+
+void ScrollList::onEvent(UIEvent& event) {
+    if (event.phase == UIEventPhase::CAPTURE) {
+        return;
+    }
+    
+    if (event.type == UIEventType::SCROLL) {
+        scrollBy(-event.scroll.y * scrollSpeed_);
+        event.consume();
+    } else if (event.type == UIEventType::MOUSE_BUTTON && event.phase == UIEventPhase::TARGET) {
+        event.consume();
+    }
+}
+
+UIComponent* ScrollList::getChild(size_t index) const {
+    return rows_[(firstItem_ + index) % rows_.size()].get();
+}
+
+void ScrollList::setRowFactory(const RowFactory& factory) {
+    rowFactory_ = factory;
+    
+    for (auto& row : rows_) {
+        row->setParent(nullptr);
+    }
+    rows_.clear();
+    boundItems_.clear();
+    visibleCount_ = 0;
+    rebindAll_ = true;
+    invalidateRows();
+}
+
+void ScrollList::setRowBinder(const RowBinder& binder) {
+    rowBinder_ = binder;
+    refresh();
+}
+
+void ScrollList::setItemCount(size_t count) {
+    if (itemCount_ == count) {
+        return;
+    }
+    
+    itemCount_ = count;
+    if (!heightTree_.empty()) {
+        resizeHeightIndex();
+    }
+    
+    setScrollOffset(scrollOffset_);
+    refresh();
+}
+
+void ScrollList::setRowHeightProvider(const RowHeightProvider& provider) {
+    rowHeightProvider_ = provider;
+    rebuildHeightIndex();
+    setScrollOffset(scrollOffset_);
+    refresh();
+}
+
+void ScrollList::setItemHeight(size_t itemIndex, float height) {
+    if (itemIndex >= itemCount_) {
+        throw std::out_of_range("ScrollList item index out of range");
+    }
+    
+    if (heightTree_.empty()) {
+        rebuildHeightIndex();
+    }
+    
+    float delta = height - getItemHeight(itemIndex);
+    for (size_t k = itemIndex + 1; k < heightTree_.size(); k += k & (~k + 1)) {
+        heightTree_[k] += delta;
+    }
+    
+    // The content height changed, so the offset may now be past the end
+    setScrollOffset(scrollOffset_);
+    invalidateRows();
+}
+
+float ScrollList::getItemHeight(size_t itemIndex) const {
+    if (heightTree_.empty()) {
+        return rowHeight_;
+    }
+    return getItemOffset(itemIndex + 1) - getItemOffset(itemIndex);
+}
+
+void ScrollList::setOverscan(size_t rows) {
+    overscan_ = rows;
+    invalidateRows();
+}
+
+void ScrollList::setScrollOffset(float offset) {
+    float clamped = std::min(std::max(offset, 0.0f), maxScrollOffset());
+    if (clamped != scrollOffset_) {
+        scrollOffset_ = clamped;
+        invalidateRows();
+    }
+}
+
+void ScrollList::scrollToItem(size_t itemIndex) {
+    if (itemIndex >= itemCount_) {
+        return;
+    }
+    
+    float top = getItemOffset(itemIndex);
+    float bottom = top + getItemHeight(itemIndex);
+    float viewportHeight = getSize().y;
+    
+    if (top < scrollOffset_) {
+        setScrollOffset(top);
+    } else if (bottom > scrollOffset_ + viewportHeight) {
+        setScrollOffset(bottom - viewportHeight);
+    }
+}
+
+float ScrollList::getContentHeight() const {
+    return getItemOffset(itemCount_);
+}
+
+float ScrollList::getItemOffset(size_t itemIndex) const {
+    if (heightTree_.empty()) {
+        return static_cast<float>(itemIndex) * rowHeight_;
+    }
+    
+    float sum = 0.0f;
+    for (size_t k = std::min(itemIndex, itemCount_); k > 0; k -= k & (~k + 1)) {
+        sum += heightTree_[k];
+    }
+    return sum;
+}
+
+size_t ScrollList::getItemAtOffset(float offset) const {
+    if (itemCount_ == 0) {
+        return 0;
+    }
+    
+    if (heightTree_.empty()) {
+        size_t index = static_cast<size_t>(std::max(offset, 0.0f) / rowHeight_);
+        return std::min(index, itemCount_ - 1);
+    }
+    
+    // Descend the Fenwick tree to the last item whose start offset is <= offset
+    size_t position = 0;
+    float remaining = offset;
+    size_t step = 1;
+    while (step * 2 <= itemCount_) {
+        step *= 2;
+    }
+    
+    for (; step > 0; step /= 2) {
+        size_t next = position + step;
+        if (next <= itemCount_ && heightTree_[next] <= remaining) {
+            position = next;
+            remaining -= heightTree_[next];
+        }
+    }
+    
+    return std::min(position, itemCount_ - 1);
+}
+
+void ScrollList::refresh() {
+    rebindAll_ = true;
+    invalidateRows();
+}
+
+void ScrollList::invalidateRows() {
+    rowsDirty_ = true;
+    markLayoutStructureDirty();
+}
+
+void ScrollList::updateVisibleRows() {
+    const glm::vec2 position = getPosition();
+    const glm::vec2 size = getSize();
+    
+    if (position != lastViewportPosition_ || size != lastViewportSize_) {
+        lastViewportPosition_ = position;
+        lastViewportSize_ = size;
+        scrollOffset_ = std::min(std::max(scrollOffset_, 0.0f), maxScrollOffset());
+        rowsDirty_ = true;
+    }
+    
+    if (!rowsDirty_) {
+        return;
+    }
+    rowsDirty_ = false;
+    
+    if (itemCount_ == 0 || !rowFactory_) {
+        visibleCount_ = 0;
+        return;
+    }
+    
+    size_t first = getItemAtOffset(scrollOffset_);
+    size_t last = getItemAtOffset(scrollOffset_ + size.y);
+    size_t begin = first > overscan_ ? first - overscan_ : 0;
+    size_t end = std::min(itemCount_, last + 1 + overscan_);
+    
+    size_t poolSize = end - begin;
+    if (heightTree_.empty()) {
+        // With fixed heights the worst case is known up front, so size the
+        // pool once instead of growing it on the first scroll
+        size_t rowsInViewport = static_cast<size_t>(std::ceil(size.y / rowHeight_)) + 1;
+        poolSize = std::max(poolSize, std::min(itemCount_, rowsInViewport + 2 * overscan_));
+    }
+    ensurePoolSize(poolSize);
+    
+    float y = position.y + getItemOffset(begin) - scrollOffset_;
+    for (size_t item = begin; item < end; item++) {
+        size_t slot = item % rows_.size();
+        UIComponent& row = *rows_[slot];
+        
+        if (rebindAll_ || boundItems_[slot] != item) {
+            if (rowBinder_) {
+                rowBinder_(item, row);
+            }
+            boundItems_[slot] = item;
+        }
+        
+        float height = getItemHeight(item);
+        row.arrange(glm::vec2(position.x, y), glm::vec2(size.x, height));
+        y += height;
+    }
+    
+    firstItem_ = begin;
+    visibleCount_ = end - begin;
+    rebindAll_ = false;
+}
+
+void ScrollList::ensurePoolSize(size_t count) {
+    if (rows_.size() >= count) {
+        return;
+    }
+    
+    // Items map to slot item % poolSize, so growing the pool reshuffles slots
+    while (rows_.size() < count) {
+        std::shared_ptr<UIComponent> row = rowFactory_(rows_.size());
+        if (!row) {
+            throw std::runtime_error("ScrollList row factory returned null");
+        }
+        row->setParent(this);
+        row->initialize();
+        rows_.push_back(row);
+        boundItems_.push_back(UNBOUND);
+    }
+    
+    rebindAll_ = true;
+    markLayoutStructureDirty();
+}
+
+float ScrollList::maxScrollOffset() const {
+    return std::max(0.0f, getContentHeight() - getSize().y);
+}
+
+void ScrollList::rebuildHeightIndex() {
+    heightTree_.assign(itemCount_ + 1, 0.0f);
+    
+    for (size_t i = 0; i < itemCount_; i++) {
+        heightTree_[i + 1] = rowHeightProvider_ ? rowHeightProvider_(i) : rowHeight_;
+    }
+    
+    for (size_t k = 1; k <= itemCount_; k++) {
+        size_t parent = k + (k & (~k + 1));
+        if (parent <= itemCount_) {
+            heightTree_[parent] += heightTree_[k];
+        }
+    }
+    
+    rowsDirty_ = true;
+}
+
+void ScrollList::resizeHeightIndex() {
+    // Each node covers items (k - lowbit(k), k], so dropping the tail leaves
+    // the rest intact, and an appended node is its own height plus the nodes
+    // below it that it covers. Heights already set are kept.
+    size_t previous = heightTree_.size() - 1;
+    heightTree_.resize(itemCount_ + 1, 0.0f);
+    for (size_t k = previous + 1; k <= itemCount_; k++) {
+        float sum = rowHeightProvider_ ? rowHeightProvider_(k - 1) : rowHeight_;
+        size_t low = k - (k & (~k + 1));
+        for (size_t j = k - 1; j > low; j -= j & (~j + 1)) {
+            sum += heightTree_[j];
+        }
+        heightTree_[k] = sum;
+    }
+    
+    rowsDirty_ = true;
+}
+
+} // namespace ui
+} // namespace voidengine
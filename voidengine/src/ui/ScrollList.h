@@ -0,0 +1,109 @@
+#pragma once
+
+#include "UIComponent.h"
+#include <functional>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace voidengine {
+namespace ui {
+
+// Vertical list that only instantiates enough row widgets to cover the
+// viewport plus an overscan margin. Rows are recycled as the list scrolls and
+// rebound to new items through the binder callback, so memory and per-frame
+// cost follow the viewport size rather than the item count.
+//
+// Rows are positioned by the list itself; leave its layout direction NONE.
+class ScrollList : public UIComponent {
+public:
+    using RowFactory = std::function<std::shared_ptr<UIComponent>(size_t slot)>;
+    using RowBinder = std::function<void(size_t itemIndex, UIComponent& row)>;
+    using RowHeightProvider = std::function<float(size_t itemIndex)>;
+    
+    ScrollList(const std::string& id, const glm::vec2& position, const glm::vec2& size,
+               float rowHeight = 24.0f);
+    
+    virtual ~ScrollList();
+    
+    void initialize() override;
+    void update(float deltaTime) override;
+    void render() override;
+    core::StringId getStyleType() const override { return core::hashString("ScrollList"); }
+    void onLayout() override;
+    
+    void onEvent(UIEvent& event) override;
+    
+    size_t getChildCount() const override { return visibleCount_; }
+    UIComponent* getChild(size_t index) const override;
+    
+    void setRowFactory(const RowFactory& factory);
+    void setRowBinder(const RowBinder& binder);
+    
+    void setItemCount(size_t count);
+    size_t getItemCount() const { return itemCount_; }
+    
+    // Switches to variable row heights; the provider is queried once per item
+    // to build the height index
+    void setRowHeightProvider(const RowHeightProvider& provider);
+    void setItemHeight(size_t itemIndex, float height);
+    float getItemHeight(size_t itemIndex) const;
+    
+    void setOverscan(size_t rows);
+    size_t getOverscan() const { return overscan_; }
+    
+    void setScrollOffset(float offset);
+    float getScrollOffset() const { return scrollOffset_; }
+    void scrollBy(float delta) { setScrollOffset(scrollOffset_ + delta); }
+    void scrollToItem(size_t itemIndex);
+    
+    void setScrollSpeed(float pixelsPerNotch) { scrollSpeed_ = pixelsPerNotch; }
+    
+    float getContentHeight() const;
+    float getItemOffset(size_t itemIndex) const;
+    size_t getItemAtOffset(float offset) const;
+    
+    size_t getFirstVisibleItem() const { return firstItem_; }
+    size_t getPoolSize() const { return rows_.size(); }
+    
+    // Rebinds every visible row, e.g. after the underlying data changed
+    void refresh();
+    
+private:
+    void invalidateRows();
+    void updateVisibleRows();
+    void ensurePoolSize(size_t count);
+    float maxScrollOffset() const;
+    
+    RowFactory rowFactory_;
+    RowBinder rowBinder_;
+    
+    size_t itemCount_ = 0;
+    float rowHeight_;
+    size_t overscan_ = 2;
+    float scrollOffset_ = 0.0f;
+    float scrollSpeed_ = 40.0f;
+    
+    void rebuildHeightIndex();
+    void resizeHeightIndex();
+    
+    RowHeightProvider rowHeightProvider_;
+    
+    // Fenwick tree of item heights, giving O(log n) offsets, lookups and
+    // height updates. Empty while every row uses rowHeight_.
+    std::vector<float> heightTree_;
+    
+    std::vector<std::shared_ptr<UIComponent>> rows_;
+    std::vector<size_t> boundItems_;
+    size_t firstItem_ = 0;
+    size_t visibleCount_ = 0;
+    glm::vec2 lastViewportPosition_ = glm::vec2(0.0f);
+    glm::vec2 lastViewportSize_ = glm::vec2(-1.0f);
+    bool rowsDirty_ = true;
+    bool rebindAll_ = true;
+    
+    static constexpr size_t UNBOUND = static_cast<size_t>(-1);
+};
+
+} // namespace ui
+} // namespace voidengine
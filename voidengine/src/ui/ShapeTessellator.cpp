@@ -0,0 +1,305 @@
+#include "ShapeTessellator.h"
+#include "../core/StringId.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace voidengine {
+namespace ui {
+
+std::unique_ptr<ShapeCache> gShapeCache = nullptr;
+
+ShapeCache& getShapeCache() {
+    if (!gShapeCache) {
+        gShapeCache = std::make_unique<ShapeCache>();
+    }
+    return *gShapeCache;
+}
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+constexpr float HALF_PI = PI * 0.5f;
+constexpr float ARC_TOLERANCE = 0.25f;
+constexpr size_t MAX_ARC_SEGMENTS = 256;
+
+void addQuad(ShapeMesh& mesh, const glm::vec2& a, float coverageA, const glm::vec2& b, float coverageB,
+             const glm::vec2& c, float coverageC, const glm::vec2& d, float coverageD) {
+    mesh.vertices.push_back(ShapeVertex{a, coverageA});
+    mesh.vertices.push_back(ShapeVertex{b, coverageB});
+    mesh.vertices.push_back(ShapeVertex{c, coverageC});
+    mesh.vertices.push_back(ShapeVertex{d, coverageD});
+}
+
+// Unit vectors from a corner's center to its points, for the top-left corner;
+// the other corners rotate them by quarter turns
+void cornerDirections(size_t segments, std::vector<glm::vec2>& out) {
+    out.clear();
+    for (size_t i = 0; i <= segments; i++) {
+        const float angle = PI + HALF_PI * static_cast<float>(i) / static_cast<float>(segments);
+        out.push_back(glm::vec2(std::cos(angle), std::sin(angle)));
+    }
+}
+
+// Outline of a rounded rect grown by offset (shrunk when negative), clockwise
+// on screen from the left end of the top-left corner. Every corner gets the
+// same number of points whatever its radius, so outlines at different
+// offsets pair up point for point.
+void roundedRectOutline(const glm::vec2& size, float radius, float offset, const std::vector<glm::vec2>& directions,
+                        std::vector<glm::vec2>& out) {
+    const glm::vec2 center = size * 0.5f;
+    const glm::vec2 low = glm::min(glm::vec2(-offset), center);
+    const glm::vec2 high = glm::max(size + glm::vec2(offset), center);
+    const float r = std::min(std::max(radius + offset, 0.0f), std::min(high.x - low.x, high.y - low.y) * 0.5f);
+    
+    out.resize(4 * directions.size());
+    glm::vec2* point = out.data();
+    for (const glm::vec2& d : directions) {
+        *point++ = glm::vec2(low.x + r, low.y + r) + r * d;
+    }
+    for (const glm::vec2& d : directions) {
+        *point++ = glm::vec2(high.x - r, low.y + r) + r * glm::vec2(-d.y, d.x);
+    }
+    for (const glm::vec2& d : directions) {
+        *point++ = glm::vec2(high.x - r, high.y - r) - r * d;
+    }
+    for (const glm::vec2& d : directions) {
+        *point++ = glm::vec2(low.x + r, high.y - r) + r * glm::vec2(d.y, -d.x);
+    }
+}
+
+void arcOutline(float radius, const std::vector<glm::vec2>& directions, std::vector<glm::vec2>& out) {
+    const float r = std::max(radius, 0.0f);
+    out.resize(directions.size());
+    for (size_t i = 0; i < directions.size(); i++) {
+        out[i] = r * directions[i];
+    }
+}
+
+// Quads joining two outlines point for point
+void addBand(const std::vector<glm::vec2>& inner, float innerCoverage, const std::vector<glm::vec2>& outer,
+             float outerCoverage, bool closed, ShapeMesh& mesh) {
+    const size_t count = inner.size();
+    const size_t edges = closed ? count : count - 1;
+    for (size_t i = 0; i < edges; i++) {
+        const size_t j = (i + 1) % count;
+        addQuad(mesh, inner[i], innerCoverage, outer[i], outerCoverage, outer[j], outerCoverage, inner[j],
+                innerCoverage);
+    }
+}
+
+float clampRadius(const glm::vec2& size, float radius) {
+    return std::min(std::max(radius, 0.0f), std::min(size.x, size.y) * 0.5f);
+}
+
+} // namespace
+
+size_t arcSegmentCount(float radius, float angle) {
+    if (radius <= ARC_TOLERANCE) {
+        return 1;
+    }
+    const float step = 2.0f * std::acos(1.0f - ARC_TOLERANCE / radius);
+    const float segments = std::ceil(std::abs(angle) / step);
+    return std::min(std::max(static_cast<size_t>(segments), size_t(1)), MAX_ARC_SEGMENTS);
+}
+
+void tessellateRoundedRect(const glm::vec2& size, float radius, float fringe, ShapeMesh& mesh) {
+    radius = clampRadius(size, radius);
+    const float half = std::max(fringe, 0.0f) * 0.5f;
+    const size_t segments = arcSegmentCount(radius + half, HALF_PI);
+    const size_t cornerPoints = segments + 1;
+    
+    std::vector<glm::vec2> directions;
+    cornerDirections(segments, directions);
+    std::vector<glm::vec2> inner;
+    roundedRectOutline(size, radius, -half, directions, inner);
+    
+    // The interior in horizontal slabs between rows of outline points: the
+    // top corners' points pair up left to right, as do the bottom ones'
+    const glm::vec2* topLeft = inner.data();
+    const glm::vec2* topRight = topLeft + cornerPoints;
+    const glm::vec2* bottomRight = topRight + cornerPoints;
+    const glm::vec2* bottomLeft = bottomRight + cornerPoints;
+    glm::vec2 previousLeft;
+    glm::vec2 previousRight;
+    for (size_t row = 0; row < 2 * cornerPoints; row++) {
+        const size_t i = row % cornerPoints;
+        const glm::vec2 left = row < cornerPoints ? topLeft[segments - i] : bottomLeft[segments - i];
+        const glm::vec2 right = row < cornerPoints ? topRight[i] : bottomRight[i];
+        if (row > 0 && left.y > previousLeft.y) {
+            addQuad(mesh, previousLeft, 1.0f, previousRight, 1.0f, right, 1.0f, left, 1.0f);
+        }
+        previousLeft = left;
+        previousRight = right;
+    }
+    
+    if (half > 0.0f) {
+        std::vector<glm::vec2> outer;
+        roundedRectOutline(size, radius, half, directions, outer);
+        addBand(inner, 1.0f, outer, 0.0f, true, mesh);
+    }
+}
+
+void tessellateRoundedRectStroke(const glm::vec2& size, float radius, float width, float fringe, ShapeMesh& mesh) {
+    if (width <= 0.0f) {
+        return;
+    }
+    radius = clampRadius(size, radius);
+    fringe = std::max(fringe, 0.0f);
+    const float band = std::max(width, fringe);
+    const float coverage = width / band;
+    const float edge = band * 0.5f;
+    const float half = fringe * 0.5f;
+    const size_t segments = arcSegmentCount(radius + edge + half, HALF_PI);
+    
+    // Outlines from the inside out: fringe start, band start, band end,
+    // fringe end
+    std::vector<glm::vec2> directions;
+    cornerDirections(segments, directions);
+    std::vector<glm::vec2> outlines[4];
+    const float offsets[4] = {-edge - half, -edge + half, edge - half, edge + half};
+    for (size_t i = 0; i < 4; i++) {
+        roundedRectOutline(size, radius, offsets[i], directions, outlines[i]);
+    }
+    
+    if (half > 0.0f) {
+        addBand(outlines[0], 0.0f, outlines[1], coverage, true, mesh);
+        addBand(outlines[2], coverage, outlines[3], 0.0f, true, mesh);
+    }
+    if (offsets[2] > offsets[1]) {
+        addBand(outlines[1], coverage, outlines[2], coverage, true, mesh);
+    }
+}
+
+void tessellateArc(float radius, float startAngle, float endAngle, float width, float fringe, ShapeMesh& mesh) {
+    if (width <= 0.0f || startAngle == endAngle) {
+        return;
+    }
+    fringe = std::max(fringe, 0.0f);
+    const float band = std::max(width, fringe);
+    const float coverage = width / band;
+    const float edge = band * 0.5f;
+    const float half = fringe * 0.5f;
+    const size_t segments = arcSegmentCount(radius + edge + half, endAngle - startAngle);
+    
+    std::vector<glm::vec2> directions;
+    for (size_t i = 0; i <= segments; i++) {
+        const float angle = startAngle + (endAngle - startAngle) * static_cast<float>(i) / static_cast<float>(segments);
+        directions.push_back(glm::vec2(std::cos(angle), std::sin(angle)));
+    }
+    std::vector<glm::vec2> outlines[4];
+    const float offsets[4] = {-edge - half, -edge + half, edge - half, edge + half};
+    for (size_t i = 0; i < 4; i++) {
+        arcOutline(radius + offsets[i], directions, outlines[i]);
+    }
+    
+    if (half > 0.0f) {
+        addBand(outlines[0], 0.0f, outlines[1], coverage, false, mesh);
+        addBand(outlines[2], coverage, outlines[3], 0.0f, false, mesh);
+    }
+    if (offsets[2] > offsets[1]) {
+        addBand(outlines[1], coverage, outlines[2], coverage, false, mesh);
+    }
+}
+
+bool ShapeCache::Key::operator==(const Key& other) const {
+    return kind == other.kind && std::equal(values, values + 6, other.values);
+}
+
+ShapeCache::ShapeCache(size_t capacity)
+    : capacity_(capacity) {
+    if (capacity_ == 0) {
+        throw std::invalid_argument("Shape cache capacity must be positive");
+    }
+    entries_.reserve(capacity_);
+    index_.reserve(capacity_);
+}
+
+const ShapeMesh& ShapeCache::getRoundedRect(const glm::vec2& size, float radius, float fringe) {
+    Key key{Kind::ROUNDED_RECT, {size.x, size.y, radius, fringe, 0.0f, 0.0f}};
+    return get(key);
+}
+
+const ShapeMesh& ShapeCache::getRoundedRectStroke(const glm::vec2& size, float radius, float width, float fringe) {
+    Key key{Kind::ROUNDED_RECT_STROKE, {size.x, size.y, radius, width, fringe, 0.0f}};
+    return get(key);
+}
+
+const ShapeMesh& ShapeCache::getArc(float radius, float startAngle, float endAngle, float width, float fringe) {
+    Key key{Kind::ARC, {radius, startAngle, endAngle, width, fringe, 0.0f}};
+    return get(key);
+}
+
+void ShapeCache::clear() {
+    entries_.clear();
+    index_.clear();
+    hand_ = 0;
+}
+
+void ShapeCache::setEnabled(bool enabled) {
+    enabled_ = enabled;
+    if (!enabled_) {
+        clear();
+    }
+}
+
+const ShapeMesh& ShapeCache::get(const Key& key) {
+    if (!enabled_) {
+        misses_++;
+        tessellate(key, scratch_);
+        return scratch_;
+    }
+    
+    const uint32_t hash = core::hashString(reinterpret_cast<const char*>(&key), sizeof(Key));
+    uint32_t slot;
+    if (const uint32_t* found = index_.find(hash)) {
+        Entry& entry = entries_[*found];
+        if (entry.key == key) {
+            entry.referenced = true;
+            hits_++;
+            return entry.mesh;
+        }
+        // Hash collision; the newer shape takes the slot
+        slot = *found;
+    } else if (entries_.size() < capacity_) {
+        slot = static_cast<uint32_t>(entries_.size());
+        entries_.emplace_back();
+        index_[hash] = slot;
+    } else {
+        while (entries_[hand_].referenced) {
+            entries_[hand_].referenced = false;
+            hand_ = (hand_ + 1) % capacity_;
+        }
+        slot = static_cast<uint32_t>(hand_);
+        hand_ = (hand_ + 1) % capacity_;
+        const Key& evicted = entries_[slot].key;
+        index_.erase(core::hashString(reinterpret_cast<const char*>(&evicted), sizeof(Key)));
+        index_[hash] = slot;
+    }
+    
+    misses_++;
+    Entry& entry = entries_[slot];
+    entry.key = key;
+    entry.referenced = true;
+    tessellate(key, entry.mesh);
+    return entry.mesh;
+}
+
+void ShapeCache::tessellate(const Key& key, ShapeMesh& mesh) {
+    mesh.vertices.clear();
+    const float* v = key.values;
+    switch (key.kind) {
+        case Kind::ROUNDED_RECT:
+            tessellateRoundedRect(glm::vec2(v[0], v[1]), v[2], v[3], mesh);
+            break;
+        case Kind::ROUNDED_RECT_STROKE:
+            tessellateRoundedRectStroke(glm::vec2(v[0], v[1]), v[2], v[3], v[4], mesh);
+            break;
+        case Kind::ARC:
+            tessellateArc(v[0], v[1], v[2], v[3], v[4], mesh);
+            break;
+    }
+}
+
+} // namespace ui
+} // namespace voidengine
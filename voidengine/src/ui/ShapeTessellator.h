@@ -0,0 +1,104 @@
+#pragma once
+
+#include "../core/FlatHashMap.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace voidengine {
+namespace ui {
+
+struct ShapeVertex {
+    glm::vec2 position;
+    // Scales the alpha of the color the shape is drawn with; zero on the
+    // outer edge of an anti-aliasing fringe
+    float coverage;
+};
+
+// A shape as a list of quads, four vertices each; a triangle repeats its last
+// vertex. Positions are relative to the shape's origin and carry no color, so
+// one mesh serves every widget with the same geometry.
+struct ShapeMesh {
+    std::vector<ShapeVertex> vertices;
+};
+
+// Segments for an arc of the given angle so no chord strays more than a
+// quarter pixel from the curve
+size_t arcSegmentCount(float radius, float angle);
+
+// The tessellators append to the mesh. Every edge gets a fringe where coverage
+// falls from 1 to 0 over fringe pixels, centered on the edge; a fringe of a
+// pixel anti-aliases and a wide one makes a soft shadow. Radii are clamped to
+// half the shorter side.
+void tessellateRoundedRect(const glm::vec2& size, float radius, float fringe, ShapeMesh& mesh);
+// A band width wide centered on the rect's edge. Bands thinner than the
+// fringe are drawn a fringe wide at proportionally lower coverage.
+void tessellateRoundedRectStroke(const glm::vec2& size, float radius, float width, float fringe, ShapeMesh& mesh);
+// A band along a circle around the origin. Angles are in radians and run
+// clockwise on screen from +x; the ends are cut square without a fringe.
+void tessellateArc(float radius, float startAngle, float endAngle, float width, float fringe, ShapeMesh& mesh);
+
+// Bounded map from shape parameters to meshes. A widget whose geometry is
+// unchanged finds its mesh here; one that changed asks under a new key, and
+// the old mesh ages out. A full cache evicts with the clock algorithm, like
+// TextLayoutCache. Main thread only.
+class ShapeCache {
+public:
+    explicit ShapeCache(size_t capacity = 512);
+    
+    // Meshes stay valid until the next get or clear()
+    const ShapeMesh& getRoundedRect(const glm::vec2& size, float radius, float fringe);
+    const ShapeMesh& getRoundedRectStroke(const glm::vec2& size, float radius, float width, float fringe);
+    const ShapeMesh& getArc(float radius, float startAngle, float endAngle, float width, float fringe);
+    void clear();
+    // While disabled every get tessellates afresh into one scratch mesh; for
+    // measuring what the cache saves
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled_; }
+    
+    size_t size() const { return entries_.size(); }
+    size_t getCapacity() const { return capacity_; }
+    uint64_t getHitCount() const { return hits_; }
+    uint64_t getMissCount() const { return misses_; }
+
+private:
+    enum class Kind : uint32_t {
+        ROUNDED_RECT,
+        ROUNDED_RECT_STROKE,
+        ARC
+    };
+    
+    struct Key {
+        Kind kind;
+        float values[6];
+        
+        bool operator==(const Key& other) const;
+    };
+    
+    struct Entry {
+        Key key;
+        ShapeMesh mesh;
+        bool referenced = false;
+    };
+    
+    const ShapeMesh& get(const Key& key);
+    static void tessellate(const Key& key, ShapeMesh& mesh);
+    
+    size_t capacity_;
+    bool enabled_ = true;
+    ShapeMesh scratch_;
+    std::vector<Entry> entries_;
+    core::FlatHashMap<uint32_t, uint32_t> index_;
+    size_t hand_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+extern std::unique_ptr<ShapeCache> gShapeCache;
+
+ShapeCache& getShapeCache();
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,468 @@
+#include "StyleSheet.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace voidengine {
+namespace ui {
+
+std::unique_ptr<StyleSystem> gStyleSystem = nullptr;
+
+StyleSystem& getStyleSystem() {
+    if (!gStyleSystem) {
+        gStyleSystem = std::make_unique<StyleSystem>();
+    }
+    return *gStyleSystem;
+}
+
+namespace {
+
+bool isColorProperty(StyleProperty property) {
+    return property < StyleProperty::BORDER_WIDTH;
+}
+
+template <typename Record>
+auto& colorField(Record& record, StyleProperty property) {
+    switch (property) {
+        case StyleProperty::BORDER:
+            return record.border;
+        case StyleProperty::TEXT:
+            return record.text;
+        case StyleProperty::HOVER_BACKGROUND:
+            return record.hoverBackground;
+        case StyleProperty::PRESSED_BACKGROUND:
+            return record.pressedBackground;
+        case StyleProperty::DISABLED_BACKGROUND:
+            return record.disabledBackground;
+        case StyleProperty::SHADOW:
+            return record.shadow;
+        default:
+            return record.background;
+    }
+}
+
+template <typename Record>
+auto& numberField(Record& record, StyleProperty property) {
+    switch (property) {
+        case StyleProperty::BORDER_WIDTH:
+            return record.borderWidth;
+        case StyleProperty::BORDER_RADIUS:
+            return record.borderRadius;
+        case StyleProperty::SHADOW_BLUR:
+            return record.shadowBlur;
+        default:
+            return record.transitionDuration;
+    }
+}
+
+struct PropertyName {
+    const char* name;
+    StyleProperty property;
+};
+
+const PropertyName PROPERTY_NAMES[] = {
+    {"background", StyleProperty::BACKGROUND},
+    {"border", StyleProperty::BORDER},
+    {"text", StyleProperty::TEXT},
+    {"hover-background", StyleProperty::HOVER_BACKGROUND},
+    {"pressed-background", StyleProperty::PRESSED_BACKGROUND},
+    {"disabled-background", StyleProperty::DISABLED_BACKGROUND},
+    {"shadow", StyleProperty::SHADOW},
+    {"border-width", StyleProperty::BORDER_WIDTH},
+    {"transition-duration", StyleProperty::TRANSITION_DURATION},
+    {"border-radius", StyleProperty::BORDER_RADIUS},
+    {"shadow-blur", StyleProperty::SHADOW_BLUR},
+};
+
+bool isNameChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-';
+}
+
+std::string trim(const std::string& text) {
+    size_t begin = 0;
+    size_t end = text.size();
+    while (begin < end && std::isspace(static_cast<unsigned char>(text[begin]))) {
+        begin++;
+    }
+    while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1]))) {
+        end--;
+    }
+    return text.substr(begin, end - begin);
+}
+
+class StyleParser {
+public:
+    explicit StyleParser(const std::string& source) : source_(source) {}
+    
+    std::shared_ptr<StyleSheet> parse() {
+        auto sheet = std::make_shared<StyleSheet>();
+        
+        while (skipBlank()) {
+            int selectorLine = line_;
+            std::string selectors = readUntil('{', "Expected '{' after selector");
+            StyleDeclaration declaration = parseBody();
+            
+            size_t start = 0;
+            while (start <= selectors.size()) {
+                size_t comma = selectors.find(',', start);
+                if (comma == std::string::npos) {
+                    comma = selectors.size();
+                }
+                std::string selector = trim(selectors.substr(start, comma - start));
+                try {
+                    sheet->addRule(selector, declaration);
+                } catch (const std::invalid_argument& e) {
+                    fail(selectorLine, e.what());
+                }
+                start = comma + 1;
+            }
+        }
+        
+        return sheet;
+    }
+
+private:
+    StyleDeclaration parseBody() {
+        StyleDeclaration declaration;
+        
+        while (true) {
+            if (!skipBlank()) {
+                fail(line_, "Unterminated rule, expected '}'");
+            }
+            if (source_[pos_] == '}') {
+                pos_++;
+                return declaration;
+            }
+            
+            int statementLine = line_;
+            std::string statement;
+            while (pos_ < source_.size() && source_[pos_] != ';' && source_[pos_] != '}') {
+                advance();
+                statement += source_[pos_ - 1];
+            }
+            if (pos_ < source_.size() && source_[pos_] == ';') {
+                pos_++;
+            }
+            
+            parseDeclaration(statement, statementLine, declaration);
+        }
+    }
+    
+    void parseDeclaration(const std::string& statement, int line, StyleDeclaration& declaration) {
+        size_t colon = statement.find(':');
+        if (colon == std::string::npos) {
+            fail(line, "Expected 'property: value'");
+        }
+        
+        std::string name = trim(statement.substr(0, colon));
+        const PropertyName* found = nullptr;
+        for (const PropertyName& entry : PROPERTY_NAMES) {
+            if (name == entry.name) {
+                found = &entry;
+                break;
+            }
+        }
+        if (!found) {
+            fail(line, "Unknown style property '" + name + "'");
+        }
+        
+        std::vector<float> values;
+        std::string text = statement.substr(colon + 1);
+        const char* cursor = text.c_str();
+        while (true) {
+            while (std::isspace(static_cast<unsigned char>(*cursor))) {
+                cursor++;
+            }
+            if (*cursor == '\0') {
+                break;
+            }
+            char* end = nullptr;
+            float value = std::strtof(cursor, &end);
+            if (end == cursor) {
+                fail(line, "Expected a number for '" + name + "'");
+            }
+            values.push_back(value);
+            cursor = end;
+        }
+        
+        if (isColorProperty(found->property)) {
+            if (values.size() != 3 && values.size() != 4) {
+                fail(line, "'" + name + "' takes 3 or 4 components");
+            }
+            float alpha = values.size() == 4 ? values[3] : 1.0f;
+            declaration.setColor(found->property, glm::vec4(values[0], values[1], values[2], alpha));
+        } else {
+            if (values.size() != 1) {
+                fail(line, "'" + name + "' takes a single number");
+            }
+            declaration.setNumber(found->property, values[0]);
+        }
+    }
+    
+    // Skips whitespace and // comments; false at the end of the source
+    bool skipBlank() {
+        while (pos_ < source_.size()) {
+            char c = source_[pos_];
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                advance();
+            } else if (c == '/' && pos_ + 1 < source_.size() && source_[pos_ + 1] == '/') {
+                while (pos_ < source_.size() && source_[pos_] != '\n') {
+                    pos_++;
+                }
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    std::string readUntil(char terminator, const std::string& message) {
+        int startLine = line_;
+        std::string text;
+        while (pos_ < source_.size() && source_[pos_] != terminator) {
+            if (source_[pos_] == '}' || source_[pos_] == ';') {
+                fail(line_, message);
+            }
+            advance();
+            text += source_[pos_ - 1];
+        }
+        if (pos_ >= source_.size()) {
+            fail(startLine, message);
+        }
+        pos_++;
+        return text;
+    }
+    
+    void advance() {
+        if (source_[pos_] == '\n') {
+            line_++;
+        }
+        pos_++;
+    }
+    
+    [[noreturn]] void fail(int line, const std::string& message) const {
+        throw std::runtime_error("Style sheet line " + std::to_string(line) + ": " + message);
+    }
+    
+    const std::string& source_;
+    size_t pos_ = 0;
+    int line_ = 1;
+};
+
+} // namespace
+
+bool StyleRecord::operator==(const StyleRecord& other) const {
+    return background == other.background && border == other.border && text == other.text &&
+           hoverBackground == other.hoverBackground && pressedBackground == other.pressedBackground &&
+           disabledBackground == other.disabledBackground && shadow == other.shadow &&
+           borderWidth == other.borderWidth && transitionDuration == other.transitionDuration &&
+           borderRadius == other.borderRadius && shadowBlur == other.shadowBlur;
+}
+
+void StyleDeclaration::setColor(StyleProperty property, const glm::vec4& color) {
+    if (property >= StyleProperty::COUNT || !isColorProperty(property)) {
+        throw std::invalid_argument("Style property is not a color");
+    }
+    colorField(values_, property) = color;
+    mask_ |= bit(property);
+}
+
+void StyleDeclaration::setNumber(StyleProperty property, float value) {
+    if (property >= StyleProperty::COUNT || isColorProperty(property)) {
+        throw std::invalid_argument("Style property is not a number");
+    }
+    numberField(values_, property) = value;
+    mask_ |= bit(property);
+}
+
+void StyleDeclaration::merge(const StyleDeclaration& other) {
+    other.applyTo(values_);
+    mask_ |= other.mask_;
+}
+
+void StyleDeclaration::applyTo(StyleRecord& record) const {
+    for (uint32_t i = 0; i < static_cast<uint32_t>(StyleProperty::COUNT); i++) {
+        StyleProperty property = static_cast<StyleProperty>(i);
+        if (!has(property)) {
+            continue;
+        }
+        if (isColorProperty(property)) {
+            colorField(record, property) = colorField(values_, property);
+        } else {
+            numberField(record, property) = numberField(values_, property);
+        }
+    }
+}
+
+std::shared_ptr<StyleSheet> StyleSheet::parse(const std::string& source) {
+    return StyleParser(source).parse();
+}
+
+void StyleSheet::addRule(const std::string& selector, const StyleDeclaration& declaration) {
+    Rule rule{0, 0, 0, 0, static_cast<uint32_t>(rules_.size()), declaration};
+    
+    if (selector.empty()) {
+        throw std::invalid_argument("Empty style selector");
+    }
+    
+    size_t pos = 0;
+    if (selector == "*") {
+        pos = selector.size();
+    }
+    while (pos < selector.size()) {
+        char kind = selector[pos];
+        if (kind == '.' || kind == '#') {
+            pos++;
+        } else if (pos != 0) {
+            throw std::invalid_argument("Malformed style selector '" + selector + "'");
+        }
+        
+        size_t start = pos;
+        while (pos < selector.size() && isNameChar(selector[pos])) {
+            pos++;
+        }
+        if (pos == start) {
+            throw std::invalid_argument("Malformed style selector '" + selector + "'");
+        }
+        
+        core::StringId name = core::hashString(selector.data() + start, pos - start);
+        if (kind == '#') {
+            // Component ids are interned, and a colliding one is not its hash
+            rule.id = core::internString(std::string_view(selector.data() + start, pos - start));
+            rule.specificity += 100;
+        } else if (kind == '.') {
+            rule.styleClass = name;
+            rule.specificity += 10;
+        } else {
+            rule.type = name;
+            rule.specificity += 1;
+        }
+    }
+    
+    // Kept in application order, so apply() is a single forward pass
+    auto position = std::upper_bound(rules_.begin(), rules_.end(), rule, [](const Rule& a, const Rule& b) {
+        return a.specificity < b.specificity;
+    });
+    rules_.insert(position, rule);
+    
+    if (rule.id != 0) {
+        idRules_[rule.id]++;
+    }
+    version_++;
+}
+
+void StyleSheet::apply(core::StringId type, core::StringId styleClass, core::StringId id,
+                       StyleRecord& record) const {
+    for (const Rule& rule : rules_) {
+        if ((rule.type == 0 || rule.type == type) &&
+            (rule.styleClass == 0 || rule.styleClass == styleClass) &&
+            (rule.id == 0 || rule.id == id)) {
+            rule.declaration.applyTo(record);
+        }
+    }
+}
+
+std::shared_ptr<StyleSheet> createDefaultStyleSheet() {
+    auto sheet = std::make_shared<StyleSheet>();
+    
+    StyleDeclaration button;
+    button.setColor(StyleProperty::BACKGROUND, glm::vec4(0.3f, 0.3f, 0.8f, 1.0f));
+    button.setColor(StyleProperty::HOVER_BACKGROUND, glm::vec4(0.4f, 0.4f, 0.9f, 1.0f));
+    button.setColor(StyleProperty::PRESSED_BACKGROUND, glm::vec4(0.2f, 0.2f, 0.7f, 1.0f));
+    button.setColor(StyleProperty::DISABLED_BACKGROUND, glm::vec4(0.5f, 0.5f, 0.5f, 0.7f));
+    sheet->addRule("Button", button);
+    
+    StyleDeclaration scrollList;
+    scrollList.setColor(StyleProperty::BACKGROUND, glm::vec4(0.15f, 0.15f, 0.2f, 0.9f));
+    sheet->addRule("ScrollList", scrollList);
+    
+    StyleDeclaration textField;
+    textField.setColor(StyleProperty::BACKGROUND, glm::vec4(0.08f, 0.08f, 0.1f, 0.95f));
+    textField.setColor(StyleProperty::BORDER, glm::vec4(0.6f, 0.6f, 0.6f, 1.0f));
+    sheet->addRule("TextField", textField);
+    
+    StyleDeclaration dataGrid;
+    dataGrid.setColor(StyleProperty::BACKGROUND, glm::vec4(0.1f, 0.1f, 0.13f, 0.95f));
+    dataGrid.setColor(StyleProperty::BORDER, glm::vec4(0.45f, 0.45f, 0.5f, 1.0f));
+    sheet->addRule("DataGrid", dataGrid);
+    
+    StyleDeclaration logConsole;
+    logConsole.setColor(StyleProperty::BACKGROUND, glm::vec4(0.05f, 0.05f, 0.07f, 0.9f));
+    logConsole.setColor(StyleProperty::BORDER, glm::vec4(0.35f, 0.35f, 0.4f, 1.0f));
+    logConsole.setColor(StyleProperty::TEXT, glm::vec4(0.85f, 0.85f, 0.85f, 1.0f));
+    sheet->addRule("LogConsole", logConsole);
+    
+    StyleDeclaration plot;
+    plot.setColor(StyleProperty::BACKGROUND, glm::vec4(0.08f, 0.08f, 0.1f, 0.9f));
+    plot.setColor(StyleProperty::BORDER, glm::vec4(0.35f, 0.35f, 0.4f, 1.0f));
+    sheet->addRule("Plot", plot);
+    
+    return sheet;
+}
+
+StyleSystem::StyleSystem() {
+    setStyleSheet(createDefaultStyleSheet());
+}
+
+void StyleSystem::setStyleSheet(std::shared_ptr<StyleSheet> sheet) {
+    if (!sheet) {
+        throw std::invalid_argument("Style sheet cannot be null");
+    }
+    
+    sheet_ = std::move(sheet);
+    sheetVersion_ = sheet_->getVersion();
+    generation_++;
+    selectorCache_.clear();
+}
+
+uint32_t StyleSystem::getGeneration() {
+    if (sheet_->getVersion() != sheetVersion_) {
+        sheetVersion_ = sheet_->getVersion();
+        generation_++;
+        selectorCache_.clear();
+    }
+    return generation_;
+}
+
+StyleId StyleSystem::resolve(core::StringId type, core::StringId styleClass, core::StringId id) {
+    getGeneration();
+    
+    const bool shared = !sheet_->hasIdRules(id);
+    const uint64_t key = (static_cast<uint64_t>(type) << 32) | styleClass;
+    if (shared) {
+        if (const StyleId* cached = selectorCache_.find(key)) {
+            return *cached;
+        }
+    }
+    
+    StyleRecord record;
+    sheet_->apply(type, styleClass, id, record);
+    
+    StyleId style = intern(record);
+    if (shared) {
+        selectorCache_.insert(key, style);
+    }
+    return style;
+}
+
+StyleId StyleSystem::intern(const StyleRecord& record) {
+    uint32_t key = core::hashString(reinterpret_cast<const char*>(&record), sizeof(StyleRecord));
+    
+    while (true) {
+        const StyleId* found = recordsByHash_.find(key);
+        if (!found) {
+            StyleId style = static_cast<StyleId>(records_.size());
+            records_.push_back(record);
+            recordsByHash_.insert(key, style);
+            return style;
+        }
+        if (records_[*found] == record) {
+            return *found;
+        }
+        key++;
+    }
+}
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "../core/FlatHashMap.h"
+#include "../core/StringId.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace voidengine {
+namespace ui {
+
+// The resolved look of a widget. Records are interned by the StyleSystem and
+// never change, so every widget with the same selectors shares one; a widget
+// with overrides keeps its own copy.
+struct StyleRecord {
+    glm::vec4 background = glm::vec4(0.2f, 0.2f, 0.2f, 0.8f);
+    glm::vec4 border = glm::vec4(0.8f, 0.8f, 0.8f, 1.0f);
+    glm::vec4 text = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+    glm::vec4 hoverBackground = glm::vec4(0.4f, 0.4f, 0.9f, 1.0f);
+    glm::vec4 pressedBackground = glm::vec4(0.2f, 0.2f, 0.7f, 1.0f);
+    glm::vec4 disabledBackground = glm::vec4(0.5f, 0.5f, 0.5f, 0.7f);
+    glm::vec4 shadow = glm::vec4(0.0f, 0.0f, 0.0f, 0.5f);
+    float borderWidth = 1.0f;
+    // Seconds a widget takes to blend into a new state color
+    float transitionDuration = 0.1f;
+    // Zero draws square corners
+    float borderRadius = 0.0f;
+    // Pixels the drop shadow fades over; zero draws no shadow
+    float shadowBlur = 0.0f;
+    
+    bool operator==(const StyleRecord& other) const;
+    bool operator!=(const StyleRecord& other) const { return !(*this == other); }
+};
+
+enum class StyleProperty : uint8_t {
+    BACKGROUND,
+    BORDER,
+    TEXT,
+    HOVER_BACKGROUND,
+    PRESSED_BACKGROUND,
+    DISABLED_BACKGROUND,
+    SHADOW,
+    BORDER_WIDTH,
+    TRANSITION_DURATION,
+    BORDER_RADIUS,
+    SHADOW_BLUR,
+    COUNT
+};
+
+// A sparse set of property values: the body of a rule, or the few properties
+// a single widget overrides
+class StyleDeclaration {
+public:
+    // Throws std::invalid_argument when the property is not a color
+    void setColor(StyleProperty property, const glm::vec4& color);
+    // Throws std::invalid_argument when the property is not a number
+    void setNumber(StyleProperty property, float value);
+    
+    bool has(StyleProperty property) const { return (mask_ & bit(property)) != 0; }
+    bool empty() const { return mask_ == 0; }
+    
+    // Properties set in other replace ours
+    void merge(const StyleDeclaration& other);
+    void applyTo(StyleRecord& record) const;
+
+private:
+    static uint32_t bit(StyleProperty property) { return 1u << static_cast<uint32_t>(property); }
+    
+    uint32_t mask_ = 0;
+    StyleRecord values_;
+};
+
+// Rules keyed by selectors of the form Type, .class, #id or a combination such
+// as Button.primary. More specific rules win (id, then class, then type);
+// among equals the later rule wins.
+class StyleSheet {
+public:
+    // Parses rules such as
+    //   Button.primary { background: 0.2 0.5 0.2 1; border-width: 2; }
+    // Throws std::runtime_error naming the line on malformed input.
+    static std::shared_ptr<StyleSheet> parse(const std::string& source);
+    
+    // Throws std::invalid_argument on a malformed selector
+    void addRule(const std::string& selector, const StyleDeclaration& declaration);
+    
+    void apply(core::StringId type, core::StringId styleClass, core::StringId id, StyleRecord& record) const;
+    // Widgets matched by id rules cannot share the per-selector cache entry
+    bool hasIdRules(core::StringId id) const { return idRules_.contains(id); }
+    
+    // Bumped by every edit so the style system notices sheets changed in place
+    uint32_t getVersion() const { return version_; }
+    size_t getRuleCount() const { return rules_.size(); }
+
+private:
+    struct Rule {
+        // Zero matches anything
+        core::StringId type;
+        core::StringId styleClass;
+        core::StringId id;
+        uint32_t specificity;
+        uint32_t order;
+        StyleDeclaration declaration;
+    };
+    
+    std::vector<Rule> rules_;
+    core::FlatHashMap<core::StringId, uint32_t> idRules_;
+    uint32_t version_ = 0;
+};
+
+// The built-in dark theme, active until another sheet is set
+std::shared_ptr<StyleSheet> createDefaultStyleSheet();
+
+using StyleId = uint32_t;
+
+// Resolves widgets' selectors against the active sheet into interned records.
+// Resolutions are cached per (type, class) until the sheet changes. Switching
+// sheets only bumps the generation; widgets re-resolve on the next
+// UIManager::update. Records are never freed, so a reference from get() stays
+// valid for the life of the system. Main thread only.
+class StyleSystem {
+public:
+    StyleSystem();
+    
+    void setStyleSheet(std::shared_ptr<StyleSheet> sheet);
+    const std::shared_ptr<StyleSheet>& getStyleSheet() const { return sheet_; }
+    
+    // Changes whenever the active sheet is replaced or edited
+    uint32_t getGeneration();
+    
+    // Widgets with overrides layer them over a copy of this record themselves,
+    // so per-widget values never reach the interned set
+    StyleId resolve(core::StringId type, core::StringId styleClass, core::StringId id);
+    const StyleRecord& get(StyleId style) const { return records_[style]; }
+    
+    size_t getRecordCount() const { return records_.size(); }
+
+private:
+    StyleId intern(const StyleRecord& record);
+    
+    std::shared_ptr<StyleSheet> sheet_;
+    uint32_t sheetVersion_ = 0;
+    uint32_t generation_ = 1;
+    
+    std::deque<StyleRecord> records_;
+    // Keyed by record hash; a collision probes the next key
+    core::FlatHashMap<uint32_t, StyleId> recordsByHash_;
+    core::FlatHashMap<uint64_t, StyleId> selectorCache_;
+};
+
+extern std::unique_ptr<StyleSystem> gStyleSystem;
+
+StyleSystem& getStyleSystem();
+
+} // namespace ui
+} // namespace voidengine
@@ -1,16 +1,20 @@
 #include "Text.h"
-#include "FontRenderer.h"
-#include <cstring>
-#include <GLFW/glfw3.h>
-#include <iostream>
+#include "Localization.h"
+#include "UIRenderer.h"
 
 namespace voidengine {
 namespace ui {
 
-Text::Text(const std::string& id, const glm::vec2& position, const std::string& text,
-           float fontSize, const glm::vec4& color)
-    : UIComponent(id, position, glm::vec2(0.0f)), text_(text), color_(color), fontSize_(fontSize) {
+Text::Text(const std::string& id, const glm::vec2& position, const std::string& text, float fontSize)
+    : UIComponent(id, position, glm::vec2(0.0f)), text_(text), fontSize_(fontSize) {
     calculateSize();
+    refreshStyle();
+}
+
+Text::Text(const std::string& id, const glm::vec2& position, const std::string& text, float fontSize,
+           const glm::vec4& color)
+    : Text(id, position, text, fontSize) {
+    setColor(color);
 }
 
 void Text::initialize() {
@@ -20,73 +24,89 @@ void Text::update(float deltaTime) {
 }
 
 void Text::render() {
-    if (!isVisible_ || text_.empty()) {
+    renderWithColor(style().textColor);
+}
+
+void Text::renderWithColor(const glm::vec4& color) {
+    if (!isVisible() || text_.empty()) {
         return;
     }
     
-    if (gFontRenderer) {
-        float x = position_.x;
-        float y = position_.y;
-        
-        if (alignment_ == TextAlignment::CENTER) {
-            x -= size_.x / 2.0f;
-        } else if (alignment_ == TextAlignment::RIGHT) {
-            x -= size_.x;
-        }
-        
-        float scale = fontSize_ / 32.0f;
-        
-        gFontRenderer->renderText(text_, x, y, scale, color_);
-    } else {
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        
-        glColor4f(color_.r, color_.g, color_.b, color_.a);
-        
-        float startX = position_.x;
-        switch (alignment_) {
-            case TextAlignment::LEFT:
-                break;
-            case TextAlignment::CENTER:
-                startX = position_.x - (size_.x / 2.0f);
-                break;
-            case TextAlignment::RIGHT:
-                startX = position_.x - size_.x;
-                break;
-        }
-        
-        float x = startX;
-        float y = position_.y;
-        float charSize = fontSize_;
-        
-        for (size_t i = 0; i < text_.length(); i++) {
-            char c = text_[i];
-            
-            if (c == '\n') {
-                x = startX;
-                y += charSize;
-                continue;
-            }
-            
-            glBegin(GL_QUADS);
-            glVertex2f(x, y);
-            glVertex2f(x + charSize * 0.75f, y);
-            glVertex2f(x + charSize * 0.75f, y + charSize);
-            glVertex2f(x, y + charSize);
-            glEnd();
-            
-            x += charSize;
-        }
+    glm::vec2 position = getPosition();
+    const glm::vec2 size = getSize();
+    
+    if (alignment_ == TextAlignment::CENTER) {
+        position.x -= size.x / 2.0f;
+    } else if (alignment_ == TextAlignment::RIGHT) {
+        position.x -= size.x;
     }
+    
+    drawText(text_.data(), text_.size(), position, fontSize_, color);
+}
+
+void Text::arrange(const glm::vec2& position, const glm::vec2& size) {
+    // Text keeps its measured size; the assigned rect only decides the anchor
+    // point that render() aligns against
+    float x = position.x;
+    if (alignment_ == TextAlignment::CENTER) {
+        x += size.x / 2.0f;
+    } else if (alignment_ == TextAlignment::RIGHT) {
+        x += size.x;
+    }
+    setPosition(glm::vec2(x, position.y));
 }
 
-void Text::setText(const std::string& text) {
+void Text::setAlignment(TextAlignment alignment) {
+    if (alignment_ != alignment) {
+        alignment_ = alignment;
+        markLayoutDirty();
+    }
+}
+
+void Text::setText(std::string_view text) {
+    localized_ = false;
     if (text_ != text) {
-        text_ = text;
+        text_.assign(text.data(), text.size());
         calculateSize();
+        markRenderDirty();
     }
 }
 
+void Text::bindText(TextFormatter format) {
+    textBinding_.reset();
+    textBinding_ = std::make_unique<Binding>([this, format = std::move(format)]() {
+        FormatBuffer buffer;
+        format(buffer);
+        setText(buffer.view());
+    });
+}
+
+void Text::setLocalizedText(core::StringId id) {
+    Localization& localization = getLocalization();
+    const std::string_view text = localization.getString(id);
+    localized_ = true;
+    localizedId_ = id;
+    if (text_ != text) {
+        text_.assign(text.data(), text.size());
+        markRenderDirty();
+    }
+    setSize(localization.measure(id, fontSize_));
+}
+
+void Text::bindLocalizedText(core::StringId id) {
+    textBinding_.reset();
+    textBinding_ = std::make_unique<Binding>([this, id]() {
+        getLocalization().getVersion();
+        setLocalizedText(id);
+    });
+}
+
+void Text::setColor(const glm::vec4& color) {
+    StyleDeclaration declaration;
+    declaration.setColor(StyleProperty::TEXT, color);
+    setStyleOverride(declaration);
+}
+
 void Text::setFontSize(float fontSize) {
     if (fontSize_ != fontSize) {
         fontSize_ = fontSize;
@@ -95,36 +115,10 @@ void Text::setFontSize(float fontSize) {
 }
 
 void Text::calculateSize() {
-    if (gFontRenderer) {
-        float scale = fontSize_ / 32.0f;
-        size_ = gFontRenderer->getTextDimensions(text_, scale);
+    if (localized_) {
+        setSize(getLocalization().measure(localizedId_, fontSize_));
     } else {
-        float charWidth = fontSize_;
-        
-        size_t maxLineLength = 0;
-        size_t lineCount = 1;
-        
-        for (size_t i = 0; i < text_.length(); i++) {
-            if (text_[i] == '\n') {
-                lineCount++;
-            }
-        }
-        
-        size_t startPos = 0;
-        size_t endPos = text_.find('\n');
-        
-        while (endPos != std::string::npos) {
-            maxLineLength = std::max(maxLineLength, endPos - startPos);
-            startPos = endPos + 1;
-            endPos = text_.find('\n', startPos);
-        }
-        
-        maxLineLength = std::max(maxLineLength, text_.length() - startPos);
-        
-        float estimatedWidth = maxLineLength * charWidth;
-        float estimatedHeight = lineCount * fontSize_;
-        
-        size_ = glm::vec2(estimatedWidth, estimatedHeight);
+        setSize(measureText(text_.data(), text_.size(), fontSize_));
     }
 }
 
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "UIComponent.h"
+#include "Observable.h"
+#include <memory>
 #include <string>
+#include <string_view>
 #include <glm/glm.hpp>
 
 namespace voidengine {
@@ -15,34 +18,60 @@ enum class TextAlignment {
 
 class Text : public UIComponent {
 public:
+    // The color comes from the style sheet
     Text(const std::string& id, const glm::vec2& position, const std::string& text = "",
-         float fontSize = 16.0f, const glm::vec4& color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+         float fontSize = 16.0f);
+    // Overrides the sheet's text color for this label only
+    Text(const std::string& id, const glm::vec2& position, const std::string& text, float fontSize,
+         const glm::vec4& color);
     
     virtual ~Text() = default;
     
     void initialize() override;
     void update(float deltaTime) override;
     void render() override;
+    core::StringId getStyleType() const override { return core::hashString("Text"); }
     
-    void setText(const std::string& text);
+    // For owners that pick the color per frame, e.g. a button's label
+    void renderWithColor(const glm::vec4& color);
+    
+    void arrange(const glm::vec2& position, const glm::vec2& size) override;
+    
+    // Unchanged text is a no-op; changed text reuses the string's storage
+    void setText(std::string_view text);
     const std::string& getText() const { return text_; }
     
-    void setColor(const glm::vec4& color) { color_ = color; }
-    const glm::vec4& getColor() const { return color_; }
+    // Re-formats the text whenever an observable the formatter reads changes,
+    // at most once per frame. Replaces any previous binding.
+    void bindText(TextFormatter format);
+    void unbindText() { textBinding_.reset(); }
+    
+    // Shows the current locale's string for id, sized from the table's metrics
+    // instead of measuring. The bound form also follows locale switches and
+    // replaces any previous binding.
+    void setLocalizedText(core::StringId id);
+    void bindLocalizedText(core::StringId id);
+    
+    // Overrides the sheet for this label
+    void setColor(const glm::vec4& color);
+    const glm::vec4& getColor() const { return style().textColor; }
     
     void setFontSize(float fontSize);
     float getFontSize() const { return fontSize_; }
     
-    void setAlignment(TextAlignment alignment) { alignment_ = alignment; }
+    void setAlignment(TextAlignment alignment);
     TextAlignment getAlignment() const { return alignment_; }
     
     void calculateSize();
     
 private:
     std::string text_;
-    glm::vec4 color_;
     float fontSize_;
     TextAlignment alignment_ = TextAlignment::LEFT;
+    // Set while the text comes from the string table
+    bool localized_ = false;
+    core::StringId localizedId_ = 0;
+    std::unique_ptr<Binding> textBinding_;
 };
 
 } // namespace ui
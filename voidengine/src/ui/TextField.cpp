@@ -0,0 +1,718 @@
+#include "TextField.h"
+#include "Clipboard.h"
+#include "UIRenderer.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <GLFW/glfw3.h>
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+constexpr float PADDING = 4.0f;
+constexpr float CARET_WIDTH = 1.5f;
+
+bool isContinuationByte(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+bool isWordByte(char c) {
+    unsigned char byte = static_cast<unsigned char>(c);
+    return std::isalnum(byte) || c == '_' || byte >= 0x80;
+}
+
+size_t encodeUtf8(unsigned int codepoint, char* out) {
+    if (codepoint < 0x80) {
+        out[0] = static_cast<char>(codepoint);
+        return 1;
+    }
+    if (codepoint < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (codepoint >> 6));
+        out[1] = static_cast<char>(0x80 | (codepoint & 0x3F));
+        return 2;
+    }
+    if (codepoint < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (codepoint >> 12));
+        out[1] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (codepoint & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (codepoint >> 18));
+    out[1] = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (codepoint & 0x3F));
+    return 4;
+}
+
+} // namespace
+
+TextField::TextField(const std::string& id, const glm::vec2& position, const glm::vec2& size,
+                     bool multiline, float fontSize)
+    : UIComponent(id, position, size), multiline_(multiline), fontSize_(fontSize) {
+    capabilities_ = UICapabilities::POINTER | UICapabilities::KEYBOARD | UICapabilities::FOCUSABLE;
+    refreshStyle();
+}
+
+void TextField::update(float deltaTime) {
+    float previous = blinkTime_;
+    blinkTime_ += deltaTime;
+    
+    // The caret toggles every half second
+    if (focused_ && static_cast<int>(previous * 2.0f) != static_cast<int>(blinkTime_ * 2.0f)) {
+        markRenderDirty();
+    }
+}
+
+void TextField::render() {
+    if (!isVisible()) {
+        return;
+    }
+    
+    refreshLayout();
+    
+    const glm::vec2 position = getPosition();
+    const glm::vec2 size = getSize();
+    
+    drawRect(position, size, style().backgroundColor);
+    drawRectOutline(position, size, focused_ ? glm::vec4(0.4f, 0.6f, 1.0f, 1.0f) : style().borderColor);
+    
+    pushClipRect(position + glm::vec2(1.0f), size - glm::vec2(2.0f));
+    
+    const glm::vec2 origin = textOrigin();
+    const float height = lineHeight();
+    const size_t selectionStart = getSelectionStart();
+    const size_t selectionEnd = getSelectionEnd();
+    const size_t cursorLine = buffer_.getLineAt(cursor_);
+    
+    for (size_t i = 0; i < lineCache_.size(); i++) {
+        size_t line = firstCachedLine_ + i;
+        const LineLayout& layout = lineCache_[i];
+        size_t lineStart = buffer_.getLineStart(line);
+        size_t lineEnd = lineStart + layout.text.size();
+        float x = origin.x - scrollX_;
+        float y = origin.y + static_cast<float>(i) * height;
+        
+        if (selectionStart < selectionEnd && selectionStart <= lineEnd && selectionEnd >= lineStart) {
+            float x0 = layout.caretX[std::max(selectionStart, lineStart) - lineStart];
+            float x1 = layout.caretX[std::min(selectionEnd, lineEnd) - lineStart];
+            if (selectionEnd > lineEnd) {
+                // Show the selected line break
+                x1 += fontSize_ * 0.3f;
+            }
+            if (x1 > x0) {
+                drawRect(glm::vec2(x + x0, y), glm::vec2(x1 - x0, height), selectionColor_);
+            }
+        }
+        
+        drawText(layout.text.data(), layout.text.size(), glm::vec2(x, y + (height - fontSize_) * 0.5f),
+                 fontSize_, style().textColor);
+        
+        if (line == cursorLine && focused_ && std::fmod(blinkTime_, 1.0f) < 0.5f) {
+            float caret = layout.caretX[cursor_ - lineStart];
+            drawRect(glm::vec2(x + caret, y), glm::vec2(CARET_WIDTH, height), style().textColor);
+        }
+    }
+    
+    popClipRect();
+}
+
+void TextField::onEvent(UIEvent& event) {
+    switch (event.type) {
+        case UIEventType::FOCUS_GAINED:
+            focused_ = true;
+            blinkTime_ = 0.0f;
+            markRenderDirty();
+            break;
+        case UIEventType::FOCUS_LOST:
+            focused_ = false;
+            dragging_ = false;
+            markRenderDirty();
+            break;
+        case UIEventType::KEY:
+            if (event.action == GLFW_PRESS || event.action == GLFW_REPEAT) {
+                handleKey(event.key, event.mods);
+            }
+            // Keep typed keys away from gameplay; Escape and Tab stay free for
+            // menus and focus navigation
+            if (event.key != GLFW_KEY_ESCAPE && event.key != GLFW_KEY_TAB) {
+                event.consume();
+            }
+            break;
+        case UIEventType::CHAR:
+            handleChar(event.codepoint);
+            event.consume();
+            break;
+        case UIEventType::MOUSE_BUTTON:
+            if (event.phase == UIEventPhase::TARGET && event.button == GLFW_MOUSE_BUTTON_LEFT) {
+                if (event.action == GLFW_PRESS) {
+                    setCursor(offsetAtPoint(event.position), (event.mods & GLFW_MOD_SHIFT) != 0);
+                    dragging_ = true;
+                } else if (event.action == GLFW_RELEASE) {
+                    dragging_ = false;
+                }
+                event.consume();
+            }
+            break;
+        case UIEventType::MOUSE_MOVE:
+            if (dragging_ && event.phase == UIEventPhase::TARGET) {
+                setCursor(offsetAtPoint(event.position), true);
+            }
+            break;
+        case UIEventType::SCROLL:
+            if (multiline_ && event.phase != UIEventPhase::CAPTURE) {
+                long target = static_cast<long>(firstVisibleLine_) - static_cast<long>(event.scroll.y * 3.0f);
+                scrollToLine(static_cast<size_t>(std::max(target, 0L)));
+                event.consume();
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void TextField::setText(std::string text) {
+    if (!multiline_) {
+        text.erase(std::remove_if(text.begin(), text.end(), [](char c) { return c == '\n' || c == '\r'; }),
+                   text.end());
+    }
+    
+    buffer_.assign(std::move(text));
+    cursor_ = 0;
+    anchor_ = 0;
+    preferredX_ = -1.0f;
+    firstVisibleLine_ = 0;
+    scrollX_ = 0.0f;
+    lineCache_.clear();
+    firstCachedLine_ = 0;
+    undoStack_.clear();
+    redoStack_.clear();
+    mergeEdits_ = false;
+    markRenderDirty();
+}
+
+void TextField::setCursor(size_t offset, bool extendSelection) {
+    offset = std::min(offset, buffer_.size());
+    while (offset > 0 && offset < buffer_.size() && isContinuationByte(buffer_.at(offset))) {
+        offset--;
+    }
+    
+    cursor_ = offset;
+    if (!extendSelection) {
+        anchor_ = offset;
+    }
+    
+    preferredX_ = -1.0f;
+    mergeEdits_ = false;
+    blinkTime_ = 0.0f;
+    scrollToCursor();
+    markRenderDirty();
+}
+
+std::string TextField::getSelectedText() const {
+    std::string text;
+    buffer_.copyRange(getSelectionStart(), getSelectionEnd() - getSelectionStart(), text);
+    return text;
+}
+
+void TextField::selectAll() {
+    anchor_ = 0;
+    cursor_ = buffer_.size();
+    mergeEdits_ = false;
+    scrollToCursor();
+    markRenderDirty();
+}
+
+void TextField::insertText(std::string_view text) {
+    std::string filtered;
+    bool hasBreaks = text.find('\r') != std::string_view::npos ||
+                     (!multiline_ && text.find('\n') != std::string_view::npos);
+    if (hasBreaks) {
+        filtered.reserve(text.size());
+        for (char c : text) {
+            if (c != '\r' && (multiline_ || c != '\n')) {
+                filtered.push_back(c);
+            }
+        }
+        text = filtered;
+    }
+    
+    replaceRange(getSelectionStart(), getSelectionEnd() - getSelectionStart(), text, EditKind::OTHER);
+}
+
+void TextField::deleteSelection() {
+    if (hasSelection()) {
+        replaceRange(getSelectionStart(), getSelectionEnd() - getSelectionStart(), std::string_view(),
+                     EditKind::OTHER);
+    }
+}
+
+void TextField::copy() const {
+    if (hasSelection()) {
+        setClipboardText(getSelectedText());
+    }
+}
+
+void TextField::cut() {
+    if (hasSelection()) {
+        copy();
+        deleteSelection();
+    }
+}
+
+void TextField::paste() {
+    std::string text = getClipboardText();
+    if (!text.empty()) {
+        insertText(text);
+    }
+}
+
+bool TextField::undo() {
+    if (undoStack_.empty()) {
+        return false;
+    }
+    
+    EditRecord record = std::move(undoStack_.back());
+    undoStack_.pop_back();
+    
+    applyReplace(record.offset, record.inserted.size(), record.removed);
+    cursor_ = std::min(record.cursorBefore, buffer_.size());
+    anchor_ = std::min(record.anchorBefore, buffer_.size());
+    redoStack_.push_back(std::move(record));
+    
+    mergeEdits_ = false;
+    preferredX_ = -1.0f;
+    scrollToCursor();
+    notifyChanged();
+    return true;
+}
+
+bool TextField::redo() {
+    if (redoStack_.empty()) {
+        return false;
+    }
+    
+    EditRecord record = std::move(redoStack_.back());
+    redoStack_.pop_back();
+    
+    applyReplace(record.offset, record.removed.size(), record.inserted);
+    cursor_ = record.offset + record.inserted.size();
+    anchor_ = cursor_;
+    undoStack_.push_back(std::move(record));
+    
+    mergeEdits_ = false;
+    preferredX_ = -1.0f;
+    scrollToCursor();
+    notifyChanged();
+    return true;
+}
+
+bool TextField::handleKey(int key, int mods) {
+    bool shift = (mods & GLFW_MOD_SHIFT) != 0;
+    bool control = (mods & (GLFW_MOD_CONTROL | GLFW_MOD_SUPER)) != 0;
+    
+    switch (key) {
+        case GLFW_KEY_LEFT:
+            if (hasSelection() && !shift) {
+                setCursor(getSelectionStart());
+            } else {
+                setCursor(control ? stepWord(cursor_, false) : stepCharacter(cursor_, false), shift);
+            }
+            return true;
+        case GLFW_KEY_RIGHT:
+            if (hasSelection() && !shift) {
+                setCursor(getSelectionEnd());
+            } else {
+                setCursor(control ? stepWord(cursor_, true) : stepCharacter(cursor_, true), shift);
+            }
+            return true;
+        case GLFW_KEY_UP:
+            moveVertically(-1, shift);
+            return true;
+        case GLFW_KEY_DOWN:
+            moveVertically(1, shift);
+            return true;
+        case GLFW_KEY_PAGE_UP:
+            moveVertically(-static_cast<long>(visibleLineCount()), shift);
+            return true;
+        case GLFW_KEY_PAGE_DOWN:
+            moveVertically(static_cast<long>(visibleLineCount()), shift);
+            return true;
+        case GLFW_KEY_HOME:
+            setCursor(control ? 0 : buffer_.getLineStart(buffer_.getLineAt(cursor_)), shift);
+            return true;
+        case GLFW_KEY_END:
+            setCursor(control ? buffer_.size() : buffer_.getLineEnd(buffer_.getLineAt(cursor_)), shift);
+            return true;
+        case GLFW_KEY_BACKSPACE:
+            if (hasSelection()) {
+                deleteSelection();
+            } else if (cursor_ > 0) {
+                size_t start = control ? stepWord(cursor_, false) : stepCharacter(cursor_, false);
+                replaceRange(start, cursor_ - start, std::string_view(), EditKind::BACKSPACE);
+            }
+            return true;
+        case GLFW_KEY_DELETE:
+            if (hasSelection()) {
+                deleteSelection();
+            } else if (cursor_ < buffer_.size()) {
+                size_t end = control ? stepWord(cursor_, true) : stepCharacter(cursor_, true);
+                replaceRange(cursor_, end - cursor_, std::string_view(), EditKind::DELETE_FORWARD);
+            }
+            return true;
+        case GLFW_KEY_ENTER:
+        case GLFW_KEY_KP_ENTER:
+            if (multiline_ && !control) {
+                insertText("\n");
+            } else if (onSubmit_) {
+                onSubmit_(*this);
+            }
+            return true;
+        default:
+            break;
+    }
+    
+    if (!control) {
+        return false;
+    }
+    
+    switch (key) {
+        case GLFW_KEY_A:
+            selectAll();
+            return true;
+        case GLFW_KEY_C:
+            copy();
+            return true;
+        case GLFW_KEY_X:
+            cut();
+            return true;
+        case GLFW_KEY_V:
+            paste();
+            return true;
+        case GLFW_KEY_Z:
+            shift ? redo() : undo();
+            return true;
+        case GLFW_KEY_Y:
+            redo();
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool TextField::handleChar(unsigned int codepoint) {
+    if (codepoint < 0x20 || codepoint == 0x7F || codepoint > 0x10FFFF) {
+        return false;
+    }
+    
+    char encoded[4];
+    size_t length = encodeUtf8(codepoint, encoded);
+    replaceRange(getSelectionStart(), getSelectionEnd() - getSelectionStart(),
+                 std::string_view(encoded, length), EditKind::TYPING);
+    return true;
+}
+
+void TextField::scrollToLine(size_t line) {
+    firstVisibleLine_ = std::min(line, buffer_.getLineCount() - 1);
+    markRenderDirty();
+}
+
+void TextField::refreshLayout() {
+    ensureAdvances();
+    
+    size_t lineCount = buffer_.getLineCount();
+    firstVisibleLine_ = std::min(firstVisibleLine_, lineCount - 1);
+    size_t count = std::min(visibleLineCount(), lineCount - firstVisibleLine_);
+    
+    // Slide the cache to the viewport, keeping the lines that stay in view
+    if (firstVisibleLine_ > firstCachedLine_) {
+        size_t shift = std::min(firstVisibleLine_ - firstCachedLine_, lineCache_.size());
+        lineCache_.erase(lineCache_.begin(), lineCache_.begin() + static_cast<std::ptrdiff_t>(shift));
+    } else if (firstVisibleLine_ < firstCachedLine_) {
+        size_t shift = firstCachedLine_ - firstVisibleLine_;
+        if (shift >= count) {
+            lineCache_.clear();
+        } else {
+            lineCache_.insert(lineCache_.begin(), shift, LineLayout());
+        }
+    }
+    firstCachedLine_ = firstVisibleLine_;
+    lineCache_.resize(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        if (!lineCache_[i].valid) {
+            buildLine(firstCachedLine_ + i, lineCache_[i]);
+        }
+    }
+}
+
+void TextField::replaceRange(size_t offset, size_t length, std::string_view text, EditKind kind) {
+    if (length == 0 && text.empty()) {
+        return;
+    }
+    
+    std::string removed;
+    buffer_.copyRange(offset, length, removed);
+    
+    bool merged = false;
+    if (mergeEdits_ && !undoStack_.empty()) {
+        EditRecord& last = undoStack_.back();
+        if (kind == EditKind::TYPING && last.kind == EditKind::TYPING && length == 0 &&
+            last.offset + last.inserted.size() == offset) {
+            last.inserted.append(text.data(), text.size());
+            merged = true;
+        } else if (kind == EditKind::BACKSPACE && last.kind == EditKind::BACKSPACE && offset + length == last.offset) {
+            last.removed.insert(0, removed);
+            last.offset = offset;
+            merged = true;
+        } else if (kind == EditKind::DELETE_FORWARD && last.kind == EditKind::DELETE_FORWARD && offset == last.offset) {
+            last.removed += removed;
+            merged = true;
+        }
+    }
+    
+    if (!merged) {
+        undoStack_.push_back(EditRecord{offset, std::move(removed), std::string(text), cursor_, anchor_, kind});
+        if (undoStack_.size() > UNDO_LIMIT) {
+            undoStack_.pop_front();
+        }
+    }
+    redoStack_.clear();
+    
+    applyReplace(offset, length, text);
+    cursor_ = offset + text.size();
+    anchor_ = cursor_;
+    
+    mergeEdits_ = kind != EditKind::OTHER;
+    preferredX_ = -1.0f;
+    blinkTime_ = 0.0f;
+    scrollToCursor();
+    notifyChanged();
+}
+
+void TextField::applyReplace(size_t offset, size_t length, std::string_view text) {
+    size_t firstLine = buffer_.getLineAt(offset);
+    size_t oldLastLine = buffer_.getLineAt(offset + length);
+    
+    buffer_.erase(offset, length);
+    buffer_.insert(offset, text);
+    
+    size_t newLastLine = buffer_.getLineAt(offset + text.size());
+    invalidateLines(firstLine, oldLastLine - firstLine + 1, newLastLine - firstLine + 1);
+    markRenderDirty();
+}
+
+void TextField::invalidateLines(size_t firstLine, size_t oldCount, size_t newCount) {
+    size_t editEnd = firstLine + oldCount;
+    size_t cacheEnd = firstCachedLine_ + lineCache_.size();
+    
+    if (editEnd <= firstCachedLine_) {
+        // Entirely above the cached lines: they only renumber
+        firstCachedLine_ = firstCachedLine_ + newCount - oldCount;
+        if (firstVisibleLine_ >= editEnd) {
+            firstVisibleLine_ = firstVisibleLine_ + newCount - oldCount;
+        }
+        return;
+    }
+    if (firstLine >= cacheEnd) {
+        return;
+    }
+    if (firstLine < firstCachedLine_) {
+        lineCache_.clear();
+        return;
+    }
+    
+    // Swap the replaced lines for unbuilt ones; the lines below shift along
+    // with their cache entries
+    auto begin = lineCache_.begin() + static_cast<std::ptrdiff_t>(firstLine - firstCachedLine_);
+    auto end = lineCache_.begin() + static_cast<std::ptrdiff_t>(std::min(editEnd, cacheEnd) - firstCachedLine_);
+    begin = lineCache_.erase(begin, end);
+    lineCache_.insert(begin, newCount, LineLayout());
+}
+
+void TextField::ensureAdvances() {
+    if (advancesReady_) {
+        return;
+    }
+    
+    for (int i = 0; i < 256; i++) {
+        char c = static_cast<char>(i);
+        advances_[i] = isContinuationByte(c) ? 0.0f : measureText(&c, 1, fontSize_).x;
+    }
+    advancesReady_ = true;
+}
+
+void TextField::buildLine(size_t line, LineLayout& layout) {
+    size_t start = buffer_.getLineStart(line);
+    size_t end = buffer_.getLineEnd(line);
+    
+    layout.text.clear();
+    buffer_.copyRange(start, end - start, layout.text);
+    
+    layout.caretX.resize(layout.text.size() + 1);
+    float x = 0.0f;
+    layout.caretX[0] = 0.0f;
+    for (size_t i = 0; i < layout.text.size(); i++) {
+        x += advances_[static_cast<unsigned char>(layout.text[i])];
+        layout.caretX[i + 1] = x;
+    }
+    
+    layout.valid = true;
+    lineRebuilds_++;
+}
+
+const TextField::LineLayout& TextField::getLineLayout(size_t line) {
+    ensureAdvances();
+    
+    if (line >= firstCachedLine_ && line < firstCachedLine_ + lineCache_.size()) {
+        LineLayout& layout = lineCache_[line - firstCachedLine_];
+        if (!layout.valid) {
+            buildLine(line, layout);
+        }
+        return layout;
+    }
+    
+    buildLine(line, scratchLine_);
+    return scratchLine_;
+}
+
+size_t TextField::visibleLineCount() const {
+    if (!multiline_) {
+        return 1;
+    }
+    
+    float innerHeight = getSize().y - 2.0f * PADDING;
+    return std::max<size_t>(1, static_cast<size_t>(std::floor(innerHeight / lineHeight())));
+}
+
+glm::vec2 TextField::textOrigin() const {
+    const glm::vec2 position = getPosition();
+    if (multiline_) {
+        return position + glm::vec2(PADDING);
+    }
+    return glm::vec2(position.x + PADDING, position.y + (getSize().y - lineHeight()) * 0.5f);
+}
+
+size_t TextField::offsetAtPoint(const glm::vec2& point) {
+    refreshLayout();
+    
+    glm::vec2 origin = textOrigin();
+    long row = static_cast<long>(std::floor((point.y - origin.y) / lineHeight()));
+    long line = static_cast<long>(firstVisibleLine_) + row;
+    line = std::min(std::max(line, 0L), static_cast<long>(buffer_.getLineCount()) - 1);
+    
+    const LineLayout& layout = getLineLayout(static_cast<size_t>(line));
+    return buffer_.getLineStart(static_cast<size_t>(line)) + columnAtX(layout, point.x - origin.x + scrollX_);
+}
+
+size_t TextField::columnAtX(const LineLayout& layout, float x) const {
+    auto it = std::lower_bound(layout.caretX.begin(), layout.caretX.end(), x);
+    size_t column = static_cast<size_t>(it - layout.caretX.begin());
+    if (column >= layout.caretX.size()) {
+        column = layout.caretX.size() - 1;
+    } else if (column > 0 && x - layout.caretX[column - 1] < layout.caretX[column] - x) {
+        column--;
+    }
+    
+    while (column > 0 && column < layout.text.size() && isContinuationByte(layout.text[column])) {
+        column--;
+    }
+    return column;
+}
+
+size_t TextField::stepCharacter(size_t offset, bool forward) const {
+    if (forward) {
+        if (offset >= buffer_.size()) {
+            return buffer_.size();
+        }
+        offset++;
+        while (offset < buffer_.size() && isContinuationByte(buffer_.at(offset))) {
+            offset++;
+        }
+        return offset;
+    }
+    
+    if (offset == 0) {
+        return 0;
+    }
+    offset--;
+    while (offset > 0 && isContinuationByte(buffer_.at(offset))) {
+        offset--;
+    }
+    return offset;
+}
+
+size_t TextField::stepWord(size_t offset, bool forward) const {
+    size_t size = buffer_.size();
+    if (forward) {
+        while (offset < size && !isWordByte(buffer_.at(offset))) {
+            offset++;
+        }
+        while (offset < size && isWordByte(buffer_.at(offset))) {
+            offset++;
+        }
+        return offset;
+    }
+    
+    while (offset > 0 && !isWordByte(buffer_.at(offset - 1))) {
+        offset--;
+    }
+    while (offset > 0 && isWordByte(buffer_.at(offset - 1))) {
+        offset--;
+    }
+    return offset;
+}
+
+void TextField::moveVertically(long lines, bool extendSelection) {
+    size_t line = buffer_.getLineAt(cursor_);
+    size_t lastLine = buffer_.getLineCount() - 1;
+    
+    if (preferredX_ < 0.0f) {
+        preferredX_ = getLineLayout(line).caretX[cursor_ - buffer_.getLineStart(line)];
+    }
+    float preferredX = preferredX_;
+    
+    size_t target;
+    if (lines < 0 && line == 0) {
+        target = 0;
+        setCursor(0, extendSelection);
+    } else if (lines > 0 && line == lastLine) {
+        target = lastLine;
+        setCursor(buffer_.size(), extendSelection);
+    } else {
+        long moved = static_cast<long>(line) + lines;
+        target = static_cast<size_t>(std::min(std::max(moved, 0L), static_cast<long>(lastLine)));
+        const LineLayout& layout = getLineLayout(target);
+        setCursor(buffer_.getLineStart(target) + columnAtX(layout, preferredX), extendSelection);
+    }
+    
+    preferredX_ = preferredX;
+}
+
+void TextField::scrollToCursor() {
+    size_t line = buffer_.getLineAt(cursor_);
+    size_t visible = visibleLineCount();
+    if (line < firstVisibleLine_) {
+        firstVisibleLine_ = line;
+    } else if (line >= firstVisibleLine_ + visible) {
+        firstVisibleLine_ = line - visible + 1;
+    }
+    
+    float caret = getLineLayout(line).caretX[cursor_ - buffer_.getLineStart(line)];
+    float innerWidth = getSize().x - 2.0f * PADDING - CARET_WIDTH;
+    if (caret - scrollX_ > innerWidth) {
+        scrollX_ = caret - innerWidth;
+    } else if (caret < scrollX_) {
+        scrollX_ = caret;
+    }
+}
+
+void TextField::notifyChanged() {
+    if (onChange_) {
+        onChange_(*this);
+    }
+}
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "UIComponent.h"
+#include "PieceTable.h"
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace voidengine {
+namespace ui {
+
+// Editable text, single- or multi-line. Contents live in a PieceTable, so an
+// edit costs the same anywhere in a large document. Glyph positions are
+// cached per line for the lines in view only; an edit invalidates just the
+// lines it touched, and the lines below it keep their cache because it is
+// indexed relative to the viewport.
+//
+// Takes keyboard focus on click. Supports cursor movement (with Ctrl for
+// words, Shift to select), selection, clipboard (Ctrl+C/X/V) and undo/redo
+// (Ctrl+Z, Ctrl+Y or Ctrl+Shift+Z), with consecutive typing and deleting
+// merged into single undo steps. Text is treated as UTF-8; the cursor never
+// stops inside a multi-byte sequence.
+class TextField : public UIComponent {
+public:
+    using TextCallback = std::function<void(TextField&)>;
+    
+    TextField(const std::string& id, const glm::vec2& position, const glm::vec2& size,
+              bool multiline = false, float fontSize = 16.0f);
+    
+    virtual ~TextField() = default;
+    
+    void update(float deltaTime) override;
+    void render() override;
+    core::StringId getStyleType() const override { return core::hashString("TextField"); }
+    
+    void onEvent(UIEvent& event) override;
+    
+    // Replaces the contents and clears the undo history
+    void setText(std::string text);
+    std::string getText() const { return buffer_.getText(); }
+    const PieceTable& getBuffer() const { return buffer_; }
+    
+    bool isMultiline() const { return multiline_; }
+    float getFontSize() const { return fontSize_; }
+    
+    size_t getCursor() const { return cursor_; }
+    void setCursor(size_t offset, bool extendSelection = false);
+    
+    bool hasSelection() const { return anchor_ != cursor_; }
+    size_t getSelectionStart() const { return anchor_ < cursor_ ? anchor_ : cursor_; }
+    size_t getSelectionEnd() const { return anchor_ < cursor_ ? cursor_ : anchor_; }
+    std::string getSelectedText() const;
+    void selectAll();
+    
+    // Replaces the selection, as typing or pasting would. Line breaks are
+    // dropped in single-line mode.
+    void insertText(std::string_view text);
+    void deleteSelection();
+    
+    void copy() const;
+    void cut();
+    void paste();
+    
+    bool undo();
+    bool redo();
+    bool canUndo() const { return !undoStack_.empty(); }
+    bool canRedo() const { return !redoStack_.empty(); }
+    
+    // Keyboard entry points, also used by automation; return whether the
+    // input was handled
+    bool handleKey(int key, int mods);
+    bool handleChar(unsigned int codepoint);
+    
+    void setOnChange(const TextCallback& callback) { onChange_ = callback; }
+    // Enter in single-line mode, Ctrl+Enter in multi-line mode
+    void setOnSubmit(const TextCallback& callback) { onSubmit_ = callback; }
+    
+    void setSelectionColor(const glm::vec4& color) { selectionColor_ = color; markRenderDirty(); }
+    
+    size_t getFirstVisibleLine() const { return firstVisibleLine_; }
+    void scrollToLine(size_t line);
+    
+    // Brings the cached line geometry in sync with the viewport; render()
+    // does this itself
+    void refreshLayout();
+    // Number of lines whose glyph geometry has been built, for profiling
+    size_t getLineRebuildCount() const { return lineRebuilds_; }
+
+private:
+    enum class EditKind {
+        OTHER,
+        TYPING,
+        BACKSPACE,
+        DELETE_FORWARD
+    };
+    
+    struct EditRecord {
+        size_t offset;
+        std::string removed;
+        std::string inserted;
+        size_t cursorBefore;
+        size_t anchorBefore;
+        EditKind kind;
+    };
+    
+    struct LineLayout {
+        bool valid = false;
+        std::string text;
+        // x of each byte boundary from the line start; size text.size() + 1
+        std::vector<float> caretX;
+    };
+    
+    void replaceRange(size_t offset, size_t length, std::string_view text, EditKind kind);
+    void applyReplace(size_t offset, size_t length, std::string_view text);
+    void invalidateLines(size_t firstLine, size_t oldCount, size_t newCount);
+    void ensureAdvances();
+    void buildLine(size_t line, LineLayout& layout);
+    const LineLayout& getLineLayout(size_t line);
+    
+    float lineHeight() const { return fontSize_ * 1.25f; }
+    size_t visibleLineCount() const;
+    glm::vec2 textOrigin() const;
+    
+    size_t offsetAtPoint(const glm::vec2& point);
+    size_t columnAtX(const LineLayout& layout, float x) const;
+    size_t stepCharacter(size_t offset, bool forward) const;
+    size_t stepWord(size_t offset, bool forward) const;
+    void moveVertically(long lines, bool extendSelection);
+    void scrollToCursor();
+    void notifyChanged();
+    
+    PieceTable buffer_;
+    bool multiline_;
+    float fontSize_;
+    
+    size_t cursor_ = 0;
+    size_t anchor_ = 0;
+    // Column x that vertical movement tries to keep; negative when unset
+    float preferredX_ = -1.0f;
+    
+    size_t firstVisibleLine_ = 0;
+    float scrollX_ = 0.0f;
+    
+    // Layouts for lines firstCachedLine_ .. firstCachedLine_ + size()
+    std::vector<LineLayout> lineCache_;
+    size_t firstCachedLine_ = 0;
+    LineLayout scratchLine_;
+    size_t lineRebuilds_ = 0;
+    
+    float advances_[256] = {};
+    bool advancesReady_ = false;
+    
+    std::deque<EditRecord> undoStack_;
+    std::vector<EditRecord> redoStack_;
+    // Cleared when the cursor moves, so typing after a jump starts a new step
+    bool mergeEdits_ = false;
+    
+    bool focused_ = false;
+    bool dragging_ = false;
+    float blinkTime_ = 0.0f;
+    glm::vec4 selectionColor_ = glm::vec4(0.3f, 0.45f, 0.9f, 0.6f);
+    
+    TextCallback onChange_;
+    TextCallback onSubmit_;
+    
+    static constexpr size_t UNDO_LIMIT = 512;
+};
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,78 @@
+#include "TextLayout.h"
+#include "UIRenderer.h"
+#include "../core/StringId.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace voidengine {
+namespace ui {
+
+TextLayoutCache::TextLayoutCache(size_t capacity)
+    : capacity_(capacity) {
+    if (capacity_ == 0) {
+        throw std::invalid_argument("Text layout cache capacity must be positive");
+    }
+    entries_.reserve(capacity_);
+    index_.reserve(capacity_);
+}
+
+const TextRun& TextLayoutCache::get(std::string_view text, float fontSize) {
+    const uint64_t key = makeKey(text, fontSize);
+    if (const uint32_t* slot = index_.find(key)) {
+        Entry& entry = entries_[*slot];
+        if (entry.fontSize == fontSize && entry.text == text) {
+            entry.referenced = true;
+            hits_++;
+            return entry.run;
+        }
+        // Hash collision; the newer string takes the slot
+        misses_++;
+        fill(entry, key, text, fontSize);
+        return entry.run;
+    }
+    
+    misses_++;
+    uint32_t slot;
+    if (entries_.size() < capacity_) {
+        slot = static_cast<uint32_t>(entries_.size());
+        entries_.emplace_back();
+    } else {
+        // Referenced entries get a second chance; the hand clears the bit as
+        // it passes, so the loop ends within one sweep
+        while (entries_[hand_].referenced) {
+            entries_[hand_].referenced = false;
+            hand_ = (hand_ + 1) % capacity_;
+        }
+        slot = static_cast<uint32_t>(hand_);
+        hand_ = (hand_ + 1) % capacity_;
+        index_.erase(entries_[slot].key);
+    }
+    
+    Entry& entry = entries_[slot];
+    fill(entry, key, text, fontSize);
+    index_[key] = slot;
+    return entry.run;
+}
+
+void TextLayoutCache::clear() {
+    entries_.clear();
+    index_.clear();
+    hand_ = 0;
+}
+
+uint64_t TextLayoutCache::makeKey(std::string_view text, float fontSize) {
+    uint32_t sizeBits;
+    std::memcpy(&sizeBits, &fontSize, sizeof(sizeBits));
+    return (static_cast<uint64_t>(core::hashString(text)) << 32) | sizeBits;
+}
+
+void TextLayoutCache::fill(Entry& entry, uint64_t key, std::string_view text, float fontSize) {
+    entry.key = key;
+    entry.text.assign(text.data(), text.size());
+    entry.fontSize = fontSize;
+    entry.referenced = true;
+    layoutText(text.data(), text.size(), fontSize, entry.run);
+}
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../core/FlatHashMap.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace voidengine {
+namespace ui {
+
+struct GlyphQuad {
+    glm::vec2 offset;
+    glm::vec2 size;
+    // Zero for the box drawn in place of a glyph when no font is loaded
+    unsigned int texture;
+};
+
+// A string laid out into glyph quads relative to its top-left corner. Laying
+// out looks up every character in the font; a run is drawn with drawTextRun
+// for as long as its string is unchanged.
+struct TextRun {
+    std::vector<GlyphQuad> glyphs;
+    glm::vec2 size = glm::vec2(0.0f);
+};
+
+// Bounded map from string and font size to a laid-out run, so widgets that
+// show the same values over and over, such as status or enum columns, lay
+// each one out once. A full cache evicts with the clock algorithm, an
+// approximation of least recently used. Not thread-safe; give each widget
+// that lays out text during update() its own cache.
+class TextLayoutCache {
+public:
+    explicit TextLayoutCache(size_t capacity = 1024);
+    
+    // The run stays valid until the next get() or clear()
+    const TextRun& get(std::string_view text, float fontSize);
+    // Needed after a font is loaded or replaced
+    void clear();
+    
+    size_t size() const { return entries_.size(); }
+    size_t getCapacity() const { return capacity_; }
+    uint64_t getHitCount() const { return hits_; }
+    uint64_t getMissCount() const { return misses_; }
+
+private:
+    struct Entry {
+        uint64_t key = 0;
+        std::string text;
+        float fontSize = 0.0f;
+        TextRun run;
+        bool referenced = false;
+    };
+    
+    static uint64_t makeKey(std::string_view text, float fontSize);
+    void fill(Entry& entry, uint64_t key, std::string_view text, float fontSize);
+    
+    size_t capacity_;
+    std::vector<Entry> entries_;
+    core::FlatHashMap<uint64_t, uint32_t> index_;
+    size_t hand_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,106 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <stdexcept>
+#include <GLFW/glfw3.h>
+
+namespace voidengine {
+namespace ui {
+
+TextureAtlas::TextureAtlas(int width, int height, const uint8_t* pixels)
+    : ownsTexture_(true), width_(width), height_(height) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Texture atlas size must be positive");
+    }
+    
+    glGenTextures(1, &texture_);
+    glBindTexture(GL_TEXTURE_2D, texture_);
+    
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+TextureAtlas::TextureAtlas(unsigned int texture, int width, int height)
+    : texture_(texture), width_(width), height_(height) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Texture atlas size must be positive");
+    }
+}
+
+TextureAtlas::~TextureAtlas() {
+    if (ownsTexture_ && texture_ != 0) {
+        glDeleteTextures(1, &texture_);
+    }
+}
+
+void TextureAtlas::addRegion(const std::string& name, int x, int y, int width, int height,
+                             const glm::vec4& insets) {
+    if (x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > width_ || y + height > height_) {
+        throw std::out_of_range("Atlas region '" + name + "' lies outside the texture");
+    }
+    if (insets.x < 0.0f || insets.y < 0.0f || insets.z < 0.0f || insets.w < 0.0f ||
+        insets.x + insets.z > static_cast<float>(width) || insets.y + insets.w > static_cast<float>(height)) {
+        throw std::invalid_argument("Atlas region '" + name + "' has overlapping insets");
+    }
+    
+    AtlasRegion region;
+    region.uv = glm::vec4(static_cast<float>(x) / width_, static_cast<float>(y) / height_,
+                          static_cast<float>(x + width) / width_, static_cast<float>(y + height) / height_);
+    region.size = glm::vec2(static_cast<float>(width), static_cast<float>(height));
+    region.insets = insets;
+    regions_[core::hashString(name)] = region;
+}
+
+const AtlasRegion& TextureAtlas::getRegion(const std::string& name) const {
+    const AtlasRegion* region = regions_.find(core::hashString(name));
+    if (!region) {
+        throw std::out_of_range("Unknown atlas region '" + name + "'");
+    }
+    return *region;
+}
+
+NineSliceGrid computeNineSliceGrid(const glm::vec2& position, const glm::vec2& size, const AtlasRegion& region) {
+    glm::vec4 insets = region.insets;
+    const float horizontal = insets.x + insets.z;
+    if (horizontal > size.x) {
+        const float scale = horizontal > 0.0f ? std::max(size.x, 0.0f) / horizontal : 0.0f;
+        insets.x *= scale;
+        insets.z *= scale;
+    }
+    const float vertical = insets.y + insets.w;
+    if (vertical > size.y) {
+        const float scale = vertical > 0.0f ? std::max(size.y, 0.0f) / vertical : 0.0f;
+        insets.y *= scale;
+        insets.w *= scale;
+    }
+    
+    // Texture borders stay at the region's own pixel size
+    const glm::vec2 texel = glm::vec2(region.uv.z - region.uv.x, region.uv.w - region.uv.y) / region.size;
+    
+    NineSliceGrid grid;
+    grid.x[0] = position.x;
+    grid.x[1] = position.x + insets.x;
+    grid.x[2] = position.x + size.x - insets.z;
+    grid.x[3] = position.x + size.x;
+    grid.y[0] = position.y;
+    grid.y[1] = position.y + insets.y;
+    grid.y[2] = position.y + size.y - insets.w;
+    grid.y[3] = position.y + size.y;
+    grid.u[0] = region.uv.x;
+    grid.u[1] = region.uv.x + region.insets.x * texel.x;
+    grid.u[2] = region.uv.z - region.insets.z * texel.x;
+    grid.u[3] = region.uv.z;
+    grid.v[0] = region.uv.y;
+    grid.v[1] = region.uv.y + region.insets.y * texel.y;
+    grid.v[2] = region.uv.w - region.insets.w * texel.y;
+    grid.v[3] = region.uv.w;
+    return grid;
+}
+
+} // namespace ui
+} // namespace voidengine
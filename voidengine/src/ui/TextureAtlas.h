@@ -0,0 +1,77 @@
+#pragma once
+
+#include "../core/FlatHashMap.h"
+#include "../core/StringId.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <glm/glm.hpp>
+
+namespace voidengine {
+namespace ui {
+
+struct AtlasRegion {
+    // u0, v0, u1, v1
+    glm::vec4 uv;
+    // Pixels
+    glm::vec2 size;
+    // Nine-slice borders in pixels: left, top, right, bottom. Borders keep
+    // their size however the region is stretched; all zero stretches it whole.
+    glm::vec4 insets;
+};
+
+// One texture holding many UI images, so widgets skinned from it share a
+// texture and their quads merge into one batch. Regions are named pixel rects
+// with y running down from the first row of pixel data.
+class TextureAtlas {
+public:
+    // Uploads width * height RGBA8 pixels into a texture the atlas owns; needs
+    // a GL context
+    TextureAtlas(int width, int height, const uint8_t* pixels);
+    // Wraps a texture uploaded elsewhere, which the atlas does not delete
+    TextureAtlas(unsigned int texture, int width, int height);
+    ~TextureAtlas();
+    
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+    
+    // Throws std::out_of_range when the rect leaves the texture and
+    // std::invalid_argument when the insets overlap
+    void addRegion(const std::string& name, int x, int y, int width, int height,
+                   const glm::vec4& insets = glm::vec4(0.0f));
+    bool hasRegion(const std::string& name) const { return regions_.contains(core::hashString(name)); }
+    // Throws std::out_of_range for unknown names
+    const AtlasRegion& getRegion(const std::string& name) const;
+    
+    unsigned int getTexture() const { return texture_; }
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+
+private:
+    unsigned int texture_ = 0;
+    bool ownsTexture_ = false;
+    int width_;
+    int height_;
+    core::FlatHashMap<core::StringId, AtlasRegion> regions_;
+};
+
+// An atlas region a widget draws itself with; holds the atlas alive
+struct NineSliceSkin {
+    std::shared_ptr<const TextureAtlas> atlas;
+    AtlasRegion region;
+};
+
+// The lines cutting a region drawn at position and size into nine quads:
+// column i spans x[i] to x[i + 1] and u[i] to u[i + 1], rows likewise. When
+// the widget is smaller than the borders, they shrink in proportion.
+struct NineSliceGrid {
+    float x[4];
+    float y[4];
+    float u[4];
+    float v[4];
+};
+
+NineSliceGrid computeNineSliceGrid(const glm::vec2& position, const glm::vec2& size, const AtlasRegion& region);
+
+} // namespace ui
+} // namespace voidengine
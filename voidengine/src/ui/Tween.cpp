@@ -0,0 +1,314 @@
+#include "Tween.h"
+#include "UIComponent.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VOIDENGINE_TWEEN_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace voidengine {
+namespace ui {
+
+std::unique_ptr<TweenSystem> gTweenSystem = nullptr;
+
+TweenSystem& getTweenSystem() {
+    if (!gTweenSystem) {
+        gTweenSystem = std::make_unique<TweenSystem>(getUIRegistry());
+    }
+    return *gTweenSystem;
+}
+
+float applyEasing(Easing easing, float t) {
+    switch (easing) {
+        case Easing::LINEAR:
+            return t;
+        case Easing::EASE_IN_QUAD:
+            return t * t;
+        case Easing::EASE_OUT_QUAD:
+            return t * (2.0f - t);
+        case Easing::EASE_IN_OUT_QUAD:
+            return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+        case Easing::EASE_OUT_CUBIC: {
+            float u = t - 1.0f;
+            return u * u * u + 1.0f;
+        }
+        default:
+            return t;
+    }
+}
+
+namespace {
+
+#ifdef VOIDENGINE_TWEEN_SSE2
+inline __m128 easeFour(Easing easing, __m128 t) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    
+    switch (easing) {
+        case Easing::LINEAR:
+            return t;
+        case Easing::EASE_IN_QUAD:
+            return _mm_mul_ps(t, t);
+        case Easing::EASE_OUT_QUAD:
+            return _mm_mul_ps(t, _mm_sub_ps(two, t));
+        case Easing::EASE_IN_OUT_QUAD: {
+            __m128 in = _mm_mul_ps(two, _mm_mul_ps(t, t));
+            __m128 out = _mm_sub_ps(_mm_mul_ps(_mm_sub_ps(_mm_set1_ps(4.0f), _mm_mul_ps(two, t)), t), one);
+            __m128 firstHalf = _mm_cmplt_ps(t, _mm_set1_ps(0.5f));
+            return _mm_or_ps(_mm_and_ps(firstHalf, in), _mm_andnot_ps(firstHalf, out));
+        }
+        case Easing::EASE_OUT_CUBIC: {
+            __m128 u = _mm_sub_ps(t, one);
+            return _mm_add_ps(_mm_mul_ps(_mm_mul_ps(u, u), u), one);
+        }
+        default:
+            return t;
+    }
+}
+#endif
+
+} // namespace
+
+TweenSystem::TweenSystem(UIRegistry& registry)
+    : registry_(registry) {
+}
+
+TweenSystem::~TweenSystem() {
+}
+
+void TweenSystem::animate(UIHandle target, TweenProperty property, const glm::vec4& to,
+                          float duration, Easing easing) {
+    std::lock_guard<std::mutex> lock(requestMutex_);
+    requests_.push_back(Request{target, property, easing, true, false, glm::vec4(0.0f), to, duration});
+}
+
+void TweenSystem::animate(UIHandle target, TweenProperty property, const glm::vec4& from, const glm::vec4& to,
+                          float duration, Easing easing) {
+    std::lock_guard<std::mutex> lock(requestMutex_);
+    requests_.push_back(Request{target, property, easing, false, false, from, to, duration});
+}
+
+void TweenSystem::cancel(UIHandle target, TweenProperty property) {
+    std::lock_guard<std::mutex> lock(requestMutex_);
+    requests_.push_back(Request{target, property, Easing::LINEAR, false, true, glm::vec4(0.0f), glm::vec4(0.0f), 0.0f});
+}
+
+bool TweenSystem::isAnimating(UIHandle target, TweenProperty property) const {
+    return tracksByKey_.contains(makeKey(target, property));
+}
+
+size_t TweenSystem::getActiveCount() const {
+    return tracksByKey_.size();
+}
+
+void TweenSystem::reserve(size_t count) {
+    tracksByKey_.reserve(count);
+}
+
+void TweenSystem::update(float deltaTime) {
+    applyRequests();
+    
+    for (size_t b = 0; b < static_cast<size_t>(Easing::COUNT); b++) {
+        TrackBucket& bucket = buckets_[b];
+        if (bucket.size() == 0) {
+            continue;
+        }
+        
+        evaluateBucket(bucket, static_cast<Easing>(b), deltaTime);
+        
+        // Scatter into the registry; this is the only per-track scalar step
+        finished_.clear();
+        size_t count = bucket.size();
+        for (size_t i = 0; i < count; i++) {
+            UIHandle target = bucket.targets[i];
+            if (!registry_.isAlive(target)) {
+                finished_.push_back(static_cast<uint32_t>(i));
+                continue;
+            }
+            
+            glm::vec4 value(bucket.values[0][i], bucket.values[1][i], bucket.values[2][i], bucket.values[3][i]);
+            writeProperty(target, bucket.properties[i], value);
+            registry_.owner(target)->markRenderDirty();
+            
+            if (bucket.elapsed[i] * bucket.inverseDuration[i] >= 1.0f) {
+                finished_.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        
+        // Back to front so swap-remove only moves tracks that are still running
+        for (size_t i = finished_.size(); i > 0; i--) {
+            removeTrack(static_cast<uint32_t>(b), finished_[i - 1]);
+        }
+    }
+}
+
+void TweenSystem::evaluateBucket(TrackBucket& bucket, Easing easing, float deltaTime) {
+    size_t count = bucket.size();
+    float* elapsed = bucket.elapsed.data();
+    const float* inverseDuration = bucket.inverseDuration.data();
+    float* eased = bucket.eased.data();
+    size_t i = 0;
+    
+#ifdef VOIDENGINE_TWEEN_SSE2
+    const __m128 step = _mm_set1_ps(deltaTime);
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        __m128 time = _mm_add_ps(_mm_loadu_ps(elapsed + i), step);
+        _mm_storeu_ps(elapsed + i, time);
+        __m128 t = _mm_min_ps(_mm_mul_ps(time, _mm_loadu_ps(inverseDuration + i)), one);
+        _mm_storeu_ps(eased + i, easeFour(easing, t));
+    }
+#endif
+    for (; i < count; i++) {
+        elapsed[i] += deltaTime;
+        eased[i] = applyEasing(easing, std::min(elapsed[i] * inverseDuration[i], 1.0f));
+    }
+    
+    for (size_t c = 0; c < 4; c++) {
+        const float* start = bucket.start[c].data();
+        const float* delta = bucket.delta[c].data();
+        float* values = bucket.values[c].data();
+        size_t j = 0;
+        
+#ifdef VOIDENGINE_TWEEN_SSE2
+        for (; j + 4 <= count; j += 4) {
+            __m128 value = _mm_add_ps(_mm_loadu_ps(start + j),
+                                      _mm_mul_ps(_mm_loadu_ps(delta + j), _mm_loadu_ps(eased + j)));
+            _mm_storeu_ps(values + j, value);
+        }
+#endif
+        for (; j < count; j++) {
+            values[j] = start[j] + delta[j] * eased[j];
+        }
+    }
+}
+
+void TweenSystem::applyRequests() {
+    {
+        std::lock_guard<std::mutex> lock(requestMutex_);
+        applying_.swap(requests_);
+        // The two buffers trade places every frame; growing the empty one to
+        // match keeps a new peak from costing a reallocation in each of them
+        requests_.reserve(applying_.capacity());
+    }
+    
+    for (const Request& request : applying_) {
+        if (const TrackLocation* location = tracksByKey_.find(makeKey(request.target, request.property))) {
+            removeTrack(location->bucket, location->index);
+        }
+        
+        if (!request.cancel && registry_.isAlive(request.target)) {
+            addTrack(request);
+        }
+    }
+    applying_.clear();
+}
+
+void TweenSystem::addTrack(const Request& request) {
+    uint32_t bucketIndex = static_cast<uint32_t>(request.easing);
+    if (bucketIndex >= static_cast<uint32_t>(Easing::COUNT)) {
+        bucketIndex = static_cast<uint32_t>(Easing::LINEAR);
+    }
+    TrackBucket& bucket = buckets_[bucketIndex];
+    
+    glm::vec4 from = request.fromCurrent ? readProperty(request.target, request.property) : request.from;
+    // A zero duration still goes through one update so the end value is written
+    float duration = std::max(request.duration, 1.0e-6f);
+    
+    bucket.elapsed.push_back(0.0f);
+    bucket.inverseDuration.push_back(1.0f / duration);
+    for (int c = 0; c < 4; c++) {
+        bucket.start[c].push_back(from[c]);
+        bucket.delta[c].push_back(request.to[c] - from[c]);
+        bucket.values[c].push_back(from[c]);
+    }
+    bucket.eased.push_back(0.0f);
+    bucket.targets.push_back(request.target);
+    bucket.properties.push_back(request.property);
+    
+    uint64_t key = makeKey(request.target, request.property);
+    bucket.keys.push_back(key);
+    tracksByKey_[key] = TrackLocation{bucketIndex, static_cast<uint32_t>(bucket.size() - 1)};
+}
+
+void TweenSystem::removeTrack(uint32_t bucketIndex, uint32_t index) {
+    TrackBucket& bucket = buckets_[bucketIndex];
+    uint32_t last = static_cast<uint32_t>(bucket.size() - 1);
+    
+    tracksByKey_.erase(bucket.keys[index]);
+    
+    if (index != last) {
+        bucket.elapsed[index] = bucket.elapsed[last];
+        bucket.inverseDuration[index] = bucket.inverseDuration[last];
+        for (int c = 0; c < 4; c++) {
+            bucket.start[c][index] = bucket.start[c][last];
+            bucket.delta[c][index] = bucket.delta[c][last];
+            bucket.values[c][index] = bucket.values[c][last];
+        }
+        bucket.eased[index] = bucket.eased[last];
+        bucket.targets[index] = bucket.targets[last];
+        bucket.properties[index] = bucket.properties[last];
+        bucket.keys[index] = bucket.keys[last];
+        
+        tracksByKey_[bucket.keys[index]].index = index;
+    }
+    
+    bucket.elapsed.pop_back();
+    bucket.inverseDuration.pop_back();
+    for (int c = 0; c < 4; c++) {
+        bucket.start[c].pop_back();
+        bucket.delta[c].pop_back();
+        bucket.values[c].pop_back();
+    }
+    bucket.eased.pop_back();
+    bucket.targets.pop_back();
+    bucket.properties.pop_back();
+    bucket.keys.pop_back();
+}
+
+glm::vec4 TweenSystem::readProperty(UIHandle target, TweenProperty property) const {
+    switch (property) {
+        case TweenProperty::POSITION: {
+            glm::vec2 position = registry_.position(target);
+            return glm::vec4(position.x, position.y, 0.0f, 0.0f);
+        }
+        case TweenProperty::SIZE: {
+            glm::vec2 size = registry_.size(target);
+            return glm::vec4(size.x, size.y, 0.0f, 0.0f);
+        }
+        case TweenProperty::BACKGROUND_COLOR:
+            return registry_.style(target).backgroundColor;
+        case TweenProperty::BORDER_COLOR:
+            return registry_.style(target).borderColor;
+        case TweenProperty::TEXT_COLOR:
+            return registry_.style(target).textColor;
+        default:
+            return glm::vec4(0.0f);
+    }
+}
+
+void TweenSystem::writeProperty(UIHandle target, TweenProperty property, const glm::vec4& value) {
+    switch (property) {
+        case TweenProperty::POSITION:
+            registry_.position(target) = glm::vec2(value.x, value.y);
+            registry_.markSpatialChange();
+            break;
+        case TweenProperty::SIZE:
+            // Through the component so that the layout sees the new size
+            registry_.owner(target)->setSize(glm::vec2(value.x, value.y));
+            break;
+        case TweenProperty::BACKGROUND_COLOR:
+            registry_.style(target).backgroundColor = value;
+            break;
+        case TweenProperty::BORDER_COLOR:
+            registry_.style(target).borderColor = value;
+            break;
+        case TweenProperty::TEXT_COLOR:
+            registry_.style(target).textColor = value;
+            break;
+    }
+}
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "UIRegistry.h"
+#include "../core/FlatHashMap.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace voidengine {
+namespace ui {
+
+enum class TweenProperty : uint8_t {
+    POSITION,
+    SIZE,
+    BACKGROUND_COLOR,
+    BORDER_COLOR,
+    TEXT_COLOR
+};
+
+enum class Easing : uint8_t {
+    LINEAR,
+    EASE_IN_QUAD,
+    EASE_OUT_QUAD,
+    EASE_IN_OUT_QUAD,
+    EASE_OUT_CUBIC,
+    COUNT
+};
+
+float applyEasing(Easing easing, float t);
+
+// Animates registry properties of UI components. Active tracks are stored as
+// structure-of-arrays buckets, one bucket per easing curve, so each frame the
+// progress, easing and interpolation of a whole bucket run as straight SIMD
+// loops; only the final write into the registry is a scalar scatter. Finished
+// tracks are swap-removed and their storage is reused by later tweens.
+//
+// A target property holds at most one tween; animating it again replaces the
+// running tween and starts from the property's current value. animate() and
+// cancel() may be called from any thread; the requests are applied at the
+// start of the next update(), which belongs on the main thread.
+class TweenSystem {
+public:
+    explicit TweenSystem(UIRegistry& registry);
+    ~TweenSystem();
+    
+    TweenSystem(const TweenSystem&) = delete;
+    TweenSystem& operator=(const TweenSystem&) = delete;
+    
+    // Positions and sizes use the x and y of the value
+    void animate(UIHandle target, TweenProperty property, const glm::vec4& to,
+                 float duration, Easing easing = Easing::EASE_OUT_QUAD);
+    void animate(UIHandle target, TweenProperty property, const glm::vec4& from, const glm::vec4& to,
+                 float duration, Easing easing = Easing::EASE_OUT_QUAD);
+    void cancel(UIHandle target, TweenProperty property);
+    
+    // Reflect the requests applied by the last update()
+    bool isAnimating(UIHandle target, TweenProperty property) const;
+    size_t getActiveCount() const;
+    
+    void reserve(size_t count);
+    void update(float deltaTime);
+    
+private:
+    struct Request {
+        UIHandle target;
+        TweenProperty property;
+        Easing easing;
+        bool fromCurrent;
+        bool cancel;
+        glm::vec4 from;
+        glm::vec4 to;
+        float duration;
+    };
+    
+    struct TrackBucket {
+        std::vector<float> elapsed;
+        std::vector<float> inverseDuration;
+        std::vector<float> start[4];
+        std::vector<float> delta[4];
+        std::vector<UIHandle> targets;
+        std::vector<TweenProperty> properties;
+        std::vector<uint64_t> keys;
+        
+        // Per-frame scratch, kept to avoid reallocating
+        std::vector<float> eased;
+        std::vector<float> values[4];
+        
+        size_t size() const { return targets.size(); }
+    };
+    
+    struct TrackLocation {
+        uint32_t bucket;
+        uint32_t index;
+    };
+    
+    static uint64_t makeKey(UIHandle target, TweenProperty property) {
+        return (static_cast<uint64_t>(target.value) << 8) | static_cast<uint64_t>(property);
+    }
+    
+    void applyRequests();
+    void addTrack(const Request& request);
+    void removeTrack(uint32_t bucketIndex, uint32_t index);
+    void evaluateBucket(TrackBucket& bucket, Easing easing, float deltaTime);
+    
+    glm::vec4 readProperty(UIHandle target, TweenProperty property) const;
+    void writeProperty(UIHandle target, TweenProperty property, const glm::vec4& value);
+    
+    UIRegistry& registry_;
+    TrackBucket buckets_[static_cast<size_t>(Easing::COUNT)];
+    core::FlatHashMap<uint64_t, TrackLocation> tracksByKey_;
+    
+    std::mutex requestMutex_;
+    std::vector<Request> requests_;
+    std::vector<Request> applying_;
+    std::vector<uint32_t> finished_;
+};
+
+extern std::unique_ptr<TweenSystem> gTweenSystem;
+
+TweenSystem& getTweenSystem();
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,219 @@
+#include "UIAutomation.h"
+#include "Text.h"
+#include "../core/StringId.h"
+#include <cmath>
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+// Decodes the code point starting at text[index] and advances index past it.
+// Malformed bytes come out as U+FFFD one byte at a time.
+unsigned int nextCodepoint(std::string_view text, size_t& index) {
+    const unsigned char lead = static_cast<unsigned char>(text[index++]);
+    size_t length;
+    unsigned int codepoint;
+    if (lead < 0x80) {
+        return lead;
+    } else if ((lead & 0xE0) == 0xC0) {
+        length = 1;
+        codepoint = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 2;
+        codepoint = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 3;
+        codepoint = lead & 0x07;
+    } else {
+        return 0xFFFD;
+    }
+    
+    if (index + length > text.size()) {
+        return 0xFFFD;
+    }
+    for (size_t i = 0; i < length; i++) {
+        const unsigned char next = static_cast<unsigned char>(text[index + i]);
+        if ((next & 0xC0) != 0x80) {
+            return 0xFFFD;
+        }
+        codepoint = (codepoint << 6) | (next & 0x3F);
+    }
+    index += length;
+    return codepoint;
+}
+
+std::string quoted(std::string_view text) {
+    std::string result;
+    result.reserve(text.size() + 2);
+    result += '"';
+    result.append(text);
+    result += '"';
+    return result;
+}
+
+} // namespace
+
+UIAutomation::UIAutomation(UIManager& manager, float frameTime)
+    : manager_(manager), frameTime_(frameTime) {
+    if (!(frameTime > 0.0f)) {
+        throw std::invalid_argument("Frame time must be positive");
+    }
+}
+
+void UIAutomation::step(int frames) {
+    for (int i = 0; i < frames; i++) {
+        manager_.update(frameTime_);
+        manager_.render();
+        time_ += frameTime_;
+        frame_++;
+    }
+}
+
+void UIAutomation::advance(float seconds) {
+    step(static_cast<int>(std::ceil(seconds / frameTime_ - 1.0e-4f)));
+}
+
+void UIAutomation::moveTo(const glm::vec2& position) {
+    pointer_ = position;
+    manager_.onMouseMove(position.x, position.y);
+}
+
+void UIAutomation::press(int button) {
+    manager_.onMouseButton(button, GLFW_PRESS, 0, pointer_.x, pointer_.y);
+}
+
+void UIAutomation::release(int button) {
+    manager_.onMouseButton(button, GLFW_RELEASE, 0, pointer_.x, pointer_.y);
+}
+
+void UIAutomation::click(const glm::vec2& position, int button) {
+    moveTo(position);
+    step();
+    press(button);
+    step();
+    release(button);
+    step();
+}
+
+void UIAutomation::click(std::string_view id, int button) {
+    UIComponent& component = get(id);
+    if (!component.isVisible()) {
+        fail("cannot click '" + std::string(id) + "': it is hidden");
+    }
+    click(component.getPosition() + component.getSize() * 0.5f, button);
+}
+
+void UIAutomation::scroll(float x, float y) {
+    manager_.onScroll(x, y);
+}
+
+bool UIAutomation::pressKey(int key, int mods) {
+    return manager_.onKey(key, 0, GLFW_PRESS, mods);
+}
+
+bool UIAutomation::releaseKey(int key, int mods) {
+    return manager_.onKey(key, 0, GLFW_RELEASE, mods);
+}
+
+bool UIAutomation::tapKey(int key, int mods) {
+    bool consumed = pressKey(key, mods);
+    releaseKey(key, mods);
+    return consumed;
+}
+
+void UIAutomation::typeText(std::string_view text) {
+    size_t index = 0;
+    while (index < text.size()) {
+        manager_.onChar(nextCodepoint(text, index));
+    }
+}
+
+UIComponent* UIAutomation::find(std::string_view id) const {
+    return manager_.getComponent(core::findString(id)).get();
+}
+
+UIComponent& UIAutomation::get(std::string_view id) const {
+    UIComponent* component = find(id);
+    if (!component) {
+        fail("no component '" + std::string(id) + "'");
+    }
+    return *component;
+}
+
+std::string UIAutomation::getText(std::string_view id) const {
+    UIComponent& component = get(id);
+    if (auto* text = dynamic_cast<Text*>(&component)) {
+        return text->getText();
+    }
+    if (auto* button = dynamic_cast<Button*>(&component)) {
+        return button->getText();
+    }
+    if (auto* field = dynamic_cast<TextField*>(&component)) {
+        return field->getText();
+    }
+    fail("component '" + std::string(id) + "' has no text");
+}
+
+void UIAutomation::expectExists(std::string_view id) const {
+    get(id);
+}
+
+void UIAutomation::expectMissing(std::string_view id) const {
+    if (find(id)) {
+        fail("expected no component '" + std::string(id) + "'");
+    }
+}
+
+void UIAutomation::expectText(std::string_view id, std::string_view expected) const {
+    std::string actual = getText(id);
+    if (actual != expected) {
+        fail("'" + std::string(id) + "' shows " + quoted(actual) + ", expected " + quoted(expected));
+    }
+}
+
+void UIAutomation::expectVisible(std::string_view id, bool visible) const {
+    if (get(id).isVisible() != visible) {
+        fail("expected '" + std::string(id) + "' to be " + (visible ? "visible" : "hidden"));
+    }
+}
+
+void UIAutomation::expectEnabled(std::string_view id, bool enabled) const {
+    if (get(id).isEnabled() != enabled) {
+        fail("expected '" + std::string(id) + "' to be " + (enabled ? "enabled" : "disabled"));
+    }
+}
+
+void UIAutomation::expectFocused(std::string_view id) const {
+    UIComponent* focused = manager_.getFocusedComponent();
+    if (id.empty()) {
+        if (focused) {
+            fail("expected nothing focused, but '" + focused->getId() + "' is");
+        }
+        return;
+    }
+    
+    if (focused != &get(id)) {
+        fail("expected '" + std::string(id) + "' to be focused, but " +
+             (focused ? "'" + focused->getId() + "' is" : std::string("nothing is")));
+    }
+}
+
+void UIAutomation::waitUntil(const std::function<bool()>& condition, int maxFrames, std::string_view description) {
+    for (int i = 0; i < maxFrames; i++) {
+        if (condition()) {
+            return;
+        }
+        step();
+    }
+    if (!condition()) {
+        fail("timed out after " + std::to_string(maxFrames) + " frames waiting for " + std::string(description));
+    }
+}
+
+void UIAutomation::fail(const std::string& message) const {
+    throw std::runtime_error("UI automation, frame " + std::to_string(frame_) + ": " + message);
+}
+
+} // namespace ui
+} // namespace voidengine
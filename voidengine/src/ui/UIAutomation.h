@@ -0,0 +1,92 @@
+#pragma once
+
+#include "UIManager.h"
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+
+namespace voidengine {
+namespace ui {
+
+// Plays a UIManager the way a user would, for scripted UI tests. Input goes
+// straight into the manager instead of through GLFW, and time only moves when
+// a frame is stepped, so a scenario runs as fast as the UI updates and ends
+// the same way every run. Pair it with a headless manager to run without a
+// window or GL context.
+//
+// Lookups and assertions throw std::runtime_error naming the component, the
+// values involved and the frame, so a failed scenario reads like a report.
+class UIAutomation {
+public:
+    explicit UIAutomation(UIManager& manager, float frameTime = 1.0f / 60.0f);
+    
+    // Each frame runs update() then render() and moves the clock by one
+    // frame time
+    void step(int frames = 1);
+    // Whole frames until at least this much virtual time has passed
+    void advance(float seconds);
+    double getTime() const { return time_; }
+    uint64_t getFrame() const { return frame_; }
+    
+    // Hover follows on the next step, as it does for real cursor motion
+    void moveTo(const glm::vec2& position);
+    void press(int button = GLFW_MOUSE_BUTTON_LEFT);
+    void release(int button = GLFW_MOUSE_BUTTON_LEFT);
+    // Move, press and release with a frame after each, so the widget sees
+    // hover and pressed states in between like it would with a real mouse
+    void click(const glm::vec2& position, int button = GLFW_MOUSE_BUTTON_LEFT);
+    // Clicks the center of a visible component
+    void click(std::string_view id, int button = GLFW_MOUSE_BUTTON_LEFT);
+    void scroll(float x, float y);
+    
+    // The key functions return whether the UI consumed the key
+    bool pressKey(int key, int mods = 0);
+    bool releaseKey(int key, int mods = 0);
+    bool tapKey(int key, int mods = 0);
+    // One CHAR event per code point of UTF-8 text
+    void typeText(std::string_view text);
+    
+    // Null when no component has that id
+    UIComponent* find(std::string_view id) const;
+    UIComponent& get(std::string_view id) const;
+    template <typename T>
+    T& get(std::string_view id) const;
+    // The string a Text, Button or TextField shows
+    std::string getText(std::string_view id) const;
+    
+    void expectExists(std::string_view id) const;
+    void expectMissing(std::string_view id) const;
+    void expectText(std::string_view id, std::string_view expected) const;
+    void expectVisible(std::string_view id, bool visible = true) const;
+    void expectEnabled(std::string_view id, bool enabled = true) const;
+    // An empty id expects nothing to be focused
+    void expectFocused(std::string_view id) const;
+    // Steps until the condition holds, failing after maxFrames
+    void waitUntil(const std::function<bool()>& condition, int maxFrames, std::string_view description);
+
+private:
+    [[noreturn]] void fail(const std::string& message) const;
+    
+    UIManager& manager_;
+    float frameTime_;
+    double time_ = 0.0;
+    uint64_t frame_ = 0;
+    glm::vec2 pointer_ = glm::vec2(0.0f);
+};
+
+template <typename T>
+T& UIAutomation::get(std::string_view id) const {
+    UIComponent& component = get(id);
+    T* typed = dynamic_cast<T*>(&component);
+    if (!typed) {
+        fail("component '" + std::string(id) + "' is not of the requested type");
+    }
+    return *typed;
+}
+
+} // namespace ui
+} // namespace voidengine
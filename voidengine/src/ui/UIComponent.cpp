@@ -1,11 +1,267 @@
 #include "UIComponent.h"
+#include <stdexcept>
 
 namespace voidengine {
 namespace ui {
 
+namespace {
+thread_local std::vector<UIComponent*>* tDeferredLayoutSink = nullptr;
+}
+
+DeferredLayoutScope::DeferredLayoutScope(std::vector<UIComponent*>& sink)
+    : previous_(tDeferredLayoutSink) {
+    tDeferredLayoutSink = &sink;
+}
+
+DeferredLayoutScope::~DeferredLayoutScope() {
+    tDeferredLayoutSink = previous_;
+}
+
 UIComponent::UIComponent(const std::string& id, const glm::vec2& position, const glm::vec2& size)
-    : id_(id), position_(position), size_(size) {
+    : id_(core::internString(id)), registry_(&getUIRegistry()) {
+    handle_ = registry_->create(this, position, size);
+}
+
+UIComponent::~UIComponent() {
+    if (gUIRegistry.get() == registry_) {
+        registry_->destroy(handle_);
+    }
+}
+
+void UIComponent::setParent(UIComponent* parent) {
+    if (parent_ != parent) {
+        parent_ = parent;
+        // The new parent rescans its children, so no list holds us any more
+        setFlag(UIFlags::LAYOUT_QUEUED, false);
+        registry_->markSpatialChange();
+    }
+}
+
+size_t UIComponent::getChildIndex(const UIComponent& child) const {
+    size_t count = getChildCount();
+    for (size_t i = 0; i < count; i++) {
+        if (getChild(i) == &child) {
+            return i;
+        }
+    }
+    return count;
+}
+
+void UIComponent::setFlag(uint8_t flag, bool value) {
+    uint8_t& flags = registry_->flags(handle_);
+    flags = value ? (flags | flag) : (flags & ~flag);
+}
+
+void UIComponent::setPosition(const glm::vec2& position) {
+    glm::vec2& current = registry_->position(handle_);
+    if (current != position) {
+        current = position;
+        registry_->markSpatialChange();
+        markRenderDirty();
+    }
+}
+
+void UIComponent::setSize(const glm::vec2& size) {
+    registry_->layoutState(handle_).intrinsicSize = size;
+    glm::vec2& current = registry_->size(handle_);
+    if (current != size) {
+        current = size;
+        registry_->markSpatialChange();
+        markLayoutDirty();
+    }
+}
+
+void UIComponent::setVisible(bool visible) {
+    if (isVisible() != visible) {
+        setFlag(UIFlags::VISIBLE, visible);
+        registry_->markSpatialChange();
+        markLayoutDirty();
+    }
+}
+
+void UIComponent::setEnabled(bool enabled) {
+    if (isEnabled() != enabled) {
+        setFlag(UIFlags::ENABLED, enabled);
+        registry_->markSpatialChange();
+        markRenderDirty();
+    }
+}
+
+void UIComponent::setRenderLayer(UILayer layer) {
+    if (layer >= UILayer::COUNT) {
+        throw std::invalid_argument("Invalid render layer");
+    }
+    renderLayer_ = layer;
+}
+
+void UIComponent::setZIndex(int zIndex) {
+    zIndex_ = zIndex;
+}
+
+void UIComponent::setStyleClass(const std::string& styleClass) {
+    core::StringId symbol = styleClass.empty() ? 0 : core::hashString(styleClass);
+    if (styleClass_ != symbol) {
+        styleClass_ = symbol;
+        resolveStyle();
+    }
+}
+
+void UIComponent::setStyleOverride(const StyleDeclaration& declaration) {
+    if (!styleOverride_) {
+        styleOverride_ = std::make_unique<StyleOverride>();
+        styleOverride_->record = getStyleSystem().get(styleId_);
+    }
+    styleOverride_->declaration.merge(declaration);
+    resolveStyle();
+}
+
+void UIComponent::clearStyleOverride() {
+    if (styleOverride_) {
+        // The override hid the shared record without changing styleId_, so
+        // an unchanged id still has a look to restore
+        StyleRecord previous = styleOverride_->record;
+        StyleId before = styleId_;
+        styleOverride_.reset();
+        resolveStyle();
+        if (styleId_ == before && getStyleRecord() != previous) {
+            onStyleChanged(getStyleRecord());
+        }
+    }
+}
+
+void UIComponent::refreshStyle() {
+    if (styleGeneration_ != getStyleSystem().getGeneration()) {
+        resolveStyle();
+    }
+}
+
+void UIComponent::resolveStyle() {
+    StyleSystem& styles = getStyleSystem();
+    
+    // Interning makes equal looks equal ids, so an unchanged id means nothing
+    // to apply, except on the first resolve
+    bool first = styleGeneration_ == 0;
+    styleGeneration_ = styles.getGeneration();
+    StyleId resolved = styles.resolve(getStyleType(), styleClass_, id_);
+    
+    if (styleOverride_) {
+        StyleRecord record = styles.get(resolved);
+        styleOverride_->declaration.applyTo(record);
+        styleId_ = resolved;
+        if (record == styleOverride_->record && !first) {
+            return;
+        }
+        styleOverride_->record = record;
+        onStyleChanged(styleOverride_->record);
+        return;
+    }
+    
+    if (resolved == styleId_ && !first) {
+        return;
+    }
+    
+    styleId_ = resolved;
+    onStyleChanged(styles.get(styleId_));
+}
+
+void UIComponent::onStyleChanged(const StyleRecord& record) {
+    UIStyle& live = style();
+    live.backgroundColor = record.background;
+    live.borderColor = record.border;
+    live.textColor = record.text;
+    live.shadowColor = record.shadow;
+    live.borderWidth = record.borderWidth;
+    live.borderRadius = record.borderRadius;
+    live.shadowBlur = record.shadowBlur;
+    markRenderDirty();
+}
+
+void UIComponent::markRenderDirty() {
+    UIComponent* root = this;
+    while (root->parent_) {
+        root = root->parent_;
+    }
+    
+    // Load first so repeated marks from many threads do not fight over the line
+    if (!root->renderDirty_.load(std::memory_order_relaxed)) {
+        root->renderDirty_.store(true, std::memory_order_relaxed);
+    }
+}
+
+void UIComponent::setLayout(const LayoutParams& params) {
+    registry_->layoutParams(handle_) = params;
+    markLayoutStructureDirty();
+}
+
+void UIComponent::markLayoutDirty() {
+    markRenderDirty();
+    
+    if (tDeferredLayoutSink) {
+        setFlag(UIFlags::LAYOUT_DIRTY, true);
+        tDeferredLayoutSink->push_back(this);
+        return;
+    }
+    
+    // Walks the full path so that a dirty node always has dirty ancestors,
+    // even when an earlier pass skipped a hidden subtree. Each node joins its
+    // parent's list once, which is how the pass finds it without a scan.
+    for (UIComponent* node = this; node; node = node->parent_) {
+        uint8_t& flags = registry_->flags(node->handle_);
+        flags |= UIFlags::LAYOUT_DIRTY;
+        if (node->parent_ && !(flags & UIFlags::LAYOUT_QUEUED)) {
+            flags |= UIFlags::LAYOUT_QUEUED;
+            registry_->layoutState(node->parent_->handle_).dirtyChildren.push_back(node->handle_.value);
+        }
+    }
+}
+
+void UIComponent::markLayoutStructureDirty() {
+    setFlag(UIFlags::LAYOUT_STRUCTURE, true);
+    markLayoutDirty();
+}
+
+void UIComponent::arrange(const glm::vec2& position, const glm::vec2& size) {
+    glm::vec2& currentPosition = registry_->position(handle_);
+    glm::vec2& currentSize = registry_->size(handle_);
+    if (currentPosition != position || currentSize != size) {
+        currentPosition = position;
+        currentSize = size;
+        registry_->markSpatialChange();
+        markRenderDirty();
+    }
+}
+
+bool UIComponent::containsPoint(const glm::vec2& point) const {
+    const glm::vec2& position = registry_->position(handle_);
+    const glm::vec2& size = registry_->size(handle_);
+    return (point.x >= position.x && point.x <= position.x + size.x &&
+            point.y >= position.y && point.y <= position.y + size.y);
+}
+
+UIComponent* UIComponent::hitTest(const glm::vec2& point) {
+    if (!isVisible()) {
+        return nullptr;
+    }
+    
+    if (hasCapability(UICapabilities::CLIPS_CHILDREN) && !containsPoint(point)) {
+        return nullptr;
+    }
+    
+    for (size_t i = getChildCount(); i-- > 0;) {
+        UIComponent* child = getChild(i);
+        if (child) {
+            if (UIComponent* hit = child->hitTest(point)) {
+                return hit;
+            }
+        }
+    }
+    
+    if (hasCapability(UICapabilities::POINTER) && containsPoint(point)) {
+        return this;
+    }
+    
+    return nullptr;
 }
 
 } // namespace ui
-} // namespace voidengine 
\ No newline at end of file
+} // namespace voidengine
@@ -1,7 +1,15 @@
 #pragma once
 
+#include "UIEvent.h"
+#include "UIRegistry.h"
+#include "StyleSheet.h"
+#include "../core/StringId.h"
+#include <atomic>
 #include <string>
 #include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
 #include <glm/glm.hpp>
 
 namespace voidengine {
@@ -9,36 +17,181 @@ namespace ui {
 
 class UIContext;
 
-class UIComponent {
+namespace UICapabilities {
+    constexpr uint32_t NONE = 0;
+    constexpr uint32_t POINTER = 1u << 0;
+    constexpr uint32_t KEYBOARD = 1u << 1;
+    constexpr uint32_t CLIPS_CHILDREN = 1u << 2;
+    // Receives every cursor sample while hovered instead of one coalesced
+    // MOUSE_MOVE per frame, e.g. for freehand drawing
+    constexpr uint32_t RAW_POINTER = 1u << 3;
+    // Reachable by directional navigation; see FocusManager
+    constexpr uint32_t FOCUSABLE = 1u << 4;
+}
+
+// Root components draw layer by layer, bottom to top, and by ascending z-index
+// within a layer; ties keep the order the roots were added in
+enum class UILayer : uint8_t {
+    BACKGROUND,
+    CONTENT,
+    POPUP,
+    TOOLTIP,
+    MODAL,
+    COUNT
+};
+
+class UIComponent : public std::enable_shared_from_this<UIComponent> {
 public:
     UIComponent(const std::string& id, const glm::vec2& position, const glm::vec2& size);
-    virtual ~UIComponent() = default;
-
+    virtual ~UIComponent();
+    
+    UIComponent(const UIComponent&) = delete;
+    UIComponent& operator=(const UIComponent&) = delete;
+    
     virtual void initialize() {}
+    // May run on a job thread; see UIManager::update for what it may touch
     virtual void update(float deltaTime) {}
     virtual void render() = 0;
-
-    const std::string& getId() const { return id_; }
     
-    const glm::vec2& getPosition() const { return position_; }
-    void setPosition(const glm::vec2& position) { position_ = position; }
+    // True when update() does nothing but update each child, which lets the
+    // manager split the subtree across threads instead of calling update()
+    virtual bool forwardsUpdateToChildren() const { return false; }
+    
+    virtual void onEvent(UIEvent& event) {}
+    // What a click would do, for keyboard and gamepad confirm; false when the
+    // component has no such action
+    virtual bool activate() { return false; }
+    
+    virtual size_t getChildCount() const { return 0; }
+    virtual UIComponent* getChild(size_t index) const { return nullptr; }
+    // Index of a direct child for getChild(); containers with an index
+    // override the linear search
+    virtual size_t getChildIndex(const UIComponent& child) const;
+    
+    UIComponent* getParent() const { return parent_; }
+    void setParent(UIComponent* parent);
+    
+    uint32_t getCapabilities() const { return capabilities_; }
+    bool hasCapability(uint32_t capability) const { return (capabilities_ & capability) != 0; }
+    
+    bool containsPoint(const glm::vec2& point) const;
+    UIComponent* hitTest(const glm::vec2& point);
+    
+    const std::string& getId() const { return core::getStringInterner().lookup(id_); }
+    core::StringId getIdSymbol() const { return id_; }
+    
+    UIHandle getHandle() const { return handle_; }
+    
+    glm::vec2 getPosition() const { return registry_->position(handle_); }
+    void setPosition(const glm::vec2& position);
+    
+    glm::vec2 getSize() const { return registry_->size(handle_); }
+    void setSize(const glm::vec2& size);
     
-    const glm::vec2& getSize() const { return size_; }
-    void setSize(const glm::vec2& size) { size_ = size; }
+    bool isVisible() const { return (registry_->flags(handle_) & UIFlags::VISIBLE) != 0; }
+    void setVisible(bool visible);
     
-    bool isVisible() const { return isVisible_; }
-    void setVisible(bool visible) { isVisible_ = visible; }
+    bool isEnabled() const { return (registry_->flags(handle_) & UIFlags::ENABLED) != 0; }
+    void setEnabled(bool enabled);
     
-    bool isEnabled() const { return isEnabled_; }
-    void setEnabled(bool enabled) { isEnabled_ = enabled; }
+    const LayoutParams& getLayout() const { return registry_->layoutParams(handle_); }
+    void setLayout(const LayoutParams& params);
+    
+    bool isLayoutDirty() const { return (registry_->flags(handle_) & UIFlags::LAYOUT_DIRTY) != 0; }
+    void markLayoutDirty();
+    // For containers whose children were added, removed or remapped: the
+    // next pass rescans them all instead of only the ones marked dirty
+    void markLayoutStructureDirty();
+    
+    // Only meaningful on roots; children draw as part of their root
+    UILayer getRenderLayer() const { return renderLayer_; }
+    void setRenderLayer(UILayer layer);
+    int getZIndex() const { return zIndex_; }
+    void setZIndex(int zIndex);
+    
+    // Each layer's geometry is recorded once and replayed until one of its
+    // roots is marked. The setters here, tweens and delivered events mark the
+    // node; a component whose look changes any other way calls this itself.
+    // Safe from update() on any thread.
+    void markRenderDirty();
+    // Clears and returns the root's mark; for the manager
+    bool consumeRenderDirty() { return renderDirty_.exchange(false, std::memory_order_relaxed); }
+    
+    // Sheet selectors match this type name, the style class and the id, as in
+    // "Button.primary" or "#quit"
+    virtual core::StringId getStyleType() const { return core::hashString("UIComponent"); }
+    void setStyleClass(const std::string& styleClass);
+    core::StringId getStyleClass() const { return styleClass_; }
+    // Layers the set properties over what the sheet gives this widget. The
+    // result is kept by the widget rather than interned, so animating an
+    // override allocates nothing per frame; only widgets with overrides pay
+    // for storing it. Main thread only.
+    void setStyleOverride(const StyleDeclaration& declaration);
+    void clearStyleOverride();
+    const StyleRecord& getStyleRecord() const {
+        return styleOverride_ ? styleOverride_->record : getStyleSystem().get(styleId_);
+    }
+    // Re-resolves the style if the sheet changed since the last call. Widgets
+    // resolve on construction and managed roots on the manager's update;
+    // components outside a UIManager call this after switching sheets.
+    void refreshStyle();
+    
+    // Size the node wants when it is not a layout container
+    virtual glm::vec2 measureContent() const { return registry_->layoutState(handle_).intrinsicSize; }
+    // Places the node in the rect chosen by its parent's layout
+    virtual void arrange(const glm::vec2& position, const glm::vec2& size);
+    // Runs on the main thread when the layout pass visits a dirty node, before
+    // its children are placed; the place for structural changes to children
+    virtual void onLayout() {}
 
 protected:
-    std::string id_;
-    glm::vec2 position_;
-    glm::vec2 size_;
-    bool isVisible_ = true;
-    bool isEnabled_ = true;
+    UIStyle& style() { return registry_->style(handle_); }
+    const UIStyle& style() const { return registry_->style(handle_); }
+    
+    void setFlag(uint8_t flag, bool value);
+    
+    // Called with the newly resolved record; the default copies the colors
+    // into the live style that rendering and tweens use
+    virtual void onStyleChanged(const StyleRecord& record);
+    
+    core::StringId id_;
+    UIRegistry* registry_;
+    UIHandle handle_;
+    uint32_t capabilities_ = UICapabilities::NONE;
+    UIComponent* parent_ = nullptr;
+    
+private:
+    struct StyleOverride {
+        StyleDeclaration declaration;
+        // The sheet's record with the declaration applied
+        StyleRecord record;
+    };
+    
+    void resolveStyle();
+    
+    UILayer renderLayer_ = UILayer::CONTENT;
+    int zIndex_ = 0;
+    std::atomic<bool> renderDirty_{true};
+    StyleId styleId_ = 0;
+    uint32_t styleGeneration_ = 0;
+    core::StringId styleClass_ = 0;
+    std::unique_ptr<StyleOverride> styleOverride_;
+};
+
+// While alive, markLayoutDirty() on the constructing thread flags only the
+// node itself and appends it to the sink instead of walking shared ancestors.
+// The owner replays the sink with markLayoutDirty() after joining.
+class DeferredLayoutScope {
+public:
+    explicit DeferredLayoutScope(std::vector<UIComponent*>& sink);
+    ~DeferredLayoutScope();
+    
+    DeferredLayoutScope(const DeferredLayoutScope&) = delete;
+    DeferredLayoutScope& operator=(const DeferredLayoutScope&) = delete;
+    
+private:
+    std::vector<UIComponent*>* previous_;
 };
 
 } // namespace ui
-} // namespace voidengine 
\ No newline at end of file
+} // namespace voidengine
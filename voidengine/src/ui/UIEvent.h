@@ -0,0 +1,49 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace voidengine {
+namespace ui {
+
+class UIComponent;
+
+enum class UIEventType {
+    MOUSE_MOVE,
+    MOUSE_BUTTON,
+    MOUSE_ENTER,
+    MOUSE_LEAVE,
+    SCROLL,
+    // Keyboard events go to the focused component
+    KEY,
+    CHAR,
+    FOCUS_GAINED,
+    FOCUS_LOST
+};
+
+enum class UIEventPhase {
+    CAPTURE,
+    TARGET,
+    BUBBLE
+};
+
+// Routed from the root down to the target (capture), delivered to the target,
+// then back up to the root (bubble). Consuming the event stops propagation and
+// tells the caller the UI handled it.
+struct UIEvent {
+    UIEventType type = UIEventType::MOUSE_MOVE;
+    UIEventPhase phase = UIEventPhase::TARGET;
+    glm::vec2 position = glm::vec2(0.0f);
+    glm::vec2 scroll = glm::vec2(0.0f);
+    int button = -1;
+    int key = -1;
+    unsigned int codepoint = 0;
+    int action = 0;
+    int mods = 0;
+    UIComponent* target = nullptr;
+    bool consumed = false;
+
+    void consume() { consumed = true; }
+};
+
+} // namespace ui
+} // namespace voidengine
@@ -1,11 +1,51 @@
 #include "UIManager.h"
+#include "Layout.h"
+#include "Observable.h"
+#include "Tween.h"
+#include "UIRenderer.h"
+#include "ScreenCompiler.h"
 #include "../window/Window.h"
+#include "../input/InputMapping.h"
+#include "../core/AllocationTracker.h"
+#include "../core/JobSystem.h"
+#include "../core/PoolAllocator.h"
 #include <algorithm>
 #include <stdexcept>
 
 namespace voidengine {
 namespace ui {
 
+namespace {
+
+bool drawsBefore(UILayer layerA, int zA, uint32_t sequenceA, UILayer layerB, int zB, uint32_t sequenceB) {
+    if (layerA != layerB) {
+        return layerA < layerB;
+    }
+    if (zA != zB) {
+        return zA < zB;
+    }
+    return sequenceA < sequenceB;
+}
+
+// Adds the heap traffic of its scope to a frame's stats
+class AllocationSample {
+public:
+    explicit AllocationSample(UIFrameStats& stats)
+        : stats_(stats), start_(core::getAllocationCounters()) {}
+    
+    ~AllocationSample() {
+        core::AllocationCounters end = core::getAllocationCounters();
+        stats_.heapAllocations += end.allocations - start_.allocations;
+        stats_.heapBytes += end.bytes - start_.bytes;
+    }
+    
+private:
+    UIFrameStats& stats_;
+    core::AllocationCounters start_;
+};
+
+} // namespace
+
 UIManager::UIManager(window::Window* window)
     : window_(window), screenWidth_(800), screenHeight_(600), lastMousePos_(0.0f, 0.0f) {
     
@@ -17,7 +57,16 @@ UIManager::UIManager(window::Window* window)
     screenHeight_ = window_->getHeight();
 }
 
+UIManager::UIManager(int width, int height)
+    : window_(nullptr), screenWidth_(width), screenHeight_(height), lastMousePos_(0.0f, 0.0f) {
+    
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Screen size must be positive");
+    }
+}
+
 UIManager::~UIManager() {
+    unbindNavigationActions();
     rootComponents_.clear();
     componentsById_.clear();
 }
@@ -29,12 +78,114 @@ void UIManager::initialize() {
 }
 
 void UIManager::update(float deltaTime) {
+    AllocationSample sample(pendingFrameStats_);
+    
+    // A sheet switch costs nothing until here; new components resolved their
+    // style when they were constructed
+    uint32_t styleGeneration = getStyleSystem().getGeneration();
+    if (styleGeneration != styleGeneration_) {
+        styleGeneration_ = styleGeneration;
+        for (auto& component : rootComponents_) {
+            refreshStyles(*component);
+        }
+    }
+    
+    // Values set since the last frame reach their bindings in one batch, and
+    // any text they change is measured by this frame's layout
+    pendingFrameStats_.bindingRuns += static_cast<uint32_t>(getBindingScheduler().flush());
+    
+    // Tweens write sizes and positions, so they run ahead of the layout. This
+    // also creates the tween system on the main thread before any widget
+    // update can ask for it from a job thread.
+    getTweenSystem().update(deltaTime);
+    
+    // Roots that also sit inside a container are laid out and updated through
+    // it, here as in the parallel path
+    for (auto& component : rootComponents_) {
+        if (!component->getParent()) {
+            updateLayout(*component);
+        }
+    }
+    
+    // Hover is resolved after layout so it sees where widgets are this frame,
+    // and before update so widgets see the hover state it produced
+    resolveHover();
+    
+    core::JobSystem* jobs = core::gJobSystem.get();
+    if (!parallelUpdate_ || !jobs || jobs->getWorkerCount() == 0) {
+        for (auto& component : rootComponents_) {
+            if (!component->getParent()) {
+                component->update(deltaTime);
+            }
+        }
+        return;
+    }
+    
+    // A few units per thread leaves room for stealing when subtrees are uneven
+    collectUpdateUnits(jobs->getThreadCount() * 4);
+    
+    deferredLayout_.resize(jobs->getThreadCount());
+    jobs->parallelFor(updateUnits_.size(), 1, [this, deltaTime](size_t index) {
+        DeferredLayoutScope scope(deferredLayout_[core::JobSystem::getThreadIndex()]);
+        updateUnits_[index]->update(deltaTime);
+    });
+    
+    for (auto& sink : deferredLayout_) {
+        for (UIComponent* component : sink) {
+            component->markLayoutDirty();
+        }
+        sink.clear();
+    }
+}
+
+void UIManager::collectUpdateUnits(size_t targetCount) {
+    updateUnits_.clear();
     for (auto& component : rootComponents_) {
-        component->update(deltaTime);
+        // Roots that also sit inside a container are reached through it; updating
+        // them twice would race with their parent's unit
+        if (!component->getParent()) {
+            updateUnits_.push_back(component.get());
+        }
+    }
+    
+    // Split pass-through containers into their children until there are
+    // enough independent units to keep every thread busy
+    bool expanded = true;
+    while (expanded && updateUnits_.size() < targetCount) {
+        expanded = false;
+        updateUnitsScratch_.clear();
+        
+        for (UIComponent* unit : updateUnits_) {
+            size_t childCount = unit->getChildCount();
+            if (unit->forwardsUpdateToChildren() && childCount > 0) {
+                for (size_t i = 0; i < childCount; i++) {
+                    updateUnitsScratch_.push_back(unit->getChild(i));
+                }
+                expanded = true;
+            } else {
+                updateUnitsScratch_.push_back(unit);
+            }
+        }
+        
+        updateUnits_.swap(updateUnitsScratch_);
     }
 }
 
 void UIManager::render() {
+    {
+        AllocationSample sample(pendingFrameStats_);
+        if (window_) {
+            renderFrame();
+        } else {
+            immediate_.endFrame();
+        }
+    }
+    
+    frameStats_ = pendingFrameStats_;
+    pendingFrameStats_ = UIFrameStats();
+}
+
+void UIManager::renderFrame() {
     glMatrixMode(GL_PROJECTION);
     glPushMatrix();
     glLoadIdentity();
@@ -46,10 +197,45 @@ void UIManager::render() {
     
     glDisable(GL_DEPTH_TEST);
     
-    for (auto& component : rootComponents_) {
-        component->render();
+    updateDrawOrder();
+    
+    for (const DrawEntry& entry : drawOrder_) {
+        if (!entry.parented && entry.component->consumeRenderDirty()) {
+            layers_[static_cast<size_t>(entry.layer)].dirty = true;
+        }
     }
     
+    size_t next = 0;
+    for (size_t layer = 0; layer < layers_.size(); layer++) {
+        size_t begin = next;
+        while (next < drawOrder_.size() && static_cast<size_t>(drawOrder_[next].layer) == layer) {
+            next++;
+        }
+        
+        LayerCache& cache = layers_[layer];
+        if (cache.dirty) {
+            // Cleared first so that a mark made while recording, e.g. by
+            // lazily bound rows, takes effect next frame
+            cache.dirty = false;
+            cache.drawList.clear();
+            
+            DrawListScope scope(cache.drawList);
+            for (size_t i = begin; i < next; i++) {
+                const DrawEntry& entry = drawOrder_[i];
+                if (!entry.parented && entry.component->isVisible()) {
+                    entry.component->render();
+                }
+            }
+            pendingFrameStats_.layerRebuilds++;
+        }
+        
+        cache.drawList.submit();
+        pendingFrameStats_.drawBatches += static_cast<uint32_t>(cache.drawList.getBatchCount());
+    }
+    
+    immediate_.render();
+    immediate_.endFrame();
+    
     glEnable(GL_DEPTH_TEST);
     
     glMatrixMode(GL_MODELVIEW);
@@ -59,16 +245,82 @@ void UIManager::render() {
     glPopMatrix();
 }
 
+void UIManager::updateDrawOrder() {
+    if (drawOrderDirty_) {
+        drawOrderDirty_ = false;
+        drawOrder_.clear();
+        for (size_t i = 0; i < rootComponents_.size(); i++) {
+            UIComponent* root = rootComponents_[i].get();
+            drawOrder_.push_back(DrawEntry{root, root->getRenderLayer(), root->getZIndex(),
+                                           static_cast<uint32_t>(i), root->getParent() != nullptr});
+        }
+        
+        std::sort(drawOrder_.begin(), drawOrder_.end(), [](const DrawEntry& a, const DrawEntry& b) {
+            return drawsBefore(a.layer, a.zIndex, a.sequence, b.layer, b.zIndex, b.sequence);
+        });
+        return;
+    }
+    
+    bool reorder = false;
+    for (DrawEntry& entry : drawOrder_) {
+        UIComponent* root = entry.component;
+        bool parented = root->getParent() != nullptr;
+        if (entry.layer == root->getRenderLayer() && entry.zIndex == root->getZIndex() && entry.parented == parented) {
+            continue;
+        }
+        
+        layers_[static_cast<size_t>(entry.layer)].dirty = true;
+        entry.layer = root->getRenderLayer();
+        entry.zIndex = root->getZIndex();
+        entry.parented = parented;
+        layers_[static_cast<size_t>(entry.layer)].dirty = true;
+        reorder = true;
+    }
+    
+    if (!reorder) {
+        return;
+    }
+    
+    // Insertion sort: the order is already sorted except for the entries that
+    // changed, so only those move
+    for (size_t i = 1; i < drawOrder_.size(); i++) {
+        DrawEntry entry = drawOrder_[i];
+        size_t j = i;
+        while (j > 0 && drawsBefore(entry.layer, entry.zIndex, entry.sequence,
+                                    drawOrder_[j - 1].layer, drawOrder_[j - 1].zIndex, drawOrder_[j - 1].sequence)) {
+            drawOrder_[j] = drawOrder_[j - 1];
+            j--;
+        }
+        drawOrder_[j] = entry;
+    }
+}
+
+void UIManager::onRootsChanged(UIComponent* root) {
+    drawOrderDirty_ = true;
+    focus_.invalidate();
+    layers_[static_cast<size_t>(root->getRenderLayer())].dirty = true;
+}
+
+std::shared_ptr<Panel> UIManager::createPanel(const std::string& id, const glm::vec2& position,
+                                             const glm::vec2& size) {
+    if (componentsById_.contains(core::findString(id))) {
+        throw std::invalid_argument("Component with ID '" + id + "' already exists");
+    }
+    
+    auto panel = core::makePooled<Panel>(id, position, size);
+    registerComponent(panel);
+    
+    return panel;
+}
+
 std::shared_ptr<Panel> UIManager::createPanel(const std::string& id, const glm::vec2& position, 
                                              const glm::vec2& size, const glm::vec4& backgroundColor) {
-    if (componentsById_.find(id) != componentsById_.end()) {
+    if (componentsById_.contains(core::findString(id))) {
         throw std::invalid_argument("Component with ID '" + id + "' already exists");
     }
     
-    auto panel = std::make_shared<Panel>(id, position, size, backgroundColor);
-    
-    rootComponents_.push_back(panel);
-    componentsById_[id] = panel;
+    auto panel = core::makePooled<Panel>(id, position, size, backgroundColor);
+    registerComponent(panel);
     
     return panel;
 }
@@ -76,29 +328,37 @@ std::shared_ptr<Panel> UIManager::createPanel(const std::string& id, const glm::
 std::shared_ptr<Button> UIManager::createButton(const std::string& id, const glm::vec2& position, 
                                                const glm::vec2& size, const std::string& text,
                                                const Button::ButtonCallback& onClick) {
-    if (componentsById_.find(id) != componentsById_.end()) {
+    if (componentsById_.contains(core::findString(id))) {
         throw std::invalid_argument("Component with ID '" + id + "' already exists");
     }
     
-    auto button = std::make_shared<Button>(id, position, size, text, onClick);
-    
-    rootComponents_.push_back(button);
-    componentsById_[id] = button;
+    auto button = core::makePooled<Button>(id, position, size, text, onClick);
+    registerComponent(button);
     
     return button;
 }
 
+std::shared_ptr<Text> UIManager::createText(const std::string& id, const glm::vec2& position,
+                                           const std::string& text, float fontSize) {
+    if (componentsById_.contains(core::findString(id))) {
+        throw std::invalid_argument("Component with ID '" + id + "' already exists");
+    }
+    
+    auto textComponent = core::makePooled<Text>(id, position, text, fontSize);
+    registerComponent(textComponent);
+    
+    return textComponent;
+}
+
 std::shared_ptr<Text> UIManager::createText(const std::string& id, const glm::vec2& position, 
                                            const std::string& text, float fontSize,
                                            const glm::vec4& color) {
-    if (componentsById_.find(id) != componentsById_.end()) {
+    if (componentsById_.contains(core::findString(id))) {
         throw std::invalid_argument("Component with ID '" + id + "' already exists");
     }
     
-    auto textComponent = std::make_shared<Text>(id, position, text, fontSize, color);
-    
-    rootComponents_.push_back(textComponent);
-    componentsById_[id] = textComponent;
+    auto textComponent = core::makePooled<Text>(id, position, text, fontSize, color);
+    registerComponent(textComponent);
     
     return textComponent;
 }
@@ -108,59 +368,389 @@ void UIManager::addComponent(std::shared_ptr<UIComponent> component) {
         throw std::invalid_argument("Cannot add null component");
     }
     
-    const std::string& id = component->getId();
+    if (componentsById_.contains(component->getIdSymbol())) {
+        throw std::invalid_argument("Component with ID '" + component->getId() + "' already exists");
+    }
     
-    if (componentsById_.find(id) != componentsById_.end()) {
+    registerComponent(component);
+}
+
+std::shared_ptr<UIComponent> UIManager::loadScreen(const std::string& path) {
+    LoadedScreen screen = loadScreenFile(path);
+    return registerScreen(screen);
+}
+
+std::shared_ptr<UIComponent> UIManager::loadScreen(const uint8_t* data, size_t size) {
+    LoadedScreen screen = instantiateScreen(data, size);
+    return registerScreen(screen);
+}
+
+std::shared_ptr<TextField> UIManager::createTextField(const std::string& id, const glm::vec2& position,
+                                                      const glm::vec2& size, bool multiline, float fontSize) {
+    if (componentsById_.contains(core::findString(id))) {
         throw std::invalid_argument("Component with ID '" + id + "' already exists");
     }
     
-    rootComponents_.push_back(component);
-    componentsById_[id] = component;
+    auto textField = core::makePooled<TextField>(id, position, size, multiline, fontSize);
+    registerComponent(textField);
+    
+    return textField;
+}
+
+std::shared_ptr<UIComponent> UIManager::loadScreenSource(const std::string& source) {
+    std::vector<uint8_t> image = compileScreen(source);
+    return loadScreen(image.data(), image.size());
+}
+
+std::shared_ptr<UIComponent> UIManager::registerScreen(LoadedScreen& screen) {
+    // Check every id first so a clash leaves the manager untouched
+    for (const auto& component : screen.components) {
+        if (componentsById_.contains(component->getIdSymbol())) {
+            throw std::invalid_argument("Component with ID '" + component->getId() + "' already exists");
+        }
+    }
+    
+    componentsById_.reserve(componentsById_.size() + screen.components.size());
+    for (const auto& component : screen.components) {
+        componentsById_.insert(component->getIdSymbol(), component);
+    }
+    rootComponents_.push_back(screen.root);
+    onRootsChanged(screen.root.get());
+    
+    return screen.root;
+}
+
+void UIManager::unloadScreen(const std::shared_ptr<UIComponent>& root) {
+    if (!root) {
+        return;
+    }
+    
+    // Not eventPath_: this may run from a click callback mid-dispatch
+    std::vector<UIComponent*> pending = {root.get()};
+    while (!pending.empty()) {
+        UIComponent* node = pending.back();
+        pending.pop_back();
+        
+        componentsById_.erase(node->getIdSymbol());
+        for (size_t i = 0; i < node->getChildCount(); i++) {
+            pending.push_back(node->getChild(i));
+        }
+    }
+    
+    rootComponents_.erase(std::remove(rootComponents_.begin(), rootComponents_.end(), root),
+                         rootComponents_.end());
+    onRootsChanged(root.get());
 }
 
 void UIManager::removeComponent(const std::string& id) {
-    auto it = componentsById_.find(id);
-    if (it != componentsById_.end()) {
-        auto component = it->second;
+    removeComponent(core::findString(id));
+}
+
+void UIManager::removeComponent(core::StringId id) {
+    std::shared_ptr<UIComponent>* found = componentsById_.find(id);
+    if (found) {
+        auto component = *found;
         rootComponents_.erase(std::remove(rootComponents_.begin(), rootComponents_.end(), component),
                              rootComponents_.end());
+        onRootsChanged(component.get());
         
-        componentsById_.erase(it);
+        componentsById_.erase(id);
     }
 }
 
 std::shared_ptr<UIComponent> UIManager::getComponent(const std::string& id) {
-    auto it = componentsById_.find(id);
-    if (it != componentsById_.end()) {
-        return it->second;
-    }
-    return nullptr;
+    return getComponent(core::findString(id));
+}
+
+std::shared_ptr<UIComponent> UIManager::getComponent(core::StringId id) {
+    std::shared_ptr<UIComponent>* found = componentsById_.find(id);
+    return found ? *found : nullptr;
+}
+
+void UIManager::registerComponent(const std::shared_ptr<UIComponent>& component) {
+    rootComponents_.push_back(component);
+    onRootsChanged(component.get());
+    componentsById_.insert(component->getIdSymbol(), component);
 }
 
 void UIManager::onMouseMove(double x, double y) {
     lastMousePos_ = glm::vec2(x, y);
+    immediate_.setMousePosition(lastMousePos_);
+    pointerMoved_ = true;
+    pendingFrameStats_.rawPointerEvents++;
     
-    for (auto& component : rootComponents_) {
-        if (auto button = std::dynamic_pointer_cast<Button>(component)) {
-            button->onMouseMove(lastMousePos_);
+    if (hoverSet_.empty()) {
+        return;
+    }
+    
+    UIComponent* hovered = getUIRegistry().owner(hoverSet_.front());
+    if (hovered && hovered->hasCapability(UICapabilities::RAW_POINTER) && hovered->containsPoint(lastMousePos_)) {
+        UIEvent event;
+        event.type = UIEventType::MOUSE_MOVE;
+        event.position = lastMousePos_;
+        dispatchEvent(event, hovered);
+    }
+}
+
+void UIManager::refreshStyles(UIComponent& component) {
+    component.refreshStyle();
+    for (size_t i = 0; i < component.getChildCount(); i++) {
+        refreshStyles(*component.getChild(i));
+    }
+}
+
+void UIManager::resolveHover() {
+    // Retained widgets under an immediate window are covered by it
+    UIComponent* target = immediate_.wantsMouse(lastMousePos_) ? nullptr : findComponentAt(lastMousePos_);
+    
+    nextHoverSet_.clear();
+    for (UIComponent* node = target; node; node = node->getParent()) {
+        nextHoverSet_.push_back(node->getHandle());
+    }
+    
+    UIRegistry& registry = getUIRegistry();
+    
+    if (nextHoverSet_ != hoverSet_) {
+        // Only components whose hover state flipped are told: leaves go out
+        // deepest first, enters arrive outermost first
+        for (UIHandle handle : hoverSet_) {
+            UIComponent* component = registry.owner(handle);
+            if (component && std::find(nextHoverSet_.begin(), nextHoverSet_.end(), handle) == nextHoverSet_.end()) {
+                UIEvent leave;
+                leave.type = UIEventType::MOUSE_LEAVE;
+                leave.position = lastMousePos_;
+                leave.target = component;
+                component->onEvent(leave);
+                component->markRenderDirty();
+                pendingFrameStats_.hoverTransitions++;
+            }
+        }
+        
+        for (auto it = nextHoverSet_.rbegin(); it != nextHoverSet_.rend(); ++it) {
+            if (std::find(hoverSet_.begin(), hoverSet_.end(), *it) == hoverSet_.end()) {
+                UIComponent* component = registry.owner(*it);
+                UIEvent enter;
+                enter.type = UIEventType::MOUSE_ENTER;
+                enter.position = lastMousePos_;
+                enter.target = component;
+                component->onEvent(enter);
+                component->markRenderDirty();
+                pendingFrameStats_.hoverTransitions++;
+            }
         }
+        
+        hoverSet_.swap(nextHoverSet_);
+    }
+    
+    if (!pointerMoved_) {
+        return;
+    }
+    pointerMoved_ = false;
+    pendingFrameStats_.coalescedPointerEvents++;
+    
+    // Raw-pointer targets already saw this position from onMouseMove
+    if (target && !target->hasCapability(UICapabilities::RAW_POINTER)) {
+        UIEvent event;
+        event.type = UIEventType::MOUSE_MOVE;
+        event.position = lastMousePos_;
+        dispatchEvent(event, target);
     }
 }
 
-void UIManager::onMouseButton(int button, int action, int mods, double x, double y) {
+bool UIManager::onMouseButton(int button, int action, int mods, double x, double y) {
     lastMousePos_ = glm::vec2(x, y);
     
-    for (auto& component : rootComponents_) {
-        if (auto btn = std::dynamic_pointer_cast<Button>(component)) {
-            btn->onMouseButton(button, action, lastMousePos_);
+    UIEvent event;
+    event.type = UIEventType::MOUSE_BUTTON;
+    event.position = lastMousePos_;
+    event.button = button;
+    event.action = action;
+    event.mods = mods;
+    
+    immediate_.setMousePosition(lastMousePos_);
+    bool immediateWants = immediate_.wantsMouse(lastMousePos_);
+    if (button == GLFW_MOUSE_BUTTON_LEFT && action != GLFW_REPEAT) {
+        immediate_.setMouseButton(action == GLFW_PRESS);
+    }
+    
+    if (action == GLFW_RELEASE) {
+        // Releases go to whoever took the press, so a press that started over
+        // gameplay is never swallowed by a widget it ends over
+        std::shared_ptr<UIComponent> captured = capturedComponent_.lock();
+        capturedComponent_.reset();
+        return captured ? dispatchEvent(event, captured.get()) : immediateWants;
+    }
+    
+    // The immediate overlay draws last, so it gets the first claim on presses
+    if (immediateWants) {
+        return true;
+    }
+    
+    UIComponent* target = findComponentAt(lastMousePos_);
+    if (action == GLFW_PRESS) {
+        UIComponent* focusTarget = target;
+        while (focusTarget && !focusTarget->hasCapability(UICapabilities::KEYBOARD | UICapabilities::FOCUSABLE)) {
+            focusTarget = focusTarget->getParent();
         }
+        setFocus(focusTarget);
+    }
+    
+    if (!target) {
+        return false;
+    }
+    
+    if (action == GLFW_PRESS) {
+        capturedComponent_ = target->weak_from_this();
+    }
+    
+    return dispatchEvent(event, target);
+}
+
+bool UIManager::onScroll(double xoffset, double yoffset) {
+    if (immediate_.wantsMouse(lastMousePos_)) {
+        return true;
+    }
+    
+    UIComponent* target = findComponentAt(lastMousePos_);
+    if (!target) {
+        return false;
+    }
+    
+    UIEvent event;
+    event.type = UIEventType::SCROLL;
+    event.position = lastMousePos_;
+    event.scroll = glm::vec2(xoffset, yoffset);
+    
+    return dispatchEvent(event, target);
+}
+
+bool UIManager::onKey(int key, int scancode, int action, int mods) {
+    std::shared_ptr<UIComponent> focused = focusedComponent_.lock();
+    if (!focused || !focused->isVisible()) {
+        return false;
+    }
+    
+    UIEvent event;
+    event.type = UIEventType::KEY;
+    event.key = key;
+    event.action = action;
+    event.mods = mods;
+    
+    return dispatchEvent(event, focused.get());
+}
+
+bool UIManager::onChar(unsigned int codepoint) {
+    std::shared_ptr<UIComponent> focused = focusedComponent_.lock();
+    if (!focused || !focused->isVisible()) {
+        return false;
+    }
+    
+    UIEvent event;
+    event.type = UIEventType::CHAR;
+    event.codepoint = codepoint;
+    
+    return dispatchEvent(event, focused.get());
+}
+
+void UIManager::setFocus(UIComponent* component) {
+    std::shared_ptr<UIComponent> previous = focusedComponent_.lock();
+    if (previous.get() == component) {
+        return;
+    }
+    
+    focusedComponent_ = component ? component->weak_from_this() : std::weak_ptr<UIComponent>();
+    
+    if (previous) {
+        UIEvent event;
+        event.type = UIEventType::FOCUS_LOST;
+        event.target = previous.get();
+        previous->onEvent(event);
+    }
+    
+    if (component) {
+        UIEvent event;
+        event.type = UIEventType::FOCUS_GAINED;
+        event.target = component;
+        component->onEvent(event);
     }
 }
 
-void UIManager::onKey(int key, int scancode, int action, int mods) {
+bool UIManager::moveFocus(FocusDirection direction) {
+    std::shared_ptr<UIComponent> focused = focusedComponent_.lock();
+    UIComponent* next = nullptr;
+    if (focused && focused->isVisible()) {
+        next = focus_.findNeighbor(*focused, direction);
+    } else if (navigationMode_) {
+        next = focus_.findFirst();
+    }
+    
+    if (!next) {
+        return false;
+    }
+    setFocus(next);
+    return true;
 }
 
-void UIManager::onChar(unsigned int codepoint) {
+bool UIManager::activateFocused() {
+    std::shared_ptr<UIComponent> focused = focusedComponent_.lock();
+    if (!focused || !focused->isVisible()) {
+        return false;
+    }
+    return focused->activate();
+}
+
+void UIManager::bindNavigationActions(input::InputMapping& mapping) {
+    unbindNavigationActions();
+    navigationMapping_ = &mapping;
+    
+    const std::pair<const char*, FocusDirection> moves[] = {
+        {NavigationActions::LEFT, FocusDirection::LEFT},
+        {NavigationActions::RIGHT, FocusDirection::RIGHT},
+        {NavigationActions::UP, FocusDirection::UP},
+        {NavigationActions::DOWN, FocusDirection::DOWN}
+    };
+    for (const auto& move : moves) {
+        FocusDirection direction = move.second;
+        navigationCallbacks_.push_back(mapping.addActionCallback(move.first,
+            [this, direction](const std::string&, const input::ActionState& state) {
+                if (state.justActivated) {
+                    moveFocus(direction);
+                }
+            }));
+    }
+    
+    navigationCallbacks_.push_back(mapping.addActionCallback(NavigationActions::ACCEPT,
+        [this](const std::string&, const input::ActionState& state) {
+            if (state.justActivated) {
+                activateFocused();
+            }
+        }));
+}
+
+void UIManager::unbindNavigationActions() {
+    if (navigationMapping_) {
+        for (int id : navigationCallbacks_) {
+            navigationMapping_->removeActionCallback(id);
+        }
+    }
+    navigationMapping_ = nullptr;
+    navigationCallbacks_.clear();
+}
+
+void UIManager::bindDefaultNavigationInputs(input::InputMapping& mapping) {
+    mapping.bindKeyToAction(NavigationActions::LEFT, GLFW_KEY_LEFT);
+    mapping.bindKeyToAction(NavigationActions::RIGHT, GLFW_KEY_RIGHT);
+    mapping.bindKeyToAction(NavigationActions::UP, GLFW_KEY_UP);
+    mapping.bindKeyToAction(NavigationActions::DOWN, GLFW_KEY_DOWN);
+    mapping.bindKeyToAction(NavigationActions::ACCEPT, GLFW_KEY_ENTER);
+    mapping.bindKeyToAction(NavigationActions::ACCEPT, GLFW_KEY_KP_ENTER);
+    mapping.bindKeyToAction(NavigationActions::ACCEPT, GLFW_KEY_SPACE);
+    
+    mapping.bindGamepadButtonToAction(NavigationActions::LEFT, GLFW_GAMEPAD_BUTTON_DPAD_LEFT);
+    mapping.bindGamepadButtonToAction(NavigationActions::RIGHT, GLFW_GAMEPAD_BUTTON_DPAD_RIGHT);
+    mapping.bindGamepadButtonToAction(NavigationActions::UP, GLFW_GAMEPAD_BUTTON_DPAD_UP);
+    mapping.bindGamepadButtonToAction(NavigationActions::DOWN, GLFW_GAMEPAD_BUTTON_DPAD_DOWN);
+    mapping.bindGamepadButtonToAction(NavigationActions::ACCEPT, GLFW_GAMEPAD_BUTTON_A);
 }
 
 void UIManager::setScreenSize(int width, int height) {
@@ -168,20 +758,64 @@ void UIManager::setScreenSize(int width, int height) {
     screenHeight_ = height;
 }
 
-std::shared_ptr<UIComponent> UIManager::findComponentAt(const glm::vec2& point) {
-    for (auto it = rootComponents_.rbegin(); it != rootComponents_.rend(); ++it) {
-        auto component = *it;
-        
-        if (auto button = std::dynamic_pointer_cast<Button>(component)) {
-            if (button->isVisible() && button->isPointInside(point)) {
-                return button;
+UIComponent* UIManager::findComponentAt(const glm::vec2& point) {
+    // Topmost first, matching what is on screen
+    updateDrawOrder();
+    for (auto it = drawOrder_.rbegin(); it != drawOrder_.rend(); ++it) {
+        if (!it->parented) {
+            if (UIComponent* hit = it->component->hitTest(point)) {
+                return hit;
             }
         }
-        
     }
     
     return nullptr;
 }
 
+bool UIManager::dispatchEvent(UIEvent& event, UIComponent* target) {
+    eventPath_.clear();
+    for (UIComponent* node = target; node; node = node->getParent()) {
+        eventPath_.push_back(node);
+    }
+    
+    event.target = target;
+    // Whatever the handlers change is redrawn with the target's layer. Plain
+    // motion is left out so that moving across a static layer keeps its cache;
+    // handlers that react to it mark themselves.
+    if (event.type != UIEventType::MOUSE_MOVE) {
+        target->markRenderDirty();
+    }
+    
+    event.phase = UIEventPhase::CAPTURE;
+    for (size_t i = eventPath_.size(); i-- > 1;) {
+        UIComponent* node = eventPath_[i];
+        if (node->hasCapability(UICapabilities::POINTER)) {
+            node->onEvent(event);
+            if (event.consumed) {
+                return true;
+            }
+        }
+    }
+    
+    event.phase = UIEventPhase::TARGET;
+    target->onEvent(event);
+    if (event.consumed) {
+        return true;
+    }
+    
+    event.phase = UIEventPhase::BUBBLE;
+    for (size_t i = 1; i < eventPath_.size(); i++) {
+        UIComponent* node = eventPath_[i];
+        if (node->hasCapability(UICapabilities::POINTER)) {
+            node->onEvent(event);
+            if (event.consumed) {
+                return true;
+            }
+        }
+    }
+    
+    return false;
+}
+
 } // namespace ui
-} // namespace voidengine 
\ No newline at end of file
+} // namespace voidengine
@@ -4,10 +4,19 @@
 #include "Panel.h"
 #include "Button.h"
 #include "Text.h"
+#include "TextField.h"
+#include "DrawList.h"
+#include "ScreenLoader.h"
+#include "ImmediateUI.h"
+#include "FocusManager.h"
+#include "../core/FlatHashMap.h"
+#include "../core/StringId.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
-#include <unordered_map>
 #include <glm/glm.hpp>
 
 namespace voidengine {
@@ -16,49 +25,214 @@ namespace window {
     class Window;
 }
 
+namespace input {
+    class InputMapping;
+}
+
 namespace ui {
 
+// Heap traffic caused by one frame of UI update and render. Stays zero unless
+// the engine is built with VOIDENGINE_TRACK_ALLOCATIONS.
+struct UIFrameStats {
+    uint64_t heapAllocations = 0;
+    uint64_t heapBytes = 0;
+    // Cursor callbacks received versus hover resolutions that acted on them
+    uint32_t rawPointerEvents = 0;
+    uint32_t coalescedPointerEvents = 0;
+    // MOUSE_ENTER plus MOUSE_LEAVE notifications sent
+    uint32_t hoverTransitions = 0;
+    // Render layers whose geometry was re-recorded, and draw calls submitted
+    uint32_t layerRebuilds = 0;
+    uint32_t drawBatches = 0;
+    // Bindings re-run because something they read changed
+    uint32_t bindingRuns = 0;
+};
+
+// Input-mapping actions read by bindNavigationActions
+namespace NavigationActions {
+    constexpr const char* LEFT = "ui_left";
+    constexpr const char* RIGHT = "ui_right";
+    constexpr const char* UP = "ui_up";
+    constexpr const char* DOWN = "ui_down";
+    constexpr const char* ACCEPT = "ui_accept";
+}
+
 class UIManager {
 public:
     explicit UIManager(window::Window* window);
+    // Headless: no window and no GL calls. Input comes from the caller, e.g.
+    // through UIAutomation, and render() draws nothing but still closes the
+    // immediate-mode frame and publishes the frame stats.
+    UIManager(int width, int height);
     ~UIManager();
     
+    bool isHeadless() const { return window_ == nullptr; }
+    
     void initialize();
+    
+    // Lays out every root, then updates the component trees. When the global
+    // job system has workers, independent subtrees update in parallel. During
+    // update a component may only change its own state and its own subtree:
+    // no creating or destroying components, no adding or removing children
+    // (do that in onLayout), and no calls back into the manager. Setters that
+    // invalidate layout are safe; the invalidation is replayed after the join.
     void update(float deltaTime);
+    // Draws the roots by UILayer, then z-index, then insertion order. Each
+    // layer replays its cached geometry unless one of its roots was marked
+    // with markRenderDirty() or changed layer, z-index or membership. Roots
+    // that sit inside another component are drawn by it.
     void render();
     
+    // The overloads without colors take them from the style sheet; the others
+    // override it for that component
+    std::shared_ptr<Panel> createPanel(const std::string& id, const glm::vec2& position, const glm::vec2& size);
     std::shared_ptr<Panel> createPanel(const std::string& id, const glm::vec2& position, const glm::vec2& size,
-                                       const glm::vec4& backgroundColor = glm::vec4(0.2f, 0.2f, 0.2f, 0.8f));
+                                       const glm::vec4& backgroundColor);
     
     std::shared_ptr<Button> createButton(const std::string& id, const glm::vec2& position, const glm::vec2& size,
                                          const std::string& text = "", 
                                          const Button::ButtonCallback& onClick = nullptr);
     
     std::shared_ptr<Text> createText(const std::string& id, const glm::vec2& position, const std::string& text = "",
-                                     float fontSize = 12.0f, 
-                                     const glm::vec4& color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+                                     float fontSize = 12.0f);
+    std::shared_ptr<Text> createText(const std::string& id, const glm::vec2& position, const std::string& text,
+                                     float fontSize, const glm::vec4& color);
+    
+    std::shared_ptr<TextField> createTextField(const std::string& id, const glm::vec2& position,
+                                               const glm::vec2& size, bool multiline = false,
+                                               float fontSize = 16.0f);
+    
+    // Instantiates a compiled .vui screen, adds its root and registers every
+    // node by id so callbacks can be bound after loading
+    std::shared_ptr<UIComponent> loadScreen(const std::string& path);
+    std::shared_ptr<UIComponent> loadScreen(const uint8_t* data, size_t size);
+    // Compiles a text description at runtime; meant for iterating on screens
+    std::shared_ptr<UIComponent> loadScreenSource(const std::string& source);
+    // Removes a loaded root and unregisters every id in its subtree
+    void unloadScreen(const std::shared_ptr<UIComponent>& root);
     
     void addComponent(std::shared_ptr<UIComponent> component);
     void removeComponent(const std::string& id);
+    // The symbol overloads take an interned id, as from findString() or
+    // getIdSymbol(); a hashed one misses ids that collided
+    void removeComponent(core::StringId id);
     std::shared_ptr<UIComponent> getComponent(const std::string& id);
+    std::shared_ptr<UIComponent> getComponent(core::StringId id);
     
+    // Only records the position; hover is resolved once per update() against
+    // the latest one. Components with UICapabilities::RAW_POINTER still get
+    // each sample as it arrives.
     void onMouseMove(double x, double y);
-    void onMouseButton(int button, int action, int mods, double x, double y);
-    void onKey(int key, int scancode, int action, int mods);
-    void onChar(unsigned int codepoint);
+    bool onMouseButton(int button, int action, int mods, double x, double y);
+    bool onScroll(double xoffset, double yoffset);
+    // Keyboard input goes to the focused component; both return whether the
+    // UI consumed it, in which case gameplay input should not see it
+    bool onKey(int key, int scancode, int action, int mods);
+    bool onChar(unsigned int codepoint);
+    
+    // Focus moves to the nearest KEYBOARD or FOCUSABLE ancestor of a clicked
+    // component, or is cleared by a click elsewhere. Null clears it.
+    void setFocus(UIComponent* component);
+    UIComponent* getFocusedComponent() const { return focusedComponent_.lock().get(); }
+    
+    // Moves focus to the nearest FOCUSABLE component that way. With nothing
+    // focused it takes the top-left one only in navigation mode, so arrow keys
+    // meant for gameplay do not hand focus to a button. False when focus did
+    // not move.
+    bool moveFocus(FocusDirection direction);
+    // Activates the focused component as if it were clicked
+    bool activateFocused();
+    // Explicit neighbors are set here
+    FocusManager& getFocusManager() { return focus_; }
+    
+    // Drives moveFocus and activateFocused from the NavigationActions of the
+    // mapping, which must outlive the manager or be unbound first
+    void bindNavigationActions(input::InputMapping& mapping);
+    void unbindNavigationActions();
+    // Arrow keys, Enter, Space and the gamepad d-pad and A button
+    static void bindDefaultNavigationInputs(input::InputMapping& mapping);
+    // Off by default; the app turns it on while a menu is meant to be driven
+    // from the keyboard or a gamepad
+    void setNavigationMode(bool enabled) { navigationMode_ = enabled; }
+    bool isNavigationMode() const { return navigationMode_; }
     
     void setScreenSize(int width, int height);
     
+    void setParallelUpdate(bool enabled) { parallelUpdate_ = enabled; }
+    bool isParallelUpdate() const { return parallelUpdate_; }
+    
+    // Immediate-mode overlay drawn on top of the retained components; its
+    // frame is submitted between render() calls
+    ImmediateUI& getImmediateUI() { return immediate_; }
+    
+    // Stats of the last completed frame, published by render()
+    const UIFrameStats& getFrameStats() const { return frameStats_; }
+    
 private:
     window::Window* window_;
     std::vector<std::shared_ptr<UIComponent>> rootComponents_;
-    std::unordered_map<std::string, std::shared_ptr<UIComponent>> componentsById_;
+    core::FlatHashMap<core::StringId, std::shared_ptr<UIComponent>> componentsById_;
     
     int screenWidth_;
     int screenHeight_;
     glm::vec2 lastMousePos_;
     
-    std::shared_ptr<UIComponent> findComponentAt(const glm::vec2& point);
+    // Hovered component and its ancestors, deepest first
+    std::vector<UIHandle> hoverSet_;
+    std::vector<UIHandle> nextHoverSet_;
+    bool pointerMoved_ = false;
+    std::weak_ptr<UIComponent> capturedComponent_;
+    std::weak_ptr<UIComponent> focusedComponent_;
+    std::vector<UIComponent*> eventPath_;
+    
+    FocusManager focus_{rootComponents_};
+    input::InputMapping* navigationMapping_ = nullptr;
+    std::vector<int> navigationCallbacks_;
+    bool navigationMode_ = false;
+    
+    struct DrawEntry {
+        UIComponent* component;
+        UILayer layer;
+        int zIndex;
+        // Index in rootComponents_ when the order was built; breaks ties
+        uint32_t sequence;
+        bool parented;
+    };
+    
+    struct LayerCache {
+        DrawList drawList;
+        bool dirty = true;
+    };
+    
+    std::vector<DrawEntry> drawOrder_;
+    bool drawOrderDirty_ = true;
+    std::array<LayerCache, static_cast<size_t>(UILayer::COUNT)> layers_;
+    
+    // Style generation the managed trees were last resolved against
+    uint32_t styleGeneration_ = 0;
+    
+    ImmediateUI immediate_;
+    
+    UIFrameStats frameStats_;
+    UIFrameStats pendingFrameStats_;
+    
+    bool parallelUpdate_ = true;
+    std::vector<UIComponent*> updateUnits_;
+    std::vector<UIComponent*> updateUnitsScratch_;
+    std::vector<std::vector<UIComponent*>> deferredLayout_;
+    
+    void resolveHover();
+    void refreshStyles(UIComponent& component);
+    void collectUpdateUnits(size_t targetCount);
+    void renderFrame();
+    void updateDrawOrder();
+    void onRootsChanged(UIComponent* root);
+    
+    void registerComponent(const std::shared_ptr<UIComponent>& component);
+    std::shared_ptr<UIComponent> registerScreen(LoadedScreen& screen);
+    
+    UIComponent* findComponentAt(const glm::vec2& point);
+    bool dispatchEvent(UIEvent& event, UIComponent* target);
 };
 
 } // namespace ui
@@ -0,0 +1,114 @@
+#include "UIRegistry.h"
+#include <stdexcept>
+
+namespace voidengine {
+namespace ui {
+
+std::unique_ptr<UIRegistry> gUIRegistry = nullptr;
+
+UIRegistry& getUIRegistry() {
+    if (!gUIRegistry) {
+        gUIRegistry = std::make_unique<UIRegistry>();
+    }
+    return *gUIRegistry;
+}
+
+UIRegistry::UIRegistry() {
+    // Slot 0 is reserved so that a zero handle is never valid
+    sparse_.push_back(0);
+    generations_.push_back(0);
+}
+
+UIRegistry::~UIRegistry() {
+}
+
+UIHandle UIRegistry::create(UIComponent* owner, const glm::vec2& position, const glm::vec2& size) {
+    uint32_t slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(sparse_.size());
+        if (slot > UIHandle::INDEX_MASK) {
+            throw std::length_error("UI registry is full");
+        }
+        sparse_.push_back(0);
+        generations_.push_back(1);
+    }
+    
+    uint32_t dense = static_cast<uint32_t>(owners_.size());
+    sparse_[slot] = dense;
+    denseToSlot_.push_back(slot);
+    
+    positions_.push_back(position);
+    sizes_.push_back(size);
+    flags_.push_back(UIFlags::VISIBLE | UIFlags::ENABLED | UIFlags::LAYOUT_DIRTY | UIFlags::LAYOUT_STRUCTURE);
+    styles_.emplace_back();
+    layoutParams_.emplace_back();
+    layoutStates_.emplace_back();
+    layoutStates_.back().intrinsicSize = size;
+    owners_.push_back(owner);
+    markSpatialChange();
+    
+    return UIHandle(slot, generations_[slot]);
+}
+
+void UIRegistry::destroy(UIHandle handle) {
+    if (!isAlive(handle)) {
+        return;
+    }
+    
+    uint32_t slot = handle.index();
+    uint32_t dense = sparse_[slot];
+    uint32_t last = static_cast<uint32_t>(owners_.size() - 1);
+    
+    if (dense != last) {
+        positions_[dense] = positions_[last];
+        sizes_[dense] = sizes_[last];
+        flags_[dense] = flags_[last];
+        styles_[dense] = styles_[last];
+        layoutParams_[dense] = layoutParams_[last];
+        layoutStates_[dense] = layoutStates_[last];
+        owners_[dense] = owners_[last];
+        
+        uint32_t movedSlot = denseToSlot_[last];
+        denseToSlot_[dense] = movedSlot;
+        sparse_[movedSlot] = dense;
+    }
+    
+    positions_.pop_back();
+    sizes_.pop_back();
+    flags_.pop_back();
+    styles_.pop_back();
+    layoutParams_.pop_back();
+    layoutStates_.pop_back();
+    owners_.pop_back();
+    denseToSlot_.pop_back();
+    
+    uint32_t generation = (generations_[slot] + 1) & UIHandle::GENERATION_MASK;
+    generations_[slot] = generation == 0 ? 1 : generation;
+    freeSlots_.push_back(slot);
+    markSpatialChange();
+}
+
+bool UIRegistry::isAlive(UIHandle handle) const {
+    uint32_t slot = handle.index();
+    return handle.isValid() && slot < generations_.size() && generations_[slot] == handle.generation();
+}
+
+void UIRegistry::reserve(size_t count) {
+    sparse_.reserve(count + 1);
+    generations_.reserve(count + 1);
+    freeSlots_.reserve(count);
+    denseToSlot_.reserve(count);
+    positions_.reserve(count);
+    sizes_.reserve(count);
+    flags_.reserve(count);
+    styles_.reserve(count);
+    layoutParams_.reserve(count);
+    layoutStates_.reserve(count);
+    owners_.reserve(count);
+}
+
+} // namespace ui
+} // namespace voidengine
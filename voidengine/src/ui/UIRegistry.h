@@ -0,0 +1,133 @@
+#pragma once
+
+#include "Layout.h"
+#include <glm/glm.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <memory>
+
+namespace voidengine {
+namespace ui {
+
+class UIComponent;
+
+// 32-bit generational handle: the low bits index a slot, the high bits hold the
+// slot's generation so stale handles to recycled slots are detected. A value of
+// zero is never issued and marks an invalid handle.
+struct UIHandle {
+    static constexpr uint32_t INDEX_BITS = 20;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+    
+    uint32_t value = 0;
+    
+    UIHandle() = default;
+    UIHandle(uint32_t index, uint32_t generation) : value((generation << INDEX_BITS) | index) {}
+    
+    uint32_t index() const { return value & INDEX_MASK; }
+    uint32_t generation() const { return value >> INDEX_BITS; }
+    bool isValid() const { return value != 0; }
+    
+    bool operator==(const UIHandle& other) const { return value == other.value; }
+    bool operator!=(const UIHandle& other) const { return value != other.value; }
+};
+
+namespace UIFlags {
+    constexpr uint8_t VISIBLE = 1u << 0;
+    constexpr uint8_t ENABLED = 1u << 1;
+    constexpr uint8_t BORDER = 1u << 2;
+    constexpr uint8_t LAYOUT_DIRTY = 1u << 3;
+    // Children were added or removed, or the node's own layout params or
+    // child mapping changed; the next pass rescans every child
+    constexpr uint8_t LAYOUT_STRUCTURE = 1u << 4;
+    // Listed in the parent's LayoutState::dirtyChildren
+    constexpr uint8_t LAYOUT_QUEUED = 1u << 5;
+}
+
+struct UIStyle {
+    glm::vec4 backgroundColor = glm::vec4(0.2f, 0.2f, 0.2f, 0.8f);
+    glm::vec4 borderColor = glm::vec4(0.8f, 0.8f, 0.8f, 1.0f);
+    glm::vec4 textColor = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+    glm::vec4 shadowColor = glm::vec4(0.0f, 0.0f, 0.0f, 0.5f);
+    float borderWidth = 1.0f;
+    float borderRadius = 0.0f;
+    float shadowBlur = 0.0f;
+};
+
+// Structure-of-arrays storage for the hot per-widget state. Each column is a
+// packed array indexed by the same dense index, so a pass over one property
+// touches contiguous memory. Removal swaps the last element into the hole and
+// keeps the columns packed. Not thread-safe: create and destroy belong on the
+// main thread, while writes to existing entries may come from anywhere that
+// owns the entry.
+class UIRegistry {
+public:
+    UIRegistry();
+    ~UIRegistry();
+    
+    UIHandle create(UIComponent* owner, const glm::vec2& position, const glm::vec2& size);
+    void destroy(UIHandle handle);
+    bool isAlive(UIHandle handle) const;
+    
+    void reserve(size_t count);
+    size_t size() const { return owners_.size(); }
+    
+    glm::vec2& position(UIHandle handle) { return positions_[denseIndex(handle)]; }
+    const glm::vec2& position(UIHandle handle) const { return positions_[denseIndex(handle)]; }
+    
+    glm::vec2& size(UIHandle handle) { return sizes_[denseIndex(handle)]; }
+    const glm::vec2& size(UIHandle handle) const { return sizes_[denseIndex(handle)]; }
+    
+    uint8_t& flags(UIHandle handle) { return flags_[denseIndex(handle)]; }
+    uint8_t flags(UIHandle handle) const { return flags_[denseIndex(handle)]; }
+    
+    UIStyle& style(UIHandle handle) { return styles_[denseIndex(handle)]; }
+    const UIStyle& style(UIHandle handle) const { return styles_[denseIndex(handle)]; }
+    
+    LayoutParams& layoutParams(UIHandle handle) { return layoutParams_[denseIndex(handle)]; }
+    const LayoutParams& layoutParams(UIHandle handle) const { return layoutParams_[denseIndex(handle)]; }
+    
+    LayoutState& layoutState(UIHandle handle) { return layoutStates_[denseIndex(handle)]; }
+    const LayoutState& layoutState(UIHandle handle) const { return layoutStates_[denseIndex(handle)]; }
+    
+    UIComponent* owner(UIHandle handle) const { return isAlive(handle) ? owners_[denseIndex(handle)] : nullptr; }
+    
+    const glm::vec2* positions() const { return positions_.data(); }
+    const glm::vec2* sizes() const { return sizes_.data(); }
+    const uint8_t* flags() const { return flags_.data(); }
+    const UIStyle* styles() const { return styles_.data(); }
+    UIComponent* const* owners() const { return owners_.data(); }
+    
+    // Bumped whenever a component is created, destroyed, moved, resized,
+    // re-parented, shown, hidden, enabled or disabled, so spatial indexes can
+    // tell when they are stale. Safe from any thread.
+    void markSpatialChange() { spatialVersion_.fetch_add(1, std::memory_order_relaxed); }
+    uint32_t getSpatialVersion() const { return spatialVersion_.load(std::memory_order_relaxed); }
+    
+private:
+    uint32_t denseIndex(UIHandle handle) const { return sparse_[handle.index()]; }
+    
+    std::vector<uint32_t> sparse_;
+    std::vector<uint32_t> generations_;
+    std::vector<uint32_t> freeSlots_;
+    std::vector<uint32_t> denseToSlot_;
+    
+    std::vector<glm::vec2> positions_;
+    std::vector<glm::vec2> sizes_;
+    std::vector<uint8_t> flags_;
+    std::vector<UIStyle> styles_;
+    std::vector<LayoutParams> layoutParams_;
+    std::vector<LayoutState> layoutStates_;
+    std::vector<UIComponent*> owners_;
+    
+    std::atomic<uint32_t> spatialVersion_{0};
+};
+
+extern std::unique_ptr<UIRegistry> gUIRegistry;
+
+UIRegistry& getUIRegistry();
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,347 @@
+#include "UIRenderer.h"
+#include "DrawList.h"
+#include "FontRenderer.h"
+#include "ShapeTessellator.h"
+#include "TextLayout.h"
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include <GLFW/glfw3.h>
+
+namespace voidengine {
+namespace ui {
+
+namespace {
+
+// Width of the anti-aliasing fringe on shape edges
+constexpr float SHAPE_FRINGE = 1.0f;
+
+DrawList* gRecordingList = nullptr;
+
+// Clip rects applied to GL directly when nothing is recording
+std::vector<glm::vec4> gClipStack;
+
+bool hasFont() {
+    return gFontRenderer && gFontRenderer->isFontLoaded();
+}
+
+void applyScissor(const glm::vec4& clip) {
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(static_cast<GLint>(clip.x),
+              static_cast<GLint>(viewport[3] - (clip.y + clip.w)),
+              static_cast<GLsizei>(clip.z),
+              static_cast<GLsizei>(clip.w));
+}
+
+void drawShape(const ShapeMesh& mesh, const glm::vec2& offset, const glm::vec4& color) {
+    if (gRecordingList) {
+        gRecordingList->addShape(mesh, offset, color);
+        return;
+    }
+    if (mesh.vertices.empty()) {
+        return;
+    }
+    
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    
+    glBegin(GL_QUADS);
+    for (const ShapeVertex& vertex : mesh.vertices) {
+        glColor4f(color.r, color.g, color.b, color.a * vertex.coverage);
+        glVertex2f(offset.x + vertex.position.x, offset.y + vertex.position.y);
+    }
+    glEnd();
+}
+
+} // namespace
+
+void drawRect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) {
+    if (gRecordingList) {
+        gRecordingList->addRect(position, size, color);
+        return;
+    }
+    
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    
+    glColor4f(color.r, color.g, color.b, color.a);
+    glBegin(GL_QUADS);
+    glVertex2f(position.x, position.y);
+    glVertex2f(position.x + size.x, position.y);
+    glVertex2f(position.x + size.x, position.y + size.y);
+    glVertex2f(position.x, position.y + size.y);
+    glEnd();
+}
+
+void drawRectOutline(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, float width) {
+    if (gRecordingList) {
+        gRecordingList->addRectOutline(position, size, color, width);
+        return;
+    }
+    
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    
+    glColor4f(color.r, color.g, color.b, color.a);
+    glLineWidth(width);
+    glBegin(GL_LINE_LOOP);
+    glVertex2f(position.x, position.y);
+    glVertex2f(position.x + size.x, position.y);
+    glVertex2f(position.x + size.x, position.y + size.y);
+    glVertex2f(position.x, position.y + size.y);
+    glEnd();
+}
+
+void drawRoundedRect(const glm::vec2& position, const glm::vec2& size, float radius, const glm::vec4& color) {
+    drawShape(getShapeCache().getRoundedRect(size, radius, SHAPE_FRINGE), position, color);
+}
+
+void drawRoundedRectOutline(const glm::vec2& position, const glm::vec2& size, float radius, const glm::vec4& color,
+                            float width) {
+    drawShape(getShapeCache().getRoundedRectStroke(size, radius, width, SHAPE_FRINGE), position, color);
+}
+
+void drawShadow(const glm::vec2& position, const glm::vec2& size, float radius, float blur, const glm::vec4& color) {
+    drawShape(getShapeCache().getRoundedRect(size, radius, std::max(blur, SHAPE_FRINGE)), position, color);
+}
+
+void drawArc(const glm::vec2& center, float radius, float startAngle, float endAngle, const glm::vec4& color,
+             float width) {
+    drawShape(getShapeCache().getArc(radius, startAngle, endAngle, width, SHAPE_FRINGE), center, color);
+}
+
+void drawNineSlice(const glm::vec2& position, const glm::vec2& size, unsigned int texture, const AtlasRegion& region,
+                   const glm::vec4& color) {
+    if (gRecordingList) {
+        gRecordingList->addNineSlice(position, size, texture, region, color);
+        return;
+    }
+    
+    const NineSliceGrid grid = computeNineSliceGrid(position, size, region);
+    
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    
+    glColor4f(color.r, color.g, color.b, color.a);
+    glBegin(GL_QUADS);
+    for (int row = 0; row < 3; row++) {
+        for (int column = 0; column < 3; column++) {
+            glTexCoord2f(grid.u[column], grid.v[row]);
+            glVertex2f(grid.x[column], grid.y[row]);
+            glTexCoord2f(grid.u[column + 1], grid.v[row]);
+            glVertex2f(grid.x[column + 1], grid.y[row]);
+            glTexCoord2f(grid.u[column + 1], grid.v[row + 1]);
+            glVertex2f(grid.x[column + 1], grid.y[row + 1]);
+            glTexCoord2f(grid.u[column], grid.v[row + 1]);
+            glVertex2f(grid.x[column], grid.y[row + 1]);
+        }
+    }
+    glEnd();
+    
+    glDisable(GL_TEXTURE_2D);
+}
+
+void drawText(const char* text, size_t length, const glm::vec2& position, float fontSize, const glm::vec4& color) {
+    if (length == 0) {
+        return;
+    }
+    
+    if (hasFont()) {
+        if (gRecordingList) {
+            gFontRenderer->appendText(*gRecordingList, text, length, position.x, position.y,
+                                      fontSize / FONT_BASE_SIZE, color);
+        } else {
+            gFontRenderer->renderText(text, length, position.x, position.y, fontSize / FONT_BASE_SIZE, color);
+        }
+        return;
+    }
+    
+    if (gRecordingList) {
+        float x = position.x;
+        float y = position.y;
+        for (size_t i = 0; i < length; i++) {
+            if (text[i] == '\n') {
+                x = position.x;
+                y += fontSize;
+                continue;
+            }
+            gRecordingList->addRect(glm::vec2(x, y), glm::vec2(fontSize * 0.75f, fontSize), color);
+            x += fontSize;
+        }
+        return;
+    }
+    
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glColor4f(color.r, color.g, color.b, color.a);
+    
+    float x = position.x;
+    float y = position.y;
+    
+    for (size_t i = 0; i < length; i++) {
+        if (text[i] == '\n') {
+            x = position.x;
+            y += fontSize;
+            continue;
+        }
+        
+        glBegin(GL_QUADS);
+        glVertex2f(x, y);
+        glVertex2f(x + fontSize * 0.75f, y);
+        glVertex2f(x + fontSize * 0.75f, y + fontSize);
+        glVertex2f(x, y + fontSize);
+        glEnd();
+        
+        x += fontSize;
+    }
+}
+
+glm::vec2 measureText(const char* text, size_t length, float fontSize) {
+    if (hasFont()) {
+        return gFontRenderer->getTextDimensions(text, length, fontSize / FONT_BASE_SIZE);
+    }
+    
+    size_t longestLine = 0;
+    size_t lineLength = 0;
+    size_t lineCount = 1;
+    
+    for (size_t i = 0; i < length; i++) {
+        if (text[i] == '\n') {
+            longestLine = std::max(longestLine, lineLength);
+            lineLength = 0;
+            lineCount++;
+        } else {
+            lineLength++;
+        }
+    }
+    longestLine = std::max(longestLine, lineLength);
+    
+    return glm::vec2(static_cast<float>(longestLine) * fontSize, static_cast<float>(lineCount) * fontSize);
+}
+
+void layoutText(const char* text, size_t length, float fontSize, TextRun& run) {
+    run.glyphs.clear();
+    run.size = measureText(text, length, fontSize);
+    if (length == 0) {
+        return;
+    }
+    
+    if (hasFont()) {
+        gFontRenderer->layoutText(text, length, fontSize / FONT_BASE_SIZE, run.glyphs);
+        return;
+    }
+    
+    // The same boxes drawText falls back to
+    float x = 0.0f;
+    float y = 0.0f;
+    for (size_t i = 0; i < length; i++) {
+        if (text[i] == '\n') {
+            x = 0.0f;
+            y += fontSize;
+            continue;
+        }
+        run.glyphs.push_back(GlyphQuad{glm::vec2(x, y), glm::vec2(fontSize * 0.75f, fontSize), 0});
+        x += fontSize;
+    }
+}
+
+void drawTextRun(const TextRun& run, const glm::vec2& position, const glm::vec4& color, float maxWidth) {
+    if (gRecordingList) {
+        for (const GlyphQuad& glyph : run.glyphs) {
+            if (maxWidth >= 0.0f && glyph.offset.x + glyph.size.x > maxWidth) {
+                continue;
+            }
+            if (glyph.texture) {
+                gRecordingList->addTexturedRect(position + glyph.offset, glyph.size, glyph.texture, color);
+            } else {
+                gRecordingList->addRect(position + glyph.offset, glyph.size, color);
+            }
+        }
+        return;
+    }
+    
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_TEXTURE_BIT);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glColor4f(color.r, color.g, color.b, color.a);
+    
+    for (const GlyphQuad& glyph : run.glyphs) {
+        if (maxWidth >= 0.0f && glyph.offset.x + glyph.size.x > maxWidth) {
+            continue;
+        }
+        
+        const float x0 = position.x + glyph.offset.x;
+        const float y0 = position.y + glyph.offset.y;
+        const float x1 = x0 + glyph.size.x;
+        const float y1 = y0 + glyph.size.y;
+        if (glyph.texture) {
+            glEnable(GL_TEXTURE_2D);
+            glBindTexture(GL_TEXTURE_2D, glyph.texture);
+        } else {
+            glDisable(GL_TEXTURE_2D);
+        }
+        
+        glBegin(GL_QUADS);
+        glTexCoord2f(0.0f, 0.0f); glVertex2f(x0, y0);
+        glTexCoord2f(1.0f, 0.0f); glVertex2f(x1, y0);
+        glTexCoord2f(1.0f, 1.0f); glVertex2f(x1, y1);
+        glTexCoord2f(0.0f, 1.0f); glVertex2f(x0, y1);
+        glEnd();
+    }
+    
+    glPopAttrib();
+}
+
+void pushClipRect(const glm::vec2& position, const glm::vec2& size) {
+    if (gRecordingList) {
+        gRecordingList->pushClipRect(position, size);
+        return;
+    }
+    
+    glm::vec4 clip(position.x, position.y, std::max(size.x, 0.0f), std::max(size.y, 0.0f));
+    if (!gClipStack.empty()) {
+        const glm::vec4& outer = gClipStack.back();
+        float x0 = std::max(clip.x, outer.x);
+        float y0 = std::max(clip.y, outer.y);
+        float x1 = std::min(clip.x + clip.z, outer.x + outer.z);
+        float y1 = std::min(clip.y + clip.w, outer.y + outer.w);
+        clip = glm::vec4(x0, y0, std::max(x1 - x0, 0.0f), std::max(y1 - y0, 0.0f));
+    }
+    
+    gClipStack.push_back(clip);
+    applyScissor(clip);
+}
+
+void popClipRect() {
+    if (gRecordingList) {
+        gRecordingList->popClipRect();
+        return;
+    }
+    
+    if (gClipStack.empty()) {
+        throw std::logic_error("Clip stack underflow");
+    }
+    
+    gClipStack.pop_back();
+    if (gClipStack.empty()) {
+        glDisable(GL_SCISSOR_TEST);
+    } else {
+        applyScissor(gClipStack.back());
+    }
+}
+
+DrawListScope::DrawListScope(DrawList& list) : previous_(gRecordingList) {
+    gRecordingList = &list;
+}
+
+DrawListScope::~DrawListScope() {
+    gRecordingList = previous_;
+}
+
+} // namespace ui
+} // namespace voidengine
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+
+namespace voidengine {
+namespace ui {
+
+struct AtlasRegion;
+class DrawList;
+struct TextRun;
+
+// Glyph textures are rasterized at this pixel size; font sizes scale from it,
+// and text dimensions scale linearly with them
+constexpr float FONT_BASE_SIZE = 32.0f;
+
+// Drawing primitives shared by the retained widgets and the immediate-mode
+// overlay, so both produce identical output. Expect the orthographic
+// projection UIManager::render sets up; main thread only.
+void drawRect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+void drawRectOutline(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, float width = 1.0f);
+
+// Anti-aliased shapes, tessellated once per distinct geometry and cached in
+// the ShapeCache. The outline is centered on the rect's edge; the shadow is
+// the rect with its edge blurred over blur pixels. Arc angles are in radians,
+// clockwise from +x.
+void drawRoundedRect(const glm::vec2& position, const glm::vec2& size, float radius, const glm::vec4& color);
+void drawRoundedRectOutline(const glm::vec2& position, const glm::vec2& size, float radius, const glm::vec4& color,
+                            float width = 1.0f);
+void drawShadow(const glm::vec2& position, const glm::vec2& size, float radius, float blur, const glm::vec4& color);
+void drawArc(const glm::vec2& center, float radius, float startAngle, float endAngle, const glm::vec4& color,
+             float width = 1.0f);
+
+// The region's borders keep their pixel size while the middle stretches to
+// fill the rect. Widgets skinned from one atlas share its texture, so their
+// quads land in one batch.
+void drawNineSlice(const glm::vec2& position, const glm::vec2& size, unsigned int texture, const AtlasRegion& region,
+                   const glm::vec4& color = glm::vec4(1.0f));
+
+// Top-left anchored. Falls back to one box per glyph when no font is loaded.
+void drawText(const char* text, size_t length, const glm::vec2& position, float fontSize, const glm::vec4& color);
+glm::vec2 measureText(const char* text, size_t length, float fontSize);
+
+// Lays text out once for drawing many times; see TextRun. Glyphs that would
+// end past maxWidth are skipped, which cuts text to a cell without a clip rect.
+void layoutText(const char* text, size_t length, float fontSize, TextRun& run);
+void drawTextRun(const TextRun& run, const glm::vec2& position, const glm::vec4& color, float maxWidth = -1.0f);
+
+// Restricts drawing to a window-space rect until the matching pop; nested
+// rects intersect
+void pushClipRect(const glm::vec2& position, const glm::vec2& size);
+void popClipRect();
+
+// While alive, the primitives above append to the list instead of drawing.
+// Scopes nest; the innermost one receives the geometry.
+class DrawListScope {
+public:
+    explicit DrawListScope(DrawList& list);
+    ~DrawListScope();
+    
+    DrawListScope(const DrawListScope&) = delete;
+    DrawListScope& operator=(const DrawListScope&) = delete;
+    
+private:
+    DrawList* previous_;
+};
+
+} // namespace ui
+} // namespace voidengine
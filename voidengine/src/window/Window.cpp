@@ -1,6 +1,7 @@
 #include "Window.h"
 #include "../ui/UIManager.h"
 #include "../ui/FontRenderer.h"
+#include "../core/JobSystem.h"
 #include "../input/Input.h"
 #include <stdexcept>
 #include <filesystem>
@@ -15,17 +16,17 @@ Window::Window(int width, int height, const std::string& title)
     if (!glfwInit()) {
         throw std::runtime_error("Failed to initialize GLFW");
     }
-
+    
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_ANY_PROFILE);
-
+    
     window_ = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
     if (!window_) {
         glfwTerminate();
         throw std::runtime_error("Failed to create GLFW window");
     }
-
+    
     glfwMakeContextCurrent(window_);
     
     glfwSetWindowUserPointer(window_, this);
@@ -67,6 +68,8 @@ Window::Window(int width, int height, const std::string& title)
         std::cerr << "Warning: Failed to load default font. Using fallback rendering." << std::endl;
     }
     
+    core::initializeJobSystem();
+    
     uiManager_ = std::make_unique<ui::UIManager>(this);
     
     // Now set up our callbacks that will handle both UI and input system
@@ -74,8 +77,13 @@ Window::Window(int width, int height, const std::string& title)
 }
 
 Window::~Window() {
+    if (gInputSystem) {
+        gInputSystem->setEventFilter(nullptr);
+    }
     uiManager_.reset();
-
+    
+    core::shutdownJobSystem();
+    
     ui::shutdownFontSystem();
     
     shutdownInputSystem();
@@ -127,43 +135,46 @@ input::InputSystem* Window::getInputSystem() const {
     return gInputSystem.get();
 }
 
+void Window::setUINavigation(bool enabled) {
+    if (enabled == uiNavigation_) {
+        return;
+    }
+    uiNavigation_ = enabled;
+    uiManager_->setNavigationMode(enabled);
+    
+    if (!enabled) {
+        uiManager_->unbindNavigationActions();
+        return;
+    }
+    if (gInputMapping) {
+        // The bindings stay on the mapping once added; without the actions'
+        // callbacks they drive nothing
+        if (!navigationInputsBound_) {
+            ui::UIManager::bindDefaultNavigationInputs(*gInputMapping);
+            navigationInputsBound_ = true;
+        }
+        uiManager_->bindNavigationActions(*gInputMapping);
+    }
+}
+
 void Window::setupCallbacks() {
     // Set the framebuffer callback
     glfwSetFramebufferSizeCallback(window_, framebufferSizeCallback);
     
-    // Set up the mouse move callback to work with both UI and InputSystem
+    // Input callbacks only queue; update() hands each event to the UI first,
+    // in arrival order, and gameplay gets what the UI did not consume
+    if (gInputSystem) {
+        gInputSystem->setEventFilter([this](const input::InputEvent& event) { return routeEventToUI(event); });
+    }
+    
     glfwSetCursorPosCallback(window_, [](GLFWwindow* window, double xpos, double ypos) {
-        // First, call our UI callback
-        Window* windowPtr = static_cast<Window*>(glfwGetWindowUserPointer(window));
-        if (windowPtr && windowPtr->uiManager_) {
-            windowPtr->uiManager_->onMouseMove(xpos, ypos);
-        }
-        
-        // Manually update the input system with the mouse move event
+        // Queued; the input system coalesces samples into one MOUSE_MOVE per update
         if (gInputSystem) {
-            // Set the mouse position directly in the InputSystem
-            gInputSystem->setMousePosition(glm::vec2(xpos, ypos));
-            
-            // Create and dispatch the event
-            input::InputEvent event;
-            event.type = input::EventType::MOUSE_MOVE;
-            event.position = glm::vec2(xpos, ypos);
-            event.delta = glm::vec2(0, 0); // Delta will be calculated in update
-            gInputSystem->processInputEvent(event);
+            gInputSystem->recordMouseMove(glm::vec2(xpos, ypos));
         }
     });
     
-    // Set up the mouse button callback to work with both UI and InputSystem
     glfwSetMouseButtonCallback(window_, [](GLFWwindow* window, int button, int action, int mods) {
-        // First, call our UI callback
-        Window* windowPtr = static_cast<Window*>(glfwGetWindowUserPointer(window));
-        if (windowPtr && windowPtr->uiManager_) {
-            double xpos, ypos;
-            glfwGetCursorPos(window, &xpos, &ypos);
-            windowPtr->uiManager_->onMouseButton(button, action, mods, xpos, ypos);
-        }
-        
-        // Manually update the input system with the mouse button event
         if (gInputSystem) {
             input::ButtonState state;
             switch (action) {
@@ -178,31 +189,29 @@ void Window::setupCallbacks() {
                     break;
             }
             
-            gInputSystem->updateMouseButtonState(button, state);
-            
-            double xpos, ypos;
-            glfwGetCursorPos(window, &xpos, &ypos);
-            
             input::InputEvent event;
             event.type = input::EventType::MOUSE_BUTTON;
             event.code = button;
             event.state = state;
-            event.position = glm::vec2(xpos, ypos);
             event.mods = mods;
+            event.timestamp = glfwGetTime();
             
-            gInputSystem->processInputEvent(event);
+            gInputSystem->queueEvent(event);
         }
     });
     
-    // Set up the key callback to work with both UI and InputSystem
-    glfwSetKeyCallback(window_, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
-        // First, call our UI callback
-        Window* windowPtr = static_cast<Window*>(glfwGetWindowUserPointer(window));
-        if (windowPtr && windowPtr->uiManager_) {
-            windowPtr->uiManager_->onKey(key, scancode, action, mods);
+    glfwSetScrollCallback(window_, [](GLFWwindow* window, double xoffset, double yoffset) {
+        if (gInputSystem) {
+            input::InputEvent event;
+            event.type = input::EventType::MOUSE_SCROLL;
+            event.delta = glm::vec2(xoffset, yoffset);
+            event.timestamp = glfwGetTime();
+            
+            gInputSystem->queueEvent(event);
         }
-        
-        // Manually update the input system with the key event
+    });
+    
+    glfwSetKeyCallback(window_, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
         if (gInputSystem) {
             input::ButtonState state;
             switch (action) {
@@ -220,33 +229,60 @@ void Window::setupCallbacks() {
                     break;
             }
             
-            gInputSystem->updateKeyState(key, state);
-            
             input::InputEvent event;
             event.type = input::EventType::KEY;
             event.code = key;
             event.state = state;
             event.mods = mods;
+            event.timestamp = glfwGetTime();
             
-            gInputSystem->processInputEvent(event);
+            gInputSystem->queueEvent(event);
         }
     });
     
-    // Set up the char callback to work with both UI and InputSystem
     glfwSetCharCallback(window_, [](GLFWwindow* window, unsigned int codepoint) {
-        // First, call our UI callback
-        Window* windowPtr = static_cast<Window*>(glfwGetWindowUserPointer(window));
-        if (windowPtr && windowPtr->uiManager_) {
-            windowPtr->uiManager_->onChar(codepoint);
-        }
-        
-        // Manually update the input system with the char event
         if (gInputSystem) {
-            gInputSystem->appendTextInput(codepoint);
+            input::InputEvent event;
+            event.type = input::EventType::CHAR;
+            event.code = static_cast<int>(codepoint);
+            event.timestamp = glfwGetTime();
+            
+            gInputSystem->queueEvent(event);
         }
     });
 }
 
+bool Window::routeEventToUI(const input::InputEvent& event) {
+    if (!uiManager_) {
+        return false;
+    }
+    
+    switch (event.type) {
+        case input::EventType::MOUSE_MOVE_RAW:
+            uiManager_->onMouseMove(event.position.x, event.position.y);
+            return false;
+        case input::EventType::MOUSE_BUTTON: {
+            int action = event.state == input::ButtonState::PRESSED_THIS_FRAME ? GLFW_PRESS : GLFW_RELEASE;
+            return uiManager_->onMouseButton(event.code, action, event.mods, event.position.x, event.position.y);
+        }
+        case input::EventType::MOUSE_SCROLL:
+            return uiManager_->onScroll(event.delta.x, event.delta.y);
+        case input::EventType::KEY: {
+            int action = GLFW_RELEASE;
+            if (event.state == input::ButtonState::PRESSED_THIS_FRAME) {
+                action = GLFW_PRESS;
+            } else if (event.state == input::ButtonState::HELD) {
+                action = GLFW_REPEAT;
+            }
+            return uiManager_->onKey(event.code, glfwGetKeyScancode(event.code), action, event.mods);
+        }
+        case input::EventType::CHAR:
+            return uiManager_->onChar(static_cast<unsigned int>(event.code));
+        default:
+            return false;
+    }
+}
+
 void Window::framebufferSizeCallback(GLFWwindow* window, int width, int height) {
     Window* windowPtr = static_cast<Window*>(glfwGetWindowUserPointer(window));
     if (windowPtr) {
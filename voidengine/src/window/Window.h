@@ -12,6 +12,7 @@ class UIManager;
 
 namespace input {
 class InputSystem;
+struct InputEvent;
 }
 
 namespace window {
@@ -34,8 +35,16 @@ public:
     ui::UIManager* getUIManager() const { return uiManager_.get(); }
     input::InputSystem* getInputSystem() const;
     
+    // Binds the default UI navigation inputs and puts the UI manager in
+    // navigation mode; off by default so the arrows, Space and Enter reach
+    // gameplay untouched
+    void setUINavigation(bool enabled);
+    bool isUINavigation() const { return uiNavigation_; }
+    
 private:
     void setupCallbacks();
+    // Hands a queued event to the UI manager; true when the UI consumed it
+    bool routeEventToUI(const input::InputEvent& event);
     
     static void framebufferSizeCallback(GLFWwindow* window, int width, int height);
     static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
@@ -48,6 +57,8 @@ private:
     int height_;
     std::string title_;
     std::unique_ptr<ui::UIManager> uiManager_;
+    bool uiNavigation_ = false;
+    bool navigationInputsBound_ = false;
 }; 
 
 } // namespace window
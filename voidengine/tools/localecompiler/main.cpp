@@ -0,0 +1,38 @@
+#include "ui/FontRenderer.h"
+#include "ui/LocaleCompiler.h"
+#include "ui/UIRenderer.h"
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+int main(int argc, char** argv) {
+    if (argc < 3 || (argc - 3) % 2 != 0) {
+        std::cerr << "Usage: " << argv[0] << " <strings.txt> <output.vloc> [<font> <pixel size>]..." << std::endl;
+        return 2;
+    }
+    
+    using namespace voidengine;
+    try {
+        // Metrics for the box fallback are always baked, then those of each
+        // font named
+        std::vector<ui::LocaleFont> fonts;
+        fonts.push_back(ui::LocaleFont{0, [](std::string_view text) {
+            return ui::measureText(text.data(), text.size(), ui::FONT_BASE_SIZE);
+        }});
+        for (int i = 3; i < argc; i += 2) {
+            auto metrics = std::make_shared<ui::FontMetrics>(argv[i], static_cast<unsigned int>(std::atoi(argv[i + 1])));
+            fonts.push_back(ui::LocaleFont{metrics->getFontKey(), [metrics](std::string_view text) {
+                return metrics->measure(text.data(), text.size());
+            }});
+        }
+        
+        ui::compileLocaleFile(argv[1], argv[2], fonts);
+    } catch (const std::exception& e) {
+        std::cerr << argv[1] << ": " << e.what() << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,19 @@
+#include "ui/ScreenCompiler.h"
+#include <exception>
+#include <iostream>
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <screen.json> <output.vui>" << std::endl;
+        return 2;
+    }
+    
+    try {
+        voidengine::ui::compileScreenFile(argv[1], argv[2]);
+    } catch (const std::exception& e) {
+        std::cerr << argv[1] << ": " << e.what() << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}